@@ -33,6 +33,9 @@ extern "C" {
 extern float log2f(float);
 extern float logf(float);
 
+extern float exp2f(float);
+extern float powf(float, float);
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,25 @@
 #include "artnetrdm.h"
 #include "artnetipprog.h"
 
+#ifndef ARTNET_NODE_MAX_PORTS
+ #define ARTNET_NODE_MAX_PORTS	32	///< Number of output ports of all virtual nodes together
+#endif
+
+#define ARTNET_NODE_MAX_PAGES	(ARTNET_NODE_MAX_PORTS / ARTNET_MAX_PORTS)	///< Virtual nodes, each one with its own ArtPollReply (BindIndex = page + 1)
+
+#if (ARTNET_NODE_MAX_PORTS % 4) != 0	// ARTNET_MAX_PORTS is an enum
+ #error ARTNET_NODE_MAX_PORTS must be a multiple of ARTNET_MAX_PORTS
+#endif
+
+#define ARTNET_PORT_ADDRESS_TABLE_SIZE	64	///< Power of 2, at least twice \ref ARTNET_NODE_MAX_PORTS
+#define ARTNET_PORT_ADDRESS_EMPTY		0xFFFF	///< Bit 15 of a Port-Address is always 0
+
+#define ARTNET_RDM_INCREMENTAL_INTERVAL	60		///< Seconds, between incremental discoveries after AtcIncOn
+
+#if (ARTNET_PORT_ADDRESS_TABLE_SIZE & (ARTNET_PORT_ADDRESS_TABLE_SIZE - 1)) != 0 || (ARTNET_PORT_ADDRESS_TABLE_SIZE < (2 * ARTNET_NODE_MAX_PORTS))
+ #error ARTNET_PORT_ADDRESS_TABLE_SIZE
+#endif
+
 struct TArtNetNodeState {
 	bool SendArtPollReplyOnChange;				///< ArtPoll : TalkToMe Bit 1 : 1 = Send ArtPollReply whenever Node conditions change.
 	uint32_t ArtPollReplyCount;					///< ArtPollReply : NodeReport : decimal counter that increments every time the Node sends an ArtPollResponse.
@@ -76,8 +95,8 @@ struct TArtNetNode {
 	uint32_t IPAddressLocal;						///< Local IP Address
 	uint32_t IPAddressBroadcast;					///< The broadcast IP Address
 	uint32_t IPSubnetMask;							///< The subnet mask
-	uint8_t  NetSwitch;								///< Bits 14-8 of the 15 bit Port-Address are encoded into the bottom 7 bits of this field.
-	uint8_t  SubSwitch;								///< Bits 7-4 of the 15 bit Port-Address are encoded into the bottom 4 bits of this field.
+	uint8_t  NetSwitch[ARTNET_NODE_MAX_PAGES];		///< Per virtual node : Bits 14-8 of the 15 bit Port-Address are encoded into the bottom 7 bits of this field.
+	uint8_t  SubSwitch[ARTNET_NODE_MAX_PAGES];		///< Per virtual node : Bits 7-4 of the 15 bit Port-Address are encoded into the bottom 4 bits of this field.
 	uint8_t  Oem[2];								///< The Oem word describes the equipment vendor and the feature set available.
 	uint8_t  ShortName[ARTNET_SHORT_NAME_LENGTH];	///< The array represents a null terminated short name for the Node.
 	uint8_t  LongName[ARTNET_LONG_NAME_LENGTH];		///< The array represents a null terminated long name for the Node.
@@ -109,6 +128,11 @@ struct TOutputPort {
 	TGenericPort port;					///< \ref TGenericPort
 };
 
+struct TPortAddressPort {
+	uint16_t nPortAddress;				///< \ref ARTNET_PORT_ADDRESS_EMPTY when the slot is free
+	uint8_t nPortIndex;
+};
+
 class ArtNetNode {
 public:
 	ArtNetNode(void);
@@ -138,11 +162,11 @@ public:
 	uint8_t GetUniverseSwitch(uint8_t) const;
 	int SetUniverseSwitch(uint8_t, TArtNetPortDir, uint8_t);
 
-	uint8_t GetNetSwitch(void) const;
-	void SetNetSwitch(uint8_t);
+	uint8_t GetNetSwitch(uint8_t nPage = 0) const;
+	void SetNetSwitch(uint8_t, uint8_t nPage = 0);
 
-	uint8_t GetSubnetSwitch(void) const;
-	void SetSubnetSwitch(uint8_t);
+	uint8_t GetSubnetSwitch(uint8_t nPage = 0) const;
+	void SetSubnetSwitch(uint8_t, uint8_t nPage = 0);
 
 	const uint8_t *GetManufacturerId(void);
 	void SetManufacturerId(const uint8_t *);
@@ -160,6 +184,7 @@ public:
 	void SendTimeCode(const struct TArtNetTimeCode *);
 
 	int HandlePacket(void);
+	uint32_t GetMillisToNextTimer(void);
 
 	void Print(void);
 
@@ -170,7 +195,12 @@ private:
 	void FillDiagData(void);
 	void FillTimeCodeData(void);
 
-	uint16_t MakePortAddress(uint16_t);
+	uint16_t MakePortAddress(uint16_t, uint8_t);
+
+	void FillPortAddressTable(void);
+	uint8_t LookupPort(uint16_t) const;
+
+	int HandleArtPacket(void);
 
 	void HandlePoll(void);
 	void HandleDmx(void);
@@ -189,6 +219,8 @@ private:
 
 	void SendPollRelply(bool);
 	void SendTod(void);
+	void StartRdmDiscovery(bool bIncremental);
+	void RunRdmDiscovery(void);
 
 	void SetNetworkDataLossCondition(void);
 
@@ -211,7 +243,8 @@ private:
 	struct TArtTodData		*m_pTodData;
 	struct TArtIpProgReply	*m_pIpProgReply;
 
-	struct TOutputPort		m_OutputPorts[ARTNET_MAX_PORTS];
+	struct TOutputPort		m_OutputPorts[ARTNET_NODE_MAX_PORTS];
+	struct TPortAddressPort	m_PortAddressTable[ARTNET_PORT_ADDRESS_TABLE_SIZE];
 
 	bool					m_bDirectUpdate;
 
@@ -221,6 +254,10 @@ private:
 
 	bool					m_IsLightSetRunning;
 	bool					m_IsRdmResponder;
+	bool					m_IsRdmDiscoveryRunning;
+	bool					m_IsRdmLineHeld;	///< The LightSet is stopped for the discovery
+	bool					m_IsRdmIncremental;	///< AtcIncOn
+	time_t					m_nRdmDiscoveryTime;
 
 	char					m_aSysName[16];
 };
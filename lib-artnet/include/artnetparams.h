@@ -60,6 +60,10 @@ public:
 	uint8_t GetNet(void) const;
 	uint8_t GetSubnet(void) const;
 	uint8_t GetUniverse(void) const;
+	uint8_t GetUniverses(void) const;
+	uint8_t GetNet(uint8_t) const;
+	uint8_t GetSubnet(uint8_t) const;
+	uint8_t GetUniverse(uint8_t) const;
 	const uint8_t *GetShortName(void) const;
 	const uint8_t *GetLongName(void) const;
 	TOutputType GetOutputType(void) const;
@@ -71,12 +75,16 @@ public:
 	bool IsRdm(void) const;
 	bool IsRdmDiscovery(void) const;
 
+	void SetUniverses(uint8_t);
+
 	void Set(ArtNetNode *);
 	void Dump(void);
 
 private:
 	bool isMaskSet(uint16_t) const;
 	uint16_t HexUint16(const char *) const;
+	uint16_t GetPortAddress(uint8_t) const;
+	void CheckPortAddresses(void);
 
 public:
     static void staticCallbackFunction(void *p, const char *s);
@@ -94,6 +102,7 @@ private:
     uint8_t m_nNet;
     uint8_t m_nSubnet;
     uint8_t m_nUniverse;
+    uint8_t m_nUniverses;
     TOutputType m_tOutputType;
     bool m_bUseTimeCode;
     bool m_bUseTimeSync;
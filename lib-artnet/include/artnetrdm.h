@@ -39,10 +39,30 @@ public:
 	virtual ~ArtNetRdm(void);
 
 	virtual void Full(void)=0;
-	virtual const uint8_t GetUidCount(void)=0;
+	virtual const uint16_t GetUidCount(void)=0;
 	virtual void Copy(uint8_t *)=0;
+	/**
+	 * Copies at most nCount UIDs, starting at UID number nOffset.
+	 * @return The number of UIDs copied
+	 */
+	virtual uint16_t Copy(uint8_t *, uint16_t nOffset, uint16_t nCount)=0;
 
 	virtual const uint8_t *Handler(const uint8_t *)=0;
+
+	/**
+	 * The discovery is ticked by ArtNetNode from its main loop. The defaults
+	 * are for a blocking Full: it is done when DiscoveryStart returns.
+	 */
+	virtual void DiscoveryStart(bool bIncremental);
+	virtual void DiscoveryStop(void);
+	/**
+	 * @return false when the discovery has finished
+	 */
+	virtual bool DiscoveryRun(void);
+	/**
+	 * While false, the DMX output must be stopped.
+	 */
+	virtual bool DiscoveryIsLineFree(void);
 };
 
 #endif /* ARTNETRDM_H_ */
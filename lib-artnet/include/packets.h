@@ -171,7 +171,7 @@ struct TArtAddress {
 	uint8_t ProtVerHi;		///< High byte of the Art-Net protocol revision number.
 	uint8_t ProtVerLo;		///< Low byte of the Art-Net protocol revision number. Current value 14.
 	uint8_t NetSwitch;		///< This value is ignored unless bit 7 is high. Send 0x00 to reset this value to the physical switch setting. Use value 0x7f for no change.
-	uint8_t Filler2;		///< Pad length to match ArtPoll.
+	uint8_t BindIndex;		///< The BindIndex defines the bound node which originated this packet. Zero or 1 addresses the root device.
 	uint8_t ShortName[ARTNET_SHORT_NAME_LENGTH];///< The Node will ignore this value if the string is null.
 	uint8_t LongName[ARTNET_LONG_NAME_LENGTH];	///< The Node will ignore this value if the string is null.
 	uint8_t SwIn[ARTNET_MAX_PORTS];		///< This value is ignored unless bit 7 is high. Send 0x00 to reset this value to the physical switch setting. Use value 0x7f for no change.
@@ -274,10 +274,12 @@ struct TArtTodControl {
 	uint8_t Spare6;			///< Transmit as zero, receivers don’t test.
 	uint8_t Spare7;			///< Transmit as zero, receivers don’t test.
 	uint8_t Net;			///< The top 7 bits of the 15 bit Port-Address of Nodes that must respond to this packet.
-	uint8_t Command;		///< 0x00 AtcNone No action. 0x01 AtcFlush The node flushes its TOD and instigates full discovery.
+	uint8_t Command;		///< 0x00 AtcNone No action. 0x01 AtcFlush The node flushes its TOD and instigates full discovery. 0x02 AtcEnd The node ends discovery. 0x03 AtcIncOn The node enables incremental discovery. 0x04 AtcIncOff The node disables incremental discovery.
 	uint8_t Address;		///< The low byte of the 15 bit Port-Address of the DMX Port that should action this command.
 }PACKED;
 
+#define ARTNET_TOD_UIDS_PER_PACKET	200	///< A larger TOD is sent as several ArtTodData packets, see BlockCount
+
 /**
  * ArtTodData packet definition
  */
@@ -302,7 +304,7 @@ struct TArtTodData {
 	uint8_t UidTotalLo;
 	uint8_t BlockCount; 	///< The index number of this packet. When UidTotal exceeds 200, multiple ArtTodData packets are used.
 	uint8_t UidCount;		///< The number of UIDs encoded in this packet. This is the index of the following array.
-	uint8_t Tod[200][6];	///< 48 bit An array of RDM UID. // TODO #define
+	uint8_t Tod[ARTNET_TOD_UIDS_PER_PACKET][6];	///< 48 bit An array of RDM UID.
 }PACKED;
 
 /**
@@ -47,6 +47,7 @@
 #include "packets.h"
 
 #include "lightset.h"
+#include "dmxbuffer.h"
 #include "ledblink.h"
 
 #include "artnetrdm.h"
@@ -124,12 +125,16 @@ ArtNetNode::ArtNetNode(void) :
 		m_nCurrentPacketTime(0),
 		m_nPreviousPacketTime(0),
 		m_IsLightSetRunning(false),
-		m_IsRdmResponder(false)
+		m_IsRdmResponder(false),
+		m_IsRdmDiscoveryRunning(false),
+		m_IsRdmLineHeld(false),
+		m_IsRdmIncremental(false),
+		m_nRdmDiscoveryTime(0)
 
  {
 	memset(&m_Node, 0, sizeof (struct TArtNetNode));
 
-	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
+	for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
 		m_OutputPorts[i].port.nStatus = (uint8_t) 0;
 		m_OutputPorts[i].port.nPortAddress = (uint16_t) 0;
 		m_OutputPorts[i].port.nDefaultAddress = (uint8_t) 0;
@@ -141,6 +146,8 @@ ArtNetNode::ArtNetNode(void) :
 		m_OutputPorts[i].ipB = (uint32_t) 0;
 	}
 
+	FillPortAddressTable();
+
 	m_Node.Status1 = STATUS1_INDICATOR_NORMAL_MODE | STATUS1_PAP_FRONT_PANEL;
 	m_Node.Status2 = STATUS2_DHCP_CAPABLE | STATUS2_PORT_ADDRESS_15BIT;
 
@@ -209,13 +216,6 @@ void ArtNetNode::Start(void) {
 
 	Network::Get()->Begin(ARTNET_UDP_PORT);
 
-	m_PollReply.NumPortsLo = m_State.nActivePorts;
-
-	for (unsigned i = 0 ; i < ARTNET_MAX_PORTS; i++) {
-		if (m_OutputPorts[i].bIsEnabled) {
-			m_PollReply.PortTypes[i] = ARTNET_ENABLE_OUTPUT | ARTNET_PORT_DMX;
-		}
-	}
 	m_State.status = ARTNET_ON;
 
 	LedBlink::Get()->SetMode(LEDBLINK_MODE_NORMAL);
@@ -259,14 +259,14 @@ uint8_t ArtNetNode::GetActiveInputPorts(void) const {
 }
 
 uint8_t ArtNetNode::GetUniverseSwitch(uint8_t nPortId) const {
-	if (nPortId >= ARTNET_MAX_PORTS) {
+	if (nPortId >= ARTNET_NODE_MAX_PORTS) {
 		return ARTNET_EARG;
 	}
 	return m_OutputPorts[nPortId].port.nDefaultAddress;
 }
 
 int ArtNetNode::SetUniverseSwitch(const uint8_t nPortIndex, const TArtNetPortDir dir, const uint8_t nAddress) {
-	if (nPortIndex >= ARTNET_MAX_PORTS) {
+	if (nPortIndex >= ARTNET_NODE_MAX_PORTS) {
 		return ARTNET_EARG;
 	}
 
@@ -276,7 +276,7 @@ int ArtNetNode::SetUniverseSwitch(const uint8_t nPortIndex, const TArtNetPortDir
 	} else if (dir == ARTNET_OUTPUT_PORT) {
 		if (!m_OutputPorts[nPortIndex].bIsEnabled) {
 			m_State.nActivePorts = m_State.nActivePorts + 1;
-			assert(m_State.nActivePorts <= ARTNET_MAX_PORTS);
+			assert(m_State.nActivePorts <= ARTNET_NODE_MAX_PORTS);
 		}
 		m_OutputPorts[nPortIndex].bIsEnabled = true;
 	} else {
@@ -284,33 +284,47 @@ int ArtNetNode::SetUniverseSwitch(const uint8_t nPortIndex, const TArtNetPortDir
 	}
 
 	m_OutputPorts[nPortIndex].port.nDefaultAddress = nAddress & (uint16_t)0x0F;		// Universe : Bits 3-0
-	m_OutputPorts[nPortIndex].port.nPortAddress = MakePortAddress((uint16_t)nAddress);
+	m_OutputPorts[nPortIndex].port.nPortAddress = MakePortAddress((uint16_t)nAddress, nPortIndex / ARTNET_MAX_PORTS);
+
+	FillPortAddressTable();
 
 	return ARTNET_EOK;
 }
 
-uint8_t ArtNetNode::GetSubnetSwitch(void) const {
-	return m_Node.SubSwitch;
+uint8_t ArtNetNode::GetSubnetSwitch(uint8_t nPage) const {
+	assert(nPage < ARTNET_NODE_MAX_PAGES);
+
+	return m_Node.SubSwitch[nPage];
 }
 
-void ArtNetNode::SetSubnetSwitch(const uint8_t nAddress) {
-	m_Node.SubSwitch = nAddress;
+void ArtNetNode::SetSubnetSwitch(const uint8_t nAddress, uint8_t nPage) {
+	assert(nPage < ARTNET_NODE_MAX_PAGES);
 
-	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
-		m_OutputPorts[i].port.nPortAddress = MakePortAddress(m_OutputPorts[i].port.nPortAddress);
+	m_Node.SubSwitch[nPage] = nAddress;
+
+	for (unsigned i = nPage * ARTNET_MAX_PORTS; i < (nPage + 1U) * ARTNET_MAX_PORTS; i++) {
+		m_OutputPorts[i].port.nPortAddress = MakePortAddress(m_OutputPorts[i].port.nPortAddress, nPage);
 	}
+
+	FillPortAddressTable();
 }
 
-uint8_t ArtNetNode::GetNetSwitch(void) const{
-	return m_Node.NetSwitch;
+uint8_t ArtNetNode::GetNetSwitch(uint8_t nPage) const{
+	assert(nPage < ARTNET_NODE_MAX_PAGES);
+
+	return m_Node.NetSwitch[nPage];
 }
 
-void ArtNetNode::SetNetSwitch(uint8_t nAddress) {
-	m_Node.NetSwitch = nAddress;
+void ArtNetNode::SetNetSwitch(uint8_t nAddress, uint8_t nPage) {
+	assert(nPage < ARTNET_NODE_MAX_PAGES);
 
-	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
-		m_OutputPorts[i].port.nPortAddress = MakePortAddress(m_OutputPorts[i].port.nPortAddress);
+	m_Node.NetSwitch[nPage] = nAddress;
+
+	for (unsigned i = nPage * ARTNET_MAX_PORTS; i < (nPage + 1U) * ARTNET_MAX_PORTS; i++) {
+		m_OutputPorts[i].port.nPortAddress = MakePortAddress(m_OutputPorts[i].port.nPortAddress, nPage);
 	}
+
+	FillPortAddressTable();
 }
 
 const char *ArtNetNode::GetShortName(void) {
@@ -373,15 +387,54 @@ void ArtNetNode::SetNetworkTimeout(time_t nNetworkDataLossTimeout) {
 	}
 }
 
-uint16_t ArtNetNode::MakePortAddress(const uint16_t nCurrentAddress) {
+uint16_t ArtNetNode::MakePortAddress(const uint16_t nCurrentAddress, uint8_t nPage) {
 	// PortAddress Bit 15 = 0
-	uint16_t newAddress = (m_Node.NetSwitch & 0x7F) << 8;	// Net : Bits 14-8
-	newAddress |= (m_Node.SubSwitch & (uint8_t)0x0F) << 4;	// Sub-Net : Bits 7-4
-	newAddress |= nCurrentAddress & (uint16_t)0x0F;			// Universe : Bits 3-0
+	uint16_t newAddress = (m_Node.NetSwitch[nPage] & 0x7F) << 8;	// Net : Bits 14-8
+	newAddress |= (m_Node.SubSwitch[nPage] & (uint8_t)0x0F) << 4;	// Sub-Net : Bits 7-4
+	newAddress |= nCurrentAddress & (uint16_t)0x0F;					// Universe : Bits 3-0
 
 	return newAddress;
 }
 
+void ArtNetNode::FillPortAddressTable(void) {
+	for (unsigned i = 0; i < ARTNET_PORT_ADDRESS_TABLE_SIZE; i++) {
+		m_PortAddressTable[i].nPortAddress = ARTNET_PORT_ADDRESS_EMPTY;
+	}
+
+	for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
+		if (!m_OutputPorts[i].bIsEnabled) {
+			continue;
+		}
+
+		const uint16_t nPortAddress = m_OutputPorts[i].port.nPortAddress;
+		unsigned nSlot = nPortAddress & (ARTNET_PORT_ADDRESS_TABLE_SIZE - 1);
+
+		// Linear probing, the table is at least half empty
+		while ((m_PortAddressTable[nSlot].nPortAddress != ARTNET_PORT_ADDRESS_EMPTY) && (m_PortAddressTable[nSlot].nPortAddress != nPortAddress)) {
+			nSlot = (nSlot + 1) & (ARTNET_PORT_ADDRESS_TABLE_SIZE - 1);
+		}
+
+		// The first port wins when ports share a Port-Address
+		if (m_PortAddressTable[nSlot].nPortAddress == ARTNET_PORT_ADDRESS_EMPTY) {
+			m_PortAddressTable[nSlot].nPortAddress = nPortAddress;
+			m_PortAddressTable[nSlot].nPortIndex = i;
+		}
+	}
+}
+
+uint8_t ArtNetNode::LookupPort(uint16_t nPortAddress) const {
+	unsigned nSlot = nPortAddress & (ARTNET_PORT_ADDRESS_TABLE_SIZE - 1);
+
+	while (m_PortAddressTable[nSlot].nPortAddress != ARTNET_PORT_ADDRESS_EMPTY) {
+		if (m_PortAddressTable[nSlot].nPortAddress == nPortAddress) {
+			return m_PortAddressTable[nSlot].nPortIndex;
+		}
+		nSlot = (nSlot + 1) & (ARTNET_PORT_ADDRESS_TABLE_SIZE - 1);
+	}
+
+	return ARTNET_NODE_MAX_PORTS;
+}
+
 void ArtNetNode::FillPollReply(void) {
 	memset(&m_PollReply, 0, sizeof (struct TArtPollReply));
 
@@ -393,8 +446,6 @@ void ArtNetNode::FillPollReply(void) {
 	m_PollReply.Port = (uint16_t) ARTNET_UDP_PORT;
 	m_PollReply.VersInfoH = DEVICE_SOFTWARE_VERSION[0];
 	m_PollReply.VersInfoL = DEVICE_SOFTWARE_VERSION[1];
-	m_PollReply.NetSwitch = m_Node.NetSwitch;
-	m_PollReply.SubSwitch = m_Node.SubSwitch;
 	m_PollReply.OemHi = m_Node.Oem[0];
 	m_PollReply.Oem = m_Node.Oem[1];
 	m_PollReply.Status1 = m_Node.Status1;
@@ -457,17 +508,56 @@ void ArtNetNode::SendPollRelply(const bool bResponse) {
 		m_State.ArtPollReplyCount++;
 	}
 
-	for (unsigned i = 0 ; i < ARTNET_MAX_PORTS; i++) {
-		m_PollReply.GoodOutput[i] = m_OutputPorts[i].port.nStatus;
-		m_PollReply.SwOut[i] = m_OutputPorts[i].port.nDefaultAddress;
-	}
-
 	char report[ARTNET_REPORT_LENGTH];
 
 	snprintf(report, ARTNET_REPORT_LENGTH, "%04x [%04d] %s AvV", (int)m_State.reportCode, (int)m_State.ArtPollReplyCount, m_aSysName);
 	strcpy((char *)m_PollReply.NodeReport, report);
 
-	Network::Get()->SendTo((const uint8_t *)&(m_PollReply), (const uint16_t)sizeof (struct TArtPollReply), m_Node.IPAddressBroadcast, (uint16_t)ARTNET_UDP_PORT);
+	unsigned nPages = 1;
+
+	for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
+		if (m_OutputPorts[i].bIsEnabled) {
+			nPages = (i / ARTNET_MAX_PORTS) + 1;
+		}
+	}
+
+	// Every page of ARTNET_MAX_PORTS ports is a virtual node with its own ArtPollReply.
+	// The BindIndex is only used when there is more than one page.
+	for (unsigned nPage = 0; nPage < nPages; nPage++) {
+		uint8_t nActivePorts = 0;
+
+		for (unsigned i = 0 ; i < ARTNET_MAX_PORTS; i++) {
+			const struct TOutputPort *pPort = &m_OutputPorts[nPage * ARTNET_MAX_PORTS + i];
+
+			if (pPort->bIsEnabled) {
+				m_PollReply.PortTypes[i] = ARTNET_ENABLE_OUTPUT | ARTNET_PORT_DMX;
+				nActivePorts++;
+			} else {
+				m_PollReply.PortTypes[i] = 0;
+			}
+
+			m_PollReply.GoodOutput[i] = pPort->port.nStatus;
+			m_PollReply.SwOut[i] = pPort->port.nDefaultAddress;
+		}
+
+		if ((nPage != 0) && (nActivePorts == 0)) {
+			continue;
+		}
+
+		m_PollReply.NumPortsLo = nActivePorts;
+		m_PollReply.NetSwitch = m_Node.NetSwitch[nPage];
+		m_PollReply.SubSwitch = m_Node.SubSwitch[nPage];
+
+		if (nPages > 1) {
+			memcpy(m_PollReply.BindIp, m_PollReply.IPAddress, sizeof m_PollReply.BindIp);
+			m_PollReply.BindIndex = nPage + 1;
+		} else {
+			memset(m_PollReply.BindIp, 0, sizeof m_PollReply.BindIp);
+			m_PollReply.BindIndex = 0;
+		}
+
+		Network::Get()->SendTo((const uint8_t *)&(m_PollReply), (const uint16_t)sizeof (struct TArtPollReply), m_Node.IPAddressBroadcast, (uint16_t)ARTNET_UDP_PORT);
+	}
 }
 
 void ArtNetNode::SendDiag(const char *text, TPriorityCodes nPriority) {
@@ -491,35 +581,17 @@ void ArtNetNode::SendDiag(const char *text, TPriorityCodes nPriority) {
 }
 
 bool ArtNetNode::IsDmxDataChanged(const uint8_t nPortId, const uint8_t *pData, const uint16_t nLength) {
-	bool isChanged = false;
-
-	uint8_t *src = (uint8_t *) pData;
-	uint8_t *dst = m_OutputPorts[nPortId].data;
+	const bool isChanged = DmxBuffer::CompareCopy(m_OutputPorts[nPortId].data, pData, nLength);
 
 	if (nLength != m_OutputPorts[nPortId].nLength) {
 		m_OutputPorts[nPortId].nLength = nLength;
-
-		for (unsigned i = 0 ; i < ARTNET_DMX_LENGTH; i++) {
-			*dst++ = *src++;
-		}
 		return true;
 	}
 
-	for (unsigned i = 0; i < ARTNET_DMX_LENGTH; i++) {
-		if (*dst != *src) {
-			*dst = *src;
-			isChanged = true;
-		}
-		dst++;
-		src++;
-	}
-
 	return isChanged;
 }
 
 bool ArtNetNode::IsMergedDmxDataChanged(const uint8_t nPortId, const uint8_t *pData, const uint16_t nLength) {
-	bool isChanged = false;
-
 	if (!m_State.IsMergeMode) {
 		m_State.IsMergeMode = true;
 		m_State.IsChanged = true;
@@ -529,24 +601,13 @@ bool ArtNetNode::IsMergedDmxDataChanged(const uint8_t nPortId, const uint8_t *pD
 
 
 	if (m_OutputPorts[nPortId].mergeMode == ARTNET_MERGE_HTP) {
+		const bool isChanged = DmxBuffer::MergeHtp(m_OutputPorts[nPortId].data, m_OutputPorts[nPortId].dataA, m_OutputPorts[nPortId].dataB, nLength);
 
 		if (nLength != m_OutputPorts[nPortId].nLength) {
 			m_OutputPorts[nPortId].nLength = nLength;
-			for (unsigned i = 0; i < nLength; i++) {
-				uint8_t data = max(m_OutputPorts[nPortId].dataA[i], m_OutputPorts[nPortId].dataB[i]);
-				m_OutputPorts[nPortId].data[i] = data;
-			}
 			return true;
 		}
 
-		for (unsigned i = 0; i < nLength; i++) {
-			uint8_t data = max(m_OutputPorts[nPortId].dataA[i], m_OutputPorts[nPortId].dataB[i]);
-			if (data != m_OutputPorts[nPortId].data[i]) {
-				m_OutputPorts[nPortId].data[i] = data;
-				isChanged = true;
-			}
-		}
-
 		return isChanged;
 	} else {
 		return IsDmxDataChanged(nPortId, pData, nLength);
@@ -559,11 +620,13 @@ void ArtNetNode::CheckMergeTimeouts(const uint8_t nPortId) {
 
 	if (timeOutA > (time_t)ARTNET_MERGE_TIMEOUT_SECONDS) {
 		m_OutputPorts[nPortId].ipA = 0;
+		DmxBuffer::Clear(m_OutputPorts[nPortId].dataA, ARTNET_DMX_LENGTH);
 		m_State.IsMergeMode = false;
 	}
 
 	if (timeOutB > (time_t)ARTNET_MERGE_TIMEOUT_SECONDS) {
 		m_OutputPorts[nPortId].ipB = 0;
+		DmxBuffer::Clear(m_OutputPorts[nPortId].dataB, ARTNET_DMX_LENGTH);
 		m_State.IsMergeMode = false;
 	}
 
@@ -625,108 +688,108 @@ void ArtNetNode::HandleDmx(void) {
 	unsigned data_length = (unsigned) ((packet->LengthHi << 8) & 0xff00) | (packet->Length);
 	data_length = min(data_length, ARTNET_DMX_LENGTH);
 
-	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
-		if ((packet->PortAddress == m_OutputPorts[i].port.nPortAddress) &&  m_OutputPorts[i].bIsEnabled) {
+	const uint8_t i = LookupPort(packet->PortAddress);
 
-			uint32_t ipA = m_OutputPorts[i].ipA;
-			uint32_t ipB = m_OutputPorts[i].ipB;
+	if (i == ARTNET_NODE_MAX_PORTS) {
+		return;
+	}
 
-			bool sendNewData = false;
+	uint32_t ipA = m_OutputPorts[i].ipA;
+	uint32_t ipB = m_OutputPorts[i].ipB;
 
-			m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus |GO_DATA_IS_BEING_TRANSMITTED;
+	bool sendNewData = false;
 
-			if (m_State.IsMergeMode) {
-				CheckMergeTimeouts(i);
-			}
+	m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus |GO_DATA_IS_BEING_TRANSMITTED;
+
+	if (m_State.IsMergeMode) {
+		CheckMergeTimeouts(i);
+	}
 
-			if (ipA == 0 && ipB == 0) {
+	if (ipA == 0 && ipB == 0) {
 #ifdef SENDDIAG
-				SendDiag("1. first packet recv on this port", ARTNET_DP_LOW);
+		SendDiag("1. first packet recv on this port", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].timeA = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == 0) {
+		m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
+		m_OutputPorts[i].timeA = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
+		sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
+	} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == 0) {
 #ifdef SENDDIAG
-				SendDiag("2. continued transmission from the same ip (source A)", ARTNET_DP_LOW);
+		SendDiag("2. continued transmission from the same ip (source A)", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].timeA = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
-			} else if (ipA == 0 && ipB == m_ArtNetPacket.IPAddressFrom) {
+		m_OutputPorts[i].timeA = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
+		sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
+	} else if (ipA == 0 && ipB == m_ArtNetPacket.IPAddressFrom) {
 #ifdef SENDDIAG
-				SendDiag("3. continued transmission from the same ip (source B)", ARTNET_DP_LOW);
+		SendDiag("3. continued transmission from the same ip (source B)", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].timeB = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
-				sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == 0) {
+		m_OutputPorts[i].timeB = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
+		sendNewData = IsDmxDataChanged(i, packet->Data, data_length);
+	} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == 0) {
 #ifdef SENDDIAG
-				SendDiag("4. new source, start the merge", ARTNET_DP_LOW);
+		SendDiag("4. new source, start the merge", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].ipB = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].timeB = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
-			} else if (ipA == 0 && ipB != m_ArtNetPacket.IPAddressFrom) {
+		m_OutputPorts[i].ipB = m_ArtNetPacket.IPAddressFrom;
+		m_OutputPorts[i].timeB = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
+		sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
+	} else if (ipA == 0 && ipB != m_ArtNetPacket.IPAddressFrom) {
 #ifdef SENDDIAG
-				SendDiag("5. new source, start the merge", ARTNET_DP_LOW);
+		SendDiag("5. new source, start the merge", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
-				m_OutputPorts[i].timeA = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
+		m_OutputPorts[i].ipA = m_ArtNetPacket.IPAddressFrom;
+		m_OutputPorts[i].timeA = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
+		sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
+	} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
 #ifdef SENDDIAG
-				SendDiag("6. continue merge", ARTNET_DP_LOW);
+		SendDiag("6. continue merge", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].timeA = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
+		m_OutputPorts[i].timeA = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataA, packet->Data, data_length);
+		sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataA, data_length);
+	} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
 #ifdef SENDDIAG
-				SendDiag("7. continue merge", ARTNET_DP_LOW);
+		SendDiag("7. continue merge", ARTNET_DP_LOW);
 #endif
-				m_OutputPorts[i].timeB = m_nCurrentPacketTime;
-				memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
-				sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
-			} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
-				SendDiag("8. Source matches both buffers, this shouldn't be happening!", ARTNET_DP_LOW);
-				return;
-			} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
-				SendDiag("9. More than two sources, discarding data", ARTNET_DP_LOW);
-				return;
-			} else {
-				SendDiag("0. No cases matched, this shouldn't happen!", ARTNET_DP_LOW);
-				return;
-			}
+		m_OutputPorts[i].timeB = m_nCurrentPacketTime;
+		memcpy(&m_OutputPorts[i].dataB, packet->Data, data_length);
+		sendNewData = IsMergedDmxDataChanged(i, m_OutputPorts[i].dataB, data_length);
+	} else if (ipA == m_ArtNetPacket.IPAddressFrom && ipB == m_ArtNetPacket.IPAddressFrom) {
+		SendDiag("8. Source matches both buffers, this shouldn't be happening!", ARTNET_DP_LOW);
+		return;
+	} else if (ipA != m_ArtNetPacket.IPAddressFrom && ipB != m_ArtNetPacket.IPAddressFrom) {
+		SendDiag("9. More than two sources, discarding data", ARTNET_DP_LOW);
+		return;
+	} else {
+		SendDiag("0. No cases matched, this shouldn't happen!", ARTNET_DP_LOW);
+		return;
+	}
 
-			if (sendNewData || m_bDirectUpdate) {
-				if (!m_State.IsSynchronousMode) {
+	if (sendNewData || m_bDirectUpdate) {
+		if (!m_State.IsSynchronousMode) {
 #ifdef SENDDIAG
-					SendDiag("Send new data", ARTNET_DP_LOW);
+			SendDiag("Send new data", ARTNET_DP_LOW);
 #endif
-					m_pLightSet->SetData(i, m_OutputPorts[i].data, m_OutputPorts[i].nLength);
+			m_pLightSet->SetSource(m_ArtNetPacket.IPAddressFrom, OP_DMX);
+			m_pLightSet->SetData(i, m_OutputPorts[i].data, m_OutputPorts[i].nLength);
 
-					if(!m_IsLightSetRunning) {
-						m_pLightSet->Start();
-						m_IsLightSetRunning = true;
-					}
-				} else {
+			if(!m_IsLightSetRunning && !m_IsRdmLineHeld) {
+				m_pLightSet->Start();
+				m_IsLightSetRunning = true;
+			}
+		} else {
 #ifdef SENDDIAG
-					SendDiag("DMX data pending", ARTNET_DP_LOW);
+			SendDiag("DMX data pending", ARTNET_DP_LOW);
 #endif
-					m_OutputPorts[i].IsDataPending = true;
-				}
-			} else {
+			m_OutputPorts[i].IsDataPending = true;
+		}
+	} else {
 #ifdef SENDDIAG
-				SendDiag("Data not changed", ARTNET_DP_LOW);
+		SendDiag("Data not changed", ARTNET_DP_LOW);
 #endif
-			}
-			// Discontinue the loop. No need to return for other ports
-			return;
-		}
 	}
 }
 
@@ -734,25 +797,38 @@ void ArtNetNode::HandleSync(void) {
 	m_State.IsSynchronousMode = true;
 	m_State.ArtSyncTime = Hardware::Get()->GetTime();
 
-	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
+	m_pLightSet->SetSource(m_ArtNetPacket.IPAddressFrom, OP_SYNC);
+
+	for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
 		if (m_OutputPorts[i].IsDataPending) {
 #ifdef SENDDIAG
 			SendDiag("Send pending data", ARTNET_DP_LOW);
 #endif
 			m_pLightSet->SetData(i, m_OutputPorts[i].data, 	m_OutputPorts[i].nLength);
-			if(!m_IsLightSetRunning) {
+			if(!m_IsLightSetRunning && !m_IsRdmLineHeld) {
 				m_pLightSet->Start();
 				m_IsLightSetRunning = true;
 			}
 			m_OutputPorts[i].IsDataPending = false;
 		}
 	}
+
+	m_pLightSet->Sync();
 }
 
 void ArtNetNode::HandleAddress(void) {
 	const struct TArtAddress *packet = (struct TArtAddress *) &(m_ArtNetPacket.ArtPacket.ArtAddress);
 	bool bClearCommand = false;
 
+	// The BindIndex selects the virtual node, 0 and 1 are the root device
+	const unsigned nPage = (packet->BindIndex == 0) ? 0 : packet->BindIndex - 1U;
+
+	if (nPage >= ARTNET_NODE_MAX_PAGES) {
+		return;
+	}
+
+	const unsigned nPortBase = nPage * ARTNET_MAX_PORTS;
+
 	m_State.reportCode = ARTNET_RCPOWEROK;
 
 	if ((packet->ShortName[0] != PROGRAM_NO_CHANGE) && (packet->ShortName[0] != PROGRAM_DEFAULTS)) {
@@ -772,31 +848,35 @@ void ArtNetNode::HandleAddress(void) {
 	}
 
 	if (packet->SubSwitch == PROGRAM_DEFAULTS) {
-		SetSubnetSwitch(NODE_DEFAULT_SUBNET_SWITCH);
+		SetSubnetSwitch(NODE_DEFAULT_SUBNET_SWITCH, nPage);
 	} else if (packet->SubSwitch & PROGRAM_CHANGE_MASK) {
-		SetSubnetSwitch(packet->SubSwitch & ~PROGRAM_CHANGE_MASK);
+		SetSubnetSwitch(packet->SubSwitch & ~PROGRAM_CHANGE_MASK, nPage);
 	}
 
 	if (packet->NetSwitch == PROGRAM_DEFAULTS) {
-		SetNetSwitch(NODE_DEFAULT_NET_SWITCH);
+		SetNetSwitch(NODE_DEFAULT_NET_SWITCH, nPage);
 	} else if (packet->NetSwitch & PROGRAM_CHANGE_MASK) {
-		SetNetSwitch(packet->NetSwitch & ~PROGRAM_CHANGE_MASK);
+		SetNetSwitch(packet->NetSwitch & ~PROGRAM_CHANGE_MASK, nPage);
 	}
 
 	for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
 		if (packet->SwOut[i] == PROGRAM_NO_CHANGE) {
 			continue;
 		} else if (packet->SwOut[i] == PROGRAM_DEFAULTS) {
-			SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, NODE_DEFAULT_UNIVERSE);
+			SetUniverseSwitch(nPortBase + i, ARTNET_OUTPUT_PORT, NODE_DEFAULT_UNIVERSE);
 		} else if (packet->SwOut[i] & PROGRAM_CHANGE_MASK) {
-			SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, packet->SwOut[i] & ~PROGRAM_CHANGE_MASK);
+			SetUniverseSwitch(nPortBase + i, ARTNET_OUTPUT_PORT, packet->SwOut[i] & ~PROGRAM_CHANGE_MASK);
 		}
 	}
+
+	// The ARTNET_PC_CLR_x commands pass the cleared data on
+	m_pLightSet->SetSource(m_ArtNetPacket.IPAddressFrom, OP_ADDRESS);
+
 	switch (packet->Command) {
 	case ARTNET_PC_CANCEL:
 		// If Node is currently in merge mode, cancel merge mode upon receipt of next ArtDmx packet.
 		m_State.IsMergeMode = false;
-		for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
+		for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
 			m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus & ~GO_OUTPUT_IS_MERGING;
 		}
 #ifdef SENDDIAG
@@ -813,94 +893,94 @@ void ArtNetNode::HandleAddress(void) {
 		LedBlink::Get()->SetMode(LEDBLINK_MODE_FAST);
 		break;
 	case ARTNET_PC_MERGE_LTP_O:
-		m_OutputPorts[0].mergeMode = ARTNET_MERGE_LTP;
-		m_OutputPorts[0].port.nStatus = m_OutputPorts[0].port.nStatus | GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 0].mergeMode = ARTNET_MERGE_LTP;
+		m_OutputPorts[nPortBase + 0].port.nStatus = m_OutputPorts[nPortBase + 0].port.nStatus | GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode LTP_0", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_LTP_1:
-		m_OutputPorts[1].mergeMode = ARTNET_MERGE_LTP;
-		m_OutputPorts[1].port.nStatus = m_OutputPorts[1].port.nStatus | GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 1].mergeMode = ARTNET_MERGE_LTP;
+		m_OutputPorts[nPortBase + 1].port.nStatus = m_OutputPorts[nPortBase + 1].port.nStatus | GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode LTP_1", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_LTP_2:
-		m_OutputPorts[2].mergeMode = ARTNET_MERGE_LTP;
-		m_OutputPorts[2].port.nStatus = m_OutputPorts[2].port.nStatus | GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 2].mergeMode = ARTNET_MERGE_LTP;
+		m_OutputPorts[nPortBase + 2].port.nStatus = m_OutputPorts[nPortBase + 2].port.nStatus | GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode LTP_2", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_LTP_3:
-		m_OutputPorts[3].mergeMode = ARTNET_MERGE_LTP;
-		m_OutputPorts[3].port.nStatus = m_OutputPorts[3].port.nStatus | GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 3].mergeMode = ARTNET_MERGE_LTP;
+		m_OutputPorts[nPortBase + 3].port.nStatus = m_OutputPorts[nPortBase + 3].port.nStatus | GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode LTP_1", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_HTP_0:
-		m_OutputPorts[0].mergeMode = ARTNET_MERGE_HTP;
-		m_OutputPorts[0].port.nStatus = m_OutputPorts[0].port.nStatus & ~GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 0].mergeMode = ARTNET_MERGE_HTP;
+		m_OutputPorts[nPortBase + 0].port.nStatus = m_OutputPorts[nPortBase + 0].port.nStatus & ~GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode HTP_0", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_HTP_1:
-		m_OutputPorts[1].mergeMode = ARTNET_MERGE_HTP;
-		m_OutputPorts[1].port.nStatus = m_OutputPorts[1].port.nStatus & ~GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 1].mergeMode = ARTNET_MERGE_HTP;
+		m_OutputPorts[nPortBase + 1].port.nStatus = m_OutputPorts[nPortBase + 1].port.nStatus & ~GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode HTP_1", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_HTP_2:
-		m_OutputPorts[2].mergeMode = ARTNET_MERGE_HTP;
-		m_OutputPorts[2].port.nStatus = m_OutputPorts[2].port.nStatus & ~GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 2].mergeMode = ARTNET_MERGE_HTP;
+		m_OutputPorts[nPortBase + 2].port.nStatus = m_OutputPorts[nPortBase + 2].port.nStatus & ~GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode HTP_2", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_MERGE_HTP_3:
-		m_OutputPorts[3].mergeMode = ARTNET_MERGE_HTP;
-		m_OutputPorts[3].port.nStatus = m_OutputPorts[3].port.nStatus & ~GO_MERGE_MODE_LTP;
+		m_OutputPorts[nPortBase + 3].mergeMode = ARTNET_MERGE_HTP;
+		m_OutputPorts[nPortBase + 3].port.nStatus = m_OutputPorts[nPortBase + 3].port.nStatus & ~GO_MERGE_MODE_LTP;
 #ifdef SENDDIAG
 		SendDiag("Setting Merge Mode HTP_3", ARTNET_DP_LOW);
 #endif
 		break;
 	case ARTNET_PC_CLR_0:
 		for (unsigned i = 0; i < ARTNET_DMX_LENGTH; i++) {
-			m_OutputPorts[0].data[i] = 0;
+			m_OutputPorts[nPortBase + 0].data[i] = 0;
 		}
-		m_pLightSet->SetData (0, m_OutputPorts[0].data, m_OutputPorts[0].nLength);
+		m_pLightSet->SetData(nPortBase + 0, m_OutputPorts[nPortBase + 0].data, m_OutputPorts[nPortBase + 0].nLength);
 		bClearCommand = true;
 		break;
 	case ARTNET_PC_CLR_1:
 		for (unsigned i = 0; i < ARTNET_DMX_LENGTH; i++) {
-			m_OutputPorts[1].data[i] = 0;
+			m_OutputPorts[nPortBase + 1].data[i] = 0;
 		}
-		m_pLightSet->SetData (1, m_OutputPorts[1].data, m_OutputPorts[1].nLength);
+		m_pLightSet->SetData(nPortBase + 1, m_OutputPorts[nPortBase + 1].data, m_OutputPorts[nPortBase + 1].nLength);
 		bClearCommand = true;
 		break;
 	case ARTNET_PC_CLR_2:
 		for (unsigned i = 0; i < ARTNET_DMX_LENGTH; i++) {
-			m_OutputPorts[2].data[i] = 0;
+			m_OutputPorts[nPortBase + 2].data[i] = 0;
 		}
-		m_pLightSet->SetData (2, m_OutputPorts[2].data, m_OutputPorts[2].nLength);
+		m_pLightSet->SetData(nPortBase + 2, m_OutputPorts[nPortBase + 2].data, m_OutputPorts[nPortBase + 2].nLength);
 		bClearCommand = true;
 		break;
 	case ARTNET_PC_CLR_3:
 		for (unsigned i = 0; i < ARTNET_DMX_LENGTH; i++) {
-			m_OutputPorts[3].data[i] = 0;
+			m_OutputPorts[nPortBase + 3].data[i] = 0;
 		}
-		m_pLightSet->SetData (3, m_OutputPorts[3].data, m_OutputPorts[3].nLength);
+		m_pLightSet->SetData(nPortBase + 3, m_OutputPorts[nPortBase + 3].data, m_OutputPorts[nPortBase + 3].nLength);
 		bClearCommand = true;
 		break;
 	default:
 		break;
 	}
 
-	if (bClearCommand && !m_IsLightSetRunning) {
+	if (bClearCommand && !m_IsLightSetRunning && !m_IsRdmLineHeld) {
 		m_pLightSet->Start();
 		m_IsLightSetRunning = true;
 	}
@@ -949,16 +1029,77 @@ void ArtNetNode::HandleTodControl(void) {
 	const uint16_t portAddress = (uint16_t)(packet->Net << 8) | (uint16_t)(packet->Address);
 
 	if ((portAddress == m_OutputPorts[0].port.nPortAddress) && m_OutputPorts[0].bIsEnabled) {
-		m_pLightSet->Stop();
-		m_IsLightSetRunning = false;
+		switch (packet->Command) {
+		case 0x01:	// AtcFlush
+			StartRdmDiscovery(false);
+			break;
+		case 0x02:	// AtcEnd
+			if (m_IsRdmDiscoveryRunning) {
+				m_pArtNetRdm->DiscoveryStop();
+				RunRdmDiscovery();
+			} else {
+				SendTod();
+			}
+			break;
+		case 0x03:	// AtcIncOn
+			m_IsRdmIncremental = true;
+			StartRdmDiscovery(true);
+			break;
+		case 0x04:	// AtcIncOff
+			m_IsRdmIncremental = false;
+			SendTod();
+			break;
+		default:
+			SendTod();
+			break;
+		}
+	}
+}
 
-		if (packet->Command == (uint8_t) 0x01) {	// AtcFlush
-			m_pArtNetRdm->Full();
+/**
+ * The TOD is sent when the discovery has finished. A restart while running
+ * begins again from the top.
+ */
+void ArtNetNode::StartRdmDiscovery(bool bIncremental) {
+	// DiscoveryStart may do a blocking discovery
+	if (!m_IsRdmResponder && !m_IsRdmLineHeld) {
+		if (m_IsLightSetRunning) {
+			m_pLightSet->Stop();
+			m_IsLightSetRunning = false;
 		}
-		SendTod();
+		m_IsRdmLineHeld = true;
+	}
 
+	m_pArtNetRdm->DiscoveryStart(bIncremental);
+	m_IsRdmDiscoveryRunning = true;
+	m_nRdmDiscoveryTime = m_nCurrentPacketTime;
+
+	RunRdmDiscovery();
+}
+
+/**
+ * One step of the discovery. The LightSet is stopped only while the
+ * discovery holds the line.
+ */
+void ArtNetNode::RunRdmDiscovery(void) {
+	if (!m_IsRdmResponder && !m_IsRdmLineHeld && !m_pArtNetRdm->DiscoveryIsLineFree()) {
+		if (m_IsLightSetRunning) {
+			m_pLightSet->Stop();
+			m_IsLightSetRunning = false;
+		}
+		m_IsRdmLineHeld = true;
+	}
+
+	m_IsRdmDiscoveryRunning = m_pArtNetRdm->DiscoveryRun();
+
+	if (m_IsRdmLineHeld && (!m_IsRdmDiscoveryRunning || m_pArtNetRdm->DiscoveryIsLineFree())) {
 		m_pLightSet->Start();
-		m_IsLightSetRunning = true;;
+		m_IsLightSetRunning = true;
+		m_IsRdmLineHeld = false;
+	}
+
+	if (!m_IsRdmDiscoveryRunning) {
+		SendTod();
 	}
 }
 
@@ -972,21 +1113,35 @@ void ArtNetNode::HandleTodRequest(void) {
 }
 
 void ArtNetNode::SendTod(void) {
-	m_pTodData->Net = m_Node.NetSwitch;
+	m_pTodData->Net = m_Node.NetSwitch[0];
 	m_pTodData->Address = m_OutputPorts[0].port.nDefaultAddress;
 
-	const uint8_t discovered = m_pArtNetRdm->GetUidCount();
+	const uint16_t discovered = m_pArtNetRdm->GetUidCount();
+
+	m_pTodData->UidTotalHi = (uint8_t) (discovered >> 8);
+	m_pTodData->UidTotalLo = (uint8_t) discovered;
+
+	// An empty TOD is still sent, as a single packet
+	uint16_t nOffset = 0;
+	uint8_t nBlockCount = 0;
+
+	do {
+		const uint16_t nCount = m_pArtNetRdm->Copy((uint8_t *) m_pTodData->Tod, nOffset, ARTNET_TOD_UIDS_PER_PACKET);
 
-	m_pTodData->UidTotalHi = 0;
-	m_pTodData->UidTotalLo = discovered;
-	m_pTodData->BlockCount = 0;
-	m_pTodData->UidCount = discovered;
+		m_pTodData->BlockCount = nBlockCount;
+		m_pTodData->UidCount = (uint8_t) nCount;
 
-	m_pArtNetRdm->Copy((uint8_t *) m_pTodData->Tod);
+		const uint16_t length = (uint16_t) sizeof(struct TArtTodData) - (uint16_t) (sizeof m_pTodData->Tod) + (uint16_t) (nCount * 6);
 
-	const uint16_t length = (uint16_t) sizeof(struct TArtTodData) - (uint16_t) (sizeof m_pTodData->Tod) + (uint16_t) (discovered * 6);
+		Network::Get()->SendTo((const uint8_t *) m_pTodData, (const uint16_t) length, m_Node.IPAddressBroadcast, (uint16_t) ARTNET_UDP_PORT);
 
-	Network::Get()->SendTo((const uint8_t *) m_pTodData, (const uint16_t) length, m_Node.IPAddressBroadcast, (uint16_t) ARTNET_UDP_PORT);
+		if (nCount == 0) {
+			break;
+		}
+
+		nOffset += nCount;
+		nBlockCount++;
+	} while ((nOffset < discovered) && (nBlockCount != 0));
 }
 
 void ArtNetNode::HandleRdm(void) {
@@ -995,6 +1150,11 @@ void ArtNetNode::HandleRdm(void) {
 
 	if ((portAddress == m_OutputPorts[0].port.nPortAddress) && m_OutputPorts[0].bIsEnabled) {
 
+		if (m_IsRdmLineHeld) {
+			// The discovery has the line, the controller will retry
+			return;
+		}
+
 		if (!m_IsRdmResponder) {
 			m_pLightSet->Stop();
 			m_IsLightSetRunning = false;
@@ -1088,7 +1248,7 @@ void ArtNetNode::SetNetworkDataLossCondition(void) {
 
 		m_State.IsSynchronousMode = false;
 
-		for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
+		for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
 			m_OutputPorts[i].port.nStatus = m_OutputPorts[i].port.nStatus & (~GO_DATA_IS_BEING_TRANSMITTED);
 			m_OutputPorts[i].nLength = (uint16_t) 0;
 			m_OutputPorts[i].ipA = (uint32_t) 0;
@@ -1097,31 +1257,93 @@ void ArtNetNode::SetNetworkDataLossCondition(void) {
 	}
 }
 
+/**
+ * The only timer the node needs is the network data loss timeout, which is
+ * armed while the LightSet is running. Merge and synchronization timeouts are
+ * evaluated on packet arrival only. A running RDM discovery is ticked from
+ * HandlePacket, so then there is no waiting.
+ */
+uint32_t ArtNetNode::GetMillisToNextTimer(void) {
+	if (m_IsRdmDiscoveryRunning) {
+		return 0;
+	}
+
+	if (!m_IsLightSetRunning) {
+		return NETWORK_WAIT_FOREVER;
+	}
+
+	const time_t nNow = Hardware::Get()->GetTime();
+	const time_t nDataLossTime = m_nPreviousPacketTime + m_State.nNetworkDataLossTimeout;
+
+	if (nNow >= nDataLossTime) {
+		return 0;
+	}
+
+	return (uint32_t) (nDataLossTime - nNow) * 1000;
+}
+
 int ArtNetNode::HandlePacket(void) {
+#if defined (NETWORK_HAVE_RECV_BURST)
+	struct TNetworkDatagram aDatagrams[NETWORK_RECV_BURST_MAX];
+
+	const uint16_t nDatagrams = Network::Get()->RecvBurst(aDatagrams, NETWORK_RECV_BURST_MAX);
+#else
 	const char *packet = (char *)&(m_ArtNetPacket.ArtPacket);
 	uint16_t nForeignPort;
 
 	const int nBytesReceived = Network::Get()->RecvFrom((const uint8_t *)packet, (const uint16_t)sizeof(m_ArtNetPacket.ArtPacket), &m_ArtNetPacket.IPAddressFrom, &nForeignPort) ;
+	const uint16_t nDatagrams = (nBytesReceived == 0) ? 0 : 1;
+#endif
 
 	m_nCurrentPacketTime = Hardware::Get()->GetTime();
 
-	if (nBytesReceived == 0) {
+	if (m_pArtNetRdm != 0) {
+		if (m_IsRdmDiscoveryRunning) {
+			RunRdmDiscovery();
+		} else if (m_IsRdmIncremental && ((m_nCurrentPacketTime - m_nRdmDiscoveryTime) >= ARTNET_RDM_INCREMENTAL_INTERVAL)) {
+			StartRdmDiscovery(true);
+		}
+	}
+
+	if (nDatagrams == 0) {
 		if ((m_nCurrentPacketTime - m_nPreviousPacketTime) >= m_State.nNetworkDataLossTimeout) {
 			SetNetworkDataLossCondition();
 		}
 		return 0;
 	}
 
-	m_ArtNetPacket.length = nBytesReceived;
 	m_nPreviousPacketTime = m_nCurrentPacketTime;
 
+#if defined (NETWORK_HAVE_RECV_BURST)
+	int nBytesHandled = 0;
+
+	// Drain the whole burst, the timers above are evaluated once per burst
+	for (unsigned i = 0; i < nDatagrams; i++) {
+		const uint16_t nLength = min(aDatagrams[i].nLength, (uint16_t) sizeof(m_ArtNetPacket.ArtPacket));
+
+		memcpy(&m_ArtNetPacket.ArtPacket, aDatagrams[i].pData, nLength);
+		m_ArtNetPacket.IPAddressFrom = aDatagrams[i].nFromIp;
+		m_ArtNetPacket.length = nLength;
+
+		nBytesHandled += HandleArtPacket();
+	}
+
+	return nBytesHandled;
+#else
+	m_ArtNetPacket.length = nBytesReceived;
+
+	return HandleArtPacket();
+#endif
+}
+
+int ArtNetNode::HandleArtPacket(void) {
 	GetType();
 
 	if (m_State.IsSynchronousMode) {
 		if ((m_ArtNetPacket.OpCode == OP_DMX) && (m_tOpCodePrevious == OP_DMX)) {
 			// WiFi UDP : We have missed the OP_SYNC
 			m_State.IsSynchronousMode = false;
-			for (unsigned i = 0; i < ARTNET_MAX_PORTS; i++) {
+			for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
 				m_OutputPorts[i].IsDataPending = false;
 			}
 		} else {
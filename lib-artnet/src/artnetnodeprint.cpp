@@ -39,8 +39,16 @@ void ArtNetNode::Print(void) {
 	printf(" Firmware     : %d.%d\n", firmware_version[0], firmware_version[1]);
 	printf(" Short name   : %s\n", m_Node.ShortName);
 	printf(" Long name    : %s\n", m_Node.LongName);
-	printf(" Net          : %d\n", m_Node.NetSwitch);
-	printf(" Sub-Net      : %d\n", m_Node.SubSwitch);
+	printf(" Net          : %d\n", m_Node.NetSwitch[0]);
+	printf(" Sub-Net      : %d\n", m_Node.SubSwitch[0]);
 	printf(" Universe     : %d\n", GetUniverseSwitch(0));
 	printf(" Active ports : %d\n", m_State.nActivePorts);
+
+	if (m_State.nActivePorts > 1) {
+		for (unsigned i = 0; i < ARTNET_NODE_MAX_PORTS; i++) {
+			if (m_OutputPorts[i].bIsEnabled) {
+				printf("  Port %2d    : %d:%d:%d\n", i, m_Node.NetSwitch[i / ARTNET_MAX_PORTS], m_Node.SubSwitch[i / ARTNET_MAX_PORTS], m_OutputPorts[i].port.nDefaultAddress);
+			}
+		}
+	}
 }
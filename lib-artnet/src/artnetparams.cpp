@@ -66,11 +66,13 @@
 #define SET_ID_MASK			1<<9
 #define SET_OEM_VALUE_MASK	1<<10
 #define SET_NETWORK_TIMEOUT	1<<11
+#define SET_UNIVERSES_MASK	1<<12
 
 static const char PARAMS_FILE_NAME[] ALIGNED = "artnet.txt";
 static const char PARAMS_NET[] ALIGNED = "net";											///< 0 {default}
 static const char PARAMS_SUBNET[] ALIGNED = "subnet";									///< 0 {default}
 static const char PARAMS_UNIVERSE[] ALIGNED = "universe";								///< 0 {default}
+static const char PARAMS_UNIVERSES[] ALIGNED = "universes";								///< 1 {default}, consecutive universes, one per output port. With output=spi, the universes of the pixels
 static const char PARAMS_OUTPUT[] ALIGNED = "output";									///< dmx {default}, spi, mon
 static const char PARAMS_TIMECODE[] ALIGNED = "use_timecode";							///< Use the TimeCode call-back handler, 0 {default}
 static const char PARAMS_TIMESYNC[] ALIGNED = "use_timesync";							///< Use the TimeSync call-back handler, 0 {default}
@@ -183,6 +185,16 @@ void ArtNetParams::callbackFunction(const char *pLine) {
 		return;
 	}
 
+	if (Sscan::Uint8(pLine, PARAMS_UNIVERSES, &value8) == SSCAN_OK) {
+		if (value8 == 0 || value8 > ARTNET_NODE_MAX_PORTS) {
+			m_nUniverses = 1;
+		} else {
+			m_nUniverses = value8;
+		}
+		m_bSetList |= SET_UNIVERSES_MASK;
+		return;
+	}
+
 	if (Sscan::Uint8(pLine, PARAMS_NET, &value8) == SSCAN_OK) {
 		m_nNet = value8;
 		m_bSetList |= SET_NET_MASK;
@@ -200,6 +212,7 @@ ArtNetParams::ArtNetParams(void): m_bSetList(0) {
 	m_nNet = 0;
 	m_nSubnet = 0;
 	m_nUniverse = 0;
+	m_nUniverses = 1;
 	m_tOutputType= OUTPUT_TYPE_DMX;
 	m_bUseTimeCode = false;
 	m_bUseTimeSync = false;
@@ -230,6 +243,71 @@ uint8_t ArtNetParams::GetUniverse(void) const {
 	return m_nUniverse;
 }
 
+uint8_t ArtNetParams::GetUniverses(void) const {
+	return m_nUniverses;
+}
+
+/**
+ * The output ports receive consecutive Port-Addresses, starting at \ref PARAMS_NET:\ref PARAMS_SUBNET:\ref PARAMS_UNIVERSE.
+ * Each page of ARTNET_MAX_PORTS ports is a virtual node with one Net and one Sub-Net, see CheckPortAddresses.
+ */
+uint16_t ArtNetParams::GetPortAddress(uint8_t nPortIndex) const {
+	const uint16_t nPortAddress = ((uint16_t) (m_nNet & 0x7F) << 8) | ((uint16_t) (m_nSubnet & 0x0F) << 4) | (uint16_t) (m_nUniverse & 0x0F);
+
+	return (nPortAddress + nPortIndex) & 0x7FFF;
+}
+
+uint8_t ArtNetParams::GetNet(uint8_t nPage) const {
+	return (uint8_t) (GetPortAddress(nPage * ARTNET_MAX_PORTS) >> 8) & 0x7F;
+}
+
+uint8_t ArtNetParams::GetSubnet(uint8_t nPage) const {
+	return (uint8_t) (GetPortAddress(nPage * ARTNET_MAX_PORTS) >> 4) & 0x0F;
+}
+
+uint8_t ArtNetParams::GetUniverse(uint8_t nPortIndex) const {
+	return (uint8_t) GetPortAddress(nPortIndex) & 0x0F;
+}
+
+/**
+ * The ports of a page share the Sub-Net of its first port. Only when a page would span two Sub-Nets,
+ * \ref PARAMS_UNIVERSE is aligned down to a multiple of ARTNET_MAX_PORTS, otherwise it is kept.
+ * The Port-Address cannot go beyond 0x7FFF.
+ */
+void ArtNetParams::CheckPortAddresses(void) {
+	for (unsigned nPort = 0; nPort < m_nUniverses; nPort += ARTNET_MAX_PORTS) {
+		const unsigned nLast = (nPort + ARTNET_MAX_PORTS < m_nUniverses ? nPort + ARTNET_MAX_PORTS : m_nUniverses) - 1;
+
+		if ((GetPortAddress(nPort) >> 4) != (GetPortAddress(nLast) >> 4)) {
+			const uint8_t nUniverse = m_nUniverse - (m_nUniverse % ARTNET_MAX_PORTS);
+			printf("Universes %d-%d cross a Sub-Net, universe %d is aligned to %d\n", (int) GetPortAddress(0), (int) (GetPortAddress(0) + m_nUniverses - 1), (int) m_nUniverse, (int) nUniverse);
+			m_nUniverse = nUniverse;
+			break;
+		}
+	}
+
+	const uint16_t nFirst = GetPortAddress(0);
+
+	if (nFirst + m_nUniverses - 1 > 0x7FFF) {
+		m_nUniverses = (uint8_t) (0x8000 - nFirst);
+		printf("Universes is limited to %d\n", (int) m_nUniverses);
+	}
+}
+
+/**
+ * For an output which needs more universes than \ref PARAMS_UNIVERSES, such as a pixel stripe.
+ * Call before Set.
+ */
+void ArtNetParams::SetUniverses(uint8_t nUniverses) {
+	if (nUniverses == 0 || nUniverses > ARTNET_NODE_MAX_PORTS) {
+		nUniverses = ARTNET_NODE_MAX_PORTS;
+	}
+
+	m_nUniverses = nUniverses;
+
+	CheckPortAddresses();
+}
+
 bool ArtNetParams::IsUseTimeCode(void) const {
 	return m_bUseTimeCode;
 }
@@ -266,12 +344,21 @@ bool ArtNetParams::Load(void) {
 	m_bSetList = 0;
 
 	ReadConfigFile configfile(ArtNetParams::staticCallbackFunction, this);
-	return configfile.Read(PARAMS_FILE_NAME);
+	const bool bIsRead = configfile.Read(PARAMS_FILE_NAME);
+
+	CheckPortAddresses();
+
+	return bIsRead;
 }
 
 void ArtNetParams::Set(ArtNetNode *pArtNetNode) {
 	assert(pArtNetNode != 0);
 
+	for (unsigned nPage = 0; nPage < ARTNET_NODE_MAX_PAGES; nPage++) {
+		pArtNetNode->SetNetSwitch(GetNet(nPage), nPage);
+		pArtNetNode->SetSubnetSwitch(GetSubnet(nPage), nPage);
+	}
+
 	if (m_bSetList == 0) {
 		return;
 	}
@@ -284,14 +371,6 @@ void ArtNetParams::Set(ArtNetNode *pArtNetNode) {
 		pArtNetNode->SetLongName((const char *)m_aLongName);
 	}
 
-	if(isMaskSet(SET_NET_MASK)) {
-		pArtNetNode->SetNetSwitch(m_nNet);
-	}
-
-	if(isMaskSet(SET_SUBNET_MASK)) {
-		pArtNetNode->SetSubnetSwitch(m_nSubnet);
-	}
-
 	if(isMaskSet(SET_ID_MASK)) {
 		pArtNetNode->SetManufacturerId(m_aManufacturerId);
 	}
@@ -334,6 +413,10 @@ void ArtNetParams::Dump(void) {
 		printf(" Universe : %d\n", m_nUniverse);
 	}
 
+	if(isMaskSet(SET_UNIVERSES_MASK)) {
+		printf(" Universes : %d\n", m_nUniverses);
+	}
+
 	if (isMaskSet(SET_RDM_MASK)) {
 		printf(" RDM Enabled : %s\n", BOOL2STRING(m_bEnableRdm));
 		if (m_bEnableRdm) {
@@ -34,3 +34,20 @@
 ArtNetRdm::~ArtNetRdm(void) {
 
 }
+
+void ArtNetRdm::DiscoveryStart(bool bIncremental) {
+	if (!bIncremental) {
+		Full();
+	}
+}
+
+void ArtNetRdm::DiscoveryStop(void) {
+}
+
+bool ArtNetRdm::DiscoveryRun(void) {
+	return false;
+}
+
+bool ArtNetRdm::DiscoveryIsLineFree(void) {
+	return true;
+}
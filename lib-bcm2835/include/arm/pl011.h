@@ -82,10 +82,14 @@
 #define PL011_MIS_RXMIS			((uint32_t)(1 << 4))	///<
 #define PL011_MIS_TXMIS   		((uint32_t)(1 << 5))	///< Transmit interrupt status
 #define PL011_MIS_FEMIS			((uint32_t)(1 << 7))	///<
+#define PL011_MIS_BEMIS			((uint32_t)(1 << 9))	///<
 
 #define PL011_ICRC_RXIC			((uint32_t)(1 << 4))	///<
 #define PL011_ICR_TXIC			((uint32_t)(1 << 5))	///< Transmit interrupt clear
 #define PL011_ICR_FEIC 			((uint32_t)(1 << 7))	///<
+#define PL011_ICR_BEIC 			((uint32_t)(1 << 9))	///<
+
+#define PL011_DMACR_RXDMAE		((uint32_t)(1 << 0))	///< Receive DMA enable
 
 #define PL011_BAUD_INT(x) 		(3000000 / (16 * (x)))
 #define PL011_BAUD_FRAC(x) 		(int)((((3000000.0 / (16.0 * (x))) - PL011_BAUD_INT(x)) * 64.0) + 0.5)
@@ -89,6 +89,7 @@
 #define	BCM2835_DMA4_BASE		(BCM2835_PERI_BASE + 0x007400)	///<
 #define	BCM2835_DMA5_BASE		(BCM2835_PERI_BASE + 0x007500)	///<
 #define	BCM2835_DMA6_BASE		(BCM2835_PERI_BASE + 0x007600)	///<
+#define	BCM2835_DMA_ENABLE_BASE	(BCM2835_PERI_BASE + 0x007FF0)	///< Global enable bits for each DMA channel
 #define BCM2835_IRQ_BASE		(BCM2835_PERI_BASE + 0x00B200)	///<
 #define BCM2835_MAILBOX_BASE	(BCM2835_PERI_BASE + 0x00B880)	///<
 #define BCM2835_PM_WDOG_BASE	(BCM2835_PERI_BASE + 0x100000)	///<
@@ -122,6 +123,7 @@
 #define INTERRUPT_GPIO1		(ARM_IRQ2_BASE + 18)
 #define INTERRUPT_GPIO2		(ARM_IRQ2_BASE + 19)
 #define INTERRUPT_GPIO3		(ARM_IRQ2_BASE + 20)
+#define INTERRUPT_I2C		(ARM_IRQ2_BASE + 21)	///< BSC0 / BSC1 Interrupt
 #define INTERRUPT_VC_UART	(ARM_IRQ2_BASE + 25)	///< UART Interrupt
 
 typedef enum {
@@ -131,6 +133,7 @@ typedef enum {
 	BCM2835_UART1_IRQn  = 1 << (INTERRUPT_AUX - ARM_IRQ1_BASE),			///<
 	// ARM_IRQ2_BASE
 	BCM2835_GPIO0_IRQn    = 1 << (INTERRUPT_GPIO0 - ARM_IRQ2_BASE),		///<
+	BCM2835_I2C_IRQn      = 1 << (INTERRUPT_I2C - ARM_IRQ2_BASE),		///<
 	BCM2835_VC_UART_IRQn  = 1 << (INTERRUPT_VC_UART - ARM_IRQ2_BASE)	///<
 } BCM2835_IRQn_TypeDef;
 
@@ -374,13 +377,14 @@ typedef struct {
 } BCM2835_EMMC_TypeDef;
 
 #define BCM2835_ST		((BCM2835_ST_TypeDef *)   BCM2835_ST_BASE)			///< Base register address for SYSTEM TIMER
-#define BCM2835_DMA0	((BCM2835_DMA_TypeDef) *) BCM2835_DMA0_BASE)		///< Base register address for DMA Channel 0
-#define BCM2835_DMA1	((BCM2835_DMA_TypeDef) *) BCM2835_DMA1_BASE)		///< Base register address for DMA Channel 1
-#define BCM2835_DMA2	((BCM2835_DMA_TypeDef) *) BCM2835_DMA2_BASE)		///< Base register address for DMA Channel 2
-#define BCM2835_DMA3	((BCM2835_DMA_TypeDef) *) BCM2835_DMA3_BASE)		///< Base register address for DMA Channel 3
-#define BCM2835_DMA4	((BCM2835_DMA_TypeDef) *) BCM2835_DMA4_BASE)		///< Base register address for DMA Channel 4
-#define BCM2835_DMA5	((BCM2835_DMA_TypeDef) *) BCM2835_DMA5_BASE)		///< Base register address for DMA Channel 5
-#define BCM2835_DMA6	((BCM2835_DMA_TypeDef) *) BCM2835_DMA6_BASE)		///< Base register address for DMA Channel 6
+#define BCM2835_DMA0	((BCM2835_DMA_TypeDef *)  BCM2835_DMA0_BASE)		///< Base register address for DMA Channel 0
+#define BCM2835_DMA1	((BCM2835_DMA_TypeDef *)  BCM2835_DMA1_BASE)		///< Base register address for DMA Channel 1
+#define BCM2835_DMA2	((BCM2835_DMA_TypeDef *)  BCM2835_DMA2_BASE)		///< Base register address for DMA Channel 2
+#define BCM2835_DMA3	((BCM2835_DMA_TypeDef *)  BCM2835_DMA3_BASE)		///< Base register address for DMA Channel 3
+#define BCM2835_DMA4	((BCM2835_DMA_TypeDef *)  BCM2835_DMA4_BASE)		///< Base register address for DMA Channel 4
+#define BCM2835_DMA5	((BCM2835_DMA_TypeDef *)  BCM2835_DMA5_BASE)		///< Base register address for DMA Channel 5
+#define BCM2835_DMA6	((BCM2835_DMA_TypeDef *)  BCM2835_DMA6_BASE)		///< Base register address for DMA Channel 6
+#define BCM2835_DMA_ENABLE	(*(volatile uint32_t *) BCM2835_DMA_ENABLE_BASE)	///< DMA Channel Enable register
 #define BCM2835_IRQ		((BCM2835_IRQ_TypeDef *)  BCM2835_IRQ_BASE)			///< Base register address for IRQ
 #define BCM2835_MAILBOX	((BCM2835_MAILBOX_TypeDef *) BCM2835_MAILBOX_BASE)	///< Base register address for MAILBOX
 #define BCM2835_PM_WDOG	((BCM2835_PM_WDOG_TypeDef *) BCM2835_PM_WDOG_BASE)	///< Base register address for WATCHDOG
@@ -0,0 +1,71 @@
+/**
+ * @file bcm2835_spi_dma.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BCM2835_SPI_DMA_H_
+#define BCM2835_SPI_DMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BCM2835_DMA_CS_RESET		((uint32_t)(1U << 31))	///< Writing a 1 to this bit will reset the DMA
+#define BCM2835_DMA_CS_WAIT_WRITES	((uint32_t)(1 << 28))	///< Wait for outstanding writes
+#define BCM2835_DMA_CS_ERROR		((uint32_t)(1 << 8))	///< DMA Error
+#define BCM2835_DMA_CS_INT			((uint32_t)(1 << 2))	///< Interrupt Status
+#define BCM2835_DMA_CS_END			((uint32_t)(1 << 1))	///< DMA End Flag
+#define BCM2835_DMA_CS_ACTIVE		((uint32_t)(1 << 0))	///< Activate the DMA
+
+#define BCM2835_DMA_TI_SRC_IGNORE	((uint32_t)(1 << 11))	///< Ignore Reads
+#define BCM2835_DMA_TI_SRC_DREQ		((uint32_t)(1 << 10))	///< Control Source Reads with DREQ
+#define BCM2835_DMA_TI_SRC_INC		((uint32_t)(1 << 8))	///< Source Address Increment
+#define BCM2835_DMA_TI_DEST_IGNORE	((uint32_t)(1 << 7))	///< Ignore Writes
+#define BCM2835_DMA_TI_DEST_DREQ	((uint32_t)(1 << 6))	///< Control Destination Writes with DREQ
+#define BCM2835_DMA_TI_DEST_INC		((uint32_t)(1 << 4))	///< Destination Address Increment
+#define BCM2835_DMA_TI_WAIT_RESP	((uint32_t)(1 << 3))	///< Wait for a Write Response
+#define BCM2835_DMA_TI_PERMAP(x)	((uint32_t)((x) << 16))	///< Peripheral Mapping
+
+#define BCM2835_DMA_DREQ_SPI_TX		6	///< SPI TX DREQ
+#define BCM2835_DMA_DREQ_SPI_RX		7	///< SPI RX DREQ
+#define BCM2835_DMA_DREQ_UART_RX	14	///< PL011 RX DREQ
+
+#define BCM2835_SPI_DMA_CHANNEL_TX	4	///< Not used by the firmware
+#define BCM2835_SPI_DMA_CHANNEL_RX	5	///< Not used by the firmware
+
+#define BCM2835_SPI_DMA_MAX_LENGTH	0xFFFF	///< The DMA mode length is 16 bits (SPI DLEN)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void bcm2835_spi_dma_begin(void);
+extern void bcm2835_spi_dma_end(void);
+
+extern void bcm2835_spi_dma_tx_start(const uint8_t *, uint32_t);
+extern bool bcm2835_spi_dma_tx_is_active(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BCM2835_SPI_DMA_H_ */
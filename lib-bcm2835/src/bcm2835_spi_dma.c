@@ -0,0 +1,179 @@
+/**
+ * @file bcm2835_spi_dma.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "arm/synchronize.h"
+
+#include "bcm2835.h"
+#include "bcm2835_spi.h"
+#include "bcm2835_spi_dma.h"
+
+#define DMA_CHANNEL(n)	((BCM2835_DMA_TypeDef *) (BCM2835_DMA0_BASE + ((n) * 0x100)))
+
+#define DMA_TX			DMA_CHANNEL(BCM2835_SPI_DMA_CHANNEL_TX)
+#define DMA_RX			DMA_CHANNEL(BCM2835_SPI_DMA_CHANNEL_RX)
+
+#define BUS_ADDRESS_MEM(p)	((uint32_t) (p) | GPU_MEM_BASE)
+#define BUS_ADDRESS_SPI0_FIFO	(GPU_IO_BASE + (BCM2835_SPI0_BASE - BCM2835_PERI_BASE) + BCM2835_SPI0_FIFO)
+
+struct TDmaControlBlock {
+	uint32_t nTransferInformation;
+	uint32_t nSourceAddress;
+	uint32_t nDestinationAddress;
+	uint32_t nTransferLength;
+	uint32_t n2DModeStride;
+	uint32_t nNextControlBlockAddress;
+	uint32_t nReserved[2];
+};
+
+/*
+ * TX is a chain of two control blocks. The first one writes the DMA mode
+ * header (DLEN and the low CS bits) into the FIFO, the second one the data.
+ * RX must be drained, otherwise the SPI stalls when the RX FIFO is full.
+ * The TX data is rounded up to whole words, DLEN stops the SPI after len bytes.
+ * RX gets exactly len bytes, as no more are clocked in.
+ */
+static struct TDmaControlBlock s_ControlBlock[3] __attribute__((aligned(32)));
+static uint32_t s_nTxHeader __attribute__((aligned(4)));
+
+static void dma_channel_reset(BCM2835_DMA_TypeDef *pDma) {
+	pDma->CS = BCM2835_DMA_CS_RESET;
+
+	while (pDma->CS & BCM2835_DMA_CS_RESET)
+		;
+}
+
+/**
+ * @ingroup SPI
+ *
+ * Configures the DMA channels for SPI0 transmit.
+ * \ref bcm2835_spi_begin must be called first.
+ */
+void bcm2835_spi_dma_begin(void) {
+	dmb();
+
+	BCM2835_DMA_ENABLE |= (1 << BCM2835_SPI_DMA_CHANNEL_TX) | (1 << BCM2835_SPI_DMA_CHANNEL_RX);
+
+	dma_channel_reset(DMA_TX);
+	dma_channel_reset(DMA_RX);
+
+	dmb();
+}
+
+void bcm2835_spi_dma_end(void) {
+	dmb();
+
+	while (bcm2835_spi_dma_tx_is_active())
+		;
+
+	dma_channel_reset(DMA_TX);
+	dma_channel_reset(DMA_RX);
+
+	BCM2835_PERI_SET_BITS(BCM2835_SPI0->CS, 0, BCM2835_SPI0_CS_DMAEN | BCM2835_SPI0_CS_ADCS);
+
+	dmb();
+}
+
+/**
+ * @ingroup SPI
+ *
+ * Starts the transfer of \p len bytes from \p tbuf and returns immediately.
+ * The buffer must stay untouched until \ref bcm2835_spi_dma_tx_is_active returns false.
+ * The DMA transfers 32-bit words, so tbuf must be 4-byte aligned and readable up to the next multiple of 4.
+ *
+ * @param tbuf Buffer of bytes to send.
+ * @param len Number of bytes to send, at most \ref BCM2835_SPI_DMA_MAX_LENGTH.
+ */
+void bcm2835_spi_dma_tx_start(const uint8_t *tbuf, uint32_t len) {
+	const uint32_t nWords = (len + 3) & ~3;
+	uint32_t cs;
+
+	assert(((uint32_t) tbuf & 3) == 0);
+	assert(len != 0);
+	assert(len <= BCM2835_SPI_DMA_MAX_LENGTH);
+	assert(!bcm2835_spi_dma_tx_is_active());
+
+	dmb();
+
+	cs = BCM2835_SPI0->CS & (BCM2835_SPI0_CS_CS | BCM2835_SPI0_CS_CPOL | BCM2835_SPI0_CS_CPHA | BCM2835_SPI0_CS_CSPOL0 | BCM2835_SPI0_CS_CSPOL1 | BCM2835_SPI0_CS_CSPOL);
+
+	s_nTxHeader = (len << 16) | (cs & 0xFF) | BCM2835_SPI0_CS_TA;
+
+	s_ControlBlock[0].nTransferInformation = BCM2835_DMA_TI_PERMAP(BCM2835_DMA_DREQ_SPI_TX) | BCM2835_DMA_TI_DEST_DREQ | BCM2835_DMA_TI_SRC_INC | BCM2835_DMA_TI_WAIT_RESP;
+	s_ControlBlock[0].nSourceAddress = BUS_ADDRESS_MEM(&s_nTxHeader);
+	s_ControlBlock[0].nDestinationAddress = BUS_ADDRESS_SPI0_FIFO;
+	s_ControlBlock[0].nTransferLength = 4;
+	s_ControlBlock[0].n2DModeStride = 0;
+	s_ControlBlock[0].nNextControlBlockAddress = BUS_ADDRESS_MEM(&s_ControlBlock[1]);
+
+	s_ControlBlock[1].nTransferInformation = s_ControlBlock[0].nTransferInformation;
+	s_ControlBlock[1].nSourceAddress = BUS_ADDRESS_MEM(tbuf);
+	s_ControlBlock[1].nDestinationAddress = BUS_ADDRESS_SPI0_FIFO;
+	s_ControlBlock[1].nTransferLength = nWords;
+	s_ControlBlock[1].n2DModeStride = 0;
+	s_ControlBlock[1].nNextControlBlockAddress = 0;
+
+	s_ControlBlock[2].nTransferInformation = BCM2835_DMA_TI_PERMAP(BCM2835_DMA_DREQ_SPI_RX) | BCM2835_DMA_TI_SRC_DREQ | BCM2835_DMA_TI_DEST_IGNORE | BCM2835_DMA_TI_WAIT_RESP;
+	s_ControlBlock[2].nSourceAddress = BUS_ADDRESS_SPI0_FIFO;
+	s_ControlBlock[2].nDestinationAddress = 0;
+	s_ControlBlock[2].nTransferLength = len;
+	s_ControlBlock[2].n2DModeStride = 0;
+	s_ControlBlock[2].nNextControlBlockAddress = 0;
+
+	// The DMA engine reads from SDRAM, bypassing the ARM data cache
+	clean_data_cache();
+	dsb();
+
+	BCM2835_SPI0->CS = cs | BCM2835_SPI0_CS_CLEAR | BCM2835_SPI0_CS_DMAEN | BCM2835_SPI0_CS_ADCS;
+
+	DMA_RX->CS = BCM2835_DMA_CS_END | BCM2835_DMA_CS_INT;
+	DMA_RX->CONBLK_AD = BUS_ADDRESS_MEM(&s_ControlBlock[2]);
+	DMA_RX->CS = BCM2835_DMA_CS_ACTIVE | BCM2835_DMA_CS_WAIT_WRITES;
+
+	DMA_TX->CS = BCM2835_DMA_CS_END | BCM2835_DMA_CS_INT;
+	DMA_TX->CONBLK_AD = BUS_ADDRESS_MEM(&s_ControlBlock[0]);
+	DMA_TX->CS = BCM2835_DMA_CS_ACTIVE | BCM2835_DMA_CS_WAIT_WRITES;
+
+	dmb();
+}
+
+/**
+ * @ingroup SPI
+ *
+ * @return true while the last byte has not been clocked out yet.
+ * The RX channel finishes last, as it waits for the final byte on the wire.
+ */
+bool bcm2835_spi_dma_tx_is_active(void) {
+	bool isActive;
+
+	dmb();
+	isActive = ((DMA_RX->CS & BCM2835_DMA_CS_ACTIVE) == BCM2835_DMA_CS_ACTIVE) || ((DMA_TX->CS & BCM2835_DMA_CS_ACTIVE) == BCM2835_DMA_CS_ACTIVE);
+	dmb();
+
+	return isActive;
+}
@@ -32,6 +32,10 @@
 
 #include "device_info.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern void sc16is740_start(device_info_t *);
 extern bool sc16is740_is_connected(const device_info_t *);
 
@@ -48,5 +52,10 @@ extern int sc16is740_getc(const device_info_t *);
 extern bool sc16is740_is_writable(const device_info_t *);
 extern int sc16is740_write(const device_info_t *, const void *, unsigned);
 extern int sc16is740_putc(const device_info_t *, const int);
+extern void sc16is740_write_fifo(const device_info_t *, const void *, unsigned);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* SC16IS740_H_ */
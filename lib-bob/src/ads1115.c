@@ -26,10 +26,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#include "bcm2835.h"
-#if defined(__linux__) || defined(__circle__)
-#else
- #include "bcm2835_i2c.h"
+#if defined(BARE_METAL)
+ #include "bcm2835.h"
 #endif
 
 #include "i2c.h"
@@ -44,12 +42,12 @@
  * @param device_info
  */
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
+	i2c_set_address(device_info->slave_address);
 
 	if (device_info->fast_mode) {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 	} else {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	}
 }
 
@@ -115,7 +113,7 @@ static void set_channel(const uint8_t channel) {
 const bool ads1115_start(device_info_t *device_info) {
 	uint16_t config;
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = ADS1115_DEFAULT_SLAVE_ADDRESS;
@@ -25,12 +25,6 @@
 
 #include <stdint.h>
 
-#if defined(__linux__) || defined(__circle__)
- #include "bcm2835.h"
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "ads1x15.h"
@@ -42,12 +36,12 @@
  * @param device_info
  */
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
+	i2c_set_address(device_info->slave_address);
 
 	if (device_info->fast_mode) {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 	} else {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	}
 }
 
@@ -119,7 +113,6 @@ void ads1x15_set_pga(const device_info_t *device_info, const ads1x15_pga_t pga)
 	i2c_write_reg_uint16_mask(ADS1x15_REG_CONFIG, (const uint16_t) pga, ADS1x15_REG_CONFIG_PGA_MASK);
 }
 
-
 /**
  *
  * @param device_info
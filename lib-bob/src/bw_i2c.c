@@ -25,15 +25,10 @@
 
 #include <stddef.h>
 
-#include "bcm2835.h"
-#if defined(__linux__)
- #define udelay bcm2835_delayMicroseconds
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "device_info.h"
 
+#include "i2c.h"
+
 #include "bw.h"
 
 #define I2C_DELAY_WRITE_READ_US		100
@@ -53,10 +48,10 @@ void bw_i2c_read_id(const device_info_t *device_info, char *id) {
 		return;
 	}
 
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address >> 1);
-	bcm2835_i2c_setClockDivider(2500);
+	i2c_set_address(device_info->slave_address >> 1);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 
-	(void) bcm2835_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	udelay(I2C_DELAY_WRITE_READ_US);
-	(void) bcm2835_i2c_read(id, BW_ID_STRING_LENGTH);
+	i2c_write_nb(cmd, sizeof(cmd) / sizeof(cmd[0]));
+	i2c_delayus(I2C_DELAY_WRITE_READ_US);
+	(void) i2c_read(id, BW_ID_STRING_LENGTH);
 }
@@ -25,13 +25,6 @@
 
 #include <stdint.h>
 
-#include "bcm2835.h"
-
-#if defined(__linux__) || defined(__circle__)
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "bw.h"
@@ -47,8 +40,8 @@
  * @param device_info
  */
 inline static void dio_i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address >> 1);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+	i2c_set_address(device_info->slave_address >> 1);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 }
 
 /**
@@ -58,7 +51,7 @@ inline static void dio_i2c_setup(const device_info_t *device_info) {
  * @return
  */
 const bool bw_i2c_dio_start(device_info_t *device_info) {
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = BW_DIO_DEFAULT_SLAVE_ADDRESS;
@@ -86,7 +79,7 @@ void bw_i2c_dio_fsel_mask(const device_info_t *device_info, const uint8_t mask)
 	cmd[1] = (char) mask;
 
 	dio_i2c_setup(device_info);
-	(void) bcm2835_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
+	i2c_write_nb(cmd, sizeof(cmd) / sizeof(cmd[0]));
 }
 
 /**
@@ -102,5 +95,5 @@ void bw_i2c_dio_output(const device_info_t *device_info, const uint8_t pins) {
 	cmd[1] = (char) pins;
 
 	dio_i2c_setup(device_info);
-	(void) bcm2835_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
+	i2c_write_nb(cmd, sizeof(cmd) / sizeof(cmd[0]));
 }
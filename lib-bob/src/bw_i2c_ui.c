@@ -26,13 +26,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#include "bcm2835.h"
-#if defined(__linux__) || defined(__circle__)
- #define udelay bcm2835_delayMicroseconds
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "bw.h"
@@ -42,39 +35,27 @@
 #define BW_UI_I2C_BYTE_WAIT_US			28
 #define BW_UI_I2C_DELAY_WRITE_READ_US	90
 
-#if defined (BARE_METAL)
-static uint32_t i2c_write_us = (uint32_t) 0;
-#endif
-
 inline static void _i2c_write(const char *buffer, const uint32_t size) {
-#if defined(BARE_METAL)
-	const uint32_t elapsed = BCM2835_ST->CLO - i2c_write_us;
-
-	if (elapsed < BW_UI_I2C_BYTE_WAIT_US) {
-		udelay(BW_UI_I2C_BYTE_WAIT_US - elapsed);
-	}
-#endif
-	(void) bcm2835_i2c_write(buffer, size);
-#if defined(BARE_METAL)
-	i2c_write_us = BCM2835_ST->CLO;
-#endif
+	i2c_write_nb(buffer, size);
 }
 
 inline static void ui_i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address >> 1);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+	i2c_set_address(device_info->slave_address >> 1);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 }
 
 const bool bw_i2c_ui_start(device_info_t *device_info) {
 	char cmd[2];
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = BW_UI_DEFAULT_SLAVE_ADDRESS;
 	}
 
 	ui_i2c_setup(device_info);
+	i2c_set_priority(I2C_PRIORITY_LOW);
+	i2c_set_gap(BW_UI_I2C_BYTE_WAIT_US);
 
 	if (!i2c_is_connected(device_info->slave_address >> 1)) {
 		return false;
@@ -89,9 +70,7 @@ const bool bw_i2c_ui_start(device_info_t *device_info) {
 	cmd[1] = (char) 1;
 
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-#if defined (BARE_METAL)
-	i2c_write_us = BCM2835_ST->CLO;
-#endif
+
 	return true;
 }
 
@@ -190,7 +169,7 @@ void bw_i2c_ui_get_backlight(const device_info_t *device_info, uint8_t *value) {
 
 	ui_i2c_setup(device_info);
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	(void) bcm2835_i2c_read((char *) value, 1);
+	(void) i2c_read((char *) value, 1);
 }
 
 void bw_i2c_ui_get_contrast(const device_info_t *device_info, uint8_t *value) {
@@ -198,7 +177,7 @@ void bw_i2c_ui_get_contrast(const device_info_t *device_info, uint8_t *value) {
 
 	ui_i2c_setup(device_info);
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	(void) bcm2835_i2c_read((char *) value, 1);
+	(void) i2c_read((char *) value, 1);
 }
 
 void bw_i2c_ui_reinit(const device_info_t *device_info) {
@@ -221,8 +200,8 @@ char bw_i2c_ui_read_button(const device_info_t *device_info, const BwUiButtons b
 
 	ui_i2c_setup(device_info);
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	udelay(BW_UI_I2C_DELAY_WRITE_READ_US);
-	(void) bcm2835_i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
+	i2c_delayus(BW_UI_I2C_DELAY_WRITE_READ_US);
+	(void) i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
 
 	return (buf[0]);
 }
@@ -233,8 +212,8 @@ char bw_i2c_ui_read_button_last(const device_info_t *device_info) {
 
 	ui_i2c_setup(device_info);
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	udelay(BW_UI_I2C_DELAY_WRITE_READ_US);
-	(void) bcm2835_i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
+	i2c_delayus(BW_UI_I2C_DELAY_WRITE_READ_US);
+	(void) i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
 
 	return (buf[0]);
 }
@@ -245,8 +224,8 @@ inline static const uint16_t read_adc(const device_info_t *device_info, const ui
 
 	ui_i2c_setup(device_info);
 	_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
-	udelay(BW_UI_I2C_DELAY_WRITE_READ_US);
-	(void) bcm2835_i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
+	i2c_delayus(BW_UI_I2C_DELAY_WRITE_READ_US);
+	(void) i2c_read(buf, sizeof(buf) / sizeof(buf[0]));
 
 	return (uint16_t) buf[0] | (uint16_t) ((uint16_t) buf[1] << 8);
 }
@@ -29,14 +29,6 @@
  #include <stdio.h>
 #endif
 
-#include "bcm2835.h"
-
-#if defined(__linux__) || defined (__circle__)
- #define udelay bcm2835_delayMicroseconds
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "htu21d.h"
@@ -49,9 +41,9 @@
 /*static uint8_t get_id_2nd(const device_info_t *device_info) {
 	char buffer[6] = { 0xFC, 0xC9 };
 
-	bcm2835_i2c_write(buffer, 2);
+	i2c_write_nb(buffer, 2);
 
-	bcm2835_i2c_read(buffer, 6);
+	i2c_read(buffer, 6);
 
 	int i = 0;
 	for(i = 0; i < 6; i++) {
@@ -64,18 +56,18 @@
 }*/
 
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
+	i2c_set_address(device_info->slave_address);
 
 	if (device_info->fast_mode) {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 	} else {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	}
 }
 
 bool htu21d_start(device_info_t *device_info) {
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = HTU21D_I2C_DEFAULT_SLAVE_ADDRESS;
@@ -102,11 +94,11 @@ static const uint16_t get_raw_value(uint8_t cmd) {
 	char buffer[3];
 
 	buffer[0] = (char) cmd;
-	bcm2835_i2c_write(buffer, 1);
+	i2c_write_nb(buffer, 1);
 
-	udelay(80 * 1000);	// datasheet says 50ms
+	i2c_delayus(80 * 1000);	// datasheet says 50ms
 
-	bcm2835_i2c_read(buffer, 3);
+	i2c_read(buffer, 3);
 
 	return (((uint16_t) buffer[0] << 8) | ((uint16_t) buffer[1])) & (uint16_t) 0xFFFC;
 }
@@ -31,12 +31,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#if defined(__linux__) || defined (__circle__)
- #include "bcm2835.h"
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "ina219.h"
@@ -80,18 +74,18 @@ struct _ina219_info {
 #define INA219_READ_REG_DELAY_US	800		///<
 
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
+	i2c_set_address(device_info->slave_address);
 
 	if (device_info->fast_mode) {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 	} else {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	}
 }
 
 const bool ina219_start(device_info_t *device_info) {
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = INA219_I2C_DEFAULT_SLAVE_ADDRESS;
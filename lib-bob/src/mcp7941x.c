@@ -26,11 +26,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 
-#include "bcm2835.h"
-#if defined(__linux__) || defined(__circle__)
-#else
- #include "bcm2835_i2c.h"
-#endif
+#include "i2c.h"
 
 #include "mcp7941x.h"
 
@@ -55,8 +51,8 @@ static uint8_t i2c_mcp7941x_slave_address __attribute__((aligned(4))) = (uint8_t
  *
  */
 void inline static mcp7941x_setup(void) {
-	bcm2835_i2c_setSlaveAddress(i2c_mcp7941x_slave_address);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+	i2c_set_address(i2c_mcp7941x_slave_address);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 }
 
 /**
@@ -67,7 +63,7 @@ void inline static mcp7941x_setup(void) {
  */
 uint8_t mcp7941x_start(const uint8_t slave_address) {
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (slave_address == (uint8_t) 0) {
 		i2c_mcp7941x_slave_address = (uint8_t)MCP7941X_DEFAULT_SLAVE_ADDRESS;
@@ -77,7 +73,7 @@ uint8_t mcp7941x_start(const uint8_t slave_address) {
 
 	mcp7941x_setup();
 
-	if (bcm2835_i2c_write(NULL, 0) == 0) {
+	if (i2c_is_connected(i2c_mcp7941x_slave_address)) {
 		return MCP7941X_OK;
 	}
 
@@ -95,8 +91,8 @@ void mcp7941x_get_date_time(struct rtc_time *t) {
 
 	mcp7941x_setup();
 
-	(void) bcm2835_i2c_write(cmd, sizeof(cmd)/sizeof(char));
-	(void) bcm2835_i2c_read(reg, sizeof(reg)/sizeof(char));
+	i2c_write_nb(cmd, sizeof(cmd)/sizeof(char));
+	(void) i2c_read(reg, sizeof(reg)/sizeof(char));
 
 	t->tm_sec = BCD2DEC((int)reg[MCP7941X_RTCC_TCR_SECONDS] & 0x7f);
 	t->tm_min = BCD2DEC((int)reg[MCP7941X_RTCC_TCR_MINUTES] & 0x7f);
@@ -138,5 +134,5 @@ void mcp7941x_set_date_time(const struct rtc_time *t) {
 
 	mcp7941x_setup();
 
-	(void) bcm2835_i2c_write(data, sizeof(data)/sizeof(data[0]));
+	i2c_write_nb(data, sizeof(data)/sizeof(data[0]));
 }
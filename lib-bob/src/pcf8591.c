@@ -27,12 +27,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#if defined(__linux__) || defined(__circle__)
- #include "bcm2835.h"
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "pcf8591.h"
@@ -47,8 +41,8 @@
  * @param device_info
  */
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+	i2c_set_address(device_info->slave_address);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	// ignore device_info->fast_mode
 }
 
@@ -58,7 +52,7 @@ static void i2c_setup(const device_info_t *device_info) {
  * @return
  */
 const bool pcf8591_start(device_info_t *device_info) {
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = PCF8591_DEFAULT_SLAVE_ADDRESS;
@@ -84,7 +78,7 @@ void pcf8591_dac_write(const device_info_t *device_info, const uint8_t data) {
 	cmd[1] = (char) data;
 
 	i2c_setup(device_info);
-	bcm2835_i2c_write(cmd, sizeof(cmd) / sizeof(cmd[0]));
+	i2c_write_nb(cmd, sizeof(cmd) / sizeof(cmd[0]));
 
 }
 
@@ -98,9 +92,9 @@ const uint8_t pcf8591_adc_read(const device_info_t *device_info, const uint8_t c
 	char data = (uint8_t) channel;
 
 	i2c_setup(device_info);
-	bcm2835_i2c_write(&data, 1);
-	bcm2835_i2c_read(&data, 1);
-	bcm2835_i2c_read(&data, 1);
+	i2c_write_nb(&data, 1);
+	i2c_read(&data, 1);
+	i2c_read(&data, 1);
 
 	return (uint8_t) data;
 }
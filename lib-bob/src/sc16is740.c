@@ -30,6 +30,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "sc16is740.h"
 #include "sc16is7x0.h"
 
 #if defined(__linux__) || defined(__circle__)
@@ -185,9 +186,7 @@ int sc16is740_read(const device_info_t *device_info, void *buffer, unsigned coun
 int sc16is740_write(const device_info_t *device_info, const void *buffer, unsigned count) {
 	int result = 0;
 	uint8_t fifo_space;
-	uint8_t i;
-	char *src = (char *) buffer;
-	char *dst;
+	const char *src = (const char *) buffer;
 
 	while (count > 0) {
 		while ((fifo_space = sc16is740_reg_read(device_info, SC16IS7X0_TXLVL)) == 0) {
@@ -197,20 +196,38 @@ int sc16is740_write(const device_info_t *device_info, const void *buffer, unsign
 			fifo_space = (uint8_t) count;
 		}
 
-		dst = &buffer_tx[1];
+		sc16is740_write_fifo(device_info, src, (unsigned) fifo_space);
 
-		for (i = 0; i < fifo_space; i++) {
-			*dst++ = *src++;
-		}
+		src += fifo_space;
+		count -= (unsigned) fifo_space;
+	}
 
-		sc16is740_setup(device_info);
-		bcm2835_spi_writenb(buffer_tx, fifo_space + 1);
+	return result;
+}
 
-		count -= (unsigned) fifo_space;
+/**
+ * Writes to the TX FIFO in a single SPI transfer, without polling TXLVL.
+ * The caller must know there is room for count bytes.
+ *
+ * @param device_info
+ * @param buffer
+ * @param count At most \ref SC16IS7X0_FIFO_TX
+ */
+void sc16is740_write_fifo(const device_info_t *device_info, const void *buffer, unsigned count) {
+	const char *src = (const char *) buffer;
+	char *dst = &buffer_tx[1];
+	unsigned i;
 
+	if (count > (unsigned) SC16IS7X0_FIFO_TX) {
+		count = (unsigned) SC16IS7X0_FIFO_TX;
 	}
 
-	return result;
+	for (i = 0; i < count; i++) {
+		*dst++ = *src++;
+	}
+
+	sc16is740_setup(device_info);
+	bcm2835_spi_writenb(buffer_tx, count + 1);
 }
 
 /**
@@ -32,7 +32,6 @@
  #define udelay bcm2835_delayMicroseconds
 #else
  #include "bcm2835_gpio.h"
- #include "bcm2835_i2c.h"
  #include "bcm2835_aux_spi.h"
  #include "bcm2835_spi.h"
 #endif
@@ -227,8 +226,8 @@ static void reset(void) {
  * @param device_info
  */
 static void i2c_setup(const oled_info_t *oled_info) {
-	bcm2835_i2c_setSlaveAddress(oled_info->slave_address);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+	i2c_set_address(oled_info->slave_address);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 }
 
 /**
@@ -280,7 +279,7 @@ static void _send_data(const oled_info_t *oled_info, const uint8_t *data, const
 		}
 	} else {
 		i2c_setup(oled_info);
-		(void) bcm2835_i2c_write((const char *) data, len);
+		i2c_write_nb((const char *) data, len);
 	}
 }
 
@@ -480,13 +479,14 @@ const bool oled_start(oled_info_t *oled_info) {
 	int i;
 
 	if (oled_info->protocol == OLED_PROTOCOL_I2C) {
-		bcm2835_i2c_begin();
+		(void) i2c_begin();
 
 		if (oled_info->slave_address == (uint8_t) 0) {
 			oled_info->slave_address = OLED_I2C_SLAVE_ADDRESS_DEFAULT;
 		}
 
 		i2c_setup(oled_info);
+		i2c_set_priority(I2C_PRIORITY_LOW);
 
 		if (!i2c_is_connected(oled_info->slave_address)) {
 			return false;
@@ -25,13 +25,6 @@
 
 #include <stdint.h>
 
-#include "bcm2835.h"
-#if defined(__linux__) || defined(__circle__)
- #define udelay bcm2835_delayMicroseconds
-#else
- #include "bcm2835_i2c.h"
-#endif
-
 #include "i2c.h"
 
 #include "tc1602.h"
@@ -44,12 +37,12 @@
  * @param device_info
  */
 static void i2c_setup(const device_info_t *device_info) {
-	bcm2835_i2c_setSlaveAddress(device_info->slave_address);
+	i2c_set_address(device_info->slave_address);
 
 	if (device_info->fast_mode) {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 	} else {
-		bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_2500);
+		i2c_set_clockdivider(I2C_CLOCK_DIVIDER_100kHz);
 	}
 }
 
@@ -83,7 +76,7 @@ static void write_4bits(const device_info_t *device_info, const uint8_t data) {
 static void write_cmd(const device_info_t *device_info, const uint8_t cmd) {
 	write_4bits(device_info, cmd & (uint8_t) 0xF0);
 	write_4bits(device_info, (cmd << 4) & (uint8_t) 0xF0);
-	udelay(EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CMD);
 }
 
 /**
@@ -94,7 +87,7 @@ static void write_cmd(const device_info_t *device_info, const uint8_t cmd) {
 static void write_reg(const device_info_t *device_info, const uint8_t reg) {
 	write_4bits(device_info, (uint8_t) TC1602_RS | (reg & (uint8_t) 0xF0));
 	write_4bits(device_info, (uint8_t) TC1602_RS | ((reg << 4) & (uint8_t) 0xF0));
-	udelay(EXEC_TIME_REG);
+	i2c_delayus(EXEC_TIME_REG);
 }
 
 /**
@@ -104,7 +97,7 @@ static void write_reg(const device_info_t *device_info, const uint8_t reg) {
  */
 const bool tc1602_i2c_start(device_info_t *device_info) {
 
-	bcm2835_i2c_begin();
+	(void) i2c_begin();
 
 	if (device_info->slave_address == (uint8_t) 0) {
 		device_info->slave_address = TC1602_I2C_DEFAULT_SLAVE_ADDRESS;
@@ -115,6 +108,7 @@ const bool tc1602_i2c_start(device_info_t *device_info) {
 	}
 
 	i2c_setup(device_info);
+	i2c_set_priority(I2C_PRIORITY_LOW);
 
 	if (!i2c_is_connected(device_info->slave_address)) {
 		return false;
@@ -126,7 +120,7 @@ const bool tc1602_i2c_start(device_info_t *device_info) {
 	write_cmd(device_info, (uint8_t) (TC1602_IC_FUNC | TC1602_IC_FUNC_4BIT | TC1602_IC_FUNC_2LINE | TC1602_IC_FUNC_5x8DOTS)); ///< Data length, number of lines, font size
 	write_cmd(device_info, (uint8_t) (TC1602_IC_DISPLAY | TC1602_IC_DISPLAY_ON | TC1602_IC_DISPLAY_CURSOR_OFF | TC1602_IC_DISPLAY_BLINK_OFF));	///< Display On,Cursor Off, Blink Off
 	write_cmd(device_info, (uint8_t) TC1602_IC_CLS);
-	udelay(EXEC_TIME_CLS - EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CLS - EXEC_TIME_CMD);
 	write_cmd(device_info, (uint8_t) (TC1602_IC_ENTRY_MODE | TC1602_IC_ENTRY_MODE_INC));	///< Cursor move direction
 
 	return true;
@@ -179,6 +173,6 @@ void tc1602_i2c_text_line_2(const device_info_t *device_info, const char *data,
  */
 void tc1602_i2c_cls(const device_info_t *device_info) {
 	write_cmd(device_info, (uint8_t) TC1602_IC_CLS);
-	udelay(EXEC_TIME_CLS - EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CLS - EXEC_TIME_CMD);
 }
 
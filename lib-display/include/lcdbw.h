@@ -60,7 +60,6 @@ private:
 
 private:
 	uint8_t m_nSlaveAddress;
-	uint32_t m_nWriteMicros;
 };
 
 #endif /* BWLCD_H_ */
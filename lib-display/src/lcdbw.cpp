@@ -25,16 +25,6 @@
 
 #include <stdint.h>
 
-extern "C" {
-extern uint32_t micros(void);
-#if defined(__linux__)
-extern void bcm2835_delayMicroseconds (const uint64_t);
-#define udelay bcm2835_delayMicroseconds
-#else
-extern void udelay(uint32_t);
-#endif
-}
-
 #include "lcdbw.h"
 
 #include "i2c.h"
@@ -55,15 +45,15 @@ extern void udelay(uint32_t);
 
 #define BW_LCD_I2C_BYTE_WAIT_US	37
 
-LcdBw::LcdBw(void): m_nSlaveAddress(BW_LCD_DEFAULT_SLAVE_ADDRESS), m_nWriteMicros(0) {
+LcdBw::LcdBw(void): m_nSlaveAddress(BW_LCD_DEFAULT_SLAVE_ADDRESS) {
 }
 
-LcdBw::LcdBw(const uint8_t nCols, const uint8_t nRows): m_nSlaveAddress(BW_LCD_DEFAULT_SLAVE_ADDRESS), m_nWriteMicros(0) {
+LcdBw::LcdBw(const uint8_t nCols, const uint8_t nRows): m_nSlaveAddress(BW_LCD_DEFAULT_SLAVE_ADDRESS) {
 	m_nCols = nCols;
 	m_nRows = nRows;
 }
 
-LcdBw::LcdBw(const uint8_t nSlaveAddress, const uint8_t nCols, const uint8_t nRows): m_nWriteMicros(0) {
+LcdBw::LcdBw(const uint8_t nSlaveAddress, const uint8_t nCols, const uint8_t nRows) {
 	if (nSlaveAddress == (uint8_t) 0) {
 		m_nSlaveAddress = BW_LCD_DEFAULT_SLAVE_ADDRESS;
 	} else {
@@ -81,6 +71,8 @@ bool LcdBw::Start(void) {
 	i2c_begin();
 
 	Setup();
+	i2c_set_priority(I2C_PRIORITY_LOW);
+	i2c_set_gap(BW_LCD_I2C_BYTE_WAIT_US);
 
 	if (!i2c_is_connected(m_nSlaveAddress >> 1)) {
 		return false;
@@ -190,13 +182,5 @@ void LcdBw::SetCursor(const TCursorMode constEnumTCursorOnOff) {
 }
 
 void LcdBw::Write(const char *buffer, const uint32_t size) {
-	const uint32_t elapsed = micros() - m_nWriteMicros;
-
-	if (elapsed < BW_LCD_I2C_BYTE_WAIT_US) {
-		udelay(BW_LCD_I2C_BYTE_WAIT_US - elapsed);
-	}
-
 	i2c_write_nb(buffer, size);
-
-	m_nWriteMicros = micros();
 }
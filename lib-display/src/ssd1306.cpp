@@ -244,6 +244,7 @@ bool Ssd1306::Start(void) {
 	i2c_begin();
 
 	Setup();
+	i2c_set_priority(I2C_PRIORITY_LOW);
 
 	if (!i2c_is_connected(m_nSlaveAddress)) {
 		return false;
@@ -26,15 +26,6 @@
 #include <stdint.h>
 #include <assert.h>
 
-extern "C" {
-#if defined(__linux__)
-extern void bcm2835_delayMicroseconds (const uint64_t);
-#define udelay bcm2835_delayMicroseconds
-#else
-extern void udelay(uint32_t);
-#endif
-}
-
 #include "tc1602.h"
 
 #include "i2c.h"
@@ -114,6 +105,7 @@ bool Tc1602::Start(void) {
 	i2c_begin();
 
 	Setup();
+	i2c_set_priority(I2C_PRIORITY_LOW);
 
 	if (!i2c_is_connected(m_nSlaveAddress)) {
 		return false;
@@ -125,7 +117,7 @@ bool Tc1602::Start(void) {
 	WriteCmd((uint8_t) (TC1602_IC_FUNC | TC1602_IC_FUNC_4BIT | TC1602_IC_FUNC_2LINE | TC1602_IC_FUNC_5x8DOTS)); ///< Data length, number of lines, font size
 	WriteCmd((uint8_t) (TC1602_IC_DISPLAY | TC1602_IC_DISPLAY_ON | TC1602_IC_DISPLAY_CURSOR_OFF | TC1602_IC_DISPLAY_BLINK_OFF));	///< Display On,Cursor Off, Blink Off
 	WriteCmd((uint8_t) TC1602_IC_CLS);
-	udelay(EXEC_TIME_CLS - EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CLS - EXEC_TIME_CMD);
 	WriteCmd((uint8_t) (TC1602_IC_ENTRY_MODE | TC1602_IC_ENTRY_MODE_INC));	///< Cursor move direction
 
 	return true;
@@ -133,7 +125,7 @@ bool Tc1602::Start(void) {
 
 void Tc1602::Cls(void) {
 	WriteCmd((uint8_t) TC1602_IC_CLS);
-	udelay(EXEC_TIME_CLS - EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CLS - EXEC_TIME_CMD);
 }
 
 void Tc1602::PutChar(int c) {
@@ -202,7 +194,7 @@ void Tc1602::Write4bits(const uint8_t data) {
 void Tc1602::WriteCmd(const uint8_t cmd) {
 	Write4bits(cmd & (uint8_t) 0xF0);
 	Write4bits((cmd << 4) & (uint8_t) 0xF0);
-	udelay(EXEC_TIME_CMD);
+	i2c_delayus(EXEC_TIME_CMD);
 }
 
 void Tc1602::SetCursor(const TCursorMode tCursorOnOff) {
@@ -222,7 +214,7 @@ void Tc1602::SetCursor(const TCursorMode tCursorOnOff) {
 void Tc1602::WriteReg(const uint8_t reg) {
 	Write4bits((uint8_t) TC1602_RS | (reg & (uint8_t) 0xF0));
 	Write4bits((uint8_t) TC1602_RS | ((reg << 4) & (uint8_t) 0xF0));
-	udelay(EXEC_TIME_REG);
+	i2c_delayus(EXEC_TIME_REG);
 }
 
 void Tc1602::SetCursorPos(uint8_t col, uint8_t row) {
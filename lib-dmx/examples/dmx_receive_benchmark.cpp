@@ -0,0 +1,433 @@
+/**
+ * @file dmx_receive_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dmx_receive.h"	// util.h has memcmp and memset
+#include "rdm.h"
+
+#include "../../lib-rdm/include/rdm_e120.h"
+
+/*
+ * No hardware needed: a synthetic line is fed through both receive modes of dmx.c.
+ * FIQ mode, fiq_dmx_in_handler for each byte and break, irq_timer1_dmx_receive for the slot time-out.
+ * DMA mode, the DMA writes the data register words into a ring, fiq_dmx_in_dma_handler for each break
+ * and irq_timer1_dmx_receive_dma polls the ring.
+ * The main loop reads the frames and the RDM messages every millisecond and checks them against the line.
+ */
+
+#define DMX_FRAMES			3000
+#define RDM_EVERY			50		///< One RDM request after this many DMX frames
+#define DISCOVERY_EVERY		6		///< Every so many RDM requests is a DUB with a response
+#define BREAK_MICROS		176
+#define MAB_MICROS			12
+#define LOOP_MICROS			1000	///< The main loop reads the frames
+#define DMA_RING_SIZE		1024	///< As DMX_DMA_RING_SIZE in dmx.c
+#define EXPECTED_ENTRIES	64
+#define DMA_SLOT_TOLERANCE	4		///< Reported, not checked, DMA mode estimates the slot time from the polls
+
+struct TEvent {
+	uint32_t nMicros;
+	uint32_t nWord;		///< As read from the PL011 data register
+};
+
+struct TExpected {
+	uint8_t data[1 + DMX_UNIVERSE_SIZE];	///< Start code and the slots
+	uint32_t nLength;
+	uint32_t nBreakToBreak;		///< 0, not checked
+};
+
+struct TResult {
+	uint32_t nFiq;
+	uint32_t nIrq;
+	uint32_t nFrames;
+	uint32_t nRdm;
+	uint32_t nFrameErrors;
+	uint32_t nRdmErrors;
+	uint32_t nBreakToBreakErrors;
+	uint32_t nSlotToSlotErrors;
+	uint32_t nSlotToSlotDeviation;	///< Largest, in us
+	uint64_t nHostNanos;
+};
+
+/*
+ * The line, generated packet by packet from a fixed seed, so both modes see the same bytes
+ */
+static TEvent s_Packet[4 + RDM_DATA_BUFFER_SIZE + 64];
+static uint32_t s_nPacketLength;
+static uint32_t s_nPacketIndex;
+static uint32_t s_nLineMicros;
+static uint32_t s_nSlotMicros;
+static uint32_t s_nDmxFrames;
+static uint32_t s_nRdmRequests;
+static uint32_t s_nBreakDmxPrevious;
+static bool s_bIsPreviousBreakDmx;
+
+static TExpected s_ExpectedDmx[EXPECTED_ENTRIES];
+static uint32_t s_nExpectedDmxHead;
+static uint32_t s_nExpectedDmxTail;
+static TExpected s_ExpectedRdm[EXPECTED_ENTRIES];
+static uint32_t s_nExpectedRdmHead;
+static uint32_t s_nExpectedRdmTail;
+
+static void AddBreak(void) {
+	s_nLineMicros += BREAK_MICROS;
+	s_Packet[s_nPacketLength].nMicros = s_nLineMicros;
+	s_Packet[s_nPacketLength].nWord = DMX_RECEIVE_DR_BE;
+	s_nPacketLength++;
+	s_nLineMicros += MAB_MICROS;
+}
+
+static void AddByte(uint8_t nByte) {
+	s_nLineMicros += s_nSlotMicros;
+	s_Packet[s_nPacketLength].nMicros = s_nLineMicros;
+	s_Packet[s_nPacketLength].nWord = nByte;
+	s_nPacketLength++;
+}
+
+static void GenerateDmx(void) {
+	TExpected *pExpected = &s_ExpectedDmx[s_nExpectedDmxHead++ % EXPECTED_ENTRIES];
+	const uint32_t nSlots = (rand() % 2) == 0 ? DMX_UNIVERSE_SIZE : 24 + (rand() % (DMX_UNIVERSE_SIZE - 24));
+
+	AddBreak();
+
+	pExpected->nBreakToBreak = s_bIsPreviousBreakDmx ? s_nLineMicros - MAB_MICROS - s_nBreakDmxPrevious : 0;
+	pExpected->nLength = nSlots;
+	s_nBreakDmxPrevious = s_nLineMicros - MAB_MICROS;
+	s_bIsPreviousBreakDmx = true;
+
+	pExpected->data[0] = DMX512_START_CODE;
+	AddByte(DMX512_START_CODE);
+
+	for (uint32_t i = 1; i <= nSlots; i++) {
+		pExpected->data[i] = (uint8_t) rand();
+		AddByte(pExpected->data[i]);
+	}
+
+	s_nDmxFrames++;
+}
+
+static void GenerateRdm(bool bIsDiscovery) {
+	TExpected *pExpected = &s_ExpectedRdm[s_nExpectedRdmHead++ % EXPECTED_ENTRIES];
+	struct _rdm_command *p = (struct _rdm_command *) pExpected->data;
+	const uint8_t nParamDataLength = bIsDiscovery ? 12 : (uint8_t) (rand() % 32);
+
+	memset(p, 0, sizeof(pExpected->data));
+
+	p->start_code = E120_SC_RDM;
+	p->sub_start_code = E120_SC_SUB_MESSAGE;
+	p->message_length = RDM_MESSAGE_MINIMUM_SIZE + nParamDataLength;
+	memset(p->destination_uid, 0xFF, RDM_UID_SIZE);
+	for (uint32_t i = 0; i < RDM_UID_SIZE; i++) {
+		p->source_uid[i] = (uint8_t) rand();
+	}
+	p->transaction_number = (uint8_t) s_nRdmRequests;
+	p->command_class = bIsDiscovery ? E120_DISCOVERY_COMMAND : (uint8_t) 0x20;
+	p->param_id[1] = bIsDiscovery ? (uint8_t) E120_DISC_UNIQUE_BRANCH : (uint8_t) rand();
+	p->param_data_length = nParamDataLength;
+	for (uint32_t i = 0; i < nParamDataLength; i++) {
+		p->param_data[i] = (uint8_t) rand();
+	}
+
+	uint16_t nChecksum = 0;
+
+	for (uint32_t i = 0; i < p->message_length; i++) {
+		nChecksum += pExpected->data[i];
+	}
+
+	pExpected->data[p->message_length] = (uint8_t) (nChecksum >> 8);
+	pExpected->data[p->message_length + 1] = (uint8_t) nChecksum;
+	pExpected->nLength = p->message_length + RDM_MESSAGE_CHECKSUM_SIZE;
+	pExpected->nBreakToBreak = 0;
+
+	AddBreak();
+	s_bIsPreviousBreakDmx = false;
+
+	for (uint32_t i = 0; i < pExpected->nLength; i++) {
+		AddByte(pExpected->data[i]);
+	}
+
+	s_nRdmRequests++;
+
+	if (!bIsDiscovery) {
+		return;
+	}
+
+	// The response of a single responder, no break
+	pExpected = &s_ExpectedRdm[s_nExpectedRdmHead++ % EXPECTED_ENTRIES];
+	uint8_t *pResponse = pExpected->data;
+	uint16_t nEcs = 0;
+
+	memset(pResponse, 0xFE, 7);
+	pResponse[7] = 0xAA;
+
+	for (uint32_t i = 0; i < RDM_UID_SIZE; i++) {
+		const uint8_t nUid = (uint8_t) rand();
+		pResponse[8 + 2 * i] = nUid | 0xAA;
+		pResponse[9 + 2 * i] = nUid | 0x55;
+		nEcs += (nUid | 0xAA) + (nUid | 0x55);
+	}
+
+	pResponse[20] = (uint8_t) (nEcs >> 8) | 0xAA;
+	pResponse[21] = (uint8_t) (nEcs >> 8) | 0x55;
+	pResponse[22] = (uint8_t) nEcs | 0xAA;
+	pResponse[23] = (uint8_t) nEcs | 0x55;
+	pExpected->nLength = 24;
+	pExpected->nBreakToBreak = 0;
+
+	s_nLineMicros += 1000;
+
+	for (uint32_t i = 0; i < pExpected->nLength; i++) {
+		AddByte(pResponse[i]);
+	}
+}
+
+static void LineReset(uint32_t nSlotMicros) {
+	srand(1);
+
+	s_nPacketLength = 0;
+	s_nPacketIndex = 0;
+	s_nLineMicros = 0;
+	s_nSlotMicros = nSlotMicros;
+	s_nDmxFrames = 0;
+	s_nRdmRequests = 0;
+	s_bIsPreviousBreakDmx = false;
+	s_nExpectedDmxHead = 0;
+	s_nExpectedDmxTail = 0;
+	s_nExpectedRdmHead = 0;
+	s_nExpectedRdmTail = 0;
+}
+
+static bool LineNext(TEvent &event) {
+	if (s_nPacketIndex == s_nPacketLength) {
+		if (s_nDmxFrames == DMX_FRAMES) {
+			return false;
+		}
+
+		s_nPacketLength = 0;
+		s_nPacketIndex = 0;
+
+		// Idle line between the packets
+		s_nLineMicros += 100 + (rand() % 2000);
+
+		if ((s_nDmxFrames != 0) && ((s_nDmxFrames % RDM_EVERY) == 0) && (s_nRdmRequests * RDM_EVERY < s_nDmxFrames)) {
+			GenerateRdm((s_nRdmRequests % DISCOVERY_EVERY) == 0);
+		} else {
+			GenerateDmx();
+		}
+	}
+
+	event = s_Packet[s_nPacketIndex++];
+
+	return true;
+}
+
+/*
+ * The main loop, dmx_get_available and rdm_get_available
+ */
+static struct _dmx_receive s_Receive;
+static volatile struct _total_statistics s_Statistics;
+static TResult s_Result;
+static bool s_bIsDma;
+
+static void Read(void) {
+	const uint8_t *p;
+
+	while ((p = dmx_receive_get_available(&s_Receive)) != NULL) {
+		const struct _dmx_data *pFrame = (const struct _dmx_data *) p;
+		const TExpected *pExpected = &s_ExpectedDmx[s_nExpectedDmxTail++ % EXPECTED_ENTRIES];
+
+		s_Result.nFrames++;
+
+		if ((pFrame->statistics.slots_in_packet != pExpected->nLength) || (memcmp(p, pExpected->data, 1 + pExpected->nLength) != 0)) {
+			s_Result.nFrameErrors++;
+			continue;
+		}
+
+		if ((pExpected->nBreakToBreak != 0) && (pFrame->statistics.break_to_break != pExpected->nBreakToBreak)) {
+			s_Result.nBreakToBreakErrors++;
+		}
+
+		const uint32_t nSlotToSlot = pFrame->statistics.slot_to_slot;
+		const uint32_t nDeviation = nSlotToSlot > s_nSlotMicros ? nSlotToSlot - s_nSlotMicros : s_nSlotMicros - nSlotToSlot;
+
+		if (nDeviation > s_Result.nSlotToSlotDeviation) {
+			s_Result.nSlotToSlotDeviation = nDeviation;
+		}
+
+		if (nDeviation > (s_bIsDma ? s_nSlotMicros / DMA_SLOT_TOLERANCE : 0)) {
+			s_Result.nSlotToSlotErrors++;
+		}
+	}
+
+	while ((p = rdm_receive_get_available(&s_Receive)) != NULL) {
+		const TExpected *pExpected = &s_ExpectedRdm[s_nExpectedRdmTail++ % EXPECTED_ENTRIES];
+
+		s_Result.nRdm++;
+
+		if (memcmp(p, pExpected->data, pExpected->nLength) != 0) {
+			s_Result.nRdmErrors++;
+		}
+	}
+}
+
+/*
+ * The PL011, the system timer C1 and the DMA
+ */
+static uint32_t s_nTimerC1;
+static bool s_bIsTimerArmed;
+static uint32_t s_DmaRing[DMA_RING_SIZE];
+static uint32_t s_nDmaHead;
+static uint32_t s_nDmaBreakMicros;
+
+static void SetTimer(uint32_t nMicros) {
+	s_nTimerC1 = nMicros;
+	s_bIsTimerArmed = true;
+}
+
+static void Fiq(const TEvent &event) {
+	if (s_bIsDma) {
+		s_DmaRing[s_nDmaHead++ & (DMA_RING_SIZE - 1)] = event.nWord;
+
+		if ((event.nWord & DMX_RECEIVE_DR_BE) == 0) {
+			return;
+		}
+
+		s_Result.nFiq++;
+		s_nDmaBreakMicros = event.nMicros;
+		SetTimer(event.nMicros + DMX_RECEIVE_BREAK_POLL);
+		return;
+	}
+
+	s_Result.nFiq++;
+
+	if (event.nWord & DMX_RECEIVE_DR_BE) {
+		dmx_receive_break(&s_Receive, event.nMicros);
+	} else {
+		const bool bIsData = (s_Receive.state == DMX_RECEIVE_STATE_DMXDATA);
+
+		dmx_receive_data(&s_Receive, (uint8_t) event.nWord, event.nMicros);
+
+		if (bIsData && (s_Receive.state == DMX_RECEIVE_STATE_DMXDATA)) {
+			SetTimer(event.nMicros + s_Receive.slot_to_slot + 12);
+		}
+	}
+}
+
+static void Irq(uint32_t nMicros) {
+	s_Result.nIrq++;
+	s_bIsTimerArmed = false;
+
+	if (s_bIsDma) {
+		const uint32_t nHead = s_nDmaHead & (DMA_RING_SIZE - 1);
+		SetTimer(nMicros + dmx_receive_poll(&s_Receive, s_DmaRing, DMA_RING_SIZE - 1, nHead, s_nDmaBreakMicros, nMicros));
+		return;
+	}
+
+	if (s_Receive.state == DMX_RECEIVE_STATE_DMXDATA) {
+		if (!dmx_receive_timeout(&s_Receive, nMicros)) {
+			SetTimer(nMicros + s_Receive.slot_to_slot);
+		}
+	}
+}
+
+/*
+ * Runs the timer and the main loop up to nMicros
+ */
+static uint32_t s_nLoopMicros;
+
+static void RunUntil(uint32_t nMicros) {
+	for (;;) {
+		if (s_bIsTimerArmed && (s_nTimerC1 <= nMicros) && (s_nTimerC1 <= s_nLoopMicros)) {
+			Irq(s_nTimerC1);
+		} else if (s_nLoopMicros <= nMicros) {
+			Read();
+			s_nLoopMicros += LOOP_MICROS;
+		} else {
+			return;
+		}
+	}
+}
+
+static bool run(const char *pName, bool bIsDma, uint32_t nSlotMicros) {
+	TEvent event;
+	struct timespec start, end;
+
+	LineReset(nSlotMicros);
+	memset(&s_Result, 0, sizeof(TResult));
+	memset((void *) &s_Statistics, 0, sizeof(struct _total_statistics));
+	dmx_receive_init(&s_Receive, &s_Statistics);
+
+	s_bIsDma = bIsDma;
+	s_bIsTimerArmed = false;
+	s_nDmaHead = 0;
+	s_nLoopMicros = LOOP_MICROS;
+
+	if (bIsDma) {
+		SetTimer(DMX_RECEIVE_IDLE_POLL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	while (LineNext(event)) {
+		RunUntil(event.nMicros);
+		Fiq(event);
+	}
+
+	RunUntil(s_nLineMicros + 2 * DMX_RECEIVE_IDLE_POLL);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	s_Result.nHostNanos = (uint64_t) (end.tv_sec - start.tv_sec) * 1000000000 + (uint64_t) (end.tv_nsec - start.tv_nsec);
+
+	const uint32_t nSeconds = s_nLineMicros / 1000000;
+	const bool bIsOk = (s_Result.nFrames == s_nExpectedDmxHead) && (s_Result.nRdm == s_nExpectedRdmHead) && (s_Result.nFrameErrors == 0) && (s_Result.nRdmErrors == 0) && (s_Result.nBreakToBreakErrors == 0) && (bIsDma || (s_Result.nSlotToSlotErrors == 0)) && (s_Statistics.dmx_receive_dropped == 0);
+
+	printf("%-10s %3u us: %5u/%5u frames, %3u/%3u RDM, errors %u/%u/%u/%u, slot +/-%2u us, %7u FIQ, %6u IRQ, %4u interrupts/s, %s\n",
+			pName, nSlotMicros, s_Result.nFrames, s_nExpectedDmxHead, s_Result.nRdm, s_nExpectedRdmHead,
+			s_Result.nFrameErrors, s_Result.nRdmErrors, s_Result.nBreakToBreakErrors, s_Result.nSlotToSlotErrors, s_Result.nSlotToSlotDeviation,
+			s_Result.nFiq, s_Result.nIrq, (s_Result.nFiq + s_Result.nIrq) / (nSeconds == 0 ? 1 : nSeconds), bIsOk ? "OK" : "WRONG");
+
+	return bIsOk;
+}
+
+int main(void) {
+	const uint32_t aSlotMicros[] = { DMX_RECEIVE_SLOT_TIME, 60, 100 };
+	bool bIsOk = true;
+
+	printf("%d DMX frames, errors are frame/RDM/break_to_break/slot_to_slot, DMA slot_to_slot is off by more than 1/%d slot\n", DMX_FRAMES, DMA_SLOT_TOLERANCE);
+
+	for (uint32_t i = 0; i < sizeof(aSlotMicros) / sizeof(aSlotMicros[0]); i++) {
+		bIsOk &= run("FIQ", false, aSlotMicros[i]);
+		bIsOk &= run("DMA", true, aSlotMicros[i]);
+	}
+
+	printf("%s\n", bIsOk ? "OK" : "FAILED");
+
+	return bIsOk ? 0 : 1;
+}
@@ -0,0 +1,387 @@
+/**
+ * @file dmx_send_buffer_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "dmx_send_buffer.h"
+
+/*
+ * No hardware needed: the PL011 UART and the system timer of irq_timer1_dmx_sender
+ * and fiq_dmx_out_handler are simulated with a clock of 1 us steps.
+ * The main loop writer is preempted by the sender wherever the clock ticks.
+ */
+
+#define SIMULATED_SECONDS	20
+#define SLOT_MICROS			44		///< 11 bits at 250 kbaud
+#define BREAK_MICROS		176		///< DMX_TRANSMIT_BREAK_TIME_TYPICAL
+#define MAB_MICROS			12		///< DMX_TRANSMIT_MAB_TIME_MIN
+#define BREAK_TO_BREAK_MIN	1204	///< DMX_TRANSMIT_BREAK_TO_BREAK_TIME_MIN
+#define FIFO_SIZE			16		///< PL011 TX FIFO
+#define FIFO_TRIGGER		8		///< TX interrupt at half full
+#define COPY_BYTES_PER_US	8		///< The memcpy of the writer, slow enough to be preempted
+
+enum TState {
+	IDLE, BREAK, MAB, DMXDATA, DMXINTER
+};
+
+struct TStatistics {
+	uint32_t nCommits;
+	uint32_t nSent;
+	uint32_t nCoalesced;
+	uint32_t nTorn;
+	uint32_t nOutOfOrder;
+	uint32_t nWaitMicros;		///< Writer spinning for the sender
+	uint32_t nMaxWaitMicros;
+	uint32_t nMaxLatencyMicros;	///< From the commit to the BREAK of that frame
+};
+
+static struct _dmx_send_buffer s_Buffer;
+static uint8_t s_BlockingFrame[DMX_SEND_BUFFER_SIZE];	///< The single buffer before the send buffer
+static bool s_bIsBuffered;
+
+// Sender
+static uint32_t s_nMicros;
+static TState s_State;
+static uint32_t s_nTimerC1;
+static uint32_t s_nBreakMicros;
+static uint32_t s_nPreviousBreakMicros;
+static const uint8_t *s_pSendData;
+static uint16_t s_nSendLength;
+static uint16_t s_nCurrentSlot;
+static uint32_t s_nPeriod;
+
+// UART
+static uint8_t s_Fifo[FIFO_SIZE];
+static uint32_t s_nFifoHead;
+static uint32_t s_nFifoTail;
+static uint32_t s_nShiftMicros;
+
+// Wire
+static uint8_t s_Wire[DMX_SEND_BUFFER_SIZE];
+static uint32_t s_nWireLength;
+static uint32_t s_nWireSeq;
+static bool s_bIsWireSeq;
+
+// Writer
+static uint32_t s_nCommitMicros[256];
+
+static struct TStatistics s_Stats;
+
+static void SetLength(uint16_t nLength) {
+	const uint32_t nPackage = BREAK_MICROS + MAB_MICROS + nLength * SLOT_MICROS;
+
+	s_nSendLength = nLength;
+	s_nPeriod = nPackage + SLOT_MICROS > BREAK_TO_BREAK_MIN ? nPackage + SLOT_MICROS : BREAK_TO_BREAK_MIN;
+}
+
+static void FifoFill(void) {
+	while (((s_nFifoTail - s_nFifoHead) < FIFO_SIZE) && (s_nCurrentSlot < s_nSendLength)) {
+		s_Fifo[s_nFifoTail++ % FIFO_SIZE] = s_pSendData[s_nCurrentSlot++];
+	}
+}
+
+/*
+ * The frame on the wire is checked at the next BREAK: slots 1-4 hold the sequence number
+ * and slot n holds (sequence + n), so a frame written while it was sent does not match.
+ * Sequence number 0 is the cleared frame from before the first commit.
+ */
+static void WireCheck(void) {
+	if (s_nWireLength == 0) {
+		return;
+	}
+
+	uint32_t nSeq;
+	memcpy(&nSeq, &s_Wire[1], sizeof(uint32_t));
+
+	for (uint32_t i = 5; i < s_nWireLength; i++) {
+		if (s_Wire[i] != (nSeq == 0 ? 0 : (uint8_t) (nSeq + i))) {
+			s_Stats.nTorn++;
+			s_nWireLength = 0;
+			return;
+		}
+	}
+
+	if (s_bIsWireSeq && (nSeq < s_nWireSeq)) {
+		s_Stats.nOutOfOrder++;
+	}
+
+	if ((nSeq != 0) && (!s_bIsWireSeq || (nSeq != s_nWireSeq))) {
+		const uint32_t nLatency = s_nPreviousBreakMicros - s_nCommitMicros[nSeq & 0xFF];
+
+		if (nLatency > s_Stats.nMaxLatencyMicros) {
+			s_Stats.nMaxLatencyMicros = nLatency;
+		}
+
+		s_Stats.nSent++;
+	}
+
+	s_nWireSeq = nSeq;
+	s_bIsWireSeq = true;
+	s_nWireLength = 0;
+}
+
+/*
+ * irq_timer1_dmx_sender
+ */
+static void Timer1(void) {
+	switch (s_State) {
+	case IDLE:
+	case DMXINTER:
+		s_nTimerC1 = s_nMicros + BREAK_MICROS;
+		s_nPreviousBreakMicros = s_nBreakMicros;
+		s_nBreakMicros = s_nMicros;
+
+		WireCheck();
+
+		if (s_bIsBuffered && dmx_send_buffer_swap(&s_Buffer)) {
+			const struct _dmx_send_frame *pFront = dmx_send_buffer_get_front(&s_Buffer);
+
+			s_pSendData = pFront->data;
+
+			if (pFront->length != s_nSendLength) {
+				SetLength(pFront->length);
+			}
+		}
+
+		s_State = BREAK;
+		break;
+	case BREAK:
+		s_nTimerC1 = s_nMicros + MAB_MICROS;
+		s_State = MAB;
+		break;
+	case MAB:
+		s_nTimerC1 = s_nBreakMicros + s_nPeriod;
+		s_nCurrentSlot = 0;
+		FifoFill();
+		s_State = (s_nCurrentSlot < s_nSendLength) ? DMXDATA : DMXINTER;
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * fiq_dmx_out_handler
+ */
+static void Fiq(void) {
+	FifoFill();
+
+	if (s_nCurrentSlot >= s_nSendLength) {
+		s_State = DMXINTER;
+	}
+}
+
+static void Uart(void) {
+	if (s_nFifoHead == s_nFifoTail) {
+		s_nShiftMicros = s_nMicros;
+		return;
+	}
+
+	if ((s_nMicros - s_nShiftMicros) < SLOT_MICROS) {
+		return;
+	}
+
+	s_nShiftMicros = s_nMicros;
+
+	const uint8_t nByte = s_Fifo[s_nFifoHead++ % FIFO_SIZE];
+
+	if (s_nWireLength < DMX_SEND_BUFFER_SIZE) {
+		s_Wire[s_nWireLength++] = nByte;
+	}
+}
+
+/*
+ * One microsecond, the interrupts preempt the writer
+ */
+static void Tick(void) {
+	s_nMicros++;
+
+	Uart();
+
+	if ((int32_t) (s_nMicros - s_nTimerC1) >= 0) {
+		Timer1();
+	}
+
+	if ((s_State == DMXDATA) && ((s_nFifoTail - s_nFifoHead) <= FIFO_TRIGGER)) {
+		Fiq();
+	}
+}
+
+static void Fill(uint8_t *pFrame, uint32_t nSeq, uint16_t nLength) {
+	uint8_t aSeq[4];
+	memcpy(aSeq, &nSeq, sizeof(uint32_t));
+
+	for (uint32_t i = 0; i < nLength; i++) {
+		if ((i % COPY_BYTES_PER_US) == 0) {
+			Tick();
+		}
+
+		if (i == 0) {
+			pFrame[i] = 0;
+		} else if (i < 5) {
+			pFrame[i] = aSeq[i - 1];
+		} else {
+			pFrame[i] = (uint8_t) (nSeq + i);
+		}
+	}
+}
+
+/*
+ * dmx_set_send_data, before and after the send buffer
+ */
+static void SetSendData(uint32_t nSeq, uint16_t nLength) {
+	if (s_bIsBuffered) {
+		Fill(dmx_send_buffer_get_back(&s_Buffer), nSeq, nLength);
+
+		s_nCommitMicros[nSeq & 0xFF] = s_nMicros;
+
+		if (dmx_send_buffer_commit(&s_Buffer, nLength)) {
+			s_Stats.nCoalesced++;
+		}
+	} else {
+		const uint32_t nStart = s_nMicros;
+
+		while ((s_State != IDLE) && (s_State != DMXINTER)) {
+			Tick();
+		}
+
+		const uint32_t nWait = s_nMicros - nStart;
+
+		s_Stats.nWaitMicros += nWait;
+
+		if (nWait > s_Stats.nMaxWaitMicros) {
+			s_Stats.nMaxWaitMicros = nWait;
+		}
+
+		// The sender can start this frame while it is written
+		s_nCommitMicros[nSeq & 0xFF] = s_nMicros;
+
+		Fill(s_BlockingFrame, nSeq, nLength);
+		SetLength(nLength);
+	}
+
+	s_Stats.nCommits++;
+}
+
+static void Reset(bool bIsBuffered) {
+	s_bIsBuffered = bIsBuffered;
+
+	dmx_send_buffer_init(&s_Buffer);
+	memset(s_BlockingFrame, 0, sizeof(s_BlockingFrame));
+	memset(&s_Stats, 0, sizeof(struct TStatistics));
+
+	s_nMicros = 0;
+	s_State = IDLE;
+	s_nTimerC1 = 0;
+	s_nBreakMicros = 0;
+	s_pSendData = bIsBuffered ? dmx_send_buffer_get_front(&s_Buffer)->data : s_BlockingFrame;
+	SetLength(1 + 512);
+
+	s_nFifoHead = 0;
+	s_nFifoTail = 0;
+	s_nWireLength = 0;
+	s_bIsWireSeq = false;
+}
+
+/*
+ * The writer commits a frame every nInterval us, as ArtNetNode::HandleDmx does for each ArtDmx.
+ */
+static bool run(const char *pName, bool bIsBuffered, uint32_t nInterval, uint16_t nLength) {
+	uint32_t nSeq = 1;
+	uint32_t nNext = 0;
+
+	Reset(bIsBuffered);
+
+	while (s_nMicros < SIMULATED_SECONDS * 1000000) {
+		if ((int32_t) (s_nMicros - nNext) >= 0) {
+			nNext += nInterval;
+			SetSendData(nSeq++, nLength);
+		} else {
+			Tick();
+		}
+	}
+
+	if (!bIsBuffered) {
+		// Overwritten in the single buffer before a BREAK
+		s_Stats.nCoalesced = s_Stats.nCommits - s_Stats.nSent;
+	}
+
+	printf("%-20s: %6u commits, %6u sent, %6u coalesced, writer waits %8u us (max %5u us), latency max %5u us, %u torn, %u out of order\n",
+			pName, s_Stats.nCommits, s_Stats.nSent, s_Stats.nCoalesced, s_Stats.nWaitMicros, s_Stats.nMaxWaitMicros,
+			s_Stats.nMaxLatencyMicros, s_Stats.nTorn, s_Stats.nOutOfOrder);
+
+	if (!bIsBuffered) {
+		return true;
+	}
+
+	// Nothing lost: every commit is sent or replaced by a newer one, apart from the last ones still on their way
+	const bool bIsAccounted = (s_Stats.nSent + s_Stats.nCoalesced + 2 >= s_Stats.nCommits) && (s_Stats.nSent + s_Stats.nCoalesced <= s_Stats.nCommits);
+
+	return (s_Stats.nTorn == 0) && (s_Stats.nOutOfOrder == 0) && bIsAccounted;
+}
+
+int main(void) {
+	bool bIsOk = true;
+
+	printf("%d simulated seconds\n", SIMULATED_SECONDS);
+
+	// Art-Net at 44 Hz, a full universe
+	(void) run("Blocking 44 Hz", false, 22727, 1 + 512);
+	bIsOk &= run("Buffered 44 Hz", true, 22727, 1 + 512);
+
+	// Faster than the DMX refresh, frames are coalesced
+	(void) run("Blocking 200 Hz", false, 5000, 1 + 512);
+	bIsOk &= run("Buffered 200 Hz", true, 5000, 1 + 512);
+
+	// Short frames, the DMX refresh is faster than the writer
+	bIsOk &= run("Buffered 32 slots", true, 22727, 1 + 32);
+
+	struct _dmx_send_buffer buffer;
+	dmx_send_buffer_init(&buffer);
+
+	const uint32_t nCommits = 10000000;
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (uint32_t i = 0; i < nCommits; i++) {
+		(void) dmx_send_buffer_commit(&buffer, 1 + 512);
+
+		if ((i & 0x3) == 0) {
+			(void) dmx_send_buffer_swap(&buffer);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	const double fNanos = ((double) (end.tv_sec - start.tv_sec) * 1E9 + (double) (end.tv_nsec - start.tv_nsec)) / nCommits;
+	printf("Commit              : %.1f ns\n", fNanos);
+
+	printf("%s\n", bIsOk ? "OK" : "FAILED");
+
+	return bIsOk ? 0 : 1;
+}
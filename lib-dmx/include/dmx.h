@@ -32,8 +32,6 @@
 #include "util.h"
 
 #define DMX_DATA_BUFFER_SIZE					516									///< including SC, aligned 4
-#define DMX_DATA_BUFFER_INDEX_ENTRIES			(1 << 1)							///<
-#define DMX_DATA_BUFFER_INDEX_MASK 				(DMX_DATA_BUFFER_INDEX_ENTRIES - 1)	///<
 
 #define DMX_TRANSMIT_BREAK_TIME_MIN				92		///< 92 us
 #define DMX_TRANSMIT_BREAK_TIME_TYPICAL			176		///< 176 us
@@ -56,6 +54,11 @@ typedef enum {
 	DMX_PORT_DIRECTION_INP = 2							///< DMX input
 } _dmx_port_direction;
 
+typedef enum {
+	DMX_RECEIVE_MODE_FIQ = 0,							///< A FIQ for each byte
+	DMX_RECEIVE_MODE_DMA = 1							///< The PL011 RX DMA fills a ring, a FIQ for each break
+} _dmx_receive_mode;
+
 struct _dmx_statistics {
 	uint32_t mark_after_break;							///<
 	uint32_t slots_in_packet;							///<
@@ -71,6 +74,9 @@ struct _dmx_data {
 struct _total_statistics {
 	uint32_t dmx_packets;								///<
 	uint32_t rdm_packets;								///<
+	uint32_t dmx_send_frames;							///< New frames put on the wire
+	uint32_t dmx_send_coalesced;						///< Frames replaced by a newer one before they were sent
+	uint32_t dmx_receive_dropped;						///< Frames received while the frame ring was full
 };
 
 #ifdef __cplusplus
@@ -85,6 +91,8 @@ extern void dmx_set_send_data_without_sc(const uint8_t *, const uint16_t);
 extern void dmx_clear_data(void);
 extern void dmx_set_port_direction(_dmx_port_direction, bool);
 extern const _dmx_port_direction dmx_get_port_direction(void);
+extern void dmx_set_receive_mode(_dmx_receive_mode);
+extern const _dmx_receive_mode dmx_get_receive_mode(void);
 extern void dmx_data_send(const uint8_t *, const uint16_t);
 extern /*@shared@*/const /*@null@*/uint8_t *dmx_get_available(void) ASSUME_ALIGNED;
 extern /*@shared@*/const uint8_t *dmx_get_current_data(void) ASSUME_ALIGNED;
@@ -142,6 +150,10 @@ public:
 		dmx_set_port_direction((_dmx_port_direction)tPortDirection, bEnableData);
 	}
 
+	inline void SetReceiveMode(_dmx_receive_mode tReceiveMode) {
+		dmx_set_receive_mode(tReceiveMode);
+	}
+
 public: // DMX
 	void Init(void);
 
@@ -0,0 +1,119 @@
+/**
+ * @file dmx_receive.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMX_RECEIVE_H_
+#define DMX_RECEIVE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmx.h"
+#include "rdm.h"
+
+#define DMX_RECEIVE_FRAMES			(1 << 3)					///< Depth of the frame ring
+#define DMX_RECEIVE_FRAMES_MASK		(DMX_RECEIVE_FRAMES - 1)	///<
+
+#define DMX_RECEIVE_DR_BE			((uint32_t)(1 << 10))		///< Break flag in a PL011 data register word
+#define DMX_RECEIVE_SLOT_TIME		44							///< us, 11 bits at 250 kbaud
+#define DMX_RECEIVE_BREAK_POLL		(2 * DMX_RECEIVE_SLOT_TIME)	///< us, from the break until the start code is in
+#define DMX_RECEIVE_IDLE_POLL		10000						///< us, must be well below the time to fill the DMA ring
+
+///< State of receiving DMX/RDM bytes, as returned by dmx_get_receive_state
+typedef enum {
+	DMX_RECEIVE_STATE_IDLE = 0,		///<
+	DMX_RECEIVE_STATE_BREAK,		///<
+	DMX_RECEIVE_STATE_MAB,			///< Not used, the MAB is not seen by the UART
+	DMX_RECEIVE_STATE_DMXDATA,		///<
+	DMX_RECEIVE_STATE_RDMDATA,		///<
+	DMX_RECEIVE_STATE_CHECKSUMH,	///<
+	DMX_RECEIVE_STATE_CHECKSUML,	///<
+	DMX_RECEIVE_STATE_RDMDISCFE,	///<
+	DMX_RECEIVE_STATE_RDMDISCEUID,	///<
+	DMX_RECEIVE_STATE_RDMDISCECS	///<
+} _dmx_receive_state;
+
+/**
+ * Assembles DMX frames and RDM messages from the bytes and breaks seen by the UART.
+ *
+ * Either call \ref dmx_receive_break and \ref dmx_receive_data for each interrupt (FIQ mode),
+ * or let a DMA fill a ring of data register words and call \ref dmx_receive_poll from a timer (DMA mode).
+ *
+ * Complete DMX frames go into a ring of \ref DMX_RECEIVE_FRAMES. When the reader does not keep up,
+ * the newest frame is dropped and counted, the frames already in the ring are never touched.
+ *
+ * There is no hardware access here, the time is passed in by the caller.
+ */
+struct _dmx_receive {
+	struct _dmx_data frame[DMX_RECEIVE_FRAMES];		///<
+	volatile uint32_t frame_head;					///< Written by the receiver
+	volatile uint32_t frame_tail;					///< Written by the reader
+	uint8_t rdm[RDM_DATA_BUFFER_INDEX_ENTRIES][RDM_DATA_BUFFER_SIZE];	///<
+	volatile uint32_t rdm_head;						///< Written by the receiver
+	volatile uint32_t rdm_tail;						///< Written by the reader
+	volatile uint32_t rdm_receive_end;				///< Time the last RDM message was complete
+	volatile uint32_t state;						///< \ref _dmx_receive_state
+	uint32_t index;									///< Next byte in the frame or message
+	uint16_t rdm_checksum;							///<
+	uint8_t rdm_disc_index;							///<
+	bool is_previous_break_dmx;						///< Is the previous break from a DMX packet?
+	uint32_t break_latest;							///<
+	uint32_t break_previous;						///<
+	uint32_t slot_micros;							///< Time of the last slot, or of the last poll in DMA mode
+	uint32_t slot_to_slot;							///< Latest estimate, used for the time-outs
+	bool is_slot_measured;							///< DMA mode, the current frame has its own estimate
+	uint32_t slots_expected;						///< Slots in the previous DMX frame
+	uint32_t ring_tail;								///< DMA mode, next word to consume
+	volatile struct _total_statistics *statistics;	///<
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void dmx_receive_init(struct _dmx_receive *, volatile struct _total_statistics *);
+extern void dmx_receive_clear(struct _dmx_receive *);
+extern void dmx_receive_stop(struct _dmx_receive *);
+
+extern void dmx_receive_break(struct _dmx_receive *, uint32_t);
+extern void dmx_receive_data(struct _dmx_receive *, uint8_t, uint32_t);
+extern bool dmx_receive_timeout(struct _dmx_receive *, uint32_t);
+extern uint32_t dmx_receive_poll(struct _dmx_receive *, const volatile uint32_t *, uint32_t, uint32_t, uint32_t, uint32_t);
+
+extern const uint8_t *dmx_receive_get_available(struct _dmx_receive *);
+extern const uint8_t *rdm_receive_get_available(struct _dmx_receive *);
+
+#ifdef __cplusplus
+}
+#endif
+
+static inline const uint8_t *dmx_receive_get_current(const struct _dmx_receive *rx) {
+	return rx->frame[rx->frame_tail].data;
+}
+
+static inline const uint8_t *rdm_receive_get_current(const struct _dmx_receive *rx) {
+	return rx->rdm[rx->rdm_tail];
+}
+
+#endif /* DMX_RECEIVE_H_ */
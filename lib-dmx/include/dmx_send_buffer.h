@@ -0,0 +1,85 @@
+/**
+ * @file dmx_send_buffer.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMX_SEND_BUFFER_H_
+#define DMX_SEND_BUFFER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DMX_SEND_BUFFER_SIZE		516			///< SC + 512 slots, aligned 4
+#define DMX_SEND_BUFFER_ENTRIES		3			///< Back, ready and front
+#define DMX_SEND_BUFFER_INDEX_MASK	0x03		///<
+#define DMX_SEND_BUFFER_NEW			0x80		///< Set in \ref _dmx_send_buffer.ready when it holds a frame not sent yet
+
+struct _dmx_send_frame {
+	uint8_t data[DMX_SEND_BUFFER_SIZE];			///<
+	uint16_t length;							///< Including the start code
+};
+
+/**
+ * Hands frames from the main loop to the DMX sender interrupt without either side waiting.
+ *
+ * The writer fills the back frame and commits it by exchanging it with the ready frame.
+ * At every BREAK the sender takes the ready frame as its front frame, when a new one is there.
+ * The front frame is never written, so the FIQ can keep streaming it while the writer
+ * commits as often as it likes. A ready frame that is replaced before it is sent is coalesced.
+ *
+ * There is no hardware access here, so it runs unchanged on Linux against a simulated UART/timer.
+ */
+struct _dmx_send_buffer {
+	struct _dmx_send_frame frame[DMX_SEND_BUFFER_ENTRIES];	///<
+	uint32_t back;								///< Owned by the writer
+	volatile uint32_t ready;					///< Shared, only changed with an atomic exchange
+	uint32_t front;								///< Owned by the sender interrupt
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void dmx_send_buffer_init(struct _dmx_send_buffer *);
+extern void dmx_send_buffer_clear(struct _dmx_send_buffer *);
+extern bool dmx_send_buffer_commit(struct _dmx_send_buffer *, uint16_t);
+extern bool dmx_send_buffer_swap(struct _dmx_send_buffer *);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @ingroup dmx
+ *
+ * @return The frame to fill before calling \ref dmx_send_buffer_commit
+ */
+static inline uint8_t *dmx_send_buffer_get_back(struct _dmx_send_buffer *buffer) {
+	return buffer->frame[buffer->back].data;
+}
+
+static inline const struct _dmx_send_frame *dmx_send_buffer_get_front(const struct _dmx_send_buffer *buffer) {
+	return &buffer->frame[buffer->front];
+}
+
+#endif /* DMX_SEND_BUFFER_H_ */
@@ -1,8 +1,9 @@
 /**
  * @file dmx.c
  *
- * @brief This file implements the DMX512/RDM receive state-machine. It
- * uses the Fast Interrupt Request (FIQ) for accurate timing.
+ * @brief This file implements the DMX512/RDM receive and send drivers.
+ * Receiving uses the Fast Interrupt Request (FIQ) for each byte, or the PL011 RX DMA
+ * with a FIQ for each break only. The frames are assembled in dmx_receive.c.
  * The Interrupt Request (IRQ) is used for sending DMX data.
  *
  */
@@ -41,13 +42,37 @@
 #include "bcm2835_st.h"
 #include "bcm2835_gpio.h"
 #include "bcm2835_vc.h"
+#include "bcm2835_spi_dma.h"
 
 #include "gpio.h"
 #include "util.h"
 #include "dmx.h"
+#include "dmx_send_buffer.h"
+#include "dmx_receive.h"
 #include "rdm.h"
 
-#include "../../lib-rdm/include/rdm_e120.h"
+#if DMX_SEND_BUFFER_SIZE != DMX_DATA_BUFFER_SIZE
+ #error DMX_SEND_BUFFER_SIZE != DMX_DATA_BUFFER_SIZE
+#endif
+
+#define DMX_DMA_CHANNEL			2											///< Not used by the firmware
+#define DMX_DMA					((BCM2835_DMA_TypeDef *) (BCM2835_DMA0_BASE + (DMX_DMA_CHANNEL * 0x100)))
+#define DMX_DMA_RING_ENTRIES	(1 << 10)									///< 45 ms of slots
+#define DMX_DMA_RING_MASK		(DMX_DMA_RING_ENTRIES - 1)					///<
+#define DMX_DMA_RING			((volatile uint32_t *) (MEM_COHERENT_REGION + 0x80000))	///< Uncached, written by the DMA only
+
+#define BUS_ADDRESS_MEM(p)		((uint32_t) (p) | GPU_MEM_BASE)
+#define BUS_ADDRESS_PL011_DR	(GPU_IO_BASE + (BCM2835_PL011_BASE - BCM2835_PERI_BASE))
+
+struct TDmaControlBlock {
+	uint32_t nTransferInformation;
+	uint32_t nSourceAddress;
+	uint32_t nDestinationAddress;
+	uint32_t nTransferLength;
+	uint32_t n2DModeStride;
+	uint32_t nNextControlBlockAddress;
+	uint32_t nReserved[2];
+};
 
 #ifdef NDEBUG
 #undef NDEBUG
@@ -55,7 +80,7 @@
 
 #include <assert.h>
 
-///< State of receiving DMX/RDM Bytes
+///< State of sending DMX
 typedef enum {
 	IDLE = 0,	///<
 	BREAK,		///<
@@ -72,36 +97,26 @@ typedef enum {
 
 static uint8_t dmx_data_direction_gpio_pin = GPIO_DMX_DATA_DIRECTION;			///<
 
-static volatile uint16_t dmx_data_buffer_index_head = (uint16_t) 0;				///<
-static volatile uint16_t dmx_data_buffer_index_tail = (uint16_t) 0;				///<
-static struct _dmx_data dmx_data[DMX_DATA_BUFFER_INDEX_ENTRIES] ALIGNED;		///<
+static struct _dmx_receive dmx_receive ALIGNED;									///< Frames and RDM messages received
+static _dmx_receive_mode dmx_receive_mode = DMX_RECEIVE_MODE_FIQ;				///<
+static volatile uint32_t dmx_dma_break_micros = (uint32_t) 0;					///< Timestamp of the latest break FIQ, DMA mode
+static struct TDmaControlBlock dmx_dma_control_block __attribute__((aligned(32)));	///< Links to itself
+static bool dmx_dma_is_running = false;											///<
 static uint8_t dmx_data_previous[DMX_DATA_BUFFER_SIZE] ALIGNED;					///<
-static uint8_t dmx_receive_state = IDLE;										///< Current state of DMX receive
-static volatile uint16_t dmx_data_index = (uint16_t) 0;							///<
 static uint32_t dmx_output_break_time = (uint32_t) DMX_TRANSMIT_BREAK_TIME_MIN;	///<
 static uint32_t dmx_output_mab_time = (uint32_t) DMX_TRANSMIT_MAB_TIME_MIN;		///<
 static uint32_t dmx_output_period = DMX_TRANSMIT_PERIOD_DEFAULT;				///<
 static uint32_t dmx_output_period_requested = DMX_TRANSMIT_PERIOD_DEFAULT;		///<
 static uint16_t dmx_send_data_length = (uint16_t) DMX_UNIVERSE_SIZE + 1;		///< SC + UNIVERSE SIZE
 static uint8_t dmx_port_direction = DMX_PORT_DIRECTION_INP;						///<
-static volatile uint32_t dmx_fiq_micros_current = (uint32_t) 0;					///< Timestamp FIQ
-static volatile uint32_t dmx_fiq_micros_previous = (uint32_t) 0;				///< Timestamp previous FIQ
-static volatile bool dmx_is_previous_break_dmx = false;							///< Is the previous break from a DMX packet?
-static volatile uint32_t dmx_break_to_break_latest = (uint32_t) 0;				///<
-static volatile uint32_t dmx_break_to_break_previous = (uint32_t) 0;			///<
 static volatile uint32_t dmx_slots_in_packet_previous = (uint32_t) 0;			///<
 static volatile uint8_t dmx_send_state = IDLE;									///<
 static volatile bool dmx_send_always = false;									///<
 //static volatile uint32_t dmx_irq_micros = 0;									///<
 static volatile uint32_t dmx_send_break_micros = (uint32_t) 0;					///<
 static volatile uint16_t dmx_send_current_slot = (uint16_t) 0;					///<
-
-static volatile uint16_t rdm_data_buffer_index_head = (uint16_t) 0;				///<
-static volatile uint16_t rdm_data_buffer_index_tail = (uint16_t) 0;				///<
-static uint8_t rdm_data_buffer[RDM_DATA_BUFFER_INDEX_ENTRIES][RDM_DATA_BUFFER_SIZE] ALIGNED;///<
-static volatile uint16_t rdm_checksum = (uint16_t) 0;							///<
-static volatile uint32_t rdm_data_receive_end = (uint32_t) 0;					///<
-static volatile uint8_t rdm_disc_index = (uint8_t) 0;							///<
+static struct _dmx_send_buffer dmx_send_buffer ALIGNED;							///< Frames from dmx_set_send_data to the sender
+static const uint8_t *dmx_send_data = dmx_send_buffer.frame[0].data;			///< The front frame, being transmitted
 
 static volatile uint32_t dmx_updates_per_seconde= (uint32_t) 0;					///<
 static uint32_t dmx_packets_previous = (uint32_t) 0;							///<
@@ -155,12 +170,11 @@ static void dmx_set_send_data_length(uint16_t send_data_length) {
  * @param length
  */
 void dmx_set_send_data(const uint8_t *data, const uint16_t length) {
-	do {
-		dmb();
-	} while (dmx_send_state != IDLE && dmx_send_state != DMXINTER);
+	(void *)memcpy(dmx_send_buffer_get_back(&dmx_send_buffer), data, (size_t)length);
 
-	(void *)memcpy(dmx_data[0].data, data, (size_t)length);
-	dmx_set_send_data_length(length);
+	if (dmx_send_buffer_commit(&dmx_send_buffer, length)) {
+		total_statistics.dmx_send_coalesced = total_statistics.dmx_send_coalesced + 1;
+	}
 }
 
 /**
@@ -169,13 +183,14 @@ void dmx_set_send_data(const uint8_t *data, const uint16_t length) {
  * @param length
  */
 void dmx_set_send_data_without_sc(const uint8_t *data, const uint16_t length) {
-	do {
-		dmb();
-	} while (dmx_send_state != IDLE && dmx_send_state != DMXINTER);
+	uint8_t *back = dmx_send_buffer_get_back(&dmx_send_buffer);
+
+	back[0] = DMX512_START_CODE;
+	(void *) memcpy(&back[1], data, (size_t) length);
 
-	dmx_data[0].data[0] = DMX512_START_CODE;
-	(void *) memcpy(&dmx_data[0].data[1], data, (size_t) length);
-	dmx_set_send_data_length(length + 1);
+	if (dmx_send_buffer_commit(&dmx_send_buffer, length + 1)) {
+		total_statistics.dmx_send_coalesced = total_statistics.dmx_send_coalesced + 1;
+	}
 }
 
 /**
@@ -183,12 +198,8 @@ void dmx_set_send_data_without_sc(const uint8_t *data, const uint16_t length) {
  *
  */
 void dmx_clear_data(void) {
-	uint32_t i = sizeof(dmx_data) / sizeof(uint32_t);
-	uint32_t *p = (uint32_t *)dmx_data;
-
-	while (i-- != (uint32_t) 0) {
-		*p++ = (uint32_t) 0;
-	}
+	dmx_receive_clear(&dmx_receive);
+	dmx_send_buffer_clear(&dmx_send_buffer);
 }
 
 /**
@@ -215,13 +226,8 @@ const uint16_t dmx_get_send_data_length(void) {
  * @return
  */
 const uint8_t *rdm_get_available(void)  {
-	if (rdm_data_buffer_index_head == rdm_data_buffer_index_tail) {
-		return NULL;
-	} else {
-		const uint8_t *p = &rdm_data_buffer[rdm_data_buffer_index_tail][0];
-		rdm_data_buffer_index_tail = (rdm_data_buffer_index_tail + 1) & RDM_DATA_BUFFER_INDEX_MASK;
-		return p;
-	}
+	dmb();
+	return rdm_receive_get_available(&dmx_receive);
 }
 
 /**
@@ -230,7 +236,7 @@ const uint8_t *rdm_get_available(void)  {
  * @return
  */
 const uint8_t *rdm_get_current_data(void) {
-	return &rdm_data_buffer[rdm_data_buffer_index_tail][0];
+	return rdm_receive_get_current(&dmx_receive);
 }
 
 /**
@@ -240,13 +246,7 @@ const uint8_t *rdm_get_current_data(void) {
  */
 const uint8_t *dmx_get_available(void)  {
 	dmb();
-	if (dmx_data_buffer_index_head == dmx_data_buffer_index_tail) {
-		return NULL;
-	} else {
-		const uint8_t *p = dmx_data[dmx_data_buffer_index_tail].data;
-		dmx_data_buffer_index_tail = (dmx_data_buffer_index_tail + 1) & DMX_DATA_BUFFER_INDEX_MASK;
-		return p;
-	}
+	return dmx_receive_get_available(&dmx_receive);
 }
 
 /**
@@ -255,7 +255,7 @@ const uint8_t *dmx_get_available(void)  {
  * @return
  */
 const uint8_t *dmx_get_current_data(void) {
-	return dmx_data[dmx_data_buffer_index_tail].data;
+	return dmx_receive_get_current(&dmx_receive);
 }
 
 /**
@@ -265,7 +265,30 @@ const uint8_t *dmx_get_current_data(void) {
  */
 const volatile uint8_t dmx_get_receive_state(void) {
 	dmb();
-	return dmx_receive_state;
+	return (uint8_t) dmx_receive.state;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * Takes effect the next time the input is started with \ref dmx_set_port_direction.
+ * The DMA mode has one FIQ for each break instead of one for each byte. Received RDM
+ * messages are seen up to a slot time later and discovery responses, which have no break,
+ * up to \ref DMX_RECEIVE_IDLE_POLL later, so a controller doing discovery uses the FIQ mode.
+ *
+ * @param receive_mode
+ */
+void dmx_set_receive_mode(_dmx_receive_mode receive_mode) {
+	dmx_receive_mode = receive_mode;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * @return
+ */
+const _dmx_receive_mode dmx_get_receive_mode(void) {
+	return dmx_receive_mode;
 }
 
 /**
@@ -326,7 +349,7 @@ const _dmx_port_direction dmx_get_port_direction(void) {
  * @return
  */
 const uint32_t rdm_get_data_receive_end(void) {
-	return rdm_data_receive_end;
+	return dmx_receive.rdm_receive_end;
 }
 
 /**
@@ -376,6 +399,9 @@ void dmx_set_output_mab_time(const uint32_t mab_time) {
 void dmx_reset_total_statistics(void) {
 	total_statistics.dmx_packets = (uint32_t) 0;
 	total_statistics.rdm_packets = (uint32_t) 0;
+	total_statistics.dmx_send_frames = (uint32_t) 0;
+	total_statistics.dmx_send_coalesced = (uint32_t) 0;
+	total_statistics.dmx_receive_dropped = (uint32_t) 0;
 }
 
 /**
@@ -387,10 +413,31 @@ const volatile struct _total_statistics *dmx_get_total_statistics(void) {
 	return &total_statistics;
 }
 
+#ifdef LOGIC_ANALYZER
+static void logic_analyzer_receive_state(void) {
+	switch (dmx_receive.state) {
+	case DMX_RECEIVE_STATE_BREAK:
+		bcm2835_gpio_set(GPIO_ANALYZER_CH2);	// BREAK
+		bcm2835_gpio_clr(GPIO_ANALYZER_CH3);	// DMX DATA
+		bcm2835_gpio_clr(GPIO_ANALYZER_CH4);	// IDLE
+		break;
+	case DMX_RECEIVE_STATE_IDLE:
+		bcm2835_gpio_clr(GPIO_ANALYZER_CH2);	// BREAK
+		bcm2835_gpio_clr(GPIO_ANALYZER_CH3);	// DMX DATA
+		bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
+		break;
+	default:
+		bcm2835_gpio_clr(GPIO_ANALYZER_CH2);	// BREAK
+		bcm2835_gpio_set(GPIO_ANALYZER_CH3);	// DMX DATA
+		break;
+	}
+}
+#endif
+
 /**
  * @ingroup dmx
  *
- * Interrupt handler for continues receiving DMX512 data.
+ * Interrupt handler for continues receiving DMX512 data, a FIQ for each byte.
  *
  */
 static void __attribute__((interrupt("FIQ"))) fiq_dmx_in_handler(void) {
@@ -400,166 +447,68 @@ static void __attribute__((interrupt("FIQ"))) fiq_dmx_in_handler(void) {
 	bcm2835_gpio_set(GPIO_ANALYZER_CH1);
 #endif
 
-	dmx_fiq_micros_current = BCM2835_ST->CLO;
-
+	const uint32_t clo = BCM2835_ST->CLO;
 	const uint32_t dr = BCM2835_PL011->DR;
 
 	if (dr & PL011_DR_BE) {
-		dmx_receive_state = BREAK;
-		dmx_break_to_break_latest = dmx_fiq_micros_current;
-#ifdef LOGIC_ANALYZER
-		bcm2835_gpio_set(GPIO_ANALYZER_CH2);	// BREAK
-		bcm2835_gpio_clr(GPIO_ANALYZER_CH4);	// IDLE
-#endif
+		dmx_receive_break(&dmx_receive, clo);
 	} else {
-		const uint8_t data = dr & 0xFF;
-
-		switch (dmx_receive_state) {
-		case IDLE:
-			if (data == 0xFE) {
-				dmx_receive_state = RDMDISCFE;
-				rdm_data_buffer[rdm_data_buffer_index_head][0] = 0xFE;
-				dmx_data_index = 1;
-			}
-			break;
-		case BREAK:
-			switch (data) {
-			case DMX512_START_CODE:
-				dmx_receive_state = DMXDATA;
-				dmx_data[dmx_data_buffer_index_head].data[0] = DMX512_START_CODE;
-				dmx_data_index = 1;
-				total_statistics.dmx_packets = total_statistics.dmx_packets + 1;
-				if (dmx_is_previous_break_dmx) {
-					dmx_data[dmx_data_buffer_index_head].statistics.break_to_break = dmx_break_to_break_latest - dmx_break_to_break_previous;
-					dmx_break_to_break_previous = dmx_break_to_break_latest;
-
-				} else {
-					dmx_is_previous_break_dmx = true;
-					dmx_break_to_break_previous = dmx_break_to_break_latest;
-				}
-#ifdef LOGIC_ANALYZER
-				bcm2835_gpio_clr(GPIO_ANALYZER_CH2);	// BREAK
-			    bcm2835_gpio_set(GPIO_ANALYZER_CH3);	// DMX DATA
-#endif
-				break;
-			case E120_SC_RDM:
-				dmx_receive_state = RDMDATA;
-				rdm_data_buffer[rdm_data_buffer_index_head][0] = E120_SC_RDM;
-				rdm_checksum = E120_SC_RDM;
-				dmx_data_index = 1;
-				total_statistics.rdm_packets = total_statistics.rdm_packets + 1;
-				dmx_is_previous_break_dmx = false;
-#ifdef LOGIC_ANALYZER
-				bcm2835_gpio_clr(GPIO_ANALYZER_CH2);	// BREAK
-			    bcm2835_gpio_set(GPIO_ANALYZER_CH3);	// DMX DATA
-#endif
-				break;
-			default:
-				dmx_receive_state = IDLE;
-				dmx_is_previous_break_dmx = false;
-#ifdef LOGIC_ANALYZER
-				bcm2835_gpio_clr(GPIO_ANALYZER_CH2);	// BREAK
-				bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
-#endif
-				break;
-			}
-			break;
-		case DMXDATA:
-			dmx_data[dmx_data_buffer_index_head].statistics.slot_to_slot = dmx_fiq_micros_current - dmx_fiq_micros_previous;
-			if (dmx_data[dmx_data_buffer_index_head].statistics.slot_to_slot < 44) { // Broadcom BUG ? FIQ is late
-				dmx_data[dmx_data_buffer_index_head].statistics.slot_to_slot = (uint32_t)44;
-			}
-			dmx_data[dmx_data_buffer_index_head].data[dmx_data_index++] = data;
-		    BCM2835_ST->C1 = dmx_fiq_micros_current + dmx_data[0].statistics.slot_to_slot + (uint32_t)12;
-			if (dmx_data_index > DMX_UNIVERSE_SIZE) {
-				dmx_receive_state = IDLE;
-				dmx_data[dmx_data_buffer_index_head].statistics.slots_in_packet = DMX_UNIVERSE_SIZE;
-				dmx_data_buffer_index_head = (dmx_data_buffer_index_head + 1) & DMX_DATA_BUFFER_INDEX_MASK;
-#ifdef LOGIC_ANALYZER
-				bcm2835_gpio_clr(GPIO_ANALYZER_CH3);	// DMX DATA
-				bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
-#endif
-			}
-			break;
-		case RDMDATA:
-			if (dmx_data_index > RDM_DATA_BUFFER_SIZE) {
-				dmx_receive_state = IDLE;
+		const bool is_data = (dmx_receive.state == DMX_RECEIVE_STATE_DMXDATA);
+
+		dmx_receive_data(&dmx_receive, (uint8_t) (dr & 0xFF), clo);
+
+		if (is_data && (dmx_receive.state == DMX_RECEIVE_STATE_DMXDATA)) {
+			BCM2835_ST->C1 = clo + dmx_receive.slot_to_slot + (uint32_t) 12;
+		}
+	}
+
 #ifdef LOGIC_ANALYZER
-				bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
+	logic_analyzer_receive_state();
+	bcm2835_gpio_clr(GPIO_ANALYZER_CH1);
 #endif
-			} else {
-				rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = data;
-				rdm_checksum += data;
-
-				const struct _rdm_command *p = (struct _rdm_command *)(&rdm_data_buffer[rdm_data_buffer_index_head][0]);
-				if (dmx_data_index == p->message_length) {
-					dmx_receive_state = CHECKSUMH;
-				}
-			}
-			break;
-		case CHECKSUMH:
-			rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] =	data;
-			rdm_checksum -= data << 8;
-			dmx_receive_state = CHECKSUML;
-			break;
-		case CHECKSUML:
-			rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = data;
-			rdm_checksum -= data;
-			const struct _rdm_command *p = (struct _rdm_command *)(&rdm_data_buffer[rdm_data_buffer_index_head][0]);
-			if ((rdm_checksum == 0) && (p->sub_start_code == E120_SC_SUB_MESSAGE)) {
-				rdm_data_buffer_index_head = (rdm_data_buffer_index_head + 1) & RDM_DATA_BUFFER_INDEX_MASK;
-				rdm_data_receive_end = BCM2835_ST->CLO;
-			}
-			dmx_receive_state = IDLE;
+
+	dmb();
+}
+
+/**
+ * Timer 1 interrupt DMX Receiver
+ * Slot time-out
+ */
+static void irq_timer1_dmx_receive(const uint32_t clo) {
+	dmb();
+	if (dmx_receive.state == DMX_RECEIVE_STATE_DMXDATA) {
+		if (!dmx_receive_timeout(&dmx_receive, clo)) {
+			BCM2835_ST->C1 = clo + dmx_receive.slot_to_slot;
+		}
 #ifdef LOGIC_ANALYZER
-			bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
+		logic_analyzer_receive_state();
 #endif
-			break;
-		case RDMDISCFE:
-			switch (data) {
-			case 0xFE:
-				rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = 0xFE;
-				break;
-			case 0xAA:
-				rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = 0xAA;
-				dmx_receive_state = RDMDISCEUID;
-				rdm_disc_index = 0;
-				break;
-			default:
-				rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = data;
-				break;
-			}
-			if (dmx_data_index == 9 ) {
-				dmx_receive_state = RDMDISCEUID;
-				rdm_disc_index = 0;
-			}
-			break;
-		case RDMDISCEUID:
-			rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = data;
-			rdm_disc_index++;
-			if (rdm_disc_index == 2 * RDM_UID_SIZE) {
-				dmx_receive_state = RDMDISCECS;
-				rdm_disc_index = 0;
-			}
-			break;
-		case RDMDISCECS:
-			rdm_data_buffer[rdm_data_buffer_index_head][dmx_data_index++] = data;
-			rdm_disc_index++;
-			if (rdm_disc_index == 4) {
-				rdm_data_buffer_index_head = (rdm_data_buffer_index_head + 1) & RDM_DATA_BUFFER_INDEX_MASK;
-				dmx_receive_state = IDLE;
-				rdm_data_receive_end = BCM2835_ST->CLO;
+	}
+	dmb();
+}
+
+/**
+ * @ingroup dmx
+ *
+ * DMA mode, the only PL011 interrupt is the break. The frame boundary is handled by the
+ * next poll of \ref irq_timer1_dmx_receive_dma, which is brought forward to just after the start code.
+ *
+ */
+static void __attribute__((interrupt("FIQ"))) fiq_dmx_in_dma_handler(void) {
+	dmb();
+
 #ifdef LOGIC_ANALYZER
-				bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
+	bcm2835_gpio_set(GPIO_ANALYZER_CH1);
 #endif
-			}
-			break;
-		default:
-			break;
-		}
+
+	const uint32_t clo = BCM2835_ST->CLO;
+
+	if (BCM2835_PL011->MIS & PL011_MIS_BEMIS) {
+		dmx_dma_break_micros = clo;
+		BCM2835_ST->C1 = clo + (uint32_t) DMX_RECEIVE_BREAK_POLL;
 	}
 
-	dmx_fiq_micros_previous = dmx_fiq_micros_current;
+	BCM2835_PL011->ICR = PL011_ICR_BEIC;
 
 #ifdef LOGIC_ANALYZER
 	bcm2835_gpio_clr(GPIO_ANALYZER_CH1);
@@ -569,25 +518,24 @@ static void __attribute__((interrupt("FIQ"))) fiq_dmx_in_handler(void) {
 }
 
 /**
- * Timer 1 interrupt DMX Receiver
- * Slot time-out
+ * Timer 1 interrupt DMX Receiver, DMA mode
+ * Consumes the ring, a few times for each frame
  */
-static void irq_timer1_dmx_receive(const uint32_t clo) {
+static void irq_timer1_dmx_receive_dma(const uint32_t clo) {
+	__disable_fiq();
 	dmb();
-	if (dmx_receive_state == DMXDATA) {
-		if (clo - dmx_fiq_micros_current > dmx_data[0].statistics.slot_to_slot) {
-			dmb();
-			dmx_receive_state = IDLE;
-			dmx_data[dmx_data_buffer_index_head].statistics.slots_in_packet = dmx_data_index - 1;
-			dmx_data_buffer_index_head = (dmx_data_buffer_index_head + 1) & DMX_DATA_BUFFER_INDEX_MASK;
+
+	const uint32_t head = ((DMX_DMA->DEST_AD - BUS_ADDRESS_MEM(DMX_DMA_RING)) / sizeof(uint32_t)) & DMX_DMA_RING_MASK;
+	const uint32_t next = dmx_receive_poll(&dmx_receive, DMX_DMA_RING, DMX_DMA_RING_MASK, head, dmx_dma_break_micros, clo);
+
+	BCM2835_ST->C1 = clo + next;
+
 #ifdef LOGIC_ANALYZER
-			bcm2835_gpio_clr(GPIO_ANALYZER_CH3);	// DMX DATA
-			bcm2835_gpio_set(GPIO_ANALYZER_CH4);	// IDLE
+	logic_analyzer_receive_state();
 #endif
-		} else {
-			BCM2835_ST->C1 = clo + dmx_data[dmx_data_buffer_index_head].statistics.slot_to_slot;
-		}
-	}
+
+	dmb();
+	__enable_fiq();
 }
 
 /**
@@ -611,6 +559,19 @@ static void irq_timer1_dmx_sender(const uint32_t clo) {
 		BCM2835_ST->C1 = clo + dmx_output_break_time;
 		BCM2835_PL011->LCRH = PL011_LCRH_WLEN8 | PL011_LCRH_STP2 | PL011_LCRH_FEN | PL011_LCRH_BRK;
 		dmx_send_break_micros = clo;
+
+		if (dmx_send_buffer_swap(&dmx_send_buffer)) {
+			const struct _dmx_send_frame *front = dmx_send_buffer_get_front(&dmx_send_buffer);
+
+			dmx_send_data = front->data;
+
+			if (front->length != dmx_send_data_length) {
+				dmx_set_send_data_length(front->length);
+			}
+
+			total_statistics.dmx_send_frames = total_statistics.dmx_send_frames + 1;
+		}
+
 		dmb();
 		dmx_send_state = BREAK;
 		break;
@@ -628,7 +589,7 @@ static void irq_timer1_dmx_sender(const uint32_t clo) {
 				break;
 			}
 
-			BCM2835_PL011->DR = dmx_data[0].data[dmx_send_current_slot];
+			BCM2835_PL011->DR = dmx_send_data[dmx_send_current_slot];
 		}
 
 		if (dmx_send_current_slot < dmx_send_data_length) {
@@ -665,7 +626,7 @@ void __attribute__((interrupt("FIQ"))) fiq_dmx_out_handler(void) {
 				break;
 			}
 
-			BCM2835_PL011->DR = dmx_data[0].data[dmx_send_current_slot];
+			BCM2835_PL011->DR = dmx_send_data[dmx_send_current_slot];
 		}
 
 		if (dmx_send_current_slot >= dmx_send_data_length) {
@@ -700,6 +661,80 @@ static void pl011_disable_fifo(void) {
 	dmb();
 }
 
+static void pl011_enable_rx_dma(void) {
+	dmb();
+	BCM2835_PL011->CR = (uint32_t) 0;
+	BCM2835_PL011->ICR = 0x7FF;
+	BCM2835_PL011->LCRH = PL011_LCRH_WLEN8 | PL011_LCRH_STP2 | PL011_LCRH_FEN;	// The FIFO covers the DMA latency
+	BCM2835_PL011->IMSC = PL011_IMSC_BEIM;
+	BCM2835_PL011->DMACR = PL011_DMACR_RXDMAE;
+	BCM2835_PL011->CR = PL011_CR_TXE | PL011_CR_RXE | PL011_CR_UARTEN;
+	dmb();
+}
+
+static void pl011_disable_rx_dma(void) {
+	dmb();
+	BCM2835_PL011->DMACR = (uint32_t) 0;
+	BCM2835_PL011->IMSC = BCM2835_PL011->IMSC & ~PL011_IMSC_BEIM;
+	BCM2835_PL011->ICR = PL011_ICR_BEIC;
+	dmb();
+}
+
+static void dmx_dma_reset(void) {
+	DMX_DMA->CS = BCM2835_DMA_CS_RESET;
+
+	while (DMX_DMA->CS & BCM2835_DMA_CS_RESET)
+		;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * A single control block, linked to itself, copies every PL011 data register word
+ * (data and the error flags) into a ring. Only the DMA writes the ring, so there is no
+ * cache maintenance on the ring and the ARM only follows the DMA destination address.
+ */
+static void dmx_dma_start(void) {
+	uint32_t i;
+
+	for (i = 0; i < DMX_DMA_RING_ENTRIES; i++) {
+		DMX_DMA_RING[i] = 0;
+	}
+
+	dmx_dma_control_block.nTransferInformation = BCM2835_DMA_TI_PERMAP(BCM2835_DMA_DREQ_UART_RX) | BCM2835_DMA_TI_SRC_DREQ | BCM2835_DMA_TI_DEST_INC | BCM2835_DMA_TI_WAIT_RESP;
+	dmx_dma_control_block.nSourceAddress = BUS_ADDRESS_PL011_DR;
+	dmx_dma_control_block.nDestinationAddress = BUS_ADDRESS_MEM(DMX_DMA_RING);
+	dmx_dma_control_block.nTransferLength = DMX_DMA_RING_ENTRIES * sizeof(uint32_t);
+	dmx_dma_control_block.n2DModeStride = 0;
+	dmx_dma_control_block.nNextControlBlockAddress = BUS_ADDRESS_MEM(&dmx_dma_control_block);
+
+	clean_data_cache();
+	dmb();
+
+	BCM2835_DMA_ENABLE |= (1 << DMX_DMA_CHANNEL);
+	dmx_dma_reset();
+
+	dmx_receive.ring_tail = 0;
+
+	DMX_DMA->CONBLK_AD = BUS_ADDRESS_MEM(&dmx_dma_control_block);
+	DMX_DMA->CS = BCM2835_DMA_CS_WAIT_WRITES | BCM2835_DMA_CS_ACTIVE;
+
+	dmx_dma_is_running = true;
+	dmb();
+}
+
+static void dmx_dma_stop(void) {
+	if (!dmx_dma_is_running) {
+		return;
+	}
+
+	pl011_disable_rx_dma();
+	dmx_dma_reset();
+
+	dmx_dma_is_running = false;
+	dmb();
+}
+
 /**
  * @ingroup dmx
  *
@@ -732,14 +767,27 @@ static void dmx_start_data(void) {
 		break;
 	case DMX_PORT_DIRECTION_INP:
 		dmb();
-		dmx_receive_state = IDLE;
+		dmx_receive_stop(&dmx_receive);
 
-		pl011_disable_fifo();
+		if (dmx_receive_mode == DMX_RECEIVE_MODE_DMA) {
+			dmx_dma_stop();
+			dmx_dma_start();
+			pl011_enable_rx_dma();
 
-		irq_timer_set(IRQ_TIMER_1, irq_timer1_dmx_receive);
-		dmb();
+			irq_timer_set(IRQ_TIMER_1, irq_timer1_dmx_receive_dma);
+			BCM2835_ST->C1 = BCM2835_ST->CLO + (uint32_t) DMX_RECEIVE_IDLE_POLL;
+			dmb();
+
+			arm_install_handler((unsigned)fiq_dmx_in_dma_handler, ARM_VECTOR(ARM_VECTOR_FIQ));
+		} else {
+			pl011_disable_fifo();
+
+			irq_timer_set(IRQ_TIMER_1, irq_timer1_dmx_receive);
+			dmb();
+
+			arm_install_handler((unsigned)fiq_dmx_in_handler, ARM_VECTOR(ARM_VECTOR_FIQ));
+		}
 
-		arm_install_handler((unsigned)fiq_dmx_in_handler, ARM_VECTOR(ARM_VECTOR_FIQ));
 		__enable_fiq();
 		dmb();
 		break;
@@ -749,8 +797,6 @@ static void dmx_start_data(void) {
 }
 
 static void dmx_stop_data(void) {
-	int i;
-
 	do {
 		dmb();
 		if (dmx_send_state == DMXINTER) {
@@ -770,12 +816,10 @@ static void dmx_stop_data(void) {
 
 	__disable_fiq();
 
-	dmb();
-	dmx_receive_state = IDLE;
+	dmx_dma_stop();
 
-	for (i = 0; i < DMX_DATA_BUFFER_INDEX_ENTRIES; i++) {
-		dmx_data[i].statistics.slots_in_packet = 0;
-	}
+	dmb();
+	dmx_receive_stop(&dmx_receive);
 }
 
 void dmx_set_port_direction(_dmx_port_direction port_direction, bool enable_data) {
@@ -871,15 +915,10 @@ void dmx_init(void) {
 	bcm2835_gpio_clr(GPIO_ANALYZER_CH5);	// IRQ
 #endif
 
-	dmx_clear_data();
-
-	dmx_data_buffer_index_head = (uint16_t) 0;
-	dmx_data_buffer_index_tail = (uint16_t) 0;
-
-	rdm_data_buffer_index_head = (uint16_t) 0;
-	rdm_data_buffer_index_tail = (uint16_t) 0;
+	dmx_send_buffer_init(&dmx_send_buffer);
+	dmx_send_data = dmx_send_buffer_get_front(&dmx_send_buffer)->data;
 
-	dmx_receive_state = IDLE;
+	dmx_receive_init(&dmx_receive, &total_statistics);
 
 	dmx_send_state = IDLE;
 	dmx_send_always = false;
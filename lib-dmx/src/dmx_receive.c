@@ -0,0 +1,421 @@
+/**
+ * @file dmx_receive.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "dmx_receive.h"
+#include "dmx.h"
+#include "rdm.h"
+
+#include "../../lib-rdm/include/rdm_e120.h"
+
+#define DMX_RECEIVE_DUB_SIZE	24	///< 7 x 0xFE, 0xAA, EUID and ECS
+
+static void frame_publish(struct _dmx_receive *rx, uint32_t slots) {
+	const uint32_t next = (rx->frame_head + 1) & DMX_RECEIVE_FRAMES_MASK;
+
+	rx->frame[rx->frame_head].statistics.slots_in_packet = slots;
+	rx->slots_expected = slots;
+	rx->state = DMX_RECEIVE_STATE_IDLE;
+
+	if (next == rx->frame_tail) {
+		rx->statistics->dmx_receive_dropped = rx->statistics->dmx_receive_dropped + 1;
+		return;
+	}
+
+	__sync_synchronize();
+	rx->frame_head = next;
+}
+
+static void rdm_publish(struct _dmx_receive *rx, uint32_t micros) {
+	__sync_synchronize();
+	rx->rdm_head = (rx->rdm_head + 1) & RDM_DATA_BUFFER_INDEX_MASK;
+	rx->rdm_receive_end = micros;
+	rx->state = DMX_RECEIVE_STATE_IDLE;
+}
+
+static void receive_byte(struct _dmx_receive *rx, uint8_t data, uint32_t micros) {
+	uint8_t *rdm = rx->rdm[rx->rdm_head];
+	struct _dmx_data *frame = &rx->frame[rx->frame_head];
+
+	switch (rx->state) {
+	case DMX_RECEIVE_STATE_IDLE:
+		if (data == 0xFE) {
+			rx->state = DMX_RECEIVE_STATE_RDMDISCFE;
+			rdm[0] = 0xFE;
+			rx->index = 1;
+		}
+		break;
+	case DMX_RECEIVE_STATE_BREAK:
+		switch (data) {
+		case DMX512_START_CODE:
+			rx->state = DMX_RECEIVE_STATE_DMXDATA;
+			frame->data[0] = DMX512_START_CODE;
+			frame->statistics.slot_to_slot = rx->slot_to_slot;
+			rx->index = 1;
+			rx->slot_micros = micros;
+			rx->is_slot_measured = false;
+			rx->statistics->dmx_packets = rx->statistics->dmx_packets + 1;
+			if (rx->is_previous_break_dmx) {
+				frame->statistics.break_to_break = rx->break_latest - rx->break_previous;
+			} else {
+				rx->is_previous_break_dmx = true;
+			}
+			rx->break_previous = rx->break_latest;
+			break;
+		case E120_SC_RDM:
+			rx->state = DMX_RECEIVE_STATE_RDMDATA;
+			rdm[0] = E120_SC_RDM;
+			rx->rdm_checksum = E120_SC_RDM;
+			rx->index = 1;
+			rx->statistics->rdm_packets = rx->statistics->rdm_packets + 1;
+			rx->is_previous_break_dmx = false;
+			break;
+		default:
+			rx->state = DMX_RECEIVE_STATE_IDLE;
+			rx->is_previous_break_dmx = false;
+			break;
+		}
+		break;
+	case DMX_RECEIVE_STATE_DMXDATA:
+		frame->data[rx->index++] = data;
+		if (rx->index > DMX_UNIVERSE_SIZE) {
+			frame_publish(rx, DMX_UNIVERSE_SIZE);
+		}
+		break;
+	case DMX_RECEIVE_STATE_RDMDATA:
+		if (rx->index > RDM_DATA_BUFFER_SIZE) {
+			rx->state = DMX_RECEIVE_STATE_IDLE;
+		} else {
+			rdm[rx->index++] = data;
+			rx->rdm_checksum += data;
+
+			const struct _rdm_command *p = (struct _rdm_command *) rdm;
+			if (rx->index == p->message_length) {
+				rx->state = DMX_RECEIVE_STATE_CHECKSUMH;
+			}
+		}
+		break;
+	case DMX_RECEIVE_STATE_CHECKSUMH:
+		rdm[rx->index++] = data;
+		rx->rdm_checksum -= data << 8;
+		rx->state = DMX_RECEIVE_STATE_CHECKSUML;
+		break;
+	case DMX_RECEIVE_STATE_CHECKSUML: {
+		rdm[rx->index++] = data;
+		rx->rdm_checksum -= data;
+		const struct _rdm_command *p = (struct _rdm_command *) rdm;
+		if ((rx->rdm_checksum == 0) && (p->sub_start_code == E120_SC_SUB_MESSAGE)) {
+			rdm_publish(rx, micros);
+		}
+		rx->state = DMX_RECEIVE_STATE_IDLE;
+		}
+		break;
+	case DMX_RECEIVE_STATE_RDMDISCFE:
+		rdm[rx->index++] = data;
+		if ((data == 0xAA) || (rx->index == 9)) {
+			rx->state = DMX_RECEIVE_STATE_RDMDISCEUID;
+			rx->rdm_disc_index = 0;
+		}
+		break;
+	case DMX_RECEIVE_STATE_RDMDISCEUID:
+		rdm[rx->index++] = data;
+		rx->rdm_disc_index++;
+		if (rx->rdm_disc_index == 2 * RDM_UID_SIZE) {
+			rx->state = DMX_RECEIVE_STATE_RDMDISCECS;
+			rx->rdm_disc_index = 0;
+		}
+		break;
+	case DMX_RECEIVE_STATE_RDMDISCECS:
+		rdm[rx->index++] = data;
+		rx->rdm_disc_index++;
+		if (rx->rdm_disc_index == 4) {
+			rdm_publish(rx, micros);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @ingroup dmx
+ *
+ * @param statistics The packet and drop counters are kept here
+ */
+void dmx_receive_init(struct _dmx_receive *rx, volatile struct _total_statistics *statistics) {
+	dmx_receive_clear(rx);
+
+	rx->frame_head = 0;
+	rx->frame_tail = 0;
+	rx->rdm_head = 0;
+	rx->rdm_tail = 0;
+	rx->rdm_receive_end = 0;
+	rx->state = DMX_RECEIVE_STATE_IDLE;
+	rx->index = 0;
+	rx->rdm_checksum = 0;
+	rx->rdm_disc_index = 0;
+	rx->is_previous_break_dmx = false;
+	rx->break_latest = 0;
+	rx->break_previous = 0;
+	rx->slot_micros = 0;
+	rx->slot_to_slot = DMX_RECEIVE_SLOT_TIME;
+	rx->is_slot_measured = false;
+	rx->slots_expected = DMX_UNIVERSE_SIZE;
+	rx->ring_tail = 0;
+	rx->statistics = statistics;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * All the frames become zeros, including the statistics.
+ */
+void dmx_receive_clear(struct _dmx_receive *rx) {
+	const uint32_t size = (uint32_t) sizeof(rx->frame);
+	uint32_t i = size / sizeof(uint32_t);
+	uint32_t *p = (uint32_t *) rx->frame;
+
+	while (i-- != (uint32_t) 0) {
+		*p++ = (uint32_t) 0;
+	}
+}
+
+/**
+ * @ingroup dmx
+ *
+ * Drops a frame or message being received. The frames already in the ring stay there.
+ */
+void dmx_receive_stop(struct _dmx_receive *rx) {
+	uint32_t i;
+
+	rx->state = DMX_RECEIVE_STATE_IDLE;
+	rx->is_previous_break_dmx = false;
+
+	for (i = 0; i < DMX_RECEIVE_FRAMES; i++) {
+		rx->frame[i].statistics.slots_in_packet = 0;
+	}
+}
+
+/**
+ * @ingroup dmx
+ *
+ * A DMX frame still open is complete with the slots received so far.
+ *
+ * @param micros Time of the break
+ */
+void dmx_receive_break(struct _dmx_receive *rx, uint32_t micros) {
+	if (rx->state == DMX_RECEIVE_STATE_DMXDATA) {
+		frame_publish(rx, rx->index - 1);
+	}
+
+	rx->state = DMX_RECEIVE_STATE_BREAK;
+	rx->break_latest = micros;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * FIQ mode, one received byte.
+ *
+ * @param micros Time the byte was received
+ */
+void dmx_receive_data(struct _dmx_receive *rx, uint8_t data, uint32_t micros) {
+	if (rx->state == DMX_RECEIVE_STATE_DMXDATA) {
+		uint32_t slot_to_slot = micros - rx->slot_micros;
+
+		if (slot_to_slot < DMX_RECEIVE_SLOT_TIME) { // Broadcom BUG ? FIQ is late
+			slot_to_slot = DMX_RECEIVE_SLOT_TIME;
+		}
+
+		rx->frame[rx->frame_head].statistics.slot_to_slot = slot_to_slot;
+		rx->slot_to_slot = slot_to_slot;
+		rx->slot_micros = micros;
+	}
+
+	receive_byte(rx, data, micros);
+}
+
+/**
+ * @ingroup dmx
+ *
+ * FIQ mode. A DMX frame is complete when no slot came in for more than a slot time.
+ *
+ * @return true when a frame was completed
+ */
+bool dmx_receive_timeout(struct _dmx_receive *rx, uint32_t micros) {
+	if ((rx->state == DMX_RECEIVE_STATE_DMXDATA) && (micros - rx->slot_micros > rx->slot_to_slot)) {
+		frame_publish(rx, rx->index - 1);
+		return true;
+	}
+
+	return false;
+}
+
+static uint32_t slots_remaining(const struct _dmx_receive *rx) {
+	const struct _rdm_command *p = (const struct _rdm_command *) rx->rdm[rx->rdm_head];
+	uint32_t end;
+
+	switch (rx->state) {
+	case DMX_RECEIVE_STATE_DMXDATA:
+		end = rx->slots_expected + 1;
+		if (rx->index > end) {	// Longer than the previous frame
+			end = DMX_UNIVERSE_SIZE + 1;
+		}
+		break;
+	case DMX_RECEIVE_STATE_RDMDATA:
+	case DMX_RECEIVE_STATE_CHECKSUMH:
+	case DMX_RECEIVE_STATE_CHECKSUML:
+		end = (rx->index > 2 ? p->message_length : RDM_MESSAGE_MINIMUM_SIZE) + RDM_MESSAGE_CHECKSUM_SIZE;
+		break;
+	case DMX_RECEIVE_STATE_RDMDISCFE:
+	case DMX_RECEIVE_STATE_RDMDISCEUID:
+	case DMX_RECEIVE_STATE_RDMDISCECS:
+		end = DMX_RECEIVE_DUB_SIZE;
+		break;
+	default:
+		return 0;
+	}
+
+	return end > rx->index ? end - rx->index : 1;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * DMA mode. Consumes the data register words the DMA wrote into the ring since the previous poll.
+ * A word with the break flag is a break at \p break_micros, the time the break interrupt was seen.
+ * A DMX frame is complete when a poll finds no new words. The slot to slot time of a frame
+ * is the shortest average over its polls, the average is too long when the frame ended before the poll.
+ *
+ * @param ring Words as read from the PL011 data register
+ * @param ring_mask Ring size - 1, the size is a power of 2
+ * @param head Next word the DMA will write
+ * @param break_micros Time of the latest break
+ * @param micros Now
+ * @return The time in us until the next poll
+ */
+uint32_t dmx_receive_poll(struct _dmx_receive *rx, const volatile uint32_t *ring, uint32_t ring_mask, uint32_t head, uint32_t break_micros, uint32_t micros) {
+	const bool is_data = (rx->state == DMX_RECEIVE_STATE_DMXDATA);
+	const uint32_t frame_head = rx->frame_head;
+	const uint32_t index = rx->index;
+	const uint32_t slot_micros = rx->slot_micros;
+	const bool is_slot_measured = rx->is_slot_measured;
+	uint32_t tail = rx->ring_tail;
+
+	if (tail == head) {
+		if (is_data) {
+			frame_publish(rx, rx->index - 1);
+		}
+	} else {
+		do {
+			const uint32_t dr = ring[tail];
+
+			if (dr & DMX_RECEIVE_DR_BE) {
+				dmx_receive_break(rx, break_micros);
+			} else {
+				receive_byte(rx, (uint8_t) dr, micros);
+			}
+
+			tail = (tail + 1) & ring_mask;
+		} while (tail != head);
+
+		rx->ring_tail = tail;
+
+		if (is_data) {
+			struct _dmx_statistics *statistics = &rx->frame[frame_head].statistics;
+			const bool is_open = (rx->state == DMX_RECEIVE_STATE_DMXDATA) && (rx->frame_head == frame_head);
+
+			// A frame ended by a break also counts the idle line and the break
+			const uint32_t end = is_open ? rx->index : DMX_UNIVERSE_SIZE + 1;
+
+			if ((is_open || (statistics->slots_in_packet == DMX_UNIVERSE_SIZE)) && (end > index)) {
+				uint32_t slot_to_slot = (micros - slot_micros) / (end - index);
+
+				if (slot_to_slot < DMX_RECEIVE_SLOT_TIME) {
+					slot_to_slot = DMX_RECEIVE_SLOT_TIME;
+				}
+
+				if (!is_slot_measured || (slot_to_slot < statistics->slot_to_slot)) {
+					statistics->slot_to_slot = slot_to_slot;
+				}
+
+				if (is_open) {
+					rx->is_slot_measured = true;
+				}
+
+				rx->slot_to_slot = statistics->slot_to_slot;
+			}
+		}
+	}
+
+	switch (rx->state) {
+	case DMX_RECEIVE_STATE_IDLE:
+		return DMX_RECEIVE_IDLE_POLL;
+	case DMX_RECEIVE_STATE_BREAK:
+		return DMX_RECEIVE_BREAK_POLL;
+	case DMX_RECEIVE_STATE_DMXDATA: {
+		const uint32_t remaining = slots_remaining(rx);
+		rx->slot_micros = micros;
+		return (remaining < 2 ? 2 : remaining) * rx->slot_to_slot;
+		}
+	default:
+		return slots_remaining(rx) * DMX_RECEIVE_SLOT_TIME;
+	}
+}
+
+/**
+ * @ingroup dmx
+ *
+ * @return The oldest frame not read yet, NULL when there is none
+ */
+const uint8_t *dmx_receive_get_available(struct _dmx_receive *rx) {
+	if (rx->frame_head == rx->frame_tail) {
+		return NULL;
+	}
+
+	const uint8_t *p = rx->frame[rx->frame_tail].data;
+	rx->frame_tail = (rx->frame_tail + 1) & DMX_RECEIVE_FRAMES_MASK;
+
+	return p;
+}
+
+/**
+ * @ingroup rdm
+ *
+ * @return The oldest message not read yet, NULL when there is none
+ */
+const uint8_t *rdm_receive_get_available(struct _dmx_receive *rx) {
+	if (rx->rdm_head == rx->rdm_tail) {
+		return NULL;
+	}
+
+	const uint8_t *p = rx->rdm[rx->rdm_tail];
+	rx->rdm_tail = (rx->rdm_tail + 1) & RDM_DATA_BUFFER_INDEX_MASK;
+
+	return p;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file dmx_send_buffer.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmx_send_buffer.h"
+
+/**
+ * @ingroup dmx
+ *
+ */
+void dmx_send_buffer_init(struct _dmx_send_buffer *buffer) {
+	dmx_send_buffer_clear(buffer);
+
+	buffer->back = 0;
+	buffer->ready = 1;
+	buffer->front = 2;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * All the frames become a full universe of zeros.
+ */
+void dmx_send_buffer_clear(struct _dmx_send_buffer *buffer) {
+	uint32_t i;
+
+	for (i = 0; i < DMX_SEND_BUFFER_ENTRIES; i++) {
+		uint32_t j = DMX_SEND_BUFFER_SIZE / sizeof(uint32_t);
+		uint32_t *p = (uint32_t *) buffer->frame[i].data;
+
+		while (j-- != (uint32_t) 0) {
+			*p++ = (uint32_t) 0;
+		}
+
+		buffer->frame[i].length = 1 + 512;	// SC + full universe
+	}
+}
+
+/**
+ * @ingroup dmx
+ *
+ * Writer side. Publishes the back frame; the previous ready frame becomes the new back frame.
+ *
+ * @param length Number of bytes written to the back frame, including the start code
+ * @return true when the previous ready frame was not sent yet, and is now coalesced
+ */
+bool dmx_send_buffer_commit(struct _dmx_send_buffer *buffer, uint16_t length) {
+	buffer->frame[buffer->back].length = length;
+
+	const uint32_t previous = __atomic_exchange_n(&buffer->ready, buffer->back | DMX_SEND_BUFFER_NEW, __ATOMIC_ACQ_REL);
+
+	buffer->back = previous & DMX_SEND_BUFFER_INDEX_MASK;
+
+	return (previous & DMX_SEND_BUFFER_NEW) == DMX_SEND_BUFFER_NEW;
+}
+
+/**
+ * @ingroup dmx
+ *
+ * Sender side, called at the start of a BREAK. The exchange is atomic as well,
+ * so that an exclusive store of an interrupted writer fails and is retried.
+ *
+ * @return true when there is a new front frame
+ */
+bool dmx_send_buffer_swap(struct _dmx_send_buffer *buffer) {
+	if ((buffer->ready & DMX_SEND_BUFFER_NEW) == 0) {
+		return false;
+	}
+
+	const uint32_t ready = __atomic_exchange_n(&buffer->ready, buffer->front, __ATOMIC_ACQ_REL);
+
+	buffer->front = ready & DMX_SEND_BUFFER_INDEX_MASK;
+
+	return true;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file capture_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "dmxcapture.h"
+#include "dmxreplay.h"
+#include "dmxmonitor.h"
+
+#include "lightset.h"
+
+#define FRAMES		10000
+#define PORTS		2
+#define FILE_NAME	"capture_benchmark.dmx"
+
+/*
+ * A show: 24 moving lights on 16 slots each, and the rest static.
+ */
+static void show(uint32_t nFrame, uint8_t nPort, uint8_t *pData) {
+	for (uint16_t i = 0; i < 512; i++) {
+		pData[i] = (uint8_t) (i + nPort);
+	}
+
+	for (uint16_t nFixture = 0; nFixture < 24; nFixture++) {
+		uint8_t *p = &pData[nFixture * 16 + 64];
+		p[0] = (uint8_t) (nFrame + nFixture);			// pan
+		p[2] = (uint8_t) ((nFrame >> 1) + nFixture);	// tilt
+		p[5] = (uint8_t) (nFrame / 8);					// dimmer
+	}
+}
+
+/*
+ * Compares each replayed frame with the show.
+ */
+class LightSetCheck: public LightSet {
+public:
+	LightSetCheck(void) : m_nFrames(0), m_nSyncs(0), m_nErrors(0) {
+	}
+
+	void Start(void) {
+	}
+
+	void Stop(void) {
+	}
+
+	void SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+		uint8_t aExpected[512];
+
+		show(m_nFrames / PORTS, nPort, aExpected);
+
+		if ((nPort != (m_nFrames % PORTS)) || (nLength != 512) || (memcmp(pData, aExpected, 512) != 0) || (m_nIpAddress != 0x0102A8C0)) {
+			m_nErrors++;
+		}
+
+		m_nFrames++;
+	}
+
+	void Sync(void) {
+		m_nSyncs++;
+	}
+
+	void SetSource(uint32_t nIpAddress, uint16_t nOpCode) {
+		m_nIpAddress = nIpAddress;
+	}
+
+	uint32_t m_nFrames;
+	uint32_t m_nSyncs;
+	uint32_t m_nErrors;
+	uint32_t m_nIpAddress;
+};
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static long file_size(const char *pFileName) {
+	struct stat st;
+	return stat(pFileName, &st) == 0 ? (long) st.st_size : -1;
+}
+
+static void capture(bool bChangesOnly) {
+	DMXCapture capture;
+	uint8_t aData[512];
+
+	if (!capture.Open(FILE_NAME, bChangesOnly)) {
+		return;
+	}
+
+	const double fStart = now();
+
+	for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+		capture.SetSource(0x0102A8C0, 0x5000);
+		for (uint8_t nPort = 0; nPort < PORTS; nPort++) {
+			show(nFrame, nPort, aData);
+			capture.Write(nPort, aData, 512);
+		}
+		capture.WriteSync();
+	}
+
+	capture.Close();
+
+	const double fSeconds = now() - fStart;
+
+	printf("Capture %-8s : %8.0f frames/s, %8ld bytes\n", bChangesOnly ? "changes" : "full", (FRAMES * PORTS) / fSeconds, file_size(FILE_NAME));
+}
+
+static void replay(void) {
+	LightSetCheck check;
+	DMXReplay replay;
+
+	if (!replay.Open(FILE_NAME)) {
+		return;
+	}
+
+	replay.SetOutput(&check);
+	replay.SetRealTime(false);
+
+	const double fStart = now();
+
+	while (replay.Run()) {
+	}
+
+	const double fSeconds = now() - fStart;
+
+	printf("Replay fast      : %8.0f frames/s, %u frames, %u syncs, %s\n", check.m_nFrames / fSeconds, (unsigned) check.m_nFrames, (unsigned) check.m_nSyncs,
+			((check.m_nErrors == 0) && (check.m_nFrames == FRAMES * PORTS) && (check.m_nSyncs == FRAMES)) ? "OK" : "FAILED");
+}
+
+int main(int argc, char **argv) {
+	uint8_t aData[512];
+
+	// The monitor output with all the slots, into a file
+	fflush(stdout);
+	const int nStdout = dup(1);
+	const int nText = open(FILE_NAME, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if ((nStdout >= 0) && (nText >= 0)) {
+		DMXMonitor monitor;
+		monitor.SetMaxDmxChannels(512);
+
+		(void) dup2(nText, 1);
+
+		const double fStart = now();
+
+		for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+			for (uint8_t nPort = 0; nPort < PORTS; nPort++) {
+				show(nFrame, nPort, aData);
+				monitor.SetData(nPort, aData, 512);
+			}
+		}
+
+		fflush(stdout);
+		const double fSeconds = now() - fStart;
+
+		(void) dup2(nStdout, 1);
+		(void) close(nText);
+		(void) close(nStdout);
+
+		printf("Print            : %8.0f frames/s, %8ld bytes\n", (FRAMES * PORTS) / fSeconds, file_size(FILE_NAME));
+	}
+
+	capture(false);
+	replay();
+
+	capture(true);
+	replay();
+
+	(void) remove(FILE_NAME);
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file dmxreplay.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dmxreplay.h"
+#include "dmxmonitor.h"
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+	DMXMonitor monitor;
+	DMXReplay replay;
+
+	if (argc < 2) {
+		printf("Usage: %s capture_file [max_dmx_channels] [fast]\n", argv[0]);
+		return -1;
+	}
+
+	if (argc >= 3) {
+		uint16_t max_channels = atoi(argv[2]);
+		if (max_channels > 512) {
+			max_channels = 512;
+		}
+		monitor.SetMaxDmxChannels(max_channels);
+	}
+
+	if (!replay.Open(argv[1])) {
+		return -1;
+	}
+
+	replay.SetOutput(&monitor);
+	replay.SetRealTime(!((argc == 4) && (strcmp(argv[3], "fast") == 0)));
+
+	const double fStart = now();
+
+	while (replay.Run()) {
+	}
+
+	const double fSeconds = now() - fStart;
+
+	fprintf(stderr, "%u records, captured in %.3f s, replayed in %.3f s\n", (unsigned) replay.GetRecords(), (double) replay.GetCaptureMicros() / 1e6, fSeconds);
+
+	replay.Close();
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file render_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "dmxmonitorgrid.h"
+
+#include "glyph.h"
+#include "console.h"
+
+#define WIDTH		800
+#define HEIGHT		480
+#define FRAMES		2000
+#define COLUMN		4		///< As in DMXMonitor
+#define ROW			4
+
+extern "C" unsigned char FONT[];
+
+static uint32_t aFrameBuffer[2][(WIDTH * HEIGHT) / 2];
+static uint8_t aData[512];
+
+/*
+ * The rendering before DMXMonitorGrid: all the slots every frame,
+ * one pixel at a time through a volatile pointer.
+ */
+static void draw_char_pixel(uint8_t *fb, int c, int x, int y, uint16_t fore, uint16_t back) {
+	unsigned char *p = FONT + (c * GLYPH_H);
+
+	x *= GLYPH_W;
+	y *= GLYPH_H;
+
+	for (int i = 0; i < GLYPH_H; i++) {
+		uint8_t line = *p++;
+		for (int j = x; j < (GLYPH_W + x); j++) {
+			volatile uint16_t *address = (volatile uint16_t *) (fb + (j * 2) + (y * WIDTH * 2));
+			*address = ((line & 0x1) != 0) ? fore : back;
+			line >>= 1;
+		}
+		y++;
+	}
+}
+
+#define TO_HEX(i)	((i) < 10) ? (int)'0' + (i) : (int)'A' + ((i) - 10)
+
+static void update_pixel(uint8_t *fb, const uint8_t *pData, uint16_t nSlots) {
+	for (uint16_t nSlot = 0; nSlot < 512; nSlot++) {
+		const int x = COLUMN + (nSlot % 32) * 3;
+		const int y = ROW + (nSlot / 32);
+
+		if (nSlot >= nSlots) {
+			draw_char_pixel(fb, ' ', x, y, CONSOLE_WHITE, CONSOLE_BLACK);
+			draw_char_pixel(fb, ' ', x + 1, y, CONSOLE_WHITE, CONSOLE_BLACK);
+		} else if (pData[nSlot] == 0) {
+			draw_char_pixel(fb, ' ', x, y, CONSOLE_WHITE, CONSOLE_BLACK);
+			draw_char_pixel(fb, '0', x + 1, y, CONSOLE_WHITE, CONSOLE_BLACK);
+		} else {
+			const uint8_t d = pData[nSlot];
+			const uint16_t fore = (uint16_t) (d > 92 ? CONSOLE_BLACK : CONSOLE_WHITE);
+			draw_char_pixel(fb, TO_HEX(d >> 4), x, y, fore, RGB(d, d, d));
+			draw_char_pixel(fb, TO_HEX(d & 0x0F), x + 1, y, fore, RGB(d, d, d));
+		}
+
+		draw_char_pixel(fb, ' ', x + 2, y, CONSOLE_WHITE, CONSOLE_BLACK);
+	}
+}
+
+/*
+ * Every nStep-th slot changes each frame, nStep = 1 is the full universe.
+ */
+static void churn(uint32_t nFrame, uint16_t nStep) {
+	for (uint16_t i = (uint16_t) (nFrame % nStep); i < 512; i = (uint16_t) (i + nStep)) {
+		aData[i] = (uint8_t) (aData[i] + 1 + (i & 0x7));
+	}
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static void report(const char *pName, double fSeconds, uint32_t nCells) {
+	printf("%-20s: %8.0f frames/s, %3u cells/frame\n", pName, FRAMES / fSeconds, (unsigned) (nCells / FRAMES));
+}
+
+int main(int argc, char **argv) {
+	struct glyph_surface surface;
+
+	surface.address = aFrameBuffer[0];
+	surface.width = WIDTH;
+	surface.height = HEIGHT;
+
+	DMXMonitorGrid grid;
+	grid.SetSurface(&surface);
+	grid.SetOrigin(COLUMN, ROW);
+
+	// The same pixels as the old rendering, for full and partial packets
+	bool bIsOk = true;
+
+	for (uint32_t nFrame = 0; nFrame < 64; nFrame++) {
+		const uint16_t nSlots = (nFrame & 0x4) ? 512 : (uint16_t) (24 + nFrame * 7);
+		churn(nFrame, (uint16_t) (1 + (nFrame & 0x3)));
+		aData[nFrame] = 0;
+		(void) grid.Update(aData, nSlots);
+		update_pixel((uint8_t *) aFrameBuffer[1], aData, nSlots);
+		if (memcmp(aFrameBuffer[0], aFrameBuffer[1], sizeof(aFrameBuffer[0])) != 0) {
+			bIsOk = false;
+		}
+	}
+
+	printf("Compare with pixel rendering : %s\n", bIsOk ? "OK" : "FAILED");
+
+	double fStart = now();
+	for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+		churn(nFrame, 1);
+		update_pixel((uint8_t *) aFrameBuffer[1], aData, 512);
+	}
+	report("Pixel, all slots", now() - fStart, FRAMES * 512);
+
+	const uint16_t aStep[] = { 1, 8, 64, 512 };
+	const char *aName[] = { "Grid, all changed", "Grid, 1/8 changed", "Grid, 1/64 changed", "Grid, 1 changed" };
+
+	for (unsigned s = 0; s < sizeof(aStep) / sizeof(aStep[0]); s++) {
+		uint32_t nCells = 0;
+		fStart = now();
+		for (uint32_t nFrame = 0; nFrame < FRAMES; nFrame++) {
+			churn(nFrame, aStep[s]);
+			nCells += grid.Update(aData, 512);
+		}
+		report(aName[s], now() - fStart, nCells);
+	}
+
+	return bIsOk ? 0 : 1;
+}
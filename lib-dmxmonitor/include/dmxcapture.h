@@ -0,0 +1,114 @@
+/**
+ * @file dmxcapture.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXCAPTURE_H_
+#define DMXCAPTURE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * The capture file is a TDmxCaptureHeader followed by records. A record is a TDmxCaptureRecord followed by nBytes of data.
+ * The fields are little endian.
+ *
+ * DMXCAPTURE_TYPE_FULL    : the nLength slots.
+ * DMXCAPTURE_TYPE_CHANGES : runs of the slots that changed since the previous frame of the port,
+ *                           each run is the offset (2 bytes), the count (2 bytes) and the count slots.
+ *                           nBytes is 0 when nothing has changed.
+ * DMXCAPTURE_TYPE_SYNC    : no data, nPort is 0.
+ *
+ * The first frame of a port, and a frame with a new length, is always DMXCAPTURE_TYPE_FULL.
+ */
+
+#define DMXCAPTURE_MAGIC		"DMXCAP1"	///< Including the '\0'
+#define DMXCAPTURE_MAX_PORTS	8
+#define DMXCAPTURE_MAX_SLOTS	512
+
+enum TDmxCaptureType {
+	DMXCAPTURE_TYPE_FULL = 0,
+	DMXCAPTURE_TYPE_CHANGES = 1,
+	DMXCAPTURE_TYPE_SYNC = 2
+};
+
+struct TDmxCaptureHeader {
+	char aMagic[8];			///< \ref DMXCAPTURE_MAGIC
+	uint64_t nStartMicros;	///< Wall clock of the start, microseconds since the Epoch
+} __attribute__((packed));
+
+struct TDmxCaptureRecord {
+	uint32_t nDeltaMicros;	///< Since the previous record, or the start
+	uint32_t nIpAddress;	///< Source, as received
+	uint16_t nOpCode;		///< Art-Net OpCode or E1.31 framing layer vector
+	uint8_t nPort;
+	uint8_t nType;			///< \ref TDmxCaptureType
+	uint16_t nLength;		///< Slots in the frame
+	uint16_t nBytes;		///< Data after the record
+} __attribute__((packed));
+
+class DMXCapture {
+public:
+	DMXCapture(void);
+	~DMXCapture(void);
+
+	bool Open(const char *pFileName, bool bChangesOnly = true);
+	void Close(void);
+
+	inline bool IsOpen(void) const {
+		return m_pFile != 0;
+	}
+
+	void SetSource(uint32_t nIpAddress, uint16_t nOpCode);
+
+	void Write(uint8_t nPort, const uint8_t *pData, uint16_t nLength);
+	void WriteSync(void);
+
+	inline uint32_t GetRecords(void) const {
+		return m_nRecords;
+	}
+
+	inline uint64_t GetBytes(void) const {
+		return m_nBytes;
+	}
+
+private:
+	uint16_t EncodeChanges(uint8_t nPort, const uint8_t *pData, uint16_t nLength);
+	void WriteRecord(uint8_t nPort, uint8_t nType, uint16_t nLength, const uint8_t *pData, uint16_t nBytes);
+
+private:
+	FILE *m_pFile;
+	bool m_bChangesOnly;
+	uint64_t m_nMicrosPrevious;
+	uint64_t m_nMicrosFlush;
+	uint32_t m_nIpAddress;
+	uint16_t m_nOpCode;
+	uint32_t m_nRecords;
+	uint64_t m_nBytes;
+	uint16_t m_aLength[DMXCAPTURE_MAX_PORTS];	///< 0 is no previous frame
+	uint8_t m_aData[DMXCAPTURE_MAX_PORTS][DMXCAPTURE_MAX_SLOTS];
+	uint8_t m_aChanges[DMXCAPTURE_MAX_SLOTS + 4];
+};
+
+#endif /* DMXCAPTURE_H_ */
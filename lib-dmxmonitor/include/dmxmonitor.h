@@ -31,6 +31,12 @@
 
 #include "lightset.h"
 
+#if defined (__linux__) || defined (__CYGWIN__)
+ #include "dmxcapture.h"
+#else
+ #include "dmxmonitorgrid.h"
+#endif
+
 class DMXMonitor: public LightSet {
 public:
 	DMXMonitor(void);
@@ -52,8 +58,14 @@ public:
 #endif
 
 #if defined (__linux__) || defined (__CYGWIN__)
+	void Sync(void);
+	void SetSource(uint32_t nIpAddress, uint16_t nOpCode);
+
 	void SetMaxDmxChannels(uint16_t);
 
+	// Capture mode, the frames are written to pCapture instead of printed
+	void SetCapture(DMXCapture *pCapture);
+
 private:
 	void DisplayDateTime(const char *);
 #endif
@@ -67,6 +79,9 @@ private:
 #if defined (__linux__) || defined (__CYGWIN__)
 	uint16_t m_nDmxStartAddress;
 	uint16_t m_nMaxChannels;
+	DMXCapture *m_pCapture;
+#else
+	DMXMonitorGrid m_Grid;
 #endif
 	uint8_t m_Data[512];
 };
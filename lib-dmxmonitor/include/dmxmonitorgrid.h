@@ -0,0 +1,62 @@
+/**
+ * @file dmxmonitorgrid.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXMONITORGRID_H_
+#define DMXMONITORGRID_H_
+
+#include <stdint.h>
+
+#include "glyph.h"
+
+#define DMXMONITORGRID_COLUMNS	32
+#define DMXMONITORGRID_ROWS		16
+#define DMXMONITORGRID_SLOTS	(DMXMONITORGRID_COLUMNS * DMXMONITORGRID_ROWS)
+
+/**
+ * The 512 slots as 16 rows of 32 hex cells. A cell is only drawn again when its value has changed.
+ */
+class DMXMonitorGrid {
+public:
+	DMXMonitorGrid(void);
+	~DMXMonitorGrid(void);
+
+	void SetSurface(const struct glyph_surface *pSurface);
+	void SetOrigin(uint8_t nColumn, uint8_t nRow);
+
+	void Invalidate(void);
+
+	uint16_t Update(const uint8_t *pData, uint16_t nSlots);
+
+private:
+	void DrawCell(uint16_t nSlot, uint16_t nValue);
+
+private:
+	struct glyph_surface m_Surface;
+	uint8_t m_nColumn;
+	uint8_t m_nRow;
+	uint16_t m_aShadow[DMXMONITORGRID_SLOTS];
+};
+
+#endif /* DMXMONITORGRID_H_ */
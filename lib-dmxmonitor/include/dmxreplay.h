@@ -0,0 +1,85 @@
+/**
+ * @file dmxreplay.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXREPLAY_H_
+#define DMXREPLAY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "lightset.h"
+
+#include "dmxcapture.h"
+
+/**
+ * Plays a DMXCapture file into a LightSet, at the captured timing or as fast as possible.
+ */
+class DMXReplay {
+public:
+	DMXReplay(void);
+	~DMXReplay(void);
+
+	bool Open(const char *pFileName);
+	void Close(void);
+
+	void SetOutput(LightSet *pLightSet);
+
+	void SetRealTime(bool bRealTime);
+
+	bool Run(void);
+	void Rewind(void);
+
+	inline uint32_t GetRecords(void) const {
+		return m_nRecords;
+	}
+
+	inline uint64_t GetStartMicros(void) const {
+		return m_nStartMicros;
+	}
+
+	inline uint64_t GetCaptureMicros(void) const {
+		return m_nCaptureMicros;
+	}
+
+private:
+	bool ApplyChanges(uint8_t nPort, const uint8_t *pData, uint16_t nBytes);
+
+private:
+	uint8_t *m_pMap;
+	size_t m_nSize;
+	size_t m_nOffset;
+	LightSet *m_pLightSet;
+	bool m_bRealTime;
+	bool m_bIsStarted;
+	uint64_t m_nStartMicros;
+	uint64_t m_nCaptureMicros;	///< Of the last record, since the start of the capture
+	uint64_t m_nReplayMicros;	///< Monotonic clock at the start of the replay
+	uint32_t m_nRecords;
+	uint16_t m_aLength[DMXCAPTURE_MAX_PORTS];
+	uint8_t m_aData[DMXCAPTURE_MAX_PORTS][DMXCAPTURE_MAX_SLOTS];
+};
+
+#endif /* DMXREPLAY_H_ */
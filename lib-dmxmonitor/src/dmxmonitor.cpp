@@ -41,6 +41,7 @@
  #define DMX_DEFAULT_START_ADDRESS	1
 #else
 #include "console.h"
+#include "glyph.h"
 #define TOP_ROW				3
 #define DMX_FOOTPRINT		512
 #define DMX_START_ADDRESS	1
@@ -48,12 +49,24 @@
 
 DMXMonitor::DMXMonitor(void) : m_bIsStarted(false), m_nSlots(0)
 #if defined (__linux__) || defined (__CYGWIN__)
-	, m_nDmxStartAddress(DMX_DEFAULT_START_ADDRESS), m_nMaxChannels(DMX_DEFAULT_MAX_CHANNELS)
+	, m_nDmxStartAddress(DMX_DEFAULT_START_ADDRESS), m_nMaxChannels(DMX_DEFAULT_MAX_CHANNELS), m_pCapture(0)
 #endif
 {
 	for (int i = 0; i < (int) (sizeof(m_Data) / sizeof(m_Data[0])); i++) {
 		m_Data[i] = 0;
 	}
+
+#if defined (__linux__) || defined (__CYGWIN__)
+#else
+	struct glyph_surface surface;
+
+	surface.address = (void *) console_get_address();
+	surface.width = console_get_width();
+	surface.height = console_get_height();
+
+	m_Grid.SetSurface(&surface);
+	m_Grid.SetOrigin(4, TOP_ROW + 1);
+#endif
 }
 
 DMXMonitor::~DMXMonitor(void) {
@@ -73,6 +86,22 @@ void DMXMonitor::SetMaxDmxChannels(uint16_t nMaxChannels) {
 	m_nMaxChannels = nMaxChannels;
 }
 
+void DMXMonitor::SetCapture(DMXCapture *pCapture) {
+	m_pCapture = pCapture;
+}
+
+void DMXMonitor::SetSource(uint32_t nIpAddress, uint16_t nOpCode) {
+	if (m_pCapture != 0) {
+		m_pCapture->SetSource(nIpAddress, nOpCode);
+	}
+}
+
+void DMXMonitor::Sync(void) {
+	if (m_pCapture != 0) {
+		m_pCapture->WriteSync();
+	}
+}
+
 uint16_t DMXMonitor::GetDmxFootprint(void) {
 	return m_nMaxChannels;
 }
@@ -112,6 +141,11 @@ void DMXMonitor::SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength)
 	struct timeval tv;
 	uint16_t i, j;
 
+	if (m_pCapture != 0) {
+		m_pCapture->Write(nPort, pData, nLength);
+		return;
+	}
+
 	gettimeofday(&tv, NULL);
 	struct tm tm = *localtime(&tv.tv_sec);
 
@@ -162,6 +196,7 @@ void DMXMonitor::Start(void) {
 		printf("%3d", i);
 	}
 
+	m_Grid.Invalidate();
 	Update();
 }
 
@@ -176,12 +211,16 @@ void DMXMonitor::Stop(void) {
 		console_set_cursor(4, i);
 		console_puts("-- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --");
 	}
+
+	m_Grid.Invalidate();
 }
 
 void DMXMonitor::Cls(void) {
 	for (int i = TOP_ROW; i < (TOP_ROW + 17); i++) {
 		console_clear_line(i);
 	}
+
+	m_Grid.Invalidate();
 }
 
 void DMXMonitor::SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
@@ -195,35 +234,7 @@ void DMXMonitor::SetData(uint8_t nPort, const uint8_t *pData, uint16_t nLength)
 }
 
 void DMXMonitor::Update(void) {
-	uint8_t row = TOP_ROW;
-	uint8_t *p = (uint8_t *)m_Data;
-	uint16_t slot = 0;
-	uint8_t i, j;
-
-	for (i = 0; (i < 16) && (slot < m_nSlots); i++) {
-
-		console_set_cursor(4, ++row);
-
-		for (j = 0; (j < 32) && (slot < m_nSlots); j++) {
-			const uint8_t d = *p++;
-			if (d == (uint8_t) 0) {
-				console_puts(" 0");
-			} else {
-				console_puthex_fg_bg(d, (uint16_t)(d > 92 ? CONSOLE_BLACK : CONSOLE_WHITE), (uint16_t)RGB(d,d,d));
-			}
-			(void) console_putc((int) ' ');
-			slot++;
-		}
-
-		for (; j < 32; j++) {
-			console_puts("   ");
-		}
-	}
-
-	for (; i < 16; i++) {
-		console_set_cursor(4, ++row);
-		console_puts("                                                                                               ");
-	}
+	(void) m_Grid.Update(m_Data, m_nSlots);
 }
 
 #endif
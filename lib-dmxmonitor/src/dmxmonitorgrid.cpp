@@ -0,0 +1,117 @@
+/**
+ * @file dmxmonitorgrid.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "dmxmonitorgrid.h"
+
+#include "glyph.h"
+#include "console.h"
+
+#define CELL_EMPTY		0x100	///< No slot, the cell is blank
+#define CELL_INVALID	0x200	///< The cell is not on the screen
+
+#define TO_HEX(i)	((i) < 10) ? (int)'0' + (i) : (int)'A' + ((i) - 10)
+
+DMXMonitorGrid::DMXMonitorGrid(void) : m_nColumn(0), m_nRow(0) {
+	m_Surface.address = NULL;
+	m_Surface.width = 0;
+	m_Surface.height = 0;
+
+	Invalidate();
+}
+
+DMXMonitorGrid::~DMXMonitorGrid(void) {
+}
+
+void DMXMonitorGrid::SetSurface(const struct glyph_surface *pSurface) {
+	m_Surface = *pSurface;
+	Invalidate();
+}
+
+void DMXMonitorGrid::SetOrigin(uint8_t nColumn, uint8_t nRow) {
+	m_nColumn = nColumn;
+	m_nRow = nRow;
+	Invalidate();
+}
+
+/**
+ * The next Update draws all the cells, including the spaces between them.
+ */
+void DMXMonitorGrid::Invalidate(void) {
+	for (uint16_t i = 0; i < DMXMONITORGRID_SLOTS; i++) {
+		m_aShadow[i] = CELL_INVALID;
+	}
+}
+
+/**
+ *
+ * @param pData The slot values
+ * @param nSlots The number of slots in pData, the cells after these are blank
+ * @return The number of cells drawn
+ */
+uint16_t DMXMonitorGrid::Update(const uint8_t *pData, uint16_t nSlots) {
+	uint16_t nDrawn = 0;
+
+	if (m_Surface.address == NULL) {
+		return 0;
+	}
+
+	for (uint16_t nSlot = 0; nSlot < DMXMONITORGRID_SLOTS; nSlot++) {
+		const uint16_t nValue = nSlot < nSlots ? (uint16_t) pData[nSlot] : (uint16_t) CELL_EMPTY;
+
+		if (m_aShadow[nSlot] != nValue) {
+			DrawCell(nSlot, nValue);
+			m_aShadow[nSlot] = nValue;
+			nDrawn++;
+		}
+	}
+
+	return nDrawn;
+}
+
+void DMXMonitorGrid::DrawCell(uint16_t nSlot, uint16_t nValue) {
+	const int x = (int) m_nColumn + (int) (nSlot % DMXMONITORGRID_COLUMNS) * 3;
+	const int y = (int) m_nRow + (int) (nSlot / DMXMONITORGRID_COLUMNS);
+
+	if (m_aShadow[nSlot] == CELL_INVALID) {
+		glyph_draw_char(&m_Surface, (int) ' ', x + 2, y, CONSOLE_WHITE, CONSOLE_BLACK);
+	}
+
+	if (nValue == CELL_EMPTY) {
+		glyph_draw_char(&m_Surface, (int) ' ', x, y, CONSOLE_WHITE, CONSOLE_BLACK);
+		glyph_draw_char(&m_Surface, (int) ' ', x + 1, y, CONSOLE_WHITE, CONSOLE_BLACK);
+	} else if (nValue == 0) {
+		glyph_draw_char(&m_Surface, (int) ' ', x, y, CONSOLE_WHITE, CONSOLE_BLACK);
+		glyph_draw_char(&m_Surface, (int) '0', x + 1, y, CONSOLE_WHITE, CONSOLE_BLACK);
+	} else {
+		const uint16_t fore = (uint16_t) (nValue > 92 ? CONSOLE_BLACK : CONSOLE_WHITE);
+		const uint16_t back = (uint16_t) RGB(nValue, nValue, nValue);
+
+		glyph_draw_char(&m_Surface, TO_HEX(nValue >> 4), x, y, fore, back);
+		glyph_draw_char(&m_Surface, TO_HEX(nValue & 0x0F), x + 1, y, fore, back);
+	}
+}
@@ -0,0 +1,233 @@
+/**
+ * @file dmxcapture.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include <assert.h>
+
+#include "dmxcapture.h"
+
+#define RUN_GAP			4		///< Unchanged slots which end a run, a run header is 4 bytes
+#define FILE_BUFFER		65536
+#define FLUSH_MICROS	1000000	///< The nodes run until killed, so at most this is lost
+
+static uint64_t micros(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000;
+}
+
+DMXCapture::DMXCapture(void) :
+		m_pFile(0),
+		m_bChangesOnly(true),
+		m_nMicrosPrevious(0),
+		m_nMicrosFlush(0),
+		m_nIpAddress(0),
+		m_nOpCode(0),
+		m_nRecords(0),
+		m_nBytes(0)
+{
+	for (unsigned i = 0; i < DMXCAPTURE_MAX_PORTS; i++) {
+		m_aLength[i] = 0;
+	}
+}
+
+DMXCapture::~DMXCapture(void) {
+	Close();
+}
+
+bool DMXCapture::Open(const char *pFileName, bool bChangesOnly) {
+	struct TDmxCaptureHeader header;
+	struct timeval tv;
+
+	assert(pFileName != 0);
+
+	Close();
+
+	m_pFile = fopen(pFileName, "wb");
+
+	if (m_pFile == 0) {
+		perror(pFileName);
+		return false;
+	}
+
+	(void) setvbuf(m_pFile, NULL, _IOFBF, FILE_BUFFER);
+
+	gettimeofday(&tv, NULL);
+
+	memcpy(header.aMagic, DMXCAPTURE_MAGIC, sizeof(header.aMagic));
+	header.nStartMicros = (uint64_t) tv.tv_sec * 1000000 + (uint64_t) tv.tv_usec;
+
+	if (fwrite(&header, sizeof(header), 1, m_pFile) != 1) {
+		perror(pFileName);
+		Close();
+		return false;
+	}
+
+	m_bChangesOnly = bChangesOnly;
+	m_nMicrosPrevious = micros();
+	m_nMicrosFlush = m_nMicrosPrevious;
+	m_nRecords = 0;
+	m_nBytes = sizeof(header);
+
+	for (unsigned i = 0; i < DMXCAPTURE_MAX_PORTS; i++) {
+		m_aLength[i] = 0;
+	}
+
+	return true;
+}
+
+void DMXCapture::Close(void) {
+	if (m_pFile == 0) {
+		return;
+	}
+
+	if (fclose(m_pFile) != 0) {
+		perror("DMXCapture::Close");
+	}
+
+	m_pFile = 0;
+}
+
+void DMXCapture::SetSource(uint32_t nIpAddress, uint16_t nOpCode) {
+	m_nIpAddress = nIpAddress;
+	m_nOpCode = nOpCode;
+}
+
+void DMXCapture::Write(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+	assert(pData != 0);
+
+	if ((m_pFile == 0) || (nPort >= DMXCAPTURE_MAX_PORTS)) {
+		return;
+	}
+
+	if (nLength > DMXCAPTURE_MAX_SLOTS) {
+		nLength = DMXCAPTURE_MAX_SLOTS;
+	}
+
+	if (m_bChangesOnly && (m_aLength[nPort] == nLength) && (nLength != 0)) {
+		const uint16_t nBytes = EncodeChanges(nPort, pData, nLength);
+
+		if (nBytes < nLength) {
+			WriteRecord(nPort, DMXCAPTURE_TYPE_CHANGES, nLength, m_aChanges, nBytes);
+			memcpy(m_aData[nPort], pData, nLength);
+			return;
+		}
+	}
+
+	WriteRecord(nPort, DMXCAPTURE_TYPE_FULL, nLength, pData, nLength);
+
+	memcpy(m_aData[nPort], pData, nLength);
+	m_aLength[nPort] = nLength;
+}
+
+void DMXCapture::WriteSync(void) {
+	if (m_pFile == 0) {
+		return;
+	}
+
+	WriteRecord(0, DMXCAPTURE_TYPE_SYNC, 0, 0, 0);
+}
+
+/**
+ * @return The number of bytes in m_aChanges, nLength or more when a full frame is smaller
+ */
+uint16_t DMXCapture::EncodeChanges(uint8_t nPort, const uint8_t *pData, uint16_t nLength) {
+	const uint8_t *pPrevious = m_aData[nPort];
+	uint16_t nBytes = 0;
+	uint16_t i = 0;
+
+	while (i < nLength) {
+		if (pData[i] == pPrevious[i]) {
+			i++;
+			continue;
+		}
+
+		// A run starts at i and ends before RUN_GAP unchanged slots
+		const uint16_t nOffset = i;
+		uint16_t nEnd = i + 1;
+		uint16_t nUnchanged = 0;
+
+		for (uint16_t j = nEnd; (j < nLength) && (nUnchanged < RUN_GAP); j++) {
+			if (pData[j] == pPrevious[j]) {
+				nUnchanged++;
+			} else {
+				nUnchanged = 0;
+				nEnd = j + 1;
+			}
+		}
+
+		const uint16_t nCount = nEnd - nOffset;
+
+		if (nBytes + 4 + nCount >= nLength) {
+			return nLength;
+		}
+
+		m_aChanges[nBytes++] = (uint8_t) nOffset;
+		m_aChanges[nBytes++] = (uint8_t) (nOffset >> 8);
+		m_aChanges[nBytes++] = (uint8_t) nCount;
+		m_aChanges[nBytes++] = (uint8_t) (nCount >> 8);
+		memcpy(&m_aChanges[nBytes], &pData[nOffset], nCount);
+		nBytes += nCount;
+
+		i = nEnd;
+	}
+
+	return nBytes;
+}
+
+void DMXCapture::WriteRecord(uint8_t nPort, uint8_t nType, uint16_t nLength, const uint8_t *pData, uint16_t nBytes) {
+	struct TDmxCaptureRecord record;
+	const uint64_t nMicros = micros();
+	const uint64_t nDelta = nMicros - m_nMicrosPrevious;
+
+	m_nMicrosPrevious = nMicros;
+
+	record.nDeltaMicros = nDelta > UINT32_MAX ? UINT32_MAX : (uint32_t) nDelta;
+	record.nIpAddress = m_nIpAddress;
+	record.nOpCode = m_nOpCode;
+	record.nPort = nPort;
+	record.nType = nType;
+	record.nLength = nLength;
+	record.nBytes = nBytes;
+
+	if ((fwrite(&record, sizeof(record), 1, m_pFile) != 1) || ((nBytes != 0) && (fwrite(pData, nBytes, 1, m_pFile) != 1))) {
+		perror("DMXCapture::WriteRecord");
+		Close();
+		return;
+	}
+
+	m_nRecords++;
+	m_nBytes += sizeof(record) + nBytes;
+
+	if (nMicros - m_nMicrosFlush > FLUSH_MICROS) {
+		m_nMicrosFlush = nMicros;
+		(void) fflush(m_pFile);
+	}
+}
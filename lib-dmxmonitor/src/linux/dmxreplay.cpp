@@ -0,0 +1,256 @@
+/**
+ * @file dmxreplay.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <assert.h>
+
+#include "dmxreplay.h"
+#include "dmxcapture.h"
+
+#include "lightset.h"
+
+static uint64_t micros(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000;
+}
+
+DMXReplay::DMXReplay(void) :
+		m_pMap(0),
+		m_nSize(0),
+		m_nOffset(0),
+		m_pLightSet(0),
+		m_bRealTime(true),
+		m_bIsStarted(false),
+		m_nStartMicros(0),
+		m_nCaptureMicros(0),
+		m_nReplayMicros(0),
+		m_nRecords(0)
+{
+	for (unsigned i = 0; i < DMXCAPTURE_MAX_PORTS; i++) {
+		m_aLength[i] = 0;
+	}
+}
+
+DMXReplay::~DMXReplay(void) {
+	Close();
+}
+
+bool DMXReplay::Open(const char *pFileName) {
+	struct TDmxCaptureHeader header;
+	struct stat st;
+
+	assert(pFileName != 0);
+
+	Close();
+
+	const int fd = open(pFileName, O_RDONLY);
+
+	if (fd < 0) {
+		perror(pFileName);
+		return false;
+	}
+
+	if ((fstat(fd, &st) < 0) || ((size_t) st.st_size < sizeof(header))) {
+		fprintf(stderr, "%s: not a capture file\n", pFileName);
+		(void) close(fd);
+		return false;
+	}
+
+	void *p = mmap(0, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	(void) close(fd);
+
+	if (p == MAP_FAILED) {
+		perror(pFileName);
+		return false;
+	}
+
+	memcpy(&header, p, sizeof(header));
+
+	if (memcmp(header.aMagic, DMXCAPTURE_MAGIC, sizeof(header.aMagic)) != 0) {
+		fprintf(stderr, "%s: not a capture file\n", pFileName);
+		(void) munmap(p, (size_t) st.st_size);
+		return false;
+	}
+
+	(void) madvise(p, (size_t) st.st_size, MADV_SEQUENTIAL);
+
+	m_pMap = (uint8_t *) p;
+	m_nSize = (size_t) st.st_size;
+	m_nStartMicros = header.nStartMicros;
+
+	Rewind();
+
+	return true;
+}
+
+void DMXReplay::Close(void) {
+	if (m_bIsStarted) {
+		m_pLightSet->Stop();
+		m_bIsStarted = false;
+	}
+
+	if (m_pMap == 0) {
+		return;
+	}
+
+	(void) munmap(m_pMap, m_nSize);
+
+	m_pMap = 0;
+	m_nSize = 0;
+}
+
+void DMXReplay::SetOutput(LightSet *pLightSet) {
+	assert(!m_bIsStarted);
+
+	m_pLightSet = pLightSet;
+}
+
+void DMXReplay::SetRealTime(bool bRealTime) {
+	m_bRealTime = bRealTime;
+}
+
+void DMXReplay::Rewind(void) {
+	m_nOffset = sizeof(struct TDmxCaptureHeader);
+	m_nCaptureMicros = 0;
+	m_nRecords = 0;
+
+	for (unsigned i = 0; i < DMXCAPTURE_MAX_PORTS; i++) {
+		m_aLength[i] = 0;
+	}
+}
+
+/**
+ * Plays the next record. With real time this waits until the captured time of the record.
+ *
+ * @return false at the end of the capture, or for a record which is not valid
+ */
+bool DMXReplay::Run(void) {
+	struct TDmxCaptureRecord record;
+
+	assert(m_pLightSet != 0);
+
+	if ((m_pMap == 0) || (m_nOffset + sizeof(record) > m_nSize)) {
+		return false;
+	}
+
+	memcpy(&record, &m_pMap[m_nOffset], sizeof(record));
+
+	if (m_nOffset + sizeof(record) + record.nBytes > m_nSize) {
+		fprintf(stderr, "DMXReplay: record %u is truncated\n", (unsigned) m_nRecords);
+		return false;
+	}
+
+	const uint8_t *pData = &m_pMap[m_nOffset + sizeof(record)];
+	const uint8_t nPort = record.nPort;
+
+	m_nCaptureMicros += record.nDeltaMicros;
+
+	if (m_bRealTime) {
+		if (m_nRecords == 0) {
+			m_nReplayMicros = micros() - m_nCaptureMicros;
+		}
+
+		const uint64_t nDue = m_nReplayMicros + m_nCaptureMicros;
+		const uint64_t nNow = micros();
+
+		if (nDue > nNow) {
+			(void) usleep((useconds_t) (nDue - nNow));
+		}
+	}
+
+	switch (record.nType) {
+	case DMXCAPTURE_TYPE_FULL:
+		if ((nPort >= DMXCAPTURE_MAX_PORTS) || (record.nLength > DMXCAPTURE_MAX_SLOTS) || (record.nBytes != record.nLength)) {
+			fprintf(stderr, "DMXReplay: record %u is not valid\n", (unsigned) m_nRecords);
+			return false;
+		}
+		memcpy(m_aData[nPort], pData, record.nLength);
+		m_aLength[nPort] = record.nLength;
+		break;
+	case DMXCAPTURE_TYPE_CHANGES:
+		if ((nPort >= DMXCAPTURE_MAX_PORTS) || (record.nLength != m_aLength[nPort]) || !ApplyChanges(nPort, pData, record.nBytes)) {
+			fprintf(stderr, "DMXReplay: record %u is not valid\n", (unsigned) m_nRecords);
+			return false;
+		}
+		break;
+	case DMXCAPTURE_TYPE_SYNC:
+		break;
+	default:
+		fprintf(stderr, "DMXReplay: record %u has an unknown type %u\n", (unsigned) m_nRecords, (unsigned) record.nType);
+		return false;
+		break;
+	}
+
+	m_nOffset += sizeof(record) + record.nBytes;
+	m_nRecords++;
+
+	m_pLightSet->SetSource(record.nIpAddress, record.nOpCode);
+
+	if (record.nType == DMXCAPTURE_TYPE_SYNC) {
+		m_pLightSet->Sync();
+		return true;
+	}
+
+	m_pLightSet->SetData(nPort, m_aData[nPort], m_aLength[nPort]);
+
+	if (!m_bIsStarted) {
+		m_pLightSet->Start();
+		m_bIsStarted = true;
+	}
+
+	return true;
+}
+
+bool DMXReplay::ApplyChanges(uint8_t nPort, const uint8_t *pData, uint16_t nBytes) {
+	uint16_t i = 0;
+
+	while (i < nBytes) {
+		if (i + 4 > nBytes) {
+			return false;
+		}
+
+		const uint16_t nOffset = (uint16_t) (pData[i] | (pData[i + 1] << 8));
+		const uint16_t nCount = (uint16_t) (pData[i + 2] | (pData[i + 3] << 8));
+		i += 4;
+
+		if ((i + nCount > nBytes) || (nOffset + nCount > m_aLength[nPort])) {
+			return false;
+		}
+
+		memcpy(&m_aData[nPort][nOffset], &pData[i], nCount);
+		i += nCount;
+	}
+
+	return true;
+}
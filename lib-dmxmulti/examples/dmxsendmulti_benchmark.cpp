@@ -0,0 +1,343 @@
+/**
+ * @file dmxsendmulti_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dmxsendmulti.h"
+#include "dmxuart.h"
+#include "dmxuartsc16is740.h"
+#include "dmxuartminiuart.h"
+
+#include "sc16is740_mock.h"
+
+/*
+ * No hardware needed: the SC16IS740 driver is replaced by sc16is740_mock.c, a register model
+ * on a simulated clock, and the mini UART is modelled below on the same clock.
+ * Every SPI byte advances the clock, so the time spent in Service() is the SPI traffic.
+ */
+
+#define SIMULATED_MICROS	5000000
+#define SOURCE_MICROS		20000		///< New data for every port, as from an Art-Net source
+#define SPI_SPEED_HZ		4000000
+#define MINIUART_SLOT_TIME	40			///< 10 bits at 250 kbaud, the mini UART has 1 stop bit
+#define PORTS				4
+
+/*
+ * The mini UART, an 8 byte TX FIFO draining at the slot time
+ */
+class DMXUartMiniUartModel: public DMXUart {
+public:
+	DMXUartMiniUartModel(void): m_nLastEnd(0), m_nBreakStart(0), m_nBreakRelease(0), m_bIsBreak(false), m_bIsFirstSlot(false), m_nBreaks(0), m_nErrorsBreakBusy(0), m_nErrorsOverflow(0) {
+		memset(&m_Current, 0, sizeof(struct _sc16is740_mock_frame));
+		memset(&m_Last, 0, sizeof(struct _sc16is740_mock_frame));
+	}
+
+	~DMXUartMiniUartModel(void) {
+	}
+
+	bool Begin(void) {
+		return true;
+	}
+
+	void SetBreak(bool bBreak) {
+		const uint32_t nMicros = sc16is740_mock_get_micros();
+
+		if (bBreak && !m_bIsBreak) {
+			if (!IsTxEmpty()) {
+				m_nErrorsBreakBusy++;
+			}
+
+			if (m_nBreaks != 0) {
+				m_Current.break_to_break = nMicros - m_nBreakStart;
+				memcpy(&m_Last, &m_Current, sizeof(struct _sc16is740_mock_frame));
+			}
+
+			memset(&m_Current, 0, sizeof(struct _sc16is740_mock_frame));
+
+			m_nBreakStart = nMicros;
+			m_nBreaks++;
+		} else if (!bBreak && m_bIsBreak) {
+			m_Current.break_time = nMicros - m_nBreakStart;
+			m_nBreakRelease = nMicros;
+			m_bIsFirstSlot = true;
+		}
+
+		m_bIsBreak = bBreak;
+	}
+
+	bool IsTxEmpty(void) {
+		return (int32_t) (sc16is740_mock_get_micros() - m_nLastEnd) >= 0;
+	}
+
+	uint32_t GetTxSpace(void) {
+		const int32_t nPending = (int32_t) (m_nLastEnd - sc16is740_mock_get_micros());
+
+		if (nPending <= 0) {
+			return DMXUART_MINIUART_FIFO_TX;
+		}
+
+		// The slot in the shift register is no longer in the FIFO
+		const uint32_t nQueued = ((uint32_t) nPending + MINIUART_SLOT_TIME - 1) / MINIUART_SLOT_TIME - 1;
+
+		return DMXUART_MINIUART_FIFO_TX - nQueued;
+	}
+
+	uint32_t GetFifoSize(void) const {
+		return DMXUART_MINIUART_FIFO_TX;
+	}
+
+	void WriteFifo(const uint8_t *pData, uint32_t nLength) {
+		const uint32_t nMicros = sc16is740_mock_get_micros();
+
+		if (nLength > GetTxSpace()) {
+			m_nErrorsOverflow++;
+			nLength = GetTxSpace();
+		}
+
+		for (uint32_t i = 0; i < nLength; i++) {
+			uint32_t nStart = m_nLastEnd;
+
+			if ((int32_t) (nMicros - m_nLastEnd) > 0) {
+				nStart = nMicros;
+
+				if (m_bIsFirstSlot) {
+					m_Current.mab_time = nStart - m_nBreakRelease;
+				} else if (nStart - m_nLastEnd > m_Current.max_gap) {
+					m_Current.max_gap = nStart - m_nLastEnd;
+				}
+			}
+
+			m_bIsFirstSlot = false;
+
+			if (m_Current.length < SC16IS740_MOCK_FRAME_SIZE) {
+				m_Current.data[m_Current.length++] = pData[i];
+			}
+
+			m_nLastEnd = nStart + MINIUART_SLOT_TIME;
+		}
+	}
+
+	const struct _sc16is740_mock_frame *GetLast(void) const {
+		return &m_Last;
+	}
+
+	uint32_t GetBreaks(void) const {
+		return m_nBreaks;
+	}
+
+	uint32_t GetErrors(void) const {
+		return m_nErrorsBreakBusy + m_nErrorsOverflow;
+	}
+
+private:
+	uint32_t m_nLastEnd;
+	uint32_t m_nBreakStart;
+	uint32_t m_nBreakRelease;
+	bool m_bIsBreak;
+	bool m_bIsFirstSlot;
+	uint32_t m_nBreaks;
+	uint32_t m_nErrorsBreakBusy;
+	uint32_t m_nErrorsOverflow;
+	struct _sc16is740_mock_frame m_Current;
+	struct _sc16is740_mock_frame m_Last;
+};
+
+struct TPortResult {
+	uint32_t nFramesChecked;
+	uint32_t nTorn;
+	uint32_t nBreakMin;
+	uint32_t nMabMin;
+	uint32_t nGapMax;
+	uint32_t nBreakToBreakMax;
+	uint32_t nBreaks;
+};
+
+static uint8_t s_Data[DMXMULTI_MAX_SLOTS];
+
+/*
+ * Every slot follows from the first one, so a frame mixed from two SetData calls shows
+ */
+static void fill(uint8_t nPortId, uint32_t nUpdate) {
+	for (uint32_t i = 0; i < DMXMULTI_MAX_SLOTS; i++) {
+		s_Data[i] = (uint8_t) (nUpdate + i * (1 + nPortId));
+	}
+}
+
+static void check(const struct _sc16is740_mock_frame *pFrame, uint8_t nPortId, uint32_t nBreaks, struct TPortResult *pResult) {
+	if (nBreaks == pResult->nBreaks) {
+		return;
+	}
+
+	pResult->nBreaks = nBreaks;
+
+	if (nBreaks < 2) {	// No completed frame yet
+		return;
+	}
+
+	pResult->nFramesChecked++;
+
+	bool bIsTorn = (pFrame->length != 1 + DMXMULTI_MAX_SLOTS) || (pFrame->data[0] != 0);
+
+	for (uint32_t i = 1; !bIsTorn && (i < pFrame->length); i++) {
+		bIsTorn = (pFrame->data[i] != (uint8_t) (pFrame->data[1] + (i - 1) * (1 + nPortId)));
+	}
+
+	if (bIsTorn) {
+		pResult->nTorn++;
+	}
+
+	if (pFrame->break_time < pResult->nBreakMin) {
+		pResult->nBreakMin = pFrame->break_time;
+	}
+
+	if (pFrame->mab_time < pResult->nMabMin) {
+		pResult->nMabMin = pFrame->mab_time;
+	}
+
+	if (pFrame->max_gap > pResult->nGapMax) {
+		pResult->nGapMax = pFrame->max_gap;
+	}
+
+	if (pFrame->break_to_break > pResult->nBreakToBreakMax) {
+		pResult->nBreakToBreakMax = pFrame->break_to_break;
+	}
+}
+
+int main(int argc, char **argv) {
+	sc16is740_mock_reset();
+
+	DMXUartSC16IS740 uart0(SPI_CS0, SPI_SPEED_HZ);
+	DMXUartSC16IS740 uart1(SPI_CS1, SPI_SPEED_HZ);
+	DMXUartSC16IS740 uart2(SPI_CS2, SPI_SPEED_HZ);
+	DMXUartMiniUartModel miniuart;
+
+	DMXSendMulti dmx;
+
+	dmx.SetMicros(sc16is740_mock_get_micros);
+
+	if (!dmx.AddPort(&uart0) || !dmx.AddPort(&uart1) || !dmx.AddPort(&uart2) || !dmx.AddPort(&miniuart)) {
+		printf("AddPort failed\n");
+		return 1;
+	}
+
+	uint32_t nUpdates = 0;
+
+	for (uint8_t nPortId = 0; nPortId < PORTS; nPortId++) {
+		fill(nPortId, nUpdates);
+		dmx.SetData(nPortId, s_Data, DMXMULTI_MAX_SLOTS);
+	}
+
+	const uint32_t nStart = sc16is740_mock_get_micros();
+
+	dmx.Start();
+
+	uint32_t nSource = nStart + SOURCE_MICROS;
+	uint32_t nServiceMax = 0;
+	uint32_t nServiceCalls = 0;
+	struct TPortResult aResult[PORTS];
+
+	for (uint32_t i = 0; i < PORTS; i++) {
+		memset(&aResult[i], 0, sizeof(struct TPortResult));
+		aResult[i].nBreakMin = UINT32_MAX;
+		aResult[i].nMabMin = UINT32_MAX;
+	}
+
+	while ((int32_t) (sc16is740_mock_get_micros() - (nStart + SIMULATED_MICROS)) < 0) {
+		const uint32_t nBefore = sc16is740_mock_get_micros();
+		uint32_t nNext = dmx.Service();
+		const uint32_t nService = sc16is740_mock_get_micros() - nBefore;
+
+		nServiceCalls++;
+
+		if (nService > nServiceMax) {
+			nServiceMax = nService;
+		}
+
+		check(&sc16is740_mock_get_device(SPI_CS0)->last, 0, sc16is740_mock_get_device(SPI_CS0)->breaks, &aResult[0]);
+		check(&sc16is740_mock_get_device(SPI_CS1)->last, 1, sc16is740_mock_get_device(SPI_CS1)->breaks, &aResult[1]);
+		check(&sc16is740_mock_get_device(SPI_CS2)->last, 2, sc16is740_mock_get_device(SPI_CS2)->breaks, &aResult[2]);
+		check(miniuart.GetLast(), 3, miniuart.GetBreaks(), &aResult[3]);
+
+		if ((int32_t) (nNext - nSource) >= 0) {
+			nNext = nSource;
+		}
+
+		sc16is740_mock_set_micros(nNext);
+
+		if ((int32_t) (sc16is740_mock_get_micros() - nSource) >= 0) {
+			nUpdates++;
+			for (uint8_t nPortId = 0; nPortId < PORTS; nPortId++) {
+				fill(nPortId, nUpdates);
+				dmx.SetData(nPortId, s_Data, DMXMULTI_MAX_SLOTS);
+			}
+			nSource += SOURCE_MICROS;
+		}
+	}
+
+	dmx.Stop();
+
+	const uint32_t nElapsed = sc16is740_mock_get_micros() - nStart;
+	uint64_t nSpiTime = 0;
+	uint32_t nSpiTransfers = 0;
+	uint32_t nSpiFrames = 0;
+	bool bIsOk = true;
+
+	printf("Simulated %u ms, %u SC16IS740 at %u Hz SPI and the mini UART, full universes, %u updates\n", nElapsed / 1000, PORTS - 1, SPI_SPEED_HZ, nUpdates);
+
+	for (uint8_t nPortId = 0; nPortId < PORTS; nPortId++) {
+		const struct TDMXMultiStatistics *pStatistics = dmx.GetStatistics(nPortId);
+		const struct TPortResult *pResult = &aResult[nPortId];
+		uint32_t nErrors;
+
+		if (nPortId < PORTS - 1) {
+			const struct _sc16is740_mock_device *pDevice = sc16is740_mock_get_device((spi_cs_t) nPortId);
+			nErrors = pDevice->errors_break_busy + pDevice->errors_overflow;
+			nSpiTime += pDevice->spi_time;
+			nSpiTransfers += pDevice->spi_transfers;
+			nSpiFrames += pDevice->breaks;
+		} else {
+			nErrors = miniuart.GetErrors();
+		}
+
+		const uint32_t nRate = (uint32_t) (((uint64_t) pStatistics->nFrames * 10000000) / nElapsed);	// 0.1 Hz
+		const bool bIsPortOk = (pResult->nFramesChecked != 0) && (pResult->nTorn == 0) && (nErrors == 0)
+				&& (pResult->nBreakMin >= dmx.GetDmxBreakTime()) && (pResult->nMabMin >= dmx.GetDmxMabTime()) && (pResult->nGapMax == 0)
+				&& (nRate >= 430);
+
+		printf("Port %u %-10s: %2u.%u Hz, %4u frames, %3u coalesced, %5u refills, BREAK >= %u us, MAB >= %u us, gap <= %u us, %u torn, %u errors, %s\n",
+				nPortId, nPortId < PORTS - 1 ? "SC16IS740" : "mini UART", nRate / 10, nRate % 10, pStatistics->nFrames, pStatistics->nCoalesced, pStatistics->nRefills,
+				pResult->nBreakMin, pResult->nMabMin, pResult->nGapMax, pResult->nTorn, nErrors, bIsPortOk ? "OK" : "WRONG");
+
+		bIsOk &= bIsPortOk;
+	}
+
+	printf("SPI: %u transfers per frame, a putc per slot needs %u, busy %u%%\n", nSpiFrames == 0 ? 0 : nSpiTransfers / nSpiFrames, 2 * (1 + DMXMULTI_MAX_SLOTS), (uint32_t) (nSpiTime / 10 / nElapsed));
+	printf("Service(): %u calls, worst %u us\n", nServiceCalls, nServiceMax);
+	printf("%s\n", bIsOk ? "OK" : "FAILED");
+
+	return bIsOk ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file dmxsendmulti.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXSENDMULTI_H_
+#define DMXSENDMULTI_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lightset.h"
+
+#include "dmxuart.h"
+#include "dmx_send_buffer.h"
+
+#define DMXMULTI_MAX_PORTS			4
+#define DMXMULTI_SLOT_TIME			44		///< 11 bits at 250 kbaud
+#define DMXMULTI_REFILL_SLACK		(2 * DMXMULTI_SLOT_TIME)	///< Refills due this soon are done in the same pass
+#define DMXMULTI_IDLE_TIME			100000	///< Next deadline when there are no ports
+#define DMXMULTI_BREAK_TIME_MIN		92		///< us
+#define DMXMULTI_BREAK_TIME_DEFAULT	176		///< us
+#define DMXMULTI_MAB_TIME_MIN		12		///< us
+#define DMXMULTI_MAB_TIME_DEFAULT	12		///< us
+#define DMXMULTI_BREAK_TO_BREAK_TIME_MIN	1204	///< us
+#define DMXMULTI_MAX_SLOTS			512
+
+typedef uint32_t (*DMXMultiMicrosPtr)(void);
+
+enum TDMXMultiState {
+	DMXMULTI_STATE_IDLE,	///< Waiting for the next BREAK
+	DMXMULTI_STATE_BREAK,	///< BREAK asserted
+	DMXMULTI_STATE_MAB,		///< Mark after BREAK
+	DMXMULTI_STATE_DATA,	///< Refilling the TX FIFO
+	DMXMULTI_STATE_DRAIN	///< Last slot written, waiting for the TX FIFO to empty
+};
+
+struct TDMXMultiStatistics {
+	uint32_t nFrames;		///< BREAKs sent
+	uint32_t nNewFrames;	///< Frames that had new data
+	uint32_t nCoalesced;	///< Frames replaced by \ref DMXSendMulti::SetData before they were sent
+	uint32_t nRefills;		///< TX FIFO writes
+	uint32_t nBytes;		///< Bytes written to the TX FIFO
+};
+
+struct TDMXMultiPort {
+	DMXUart *pUart;
+	struct _dmx_send_buffer Buffer;
+	TDMXMultiState tState;
+	uint32_t nDeadline;
+	uint32_t nBreakMicros;
+	const uint8_t *pData;
+	uint16_t nLength;
+	uint16_t nIndex;
+	struct TDMXMultiStatistics Statistics;
+};
+
+/**
+ * Up to \ref DMXMULTI_MAX_PORTS DMX outputs, driven from a single timer.
+ *
+ * \ref Service runs every port state machine that is due and returns the next deadline.
+ * The BREAK and MAB are timed from the clock read right after the edge has been written,
+ * so that SPI transfers done earlier in the same pass cannot shorten them.
+ * BREAK and MAB edges are handled first, then all FIFO refills that are due within
+ * \ref DMXMULTI_REFILL_SLACK are done in one pass, so that a refill writes close to a full FIFO.
+ * The timing never gets shorter than set, a late deadline only makes BREAK or MAB longer.
+ *
+ * The ports start staggered over the period, so that their refills do not pile up.
+ */
+class DMXSendMulti: public LightSet {
+public:
+	DMXSendMulti(void);
+	~DMXSendMulti(void);
+
+	// Calls DMXUart::Begin. The port gets the next nPortId.
+	bool AddPort(DMXUart *pUart);
+
+	inline uint8_t GetPorts(void) {
+		return m_nPorts;
+	}
+
+	void Start(void);
+	void Stop(void);
+
+	void SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength);
+
+	inline void SetDmxBreakTime(uint32_t nBreakTime) {
+		m_nBreakTime = (nBreakTime < DMXMULTI_BREAK_TIME_MIN) ? DMXMULTI_BREAK_TIME_MIN : nBreakTime;
+	}
+
+	inline uint32_t GetDmxBreakTime(void) {
+		return m_nBreakTime;
+	}
+
+	inline void SetDmxMabTime(uint32_t nMabTime) {
+		m_nMabTime = (nMabTime < DMXMULTI_MAB_TIME_MIN) ? DMXMULTI_MAB_TIME_MIN : nMabTime;
+	}
+
+	inline uint32_t GetDmxMabTime(void) {
+		return m_nMabTime;
+	}
+
+	// 0 is as fast as the frame length allows, 44 Hz for a full universe
+	inline void SetDmxPeriodTime(uint32_t nPeriodTime) {
+		m_nPeriodTime = nPeriodTime;
+	}
+
+	inline uint32_t GetDmxPeriodTime(void) {
+		return m_nPeriodTime;
+	}
+
+	// Defaults to the system timer, set before Start for simulation
+	inline void SetMicros(DMXMultiMicrosPtr pMicros) {
+		m_pMicros = pMicros;
+	}
+
+	// Called from the timer interrupt, or by the caller on Linux
+	uint32_t Service(void);
+
+	const struct TDMXMultiStatistics *GetStatistics(uint8_t nPortId) const;
+
+	void Print(void);
+
+private:
+	void Begin(void);
+	void End(void);
+	void Step(struct TDMXMultiPort *pPort, uint32_t nMicros);
+	void Refill(struct TDMXMultiPort *pPort, uint32_t nMicros);
+	uint32_t GetPeriod(const struct TDMXMultiPort *pPort) const;
+
+private:
+	struct TDMXMultiPort m_aPorts[DMXMULTI_MAX_PORTS];
+	uint8_t m_nPorts;
+	bool m_bIsStarted;
+	DMXMultiMicrosPtr m_pMicros;
+	uint32_t m_nBreakTime;
+	uint32_t m_nMabTime;
+	uint32_t m_nPeriodTime;
+};
+
+#endif /* DMXSENDMULTI_H_ */
@@ -0,0 +1,56 @@
+/**
+ * @file dmxuart.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXUART_H_
+#define DMXUART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * One physical DMX output, as seen by the \ref DMXSendMulti scheduler.
+ *
+ * The scheduler never waits on a port: it only asks how much room there is in the TX FIFO
+ * and then writes at most that many bytes in one go.
+ */
+class DMXUart {
+public:
+	virtual ~DMXUart(void);
+
+	// Set up 250 kbaud 8N2. Returns false when the UART is not there.
+	virtual bool Begin(void)= 0;
+
+	virtual void SetBreak(bool bBreak)= 0;
+
+	// TX FIFO and the transmit shift register are both empty
+	virtual bool IsTxEmpty(void)= 0;
+	virtual uint32_t GetTxSpace(void)= 0;
+	virtual uint32_t GetFifoSize(void) const= 0;
+
+	// nLength <= GetTxSpace()
+	virtual void WriteFifo(const uint8_t *pData, uint32_t nLength)= 0;
+};
+
+#endif /* DMXUART_H_ */
@@ -0,0 +1,60 @@
+/**
+ * @file dmxuartminiuart.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXUARTMINIUART_H_
+#define DMXUARTMINIUART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmxuart.h"
+
+#define DMXUART_MINIUART_FIFO_TX	8
+
+/**
+ * DMX output on the BCM2835 mini UART (UART1), TXD on GPIO14 (P1-08).
+ *
+ * The mini UART takes over GPIO14 from the PL011, so it cannot be used together with \ref DMXSend.
+ * It can only do 1 stop bit. Receivers sample the first stop bit only, so in practice this works,
+ * but strictly it is outside DMX512-A; use an SC16IS740 port where that matters.
+ * The baud rate is derived from \ref BCM2835_CORE_CLK_HZ, so the core clock must be fixed with core_freq in config.txt.
+ */
+class DMXUartMiniUart: public DMXUart {
+public:
+	DMXUartMiniUart(void);
+	~DMXUartMiniUart(void);
+
+	bool Begin(void);
+
+	void SetBreak(bool bBreak);
+
+	bool IsTxEmpty(void);
+	uint32_t GetTxSpace(void);
+	uint32_t GetFifoSize(void) const;
+
+	void WriteFifo(const uint8_t *pData, uint32_t nLength);
+};
+
+#endif /* DMXUARTMINIUART_H_ */
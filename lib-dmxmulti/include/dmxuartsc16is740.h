@@ -0,0 +1,62 @@
+/**
+ * @file dmxuartsc16is740.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXUARTSC16IS740_H_
+#define DMXUARTSC16IS740_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmxuart.h"
+
+#include "sc16is740.h"
+#include "device_info.h"
+
+/**
+ * DMX output on an SC16IS740 SPI UART bridge.
+ *
+ * Every call is one SPI transfer, so a FIFO refill costs a TXLVL read plus a single burst write.
+ */
+class DMXUartSC16IS740: public DMXUart {
+public:
+	DMXUartSC16IS740(spi_cs_t tChipSelect = SPI_CS0, uint32_t nSpeedHz = SC16IS7X0_SPI_SPEED_MAX_HZ);
+	~DMXUartSC16IS740(void);
+
+	bool Begin(void);
+
+	void SetBreak(bool bBreak);
+
+	bool IsTxEmpty(void);
+	uint32_t GetTxSpace(void);
+	uint32_t GetFifoSize(void) const;
+
+	void WriteFifo(const uint8_t *pData, uint32_t nLength);
+
+private:
+	device_info_t m_DeviceInfo;
+	uint8_t m_nLcr;
+};
+
+#endif /* DMXUARTSC16IS740_H_ */
@@ -0,0 +1,93 @@
+/**
+ * @file sc16is740_mock.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SC16IS740_MOCK_H_
+#define SC16IS740_MOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sc16is7x0.h"
+#include "device_info.h"
+
+#define SC16IS740_MOCK_DEVICES			3		///< One for each \ref spi_cs_t
+#define SC16IS740_MOCK_FRAME_SIZE		513		///< SC + 512 slots
+#define SC16IS740_MOCK_SPI_SETUP_NS		1000	///< Per transfer, chip select and driver overhead
+
+struct _sc16is740_mock_frame {
+	uint8_t data[SC16IS740_MOCK_FRAME_SIZE];	///< As shifted out on TX
+	uint16_t length;				///<
+	uint32_t break_time;			///< us
+	uint32_t mab_time;				///< us, from the end of the BREAK to the first start bit
+	uint32_t max_gap;				///< us, longest idle line between two slots
+	uint32_t break_to_break;		///< us
+};
+
+/**
+ * Register model of an SC16IS740 TX side.
+ *
+ * The TX FIFO drains at the baud rate and format set in DLL, DLH and LCR, against a simulated
+ * clock. Every SPI transfer moves that clock forward by its duration at the SPI speed.
+ */
+struct _sc16is740_mock_device {
+	uint8_t reg[16];				///< As written, indexed by register address
+	uint8_t dll;					///<
+	uint8_t dlh;					///<
+	uint8_t fifo[SC16IS7X0_FIFO_TX];	///<
+	uint32_t fifo_head;				///<
+	uint32_t fifo_count;			///<
+	bool shifting;					///< Transmit shift register busy
+	uint64_t tx_end;				///< ns, end of the slot in the shift register
+	uint64_t synced;				///< ns
+	uint64_t break_start;			///< ns
+	uint64_t break_release;			///< ns
+	uint64_t last_slot_end;			///< ns
+	bool first_slot;				///<
+	uint32_t breaks;				///<
+	struct _sc16is740_mock_frame current;	///< Being received
+	struct _sc16is740_mock_frame last;		///< Completed by the most recent BREAK
+	uint32_t errors_break_busy;		///< BREAK while a slot was still going out
+	uint32_t errors_overflow;		///< THR written with a full FIFO
+	uint32_t spi_transfers;			///<
+	uint32_t spi_bytes;				///<
+	uint64_t spi_time;				///< ns
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void sc16is740_mock_reset(void);
+
+extern void sc16is740_mock_set_micros(uint32_t);
+extern uint32_t sc16is740_mock_get_micros(void);
+
+extern const struct _sc16is740_mock_device *sc16is740_mock_get_device(spi_cs_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SC16IS740_MOCK_H_ */
@@ -0,0 +1,297 @@
+/**
+ * @file dmxsendmulti.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#else
+ #include <string.h>
+#endif
+
+#include "dmxsendmulti.h"
+#include "dmxuart.h"
+
+#include "dmx_send_buffer.h"
+
+static inline bool is_due(uint32_t nMicros, uint32_t nDeadline) {
+	return (int32_t) (nMicros - nDeadline) >= 0;
+}
+
+DMXSendMulti::DMXSendMulti(void) :
+	m_nPorts(0),
+	m_bIsStarted(false),
+	m_pMicros(0),
+	m_nBreakTime(DMXMULTI_BREAK_TIME_DEFAULT),
+	m_nMabTime(DMXMULTI_MAB_TIME_DEFAULT),
+	m_nPeriodTime(0)
+{
+	for (uint32_t i = 0; i < DMXMULTI_MAX_PORTS; i++) {
+		struct TDMXMultiPort *pPort = &m_aPorts[i];
+
+		pPort->pUart = 0;
+		dmx_send_buffer_init(&pPort->Buffer);
+		pPort->tState = DMXMULTI_STATE_IDLE;
+		pPort->nDeadline = 0;
+		pPort->nBreakMicros = 0;
+		pPort->pData = dmx_send_buffer_get_front(&pPort->Buffer)->data;
+		pPort->nLength = dmx_send_buffer_get_front(&pPort->Buffer)->length;
+		pPort->nIndex = 0;
+		memset(&pPort->Statistics, 0, sizeof(struct TDMXMultiStatistics));
+	}
+}
+
+DMXSendMulti::~DMXSendMulti(void) {
+	Stop();
+}
+
+bool DMXSendMulti::AddPort(DMXUart *pUart) {
+	assert(pUart != 0);
+	assert(!m_bIsStarted);
+
+	if (m_nPorts == DMXMULTI_MAX_PORTS) {
+		return false;
+	}
+
+	if (!pUart->Begin()) {
+		return false;
+	}
+
+	pUart->SetBreak(false);
+
+	m_aPorts[m_nPorts++].pUart = pUart;
+
+	return true;
+}
+
+void DMXSendMulti::SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLength) {
+	if (nPortId >= m_nPorts) {
+		return;
+	}
+
+	if (nLength > DMXMULTI_MAX_SLOTS) {
+		nLength = DMXMULTI_MAX_SLOTS;
+	}
+
+	struct TDMXMultiPort *pPort = &m_aPorts[nPortId];
+	uint8_t *pBack = dmx_send_buffer_get_back(&pPort->Buffer);
+
+	pBack[0] = 0;	// Start code
+	memcpy(&pBack[1], pData, nLength);
+
+	if (dmx_send_buffer_commit(&pPort->Buffer, 1 + nLength)) {
+		pPort->Statistics.nCoalesced++;
+	}
+}
+
+/**
+ * Arms all the ports, the first BREAKs are spread over one period.
+ */
+void DMXSendMulti::Begin(void) {
+	assert(m_pMicros != 0);
+
+	const uint32_t nMicros = m_pMicros();
+
+	for (uint32_t i = 0; i < m_nPorts; i++) {
+		struct TDMXMultiPort *pPort = &m_aPorts[i];
+
+		pPort->tState = DMXMULTI_STATE_IDLE;
+		pPort->nDeadline = nMicros + (i * GetPeriod(pPort)) / m_nPorts;
+		pPort->nIndex = 0;
+	}
+}
+
+void DMXSendMulti::End(void) {
+	for (uint32_t i = 0; i < m_nPorts; i++) {
+		struct TDMXMultiPort *pPort = &m_aPorts[i];
+
+		if (pPort->tState == DMXMULTI_STATE_BREAK) {
+			pPort->pUart->SetBreak(false);
+		}
+
+		pPort->tState = DMXMULTI_STATE_IDLE;
+	}
+}
+
+/**
+ * @return The time at which Service must be called again
+ */
+uint32_t DMXSendMulti::Service(void) {
+	const uint32_t nMicros = m_pMicros();
+	uint32_t i;
+
+	for (i = 0; i < m_nPorts; i++) {
+		struct TDMXMultiPort *pPort = &m_aPorts[i];
+
+		while ((pPort->tState != DMXMULTI_STATE_DATA) && is_due(nMicros, pPort->nDeadline)) {
+			Step(pPort, nMicros);
+		}
+	}
+
+	for (i = 0; i < m_nPorts; i++) {
+		struct TDMXMultiPort *pPort = &m_aPorts[i];
+
+		if ((pPort->tState == DMXMULTI_STATE_DATA) && is_due(nMicros + DMXMULTI_REFILL_SLACK, pPort->nDeadline)) {
+			Refill(pPort, nMicros);
+		}
+	}
+
+	uint32_t nNext = nMicros + DMXMULTI_IDLE_TIME;
+
+	for (i = 0; i < m_nPorts; i++) {
+		if ((int32_t) (m_aPorts[i].nDeadline - nNext) < 0) {
+			nNext = m_aPorts[i].nDeadline;
+		}
+	}
+
+	return nNext;
+}
+
+void DMXSendMulti::Step(struct TDMXMultiPort *pPort, uint32_t nMicros) {
+	switch (pPort->tState) {
+	case DMXMULTI_STATE_IDLE: {
+		if (dmx_send_buffer_swap(&pPort->Buffer)) {
+			pPort->Statistics.nNewFrames++;
+		}
+
+		const struct _dmx_send_frame *pFrame = dmx_send_buffer_get_front(&pPort->Buffer);
+
+		pPort->pData = pFrame->data;
+		pPort->nLength = pFrame->length;
+
+		pPort->pUart->SetBreak(true);
+
+		pPort->nBreakMicros = m_pMicros();
+		pPort->nDeadline = pPort->nBreakMicros + m_nBreakTime;
+		pPort->tState = DMXMULTI_STATE_BREAK;
+		pPort->Statistics.nFrames++;
+	}
+		break;
+	case DMXMULTI_STATE_BREAK:
+		pPort->pUart->SetBreak(false);
+
+		pPort->nDeadline = m_pMicros() + m_nMabTime;
+		pPort->tState = DMXMULTI_STATE_MAB;
+		break;
+	case DMXMULTI_STATE_MAB:
+		// The first refill, in the second pass of Service, ends the MAB
+		pPort->nIndex = 0;
+		pPort->nDeadline = nMicros;
+		pPort->tState = DMXMULTI_STATE_DATA;
+		break;
+	case DMXMULTI_STATE_DRAIN:
+		if (!pPort->pUart->IsTxEmpty()) {
+			pPort->nDeadline = nMicros + DMXMULTI_SLOT_TIME;
+			break;
+		}
+
+		pPort->nDeadline = pPort->nBreakMicros + GetPeriod(pPort);
+
+		if (is_due(nMicros, pPort->nDeadline)) {
+			pPort->nDeadline = nMicros;
+		}
+
+		pPort->tState = DMXMULTI_STATE_IDLE;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Writes as much as fits in one go, and comes back when the FIFO is half empty.
+ * The FIFO is known to be empty after the BREAK, so the first refill does not ask.
+ */
+void DMXSendMulti::Refill(struct TDMXMultiPort *pPort, uint32_t nMicros) {
+	const uint32_t nFifoSize = pPort->pUart->GetFifoSize();
+	const uint32_t nSpace = (pPort->nIndex == 0) ? nFifoSize : pPort->pUart->GetTxSpace();
+
+	uint32_t nCount = (uint32_t) (pPort->nLength - pPort->nIndex);
+
+	if (nCount > nSpace) {
+		nCount = nSpace;
+	}
+
+	if (nCount != 0) {
+		pPort->pUart->WriteFifo(&pPort->pData[pPort->nIndex], nCount);
+		pPort->nIndex += (uint16_t) nCount;
+		pPort->Statistics.nRefills++;
+		pPort->Statistics.nBytes += nCount;
+	}
+
+	const uint32_t nQueued = nFifoSize - nSpace + nCount;
+
+	if (pPort->nIndex == pPort->nLength) {
+		pPort->nDeadline = nMicros + (nQueued + 1) * DMXMULTI_SLOT_TIME;
+		pPort->tState = DMXMULTI_STATE_DRAIN;
+		return;
+	}
+
+	const uint32_t nLow = nFifoSize / 2;
+
+	if (nQueued > nLow) {
+		pPort->nDeadline = nMicros + (nQueued - nLow) * DMXMULTI_SLOT_TIME;
+	} else {
+		pPort->nDeadline = nMicros + DMXMULTI_SLOT_TIME;
+	}
+}
+
+uint32_t DMXSendMulti::GetPeriod(const struct TDMXMultiPort *pPort) const {
+	uint32_t nMinimum = m_nBreakTime + m_nMabTime + (uint32_t) pPort->nLength * DMXMULTI_SLOT_TIME;
+
+	if (nMinimum < DMXMULTI_BREAK_TO_BREAK_TIME_MIN) {
+		nMinimum = DMXMULTI_BREAK_TO_BREAK_TIME_MIN;
+	}
+
+	if (m_nPeriodTime < nMinimum) {
+		return nMinimum;
+	}
+
+	return m_nPeriodTime;
+}
+
+const struct TDMXMultiStatistics *DMXSendMulti::GetStatistics(uint8_t nPortId) const {
+	if (nPortId >= m_nPorts) {
+		return 0;
+	}
+
+	return &m_aPorts[nPortId].Statistics;
+}
+
+void DMXSendMulti::Print(void) {
+	printf("\nDMX Send multi configuration\n");
+	printf(" Ports        : %d\n", (int) m_nPorts);
+	printf(" Break time   : %d\n", (int) m_nBreakTime);
+	printf(" MAB time     : %d\n", (int) m_nMabTime);
+
+	if (m_nPeriodTime == 0) {
+		printf(" Refresh rate : max\n");
+	} else {
+		printf(" Refresh rate : %d\n", (int) (1000000 / m_nPeriodTime));
+	}
+}
@@ -0,0 +1,83 @@
+/**
+ * @file dmxuartsc16is740.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmxuartsc16is740.h"
+
+#include "sc16is740.h"
+#include "sc16is7x0.h"
+#include "device_info.h"
+
+#define DMX_BAUDRATE	250000
+
+DMXUartSC16IS740::DMXUartSC16IS740(spi_cs_t tChipSelect, uint32_t nSpeedHz): m_nLcr(LCR_BITS8 | LCR_NONE | LCR_BITS2) {
+	m_DeviceInfo.chip_select = tChipSelect;
+	m_DeviceInfo.slave_address = 0;
+	m_DeviceInfo.speed_hz = nSpeedHz;
+	m_DeviceInfo.fast_mode = false;
+	m_DeviceInfo.internal.adc_channel = 0;
+	m_DeviceInfo.internal.clk_div = 0;
+	m_DeviceInfo.internal.count = 0;
+}
+
+DMXUartSC16IS740::~DMXUartSC16IS740(void) {
+}
+
+bool DMXUartSC16IS740::Begin(void) {
+	sc16is740_start(&m_DeviceInfo);
+
+	if (!sc16is740_is_connected(&m_DeviceInfo)) {
+		return false;
+	}
+
+	sc16is740_set_format(&m_DeviceInfo, 8, SERIAL_PARITY_NONE, 2);
+	sc16is740_set_baud(&m_DeviceInfo, DMX_BAUDRATE);
+
+	sc16is740_reg_write(&m_DeviceInfo, SC16IS7X0_FCR, (uint8_t) (FCR_ENABLE_FIFO | FCR_TX_FIFO_RST));
+
+	return true;
+}
+
+void DMXUartSC16IS740::SetBreak(bool bBreak) {
+	sc16is740_reg_write(&m_DeviceInfo, SC16IS7X0_LCR, bBreak ? (m_nLcr | LCR_BRK_ENA) : m_nLcr);
+}
+
+bool DMXUartSC16IS740::IsTxEmpty(void) {
+	return (sc16is740_reg_read(&m_DeviceInfo, SC16IS7X0_LSR) & LSR_TEMT) == LSR_TEMT;
+}
+
+uint32_t DMXUartSC16IS740::GetTxSpace(void) {
+	return (uint32_t) sc16is740_reg_read(&m_DeviceInfo, SC16IS7X0_TXLVL);
+}
+
+uint32_t DMXUartSC16IS740::GetFifoSize(void) const {
+	return (uint32_t) SC16IS7X0_FIFO_TX;
+}
+
+void DMXUartSC16IS740::WriteFifo(const uint8_t *pData, uint32_t nLength) {
+	sc16is740_write_fifo(&m_DeviceInfo, pData, (unsigned) nLength);
+}
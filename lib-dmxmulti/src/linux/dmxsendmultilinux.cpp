@@ -0,0 +1,65 @@
+/**
+ * @file dmxsendmultilinux.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/time.h>
+
+#include "dmxsendmulti.h"
+
+static uint32_t tv_micros(void) {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+
+	return (uint32_t) (tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+/**
+ * There is no timer interrupt on Linux; the caller runs \ref DMXSendMulti::Service,
+ * against real or simulated time.
+ */
+void DMXSendMulti::Start(void) {
+	if (m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = true;
+
+	if (m_pMicros == 0) {
+		m_pMicros = tv_micros;
+	}
+
+	Begin();
+}
+
+void DMXSendMulti::Stop(void) {
+	if (!m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = false;
+
+	End();
+}
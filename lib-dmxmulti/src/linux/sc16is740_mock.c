@@ -0,0 +1,318 @@
+/**
+ * @file sc16is740_mock.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "sc16is740.h"
+#include "sc16is7x0.h"
+#include "sc16is740_mock.h"
+
+#include "device_info.h"
+
+/*
+ * Replaces lib-bob/src/sc16is740.c, for the functions needed by the DMX transmitter.
+ */
+
+#define MOCK_CORE_CLK_HZ	250000000
+
+static struct _sc16is740_mock_device s_devices[SC16IS740_MOCK_DEVICES];
+static uint64_t s_nanos;
+
+static struct _sc16is740_mock_device *get_device(const device_info_t *device_info) {
+	return &s_devices[(unsigned) device_info->chip_select % SC16IS740_MOCK_DEVICES];
+}
+
+static uint64_t get_slot_time(const struct _sc16is740_mock_device *device) {
+	const uint8_t lcr = device->reg[SC16IS7X0_LCR];
+	uint32_t divisor = (uint32_t) device->dll | ((uint32_t) device->dlh << 8);
+	uint32_t bits = 1 + 5 + (lcr & 0x03) + 1;	// Start, data, stop
+
+	if ((lcr & LCR_BITS2) == LCR_BITS2) {
+		bits++;
+	}
+
+	if ((lcr & 0x08) == 0x08) {
+		bits++;	// Parity
+	}
+
+	if (divisor == 0) {
+		divisor = 1;
+	}
+
+	return ((uint64_t) bits * 16 * divisor * 1000000000ULL) / SC16IS7X0_XTAL_FREQ;
+}
+
+static void shift_out(struct _sc16is740_mock_device *device, uint8_t data, uint64_t start, uint64_t slot_time) {
+	struct _sc16is740_mock_frame *frame = &device->current;
+
+	if (device->first_slot) {
+		frame->mab_time = (uint32_t) ((start - device->break_release) / 1000);
+		device->first_slot = false;
+	} else {
+		const uint32_t gap = (uint32_t) ((start - device->last_slot_end) / 1000);
+
+		if (gap > frame->max_gap) {
+			frame->max_gap = gap;
+		}
+	}
+
+	if (frame->length < SC16IS740_MOCK_FRAME_SIZE) {
+		frame->data[frame->length++] = data;
+	}
+
+	device->last_slot_end = start + slot_time;
+}
+
+/*
+ * Brings the TX side up to the current time. Bytes in the FIFO were there at the previous
+ * sync at the latest, so none of them can start before it.
+ */
+static void sync(struct _sc16is740_mock_device *device) {
+	const uint64_t slot_time = get_slot_time(device);
+
+	for (;;) {
+		if (device->shifting) {
+			if (device->tx_end > s_nanos) {
+				break;
+			}
+			device->shifting = false;
+		}
+
+		if ((device->fifo_count == 0) || ((device->reg[SC16IS7X0_LCR] & LCR_BRK_ENA) == LCR_BRK_ENA)) {
+			break;
+		}
+
+		const uint64_t start = device->tx_end > device->synced ? device->tx_end : device->synced;
+		const uint8_t data = device->fifo[device->fifo_head];
+
+		device->fifo_head = (device->fifo_head + 1) % SC16IS7X0_FIFO_TX;
+		device->fifo_count--;
+
+		shift_out(device, data, start, slot_time);
+
+		device->shifting = true;
+		device->tx_end = start + slot_time;
+	}
+
+	device->synced = s_nanos;
+}
+
+/*
+ * The command byte of an SPI transfer, including the chip select setup.
+ */
+static void spi_begin(const device_info_t *device_info) {
+	struct _sc16is740_mock_device *device = get_device(device_info);
+	const uint64_t time = SC16IS740_MOCK_SPI_SETUP_NS + (8 * 1000000000ULL) / device_info->speed_hz;
+
+	s_nanos += time;
+
+	device->spi_transfers++;
+	device->spi_bytes++;
+	device->spi_time += time;
+
+	sync(device);
+}
+
+/*
+ * A data byte is there as soon as it has been clocked in.
+ */
+static void spi_byte(const device_info_t *device_info) {
+	struct _sc16is740_mock_device *device = get_device(device_info);
+	const uint64_t time = (8 * 1000000000ULL) / device_info->speed_hz;
+
+	s_nanos += time;
+
+	device->spi_bytes++;
+	device->spi_time += time;
+
+	sync(device);
+}
+
+static void set_lcr(struct _sc16is740_mock_device *device, uint8_t value) {
+	const bool was_break = (device->reg[SC16IS7X0_LCR] & LCR_BRK_ENA) == LCR_BRK_ENA;
+	const bool is_break = (value & LCR_BRK_ENA) == LCR_BRK_ENA;
+
+	device->reg[SC16IS7X0_LCR] = value;
+
+	if (!was_break && is_break) {
+		if (device->shifting || (device->fifo_count != 0)) {
+			device->errors_break_busy++;
+		}
+
+		if (device->breaks != 0) {
+			device->current.break_to_break = (uint32_t) ((s_nanos - device->break_start) / 1000);
+			memcpy(&device->last, &device->current, sizeof(struct _sc16is740_mock_frame));
+		}
+
+		memset(&device->current, 0, sizeof(struct _sc16is740_mock_frame));
+
+		device->break_start = s_nanos;
+		device->breaks++;
+	} else if (was_break && !is_break) {
+		device->current.break_time = (uint32_t) ((s_nanos - device->break_start) / 1000);
+		device->break_release = s_nanos;
+		device->first_slot = true;
+	}
+}
+
+static void reg_write(struct _sc16is740_mock_device *device, uint8_t reg, uint8_t value) {
+	const bool divisor_latch = (device->reg[SC16IS7X0_LCR] & LCR_ENABLE_DIV) == LCR_ENABLE_DIV;
+
+	if (divisor_latch && (reg == SC16IS7X0_DLL)) {
+		device->dll = value;
+	} else if (divisor_latch && (reg == SC16IS7X0_DLH)) {
+		device->dlh = value;
+	} else if (reg == SC16IS7X0_THR) {
+		if (device->fifo_count == SC16IS7X0_FIFO_TX) {
+			device->errors_overflow++;
+			return;
+		}
+		device->fifo[(device->fifo_head + device->fifo_count) % SC16IS7X0_FIFO_TX] = value;
+		device->fifo_count++;
+	} else if (reg == SC16IS7X0_LCR) {
+		set_lcr(device, value);
+	} else if (reg == SC16IS7X0_FCR) {
+		if ((value & FCR_TX_FIFO_RST) == FCR_TX_FIFO_RST) {
+			device->fifo_count = 0;
+		}
+		device->reg[reg] = value;
+	} else {
+		device->reg[reg & 0x0F] = value;
+	}
+}
+
+void sc16is740_mock_reset(void) {
+	memset(s_devices, 0, sizeof(s_devices));
+	s_nanos = 0;
+}
+
+void sc16is740_mock_set_micros(uint32_t micros) {
+	const uint64_t nanos = (uint64_t) micros * 1000;
+
+	if (nanos > s_nanos) {
+		s_nanos = nanos;
+	}
+}
+
+uint32_t sc16is740_mock_get_micros(void) {
+	return (uint32_t) (s_nanos / 1000);
+}
+
+const struct _sc16is740_mock_device *sc16is740_mock_get_device(spi_cs_t chip_select) {
+	return &s_devices[(unsigned) chip_select % SC16IS740_MOCK_DEVICES];
+}
+
+uint8_t sc16is740_reg_read(const device_info_t *device_info, const uint8_t reg) {
+	struct _sc16is740_mock_device *device = get_device(device_info);
+
+	spi_begin(device_info);
+	spi_byte(device_info);
+
+	switch (reg) {
+	case SC16IS7X0_TXLVL:
+		return (uint8_t) (SC16IS7X0_FIFO_TX - device->fifo_count);
+	case SC16IS7X0_LSR:
+		if (device->fifo_count != 0) {
+			return 0;
+		}
+		return device->shifting ? LSR_THRE : (LSR_THRE | LSR_TEMT);
+	default:
+		return device->reg[reg & 0x0F];
+	}
+}
+
+void sc16is740_reg_write(const device_info_t *device_info, const uint8_t reg, const uint8_t value) {
+	spi_begin(device_info);
+	spi_byte(device_info);
+
+	reg_write(get_device(device_info), reg, value);
+}
+
+void sc16is740_write_fifo(const device_info_t *device_info, const void *buffer, unsigned count) {
+	struct _sc16is740_mock_device *device = get_device(device_info);
+	const uint8_t *src = (const uint8_t *) buffer;
+
+	if (count > (unsigned) SC16IS7X0_FIFO_TX) {
+		count = (unsigned) SC16IS7X0_FIFO_TX;
+	}
+
+	spi_begin(device_info);
+
+	while (count-- != 0) {
+		spi_byte(device_info);
+		reg_write(device, SC16IS7X0_THR, *src++);
+	}
+}
+
+void sc16is740_set_baud(const device_info_t *device_info, const int baudrate) {
+	const unsigned long divisor = (unsigned long) SC16IS7X0_BAUDRATE_DIVISOR(baudrate);
+	const uint8_t lcr = sc16is740_reg_read(device_info, SC16IS7X0_LCR);
+
+	sc16is740_reg_write(device_info, SC16IS7X0_LCR, lcr | LCR_ENABLE_DIV);
+	sc16is740_reg_write(device_info, SC16IS7X0_DLL, (uint8_t) (divisor & 0xFF));
+	sc16is740_reg_write(device_info, SC16IS7X0_DLH, (uint8_t) ((divisor >> 8) & 0xFF));
+	sc16is740_reg_write(device_info, SC16IS7X0_LCR, lcr);
+}
+
+void sc16is740_set_format(const device_info_t *device_info, int bits, _serial_parity parity, int stop_bits) {
+	uint8_t lcr = (bits >= 5 && bits <= 8) ? (uint8_t) (bits - 5) : LCR_BITS8;
+
+	if (parity == SERIAL_PARITY_ODD) {
+		lcr |= LCR_ODD;
+	} else if (parity == SERIAL_PARITY_EVEN) {
+		lcr |= LCR_EVEN;
+	}
+
+	if (stop_bits == 2) {
+		lcr |= LCR_BITS2;
+	}
+
+	sc16is740_reg_write(device_info, SC16IS7X0_LCR, lcr);
+}
+
+bool sc16is740_is_connected(const device_info_t *device_info) {
+	const uint8_t TEST_CHARACTER = (uint8_t) 'A';
+
+	sc16is740_reg_write(device_info, SC16IS7X0_SPR, TEST_CHARACTER);
+
+	return (sc16is740_reg_read(device_info, SC16IS7X0_SPR) == TEST_CHARACTER);
+}
+
+void sc16is740_start(device_info_t *device_info) {
+	if (device_info->speed_hz == (uint32_t) 0) {
+		device_info->speed_hz = (uint32_t) SC16IS7X0_SPI_SPEED_DEFAULT_HZ;
+	} else if (device_info->speed_hz > (uint32_t) SC16IS7X0_SPI_SPEED_MAX_HZ) {
+		device_info->speed_hz = (uint32_t) SC16IS7X0_SPI_SPEED_MAX_HZ;
+	}
+
+	device_info->internal.clk_div = (uint16_t) ((uint32_t) MOCK_CORE_CLK_HZ / device_info->speed_hz);
+
+	sc16is740_set_format(device_info, 8, SERIAL_PARITY_NONE, 1);
+	sc16is740_set_baud(device_info, SC16IS7X0_DEFAULT_BAUDRATE);
+
+	sc16is740_reg_write(device_info, SC16IS7X0_FCR, (uint8_t) (FCR_ENABLE_FIFO | FCR_RX_FIFO_RST | FCR_TX_FIFO_RST));
+}
@@ -0,0 +1,92 @@
+/**
+ * @file dmxsendmultiirq.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "dmxsendmulti.h"
+
+#include "arm/irq_timer.h"
+
+#include "bcm2835.h"
+#include "bcm2835_st.h"
+
+#define DMXMULTI_TIMER_MIN	2	///< us, a compare value in the past is only matched after the counter wraps
+
+static DMXSendMulti *s_pThis = 0;
+
+static uint32_t st_micros(void) {
+	return BCM2835_ST->CLO;
+}
+
+static void irq_timer1_dmx_multi(__attribute__((unused)) const uint32_t clo) {
+	assert(s_pThis != 0);
+
+	const uint32_t nNext = s_pThis->Service();
+	const uint32_t nNow = BCM2835_ST->CLO;
+
+	if ((int32_t) (nNext - nNow) < DMXMULTI_TIMER_MIN) {
+		BCM2835_ST->C1 = nNow + DMXMULTI_TIMER_MIN;
+	} else {
+		BCM2835_ST->C1 = nNext;
+	}
+}
+
+/**
+ * Takes system timer compare 1, the same timer \ref DMXSend uses, so only one of the two can be started.
+ */
+void DMXSendMulti::Start(void) {
+	if (m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = true;
+
+	s_pThis = this;
+
+	if (m_pMicros == 0) {
+		m_pMicros = st_micros;
+	}
+
+	irq_timer_init();
+
+	Begin();
+
+	BCM2835_ST->C1 = BCM2835_ST->CLO + DMXMULTI_TIMER_MIN;
+	irq_timer_set(IRQ_TIMER_1, irq_timer1_dmx_multi);
+}
+
+void DMXSendMulti::Stop(void) {
+	if (!m_bIsStarted) {
+		return;
+	}
+
+	m_bIsStarted = false;
+
+	irq_timer_set(IRQ_TIMER_1, 0);
+
+	End();
+}
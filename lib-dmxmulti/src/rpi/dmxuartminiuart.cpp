@@ -0,0 +1,93 @@
+/**
+ * @file dmxuartminiuart.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "dmxuartminiuart.h"
+
+#include "bcm2835.h"
+#include "bcm2835_gpio.h"
+#include "bcm2835_aux.h"
+
+#define DMX_BAUDRATE	250000
+
+#define UART1_LCR_8BITS		0x03	///< 8 bits mode
+#define UART1_LCR_BREAK		0x40	///< TXD pulled low
+#define UART1_LSR_TEMT		0x40	///< Transmitter empty
+#define UART1_CNTL_TRN_ENBL	0x02	///< Transmitter enable
+#define UART1_STAT_TX_LEVEL_SHIFT	24
+#define UART1_STAT_TX_LEVEL_MASK	0x0F
+
+DMXUartMiniUart::DMXUartMiniUart(void) {
+}
+
+DMXUartMiniUart::~DMXUartMiniUart(void) {
+}
+
+bool DMXUartMiniUart::Begin(void) {
+	BCM2835_UART1->ENABLE |= BCM2835_AUX_ENABLE_UART1;
+	BCM2835_UART1->CNTL = 0x00;
+	BCM2835_UART1->LCR = UART1_LCR_8BITS;
+	BCM2835_UART1->MCR = 0x00;
+	BCM2835_UART1->IER = 0x00;
+	BCM2835_UART1->IIR = 0xC6;	// Clear the FIFOs
+	BCM2835_UART1->BAUD = (BCM2835_CORE_CLK_HZ / (8 * DMX_BAUDRATE)) - 1;
+
+	bcm2835_gpio_fsel(RPI_V2_GPIO_P1_08, BCM2835_GPIO_FSEL_ALT5);
+	bcm2835_gpio_set_pud(RPI_V2_GPIO_P1_08, BCM2835_GPIO_PUD_OFF);
+
+	BCM2835_UART1->CNTL = UART1_CNTL_TRN_ENBL;
+
+	return true;
+}
+
+void DMXUartMiniUart::SetBreak(bool bBreak) {
+	if (bBreak) {
+		BCM2835_UART1->LCR = UART1_LCR_8BITS | UART1_LCR_BREAK;
+	} else {
+		BCM2835_UART1->LCR = UART1_LCR_8BITS;
+	}
+}
+
+bool DMXUartMiniUart::IsTxEmpty(void) {
+	return (BCM2835_UART1->LSR & UART1_LSR_TEMT) == UART1_LSR_TEMT;
+}
+
+uint32_t DMXUartMiniUart::GetTxSpace(void) {
+	const uint32_t nLevel = (BCM2835_UART1->STAT >> UART1_STAT_TX_LEVEL_SHIFT) & UART1_STAT_TX_LEVEL_MASK;
+
+	return DMXUART_MINIUART_FIFO_TX - nLevel;
+}
+
+uint32_t DMXUartMiniUart::GetFifoSize(void) const {
+	return DMXUART_MINIUART_FIFO_TX;
+}
+
+void DMXUartMiniUart::WriteFifo(const uint8_t *pData, uint32_t nLength) {
+	while (nLength-- != 0) {
+		BCM2835_UART1->IO = (uint32_t) *pData++;
+	}
+}
@@ -135,6 +135,10 @@ enum TUniverse {
 #define E131_UNIVERSE_DISCOVERY_INTERVAL_SECONDS	10	///<
 #define E131_NETWORK_DATA_LOSS_TIMEOUT_SECONDS		2.5	///<
 
+#ifndef E131_MAX_PORTS
+ #define E131_MAX_PORTS							32	///< Number of universes one bridge can output
+#endif
+
 #define E131_CID_LENGTH					16
 #define E131_SOURCE_NAME_LENGTH			64
 #define E131_PACKET_IDENTIFIER_LENGTH	12
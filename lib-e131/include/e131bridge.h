@@ -34,13 +34,19 @@
 
 #define UUID_STRING_LENGTH	36
 
+#define E131_UNIVERSE_TABLE_SIZE	64	///< Power of 2, at least twice \ref E131_MAX_PORTS
+
+#if (E131_UNIVERSE_TABLE_SIZE & (E131_UNIVERSE_TABLE_SIZE - 1)) != 0 || (E131_UNIVERSE_TABLE_SIZE < (2 * E131_MAX_PORTS))
+ #error E131_UNIVERSE_TABLE_SIZE
+#endif
+
 struct TE131BridgeState {
-	uint8_t nPriority;
 	bool IsNetworkDataLoss;			///<
-	bool IsMergeMode;				///< Is the Bridge in merging mode?
 	bool IsTransmitting;			///<
 	bool IsSynchronized;			///< “Synchronized” or an “Unsynchronized” state.
 	bool IsForcedSynchronized;		///<
+	bool IsNetworkBegun;			///< UDP port is open, multicast groups can be joined
+	uint8_t nActivePorts;			///< Number of active ports
 	uint32_t SynchronizationTime;	///<
 	uint32_t DiscoveryTime;			///<
 	uint16_t DiscoveryPacketLength;	///<
@@ -57,12 +63,24 @@ struct TSource {
 struct TOutputPort {
 	uint8_t data[E131_DMX_LENGTH];	///< Data sent
 	uint16_t length;				///< Length of sent DMX data
+	uint16_t nUniverse;				///< Universe received on this port
+	bool bIsEnabled;				///< Is the port enabled ?
 	TMerge mergeMode;				///< \ref TMerge
+	bool IsMergeMode;				///< Is the port in merging mode?
+	uint8_t nPriority;				///< Priority of the source(s) currently received
 	bool IsDataPending;				///<
 	struct TSource sourceA;			///<
 	struct TSource sourceB;			///<
 };
 
+/**
+ * Open addressed universe to port lookup, an empty slot has nUniverse 0
+ */
+struct TUniversePort {
+	uint16_t nUniverse;				///<
+	uint8_t nPortIndex;				///<
+};
+
 class E131Bridge {
 public:
 	E131Bridge(void);
@@ -75,43 +93,61 @@ public:
 	uint16_t getUniverse(void) const;
 	void setUniverse(const uint16_t);
 
+	uint16_t getUniverse(uint8_t) const;
+	void setUniverse(uint8_t, const uint16_t);
+
+	uint8_t GetActivePorts(void) const;
+
 	TMerge getMergeMode(void) const;
 	void setMergeMode(TMerge);
 
+	TMerge getMergeMode(uint8_t) const;
+	void setMergeMode(uint8_t, TMerge);
+
 	const uint8_t *GetCid(void);
 	void setCid(const uint8_t[E131_CID_LENGTH]);
 
 	const char *GetSourceName(void);
 	void setSourceName(const char[E131_SOURCE_NAME_LENGTH]);
 
+	void Begin(void);
+
 	int Run(void);
+	uint32_t GetMillisToNextTimer(void);
 
-	void Print(uint32_t nMulticastIp);
+	void Print(void);
+
+public:
+	static uint32_t UniverseToMulticastIp(uint16_t);
 
 private:
 	void Start(void);
 	void Stop(void);
 
 	void FillDiscoveryPacket(void);
+	void FillUniverseTable(void);
+	uint8_t LookupPort(uint16_t) const;
 
 	bool IsValidRoot(void);
 	bool IsValidDataPacket(void);
 
 	void SetNetworkDataLossCondition(void);
-	void CheckMergeTimeouts(void);
-	bool IsPriorityTimeOut(void);
+	void SetStreamTerminated(uint8_t);
+	void CheckMergeTimeouts(uint8_t);
+	bool IsPriorityTimeOut(uint8_t);
 	bool isIpCidMatch(const struct TSource *);
-	bool IsDmxDataChanged(const uint8_t *, const uint16_t);
-	bool IsMergedDmxDataChanged(const uint8_t *, const uint16_t );
+	bool IsDmxDataChanged(uint8_t, const uint8_t *, const uint16_t);
+	bool IsMergedDmxDataChanged(uint8_t, const uint8_t *, const uint16_t );
 
 	void SendDiscoveryPacket(void);
 
-	void HandleDmx(void);
+	int HandleE131Packet(void);
+
+	void HandleDmx(uint8_t);
 	void HandleSynchronization(void);
 
 private:
 	LightSet *m_pLightSet;
-	uint16_t m_nUniverse;
 	uint8_t m_Cid[E131_CID_LENGTH];
 	char m_SourceName[E131_SOURCE_NAME_LENGTH];
 
@@ -121,7 +157,8 @@ private:
 	uint32_t m_nPreviousPacketMillis;
 
 	struct TE131BridgeState m_State;
-	struct TOutputPort m_OutputPort;
+	struct TOutputPort m_OutputPorts[E131_MAX_PORTS];
+	struct TUniversePort m_UniverseTable[E131_UNIVERSE_TABLE_SIZE];
 
 	struct TE131 m_E131;
 	struct TE131DiscoveryPacket m_E131DiscoveryPacket;
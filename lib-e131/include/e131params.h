@@ -47,6 +47,8 @@ public:
 
 	TOutputType GetOutputType(void) const;
 	uint16_t GetUniverse(void) const;
+	uint8_t GetUniverses(void) const;
+	uint16_t GetUniverse(uint8_t) const;
 	TMerge GetMergeMode(void) const;
 	bool isHaveCustomCid(void) const;
 	const char *GetCidString(void);
@@ -67,6 +69,7 @@ private:
     uint32_t m_bSetList;
 
     uint16_t m_nUniverse;
+    uint8_t m_nUniverses;
     TOutputType m_tOutputType;
     TMerge m_tMergeMode;
     char m_aCidString[UUID_STRING_LENGTH + 2];
@@ -48,6 +48,7 @@
 #include "e131bridge.h"
 
 #include "lightset.h"
+#include "dmxbuffer.h"
 
 
 #include "hardware.h"
@@ -60,28 +61,33 @@ static const uint8_t ACN_PACKET_IDENTIFIER[E131_PACKET_IDENTIFIER_LENGTH] = { 0x
 
 E131Bridge::E131Bridge(void) :
 		m_pLightSet(0),
-		m_nUniverse(E131_UNIVERSE_DEFAULT),
 		m_nCurrentPacketMillis(0),
 		m_nPreviousPacketMillis(0) {
 
-	memset(&m_OutputPort, 0, sizeof(struct TOutputPort));
-	m_OutputPort.mergeMode = E131_MERGE_HTP;
-	m_OutputPort.IsDataPending = false;
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		memset(&m_OutputPorts[i], 0, sizeof(struct TOutputPort));
+		m_OutputPorts[i].mergeMode = E131_MERGE_HTP;
+		m_OutputPorts[i].IsMergeMode = false;
+		m_OutputPorts[i].nPriority = E131_PRIORITY_LOWEST;
+		m_OutputPorts[i].IsDataPending = false;
+		m_OutputPorts[i].bIsEnabled = false;
+	}
+
+	memset(m_UniverseTable, 0, sizeof(m_UniverseTable));
 
 	memset(&m_State, 0, sizeof(struct TE131BridgeState));
 	m_State.IsNetworkDataLoss = true;
-	m_State.IsMergeMode = false;
 	m_State.IsTransmitting = false;
 	m_State.IsSynchronized = false;
 	m_State.IsForcedSynchronized = false;
-	m_State.nPriority = E131_PRIORITY_LOWEST;
+	m_State.IsNetworkBegun = false;
+	m_State.nActivePorts = 0;
 	m_State.DiscoveryTime = 0;
 
-	m_DiscoveryIpAddress = 0;
+	m_DiscoveryIpAddress = UniverseToMulticastIp(E131_UNIVERSE_DISCOVERY);
 
-	struct in_addr addr;
-	(void)inet_aton("239.255.0.0", &addr);
-	m_DiscoveryIpAddress = addr.s_addr | ((uint32_t)(((uint32_t)E131_UNIVERSE_DISCOVERY & (uint32_t)0xFF) << 24)) | ((uint32_t)(((uint32_t)E131_UNIVERSE_DISCOVERY & (uint32_t)0xFF00) << 8));
+	memset(&m_E131DiscoveryPacket, 0, sizeof(struct TE131DiscoveryPacket));
+	memset(m_Cid, 0, E131_CID_LENGTH);
 
 	setSourceName(DEFAULT_SOURCE_NAME);
 	setUniverse(E131_UNIVERSE_DEFAULT);
@@ -94,6 +100,20 @@ E131Bridge::~E131Bridge(void) {
 	}
 }
 
+void E131Bridge::Begin(void) {
+	Network::Get()->Begin(E131_DEFAULT_PORT);
+
+	m_State.IsNetworkBegun = true;
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if (m_OutputPorts[i].bIsEnabled) {
+			Network::Get()->JoinGroup(UniverseToMulticastIp(m_OutputPorts[i].nUniverse));
+		}
+	}
+
+	FillDiscoveryPacket();
+}
+
 void E131Bridge::Start(void) {
 	assert(m_pLightSet != 0);
 
@@ -101,8 +121,6 @@ void E131Bridge::Start(void) {
 		return;
 	}
 
-	FillDiscoveryPacket();
-
 	m_pLightSet->Start();
 	m_State.IsTransmitting = true;
 }
@@ -111,14 +129,16 @@ void E131Bridge::Stop(void) {
 	m_pLightSet->Stop();
 	//
 	m_State.IsNetworkDataLoss = true;
-	m_State.IsMergeMode = false;
 	m_State.IsTransmitting = false;
 	m_State.IsSynchronized = false;
 	m_State.IsForcedSynchronized = false;
-	m_State.nPriority = E131_PRIORITY_LOWEST;
 	//
-	m_OutputPort.length = 0;
-	m_OutputPort.IsDataPending = false;
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		m_OutputPorts[i].length = 0;
+		m_OutputPorts[i].IsDataPending = false;
+		m_OutputPorts[i].IsMergeMode = false;
+		m_OutputPorts[i].nPriority = E131_PRIORITY_LOWEST;
+	}
 }
 
 const uint8_t *E131Bridge::GetSoftwareVersion(void) {
@@ -131,14 +151,87 @@ void E131Bridge::SetOutput(LightSet *pLightSet) {
 	m_pLightSet = pLightSet;
 }
 
+uint32_t E131Bridge::UniverseToMulticastIp(uint16_t nUniverse) {
+	struct in_addr group_ip;
+	(void)inet_aton("239.255.0.0", &group_ip);
+
+	return group_ip.s_addr | ((uint32_t)(((uint32_t)nUniverse & (uint32_t)0xFF) << 24)) | ((uint32_t)(((uint32_t)nUniverse & (uint32_t)0xFF00) << 8));
+}
+
 uint16_t E131Bridge::getUniverse() const{
-	return m_nUniverse;
+	return m_OutputPorts[0].nUniverse;
 }
 
 void E131Bridge::setUniverse(const uint16_t nUniverse) {
+	setUniverse(0, nUniverse);
+}
+
+uint16_t E131Bridge::getUniverse(uint8_t nPortIndex) const {
+	assert(nPortIndex < E131_MAX_PORTS);
+
+	return m_OutputPorts[nPortIndex].nUniverse;
+}
+
+void E131Bridge::setUniverse(uint8_t nPortIndex, const uint16_t nUniverse) {
+	assert(nPortIndex < E131_MAX_PORTS);
 	assert((nUniverse >= E131_UNIVERSE_DEFAULT) && (nUniverse <= E131_UNIVERSE_MAX));
 
-	m_nUniverse = nUniverse;
+	if (!m_OutputPorts[nPortIndex].bIsEnabled) {
+		m_OutputPorts[nPortIndex].bIsEnabled = true;
+		m_State.nActivePorts++;
+	}
+
+	m_OutputPorts[nPortIndex].nUniverse = nUniverse;
+
+	FillUniverseTable();
+
+	if (m_State.IsNetworkBegun) {
+		Network::Get()->JoinGroup(UniverseToMulticastIp(nUniverse));
+		FillDiscoveryPacket();
+	}
+}
+
+uint8_t E131Bridge::GetActivePorts(void) const {
+	return m_State.nActivePorts;
+}
+
+void E131Bridge::FillUniverseTable(void) {
+	memset(m_UniverseTable, 0, sizeof(m_UniverseTable));
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if (!m_OutputPorts[i].bIsEnabled) {
+			continue;
+		}
+
+		const uint16_t nUniverse = m_OutputPorts[i].nUniverse;
+		unsigned nSlot = nUniverse & (E131_UNIVERSE_TABLE_SIZE - 1);
+
+		// Linear probing, the table is at least half empty
+		while ((m_UniverseTable[nSlot].nUniverse != 0) && (m_UniverseTable[nSlot].nUniverse != nUniverse)) {
+			nSlot = (nSlot + 1) & (E131_UNIVERSE_TABLE_SIZE - 1);
+		}
+
+		if (m_UniverseTable[nSlot].nUniverse == 0) {
+			m_UniverseTable[nSlot].nUniverse = nUniverse;
+			m_UniverseTable[nSlot].nPortIndex = i;
+		}
+	}
+}
+
+/**
+ * @return The port index, or E131_MAX_PORTS when the universe is not received by this bridge
+ */
+uint8_t E131Bridge::LookupPort(uint16_t nUniverse) const {
+	unsigned nSlot = nUniverse & (E131_UNIVERSE_TABLE_SIZE - 1);
+
+	while (m_UniverseTable[nSlot].nUniverse != 0) {
+		if (m_UniverseTable[nSlot].nUniverse == nUniverse) {
+			return m_UniverseTable[nSlot].nPortIndex;
+		}
+		nSlot = (nSlot + 1) & (E131_UNIVERSE_TABLE_SIZE - 1);
+	}
+
+	return E131_MAX_PORTS;
 }
 
 const uint8_t* E131Bridge::GetCid(void) {
@@ -162,17 +255,59 @@ void E131Bridge::setSourceName(const char aSourceName[E131_SOURCE_NAME_LENGTH])
 }
 
 TMerge E131Bridge::getMergeMode(void) const {
-	return m_OutputPort.mergeMode;
+	return m_OutputPorts[0].mergeMode;
 }
 
 void E131Bridge::setMergeMode(TMerge mergeMode) {
-	m_OutputPort.mergeMode = mergeMode;
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		m_OutputPorts[i].mergeMode = mergeMode;
+	}
+}
+
+TMerge E131Bridge::getMergeMode(uint8_t nPortIndex) const {
+	assert(nPortIndex < E131_MAX_PORTS);
+
+	return m_OutputPorts[nPortIndex].mergeMode;
+}
+
+void E131Bridge::setMergeMode(uint8_t nPortIndex, TMerge mergeMode) {
+	assert(nPortIndex < E131_MAX_PORTS);
+
+	m_OutputPorts[nPortIndex].mergeMode = mergeMode;
 }
 
 void E131Bridge::FillDiscoveryPacket(void) {
+	uint16_t aUniverses[E131_MAX_PORTS];
+	unsigned nUniverses = 0;
+
+	// 8 Universe Discovery Layer : sorted list of universes, insertion sort of at most E131_MAX_PORTS entries
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if (!m_OutputPorts[i].bIsEnabled) {
+			continue;
+		}
+
+		const uint16_t nUniverse = m_OutputPorts[i].nUniverse;
+		unsigned j = nUniverses;
+
+		while ((j > 0) && (aUniverses[j - 1] > nUniverse)) {
+			j--;
+		}
+
+		if ((j > 0) && (aUniverses[j - 1] == nUniverse)) {
+			continue;
+		}
+
+		for (unsigned k = nUniverses; k > j; k--) {
+			aUniverses[k] = aUniverses[k - 1];
+		}
+
+		aUniverses[j] = nUniverse;
+		nUniverses++;
+	}
+
 	uint16_t root_layer_length = sizeof(struct TRootLayer);
 	uint16_t framing_layer_size = sizeof(struct TDiscoveryFrameLayer);
-	uint16_t discovery_layer_size = sizeof(struct TUniverseDiscoveryLayer) - (511 * 2);
+	uint16_t discovery_layer_size = sizeof(struct TUniverseDiscoveryLayer) - ((512 - nUniverses) * 2);
 
 	m_State.DiscoveryPacketLength = root_layer_length + framing_layer_size + discovery_layer_size;
 
@@ -194,93 +329,75 @@ void E131Bridge::FillDiscoveryPacket(void) {
 	// Universe Discovery Layer (See Section 8)
 	m_E131DiscoveryPacket.UniverseDiscoveryLayer.FlagsLength = __builtin_bswap16((0x07 << 12) | discovery_layer_size);
 	m_E131DiscoveryPacket.UniverseDiscoveryLayer.Vector = __builtin_bswap32(VECTOR_UNIVERSE_DISCOVERY_UNIVERSE_LIST);
-	m_E131DiscoveryPacket.UniverseDiscoveryLayer.ListOfUniverses[0] = __builtin_bswap16(m_nUniverse);
-}
 
-bool E131Bridge::IsDmxDataChanged(const uint8_t *pData, const uint16_t nLength) {
-	bool isChanged = false;
+	for (unsigned i = 0; i < nUniverses; i++) {
+		m_E131DiscoveryPacket.UniverseDiscoveryLayer.ListOfUniverses[i] = __builtin_bswap16(aUniverses[i]);
+	}
+}
 
-	uint8_t *src = (uint8_t *)pData;
-	uint8_t *dst = (uint8_t *)m_OutputPort.data;
+bool E131Bridge::IsDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, const uint16_t nLength) {
+	struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
+	const bool isChanged = DmxBuffer::CompareCopy(pPort->data, pData, nLength);
 
-	if (nLength != m_OutputPort.length) {
-		m_OutputPort.length = nLength;
-		for (unsigned i = 0 ; i < E131_DMX_LENGTH; i++) {
-			*dst++ = *src++;
-		}
+	if (nLength != pPort->length) {
+		pPort->length = nLength;
 		return true;
 	}
 
-	for (unsigned i = 0; i < E131_DMX_LENGTH; i++) {
-		if (*dst != *src) {
-			*dst = *src;
-			isChanged = true;
-		}
-		dst++;
-		src++;
-	}
-
 	return isChanged;
 }
 
-bool E131Bridge::IsMergedDmxDataChanged(const uint8_t *pData, const uint16_t nLength) {
-	bool isChanged = false;
+bool E131Bridge::IsMergedDmxDataChanged(uint8_t nPortIndex, const uint8_t *pData, const uint16_t nLength) {
+	struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
 
-	if (m_OutputPort.mergeMode == E131_MERGE_HTP) {
+	if (pPort->mergeMode == E131_MERGE_HTP) {
+		const bool isChanged = DmxBuffer::MergeHtp(pPort->data, pPort->sourceA.data, pPort->sourceB.data, nLength);
 
-		if (nLength != m_OutputPort.length) {
-			m_OutputPort.length = nLength;
-			for (unsigned i = 0; i < nLength; i++) {
-				uint8_t data = MAX(m_OutputPort.sourceA.data[i], m_OutputPort.sourceB.data[i]);
-				m_OutputPort.data[i] = data;
-			}
+		if (nLength != pPort->length) {
+			pPort->length = nLength;
 			return true;
 		}
 
-		for (unsigned i = 0; i < nLength; i++) {
-			uint8_t data = MAX(m_OutputPort.sourceA.data[i], m_OutputPort.sourceB.data[i]);
-			if (data != m_OutputPort.data[i]) {
-				m_OutputPort.data[i] = data;
-				isChanged = true;
-			}
-		}
-
 		return isChanged;
 	} else {
-		return IsDmxDataChanged(pData, nLength);
+		return IsDmxDataChanged(nPortIndex, pData, nLength);
 	}
 }
 
-void E131Bridge::CheckMergeTimeouts(void) {
-	const uint32_t timeOutA = m_nCurrentPacketMillis - m_OutputPort.sourceA.time;
-	const uint32_t timeOutB = m_nCurrentPacketMillis - m_OutputPort.sourceB.time;
+void E131Bridge::CheckMergeTimeouts(uint8_t nPortIndex) {
+	struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
+	const uint32_t timeOutA = m_nCurrentPacketMillis - pPort->sourceA.time;
+	const uint32_t timeOutB = m_nCurrentPacketMillis - pPort->sourceB.time;
 
 	if (timeOutA > (uint32_t)(E131_MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPort.sourceA.ip = 0;
-		m_State.IsMergeMode = false;
+		pPort->sourceA.ip = 0;
+		DmxBuffer::Clear(pPort->sourceA.data, E131_DMX_LENGTH);
+		pPort->IsMergeMode = false;
 	}
 
 	if (timeOutB > (uint32_t)(E131_MERGE_TIMEOUT_SECONDS * 1000)) {
-		m_OutputPort.sourceB.ip = 0;
-		m_State.IsMergeMode = false;
+		pPort->sourceB.ip = 0;
+		DmxBuffer::Clear(pPort->sourceB.data, E131_DMX_LENGTH);
+		pPort->IsMergeMode = false;
 	}
 }
 
-bool E131Bridge::IsPriorityTimeOut(void) {
-	const uint32_t timeOutA = m_nCurrentPacketMillis - m_OutputPort.sourceA.time;
-	const uint32_t timeOutB = m_nCurrentPacketMillis - m_OutputPort.sourceB.time;
+bool E131Bridge::IsPriorityTimeOut(uint8_t nPortIndex) {
+	const struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
+	const uint32_t timeOutA = m_nCurrentPacketMillis - pPort->sourceA.time;
+	const uint32_t timeOutB = m_nCurrentPacketMillis - pPort->sourceB.time;
 
-	if ( (m_OutputPort.sourceA.ip != 0) && (m_OutputPort.sourceB.ip != 0) ) {
+	if ( (pPort->sourceA.ip != 0) && (pPort->sourceB.ip != 0) ) {
 		if ( (timeOutA < (uint32_t)(E131_PRIORITY_TIMEOUT_SECONDS * 1000)) || (timeOutB < (uint32_t)(E131_PRIORITY_TIMEOUT_SECONDS * 1000)) ) {
 			return false;
 		} else {
 			return true;
 		}
-	} else if ( (m_OutputPort.sourceA.ip != 0) && (m_OutputPort.sourceB.ip == 0) ) {
+	} else if ( (pPort->sourceA.ip != 0) && (pPort->sourceB.ip == 0) ) {
 		if (timeOutA > (uint32_t)(E131_PRIORITY_TIMEOUT_SECONDS * 1000)) {
 			return true;
 		}
-	} else if ( (m_OutputPort.sourceA.ip == 0) && (m_OutputPort.sourceB.ip != 0) ) {
+	} else if ( (pPort->sourceA.ip == 0) && (pPort->sourceB.ip != 0) ) {
 		if (timeOutB > (uint32_t)(E131_PRIORITY_TIMEOUT_SECONDS * 1000)) {
 			return true;
 		}
@@ -301,13 +418,14 @@ bool E131Bridge::isIpCidMatch(const struct TSource *source) {
 	return true;
 }
 
-void E131Bridge::HandleDmx(void) {
+void E131Bridge::HandleDmx(uint8_t nPortIndex) {
+	struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
 	const uint8_t *p = &m_E131.E131Packet.Data.DMPLayer.PropertyValues[1];
 	const uint16_t slots = __builtin_bswap16(m_E131.E131Packet.Data.DMPLayer.PropertyValueCount) - (uint16_t)1;
-	const uint32_t ipA = m_OutputPort.sourceA.ip;
-	const uint32_t ipB = m_OutputPort.sourceB.ip;
-	struct TSource *pSourceA = &m_OutputPort.sourceA;
-	struct TSource *pSourceB = &m_OutputPort.sourceB;
+	const uint32_t ipA = pPort->sourceA.ip;
+	const uint32_t ipB = pPort->sourceB.ip;
+	struct TSource *pSourceA = &pPort->sourceA;
+	struct TSource *pSourceB = &pPort->sourceB;
 	const bool isSourceA = isIpCidMatch(pSourceA);
 	const bool isSourceB = isIpCidMatch(pSourceB);
 
@@ -341,8 +459,8 @@ void E131Bridge::HandleDmx(void) {
 	// Any property values in these packets shall be ignored.
 	if ((m_E131.E131Packet.Data.FrameLayer.Options & E131_OPTIONS_MASK_STREAM_TERMINATED) != 0) {
 		if (isSourceA || isSourceB) {
-			if (!m_State.IsMergeMode) {
-				SetNetworkDataLossCondition();
+			if (!pPort->IsMergeMode) {
+				SetStreamTerminated(nPortIndex);
 			}
 		}
 		return;
@@ -363,20 +481,20 @@ void E131Bridge::HandleDmx(void) {
 		m_State.IsForcedSynchronized = false;
 	}
 
-	if (m_State.IsMergeMode) {
-		CheckMergeTimeouts();
+	if (pPort->IsMergeMode) {
+		CheckMergeTimeouts(nPortIndex);
 	}
 
-	if (m_E131.E131Packet.Data.FrameLayer.Priority < m_State.nPriority ){
-		if (!IsPriorityTimeOut()) {
+	if (m_E131.E131Packet.Data.FrameLayer.Priority < pPort->nPriority ){
+		if (!IsPriorityTimeOut(nPortIndex)) {
 			return;
 		}
-		m_State.nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
-	} else if (m_E131.E131Packet.Data.FrameLayer.Priority > m_State.nPriority) {
-		m_OutputPort.sourceA.ip = 0;
-		m_OutputPort.sourceB.ip = 0;
-		m_State.IsMergeMode = false;
-		m_State.nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
+		pPort->nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
+	} else if (m_E131.E131Packet.Data.FrameLayer.Priority > pPort->nPriority) {
+		pPort->sourceA.ip = 0;
+		pPort->sourceB.ip = 0;
+		pPort->IsMergeMode = false;
+		pPort->nPriority = m_E131.E131Packet.Data.FrameLayer.Priority;
 	}
 
 	if ((ipA == 0) && (ipB == 0)) {
@@ -386,55 +504,55 @@ void E131Bridge::HandleDmx(void) {
 		memcpy(pSourceA->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
 		pSourceA->time = m_nCurrentPacketMillis;
 		memcpy((void *)pSourceA->data, (const void *)p, slots);
-		sendNewData = IsDmxDataChanged(p, slots);
+		sendNewData = IsDmxDataChanged(nPortIndex, p, slots);
 
 	} else if (isSourceA && (ipB == 0)) {
 		//printf("2. Continue package from SourceA\n");
 		pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
 		pSourceA->time = m_nCurrentPacketMillis;
 		memcpy((void *)pSourceA->data, (const void *)p, slots);
-		sendNewData = IsDmxDataChanged(p, slots);
+		sendNewData = IsDmxDataChanged(nPortIndex, p, slots);
 
 	} else if ((ipA == 0) && isSourceB) {
 		//printf("3. Continue package from SourceB\n");
 		pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
 		pSourceB->time = m_nCurrentPacketMillis;
 		memcpy((void *)pSourceB->data, (const void *)p, slots);
-		sendNewData = IsDmxDataChanged(p, slots);
+		sendNewData = IsDmxDataChanged(nPortIndex, p, slots);
 
 	} else if (!isSourceA && (ipB == 0)) {
 		//printf("4. New ip, start merging\n");
 		pSourceB->ip = m_E131.IPAddressFrom;
 		pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-		memcpy(m_OutputPort.sourceB.cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
+		memcpy(pSourceB->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
 		pSourceB->time = m_nCurrentPacketMillis;
-		m_State.IsMergeMode = true;
+		pPort->IsMergeMode = true;
 		memcpy((void *)pSourceB->data, (const void *)p, slots);
-		sendNewData = IsMergedDmxDataChanged(pSourceB->data, slots);
+		sendNewData = IsMergedDmxDataChanged(nPortIndex, pSourceB->data, slots);
 
 	} else if ((ipA == 0) && !isSourceB) {
 		//printf("5. New ip, start merging\n");
 		pSourceA->ip = m_E131.IPAddressFrom;
 		pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
-		memcpy(m_OutputPort.sourceA.cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
+		memcpy(pSourceA->cid, m_E131.E131Packet.Data.RootLayer.Cid, 16);
 		pSourceA->time = m_nCurrentPacketMillis;
-		m_State.IsMergeMode = true;
+		pPort->IsMergeMode = true;
 		memcpy((void *)pSourceA->data, (const void *)p, slots);
-		sendNewData = IsMergedDmxDataChanged(pSourceA->data, slots);
+		sendNewData = IsMergedDmxDataChanged(nPortIndex, pSourceA->data, slots);
 
 	} else if (isSourceA && !isSourceB) {
 		//printf("6. Continue merging\n");
 		pSourceA->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
 		pSourceA->time = m_nCurrentPacketMillis;
 		memcpy((void *)pSourceA->data, (const void *)p, slots);
-		sendNewData = IsMergedDmxDataChanged(pSourceA->data, slots);
+		sendNewData = IsMergedDmxDataChanged(nPortIndex, pSourceA->data, slots);
 
 	} else if (!isSourceA && isSourceB) {
 		//printf("7. Continue merging\n");
 		pSourceB->sequenceNumberData = m_E131.E131Packet.Data.FrameLayer.SequenceNumber;
 		pSourceB->time = m_nCurrentPacketMillis;
 		memcpy((void *)pSourceB->data, (const void *)p, slots);
-		sendNewData = IsMergedDmxDataChanged(pSourceB->data, slots);
+		sendNewData = IsMergedDmxDataChanged(nPortIndex, pSourceB->data, slots);
 
 	} else if (isSourceA && isSourceB) {
 		//printf("8. Source matches both buffers, this shouldn't be happening!\n");
@@ -451,35 +569,65 @@ void E131Bridge::HandleDmx(void) {
 
 	if (sendNewData) {
 		if (!m_State.IsSynchronized) {
-			m_pLightSet->SetData(0, m_OutputPort.data, m_OutputPort.length);
+			m_pLightSet->SetSource(m_E131.IPAddressFrom, E131_VECTOR_DATA_PACKET);
+			m_pLightSet->SetData(nPortIndex, pPort->data, pPort->length);
 			Start();
 		} else {
-			m_OutputPort.IsDataPending = true;
+			pPort->IsDataPending = true;
 		}
-
-
 	}
 }
 
 void E131Bridge::HandleSynchronization(void) {
-	if (m_E131.E131Packet.Synchronization.FrameLayer.UniverseNumber != __builtin_bswap16(m_nUniverse)) {
+	if (LookupPort(__builtin_bswap16(m_E131.E131Packet.Synchronization.FrameLayer.UniverseNumber)) == E131_MAX_PORTS) {
 		return;
 	}
 
 	m_State.IsSynchronized = true;
 	m_State.SynchronizationTime = m_nCurrentPacketMillis;
 
-	if (m_OutputPort.IsDataPending) {
-		m_pLightSet->SetData(0, m_OutputPort.data, m_OutputPort.length);
-		Start();
-		m_OutputPort.IsDataPending = false;
+	m_pLightSet->SetSource(m_E131.IPAddressFrom, E131_VECTOR_EXTENDED_SYNCHRONIZATION);
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if (m_OutputPorts[i].IsDataPending) {
+			m_pLightSet->SetData(i, m_OutputPorts[i].data, m_OutputPorts[i].length);
+			Start();
+			m_OutputPorts[i].IsDataPending = false;
+		}
 	}
+
+	m_pLightSet->Sync();
 }
 
 void E131Bridge::SetNetworkDataLossCondition(void) {
 	Stop();
-	m_OutputPort.sourceA.ip = (uint32_t) 0;
-	m_OutputPort.sourceB.ip = (uint32_t) 0;
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		m_OutputPorts[i].sourceA.ip = (uint32_t) 0;
+		m_OutputPorts[i].sourceB.ip = (uint32_t) 0;
+	}
+}
+
+/**
+ * A terminated stream only affects its own universe. The output is stopped
+ * when no other port is receiving data anymore.
+ */
+void E131Bridge::SetStreamTerminated(uint8_t nPortIndex) {
+	struct TOutputPort *pPort = &m_OutputPorts[nPortIndex];
+
+	pPort->sourceA.ip = (uint32_t) 0;
+	pPort->sourceB.ip = (uint32_t) 0;
+	pPort->length = 0;
+	pPort->IsDataPending = false;
+	pPort->nPriority = E131_PRIORITY_LOWEST;
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if ((m_OutputPorts[i].sourceA.ip != 0) || (m_OutputPorts[i].sourceB.ip != 0)) {
+			return;
+		}
+	}
+
+	SetNetworkDataLossCondition();
 }
 
 void E131Bridge::SendDiscoveryPacket(void) {
@@ -505,13 +653,6 @@ bool E131Bridge::IsValidRoot(void) {
 bool E131Bridge::IsValidDataPacket(void) {
 	// Frame layer
 
-	// 8.2 Association of Multicast Addresses and Universe
-	// Note: The identity of the universe shall be determined by the universe number in the
-	// packet and not assumed from the multicast address.
-	if (m_E131.E131Packet.Data.FrameLayer.Universe != __builtin_bswap16(m_nUniverse)) {
-		return false;
-	}
-
 	// DMP layer
 
 	// The DMP Layer's Vector shall be set to 0x02, which indicates a DMP Set Property message by
@@ -541,12 +682,37 @@ bool E131Bridge::IsValidDataPacket(void) {
 	return true;
 }
 
+/**
+ * Timers : the universe discovery interval and, while transmitting, the network
+ * data loss timeout. The synchronization timeout is evaluated on packet arrival only.
+ */
+uint32_t E131Bridge::GetMillisToNextTimer(void) {
+	const uint32_t nNow = Hardware::Get()->Millis();
+
+	const uint32_t nDiscoveryElapsed = nNow - m_State.DiscoveryTime;
+	uint32_t nMillis = (nDiscoveryElapsed >= (E131_UNIVERSE_DISCOVERY_INTERVAL_SECONDS * 1000)) ? 0 : (E131_UNIVERSE_DISCOVERY_INTERVAL_SECONDS * 1000) - nDiscoveryElapsed;
+
+	if (m_State.IsTransmitting) {
+		const uint32_t nDataLossElapsed = nNow - m_nPreviousPacketMillis;
+		const uint32_t nDataLossTimeout = (uint32_t)(E131_NETWORK_DATA_LOSS_TIMEOUT_SECONDS * 1000);
+		nMillis = MIN(nMillis, (nDataLossElapsed >= nDataLossTimeout) ? 0 : nDataLossTimeout - nDataLossElapsed);
+	}
+
+	return nMillis;
+}
+
 int E131Bridge::Run(void) {
+#if defined (NETWORK_HAVE_RECV_BURST)
+	struct TNetworkDatagram aDatagrams[NETWORK_RECV_BURST_MAX];
+
+	const uint16_t nDatagrams = Network::Get()->RecvBurst(aDatagrams, NETWORK_RECV_BURST_MAX);
+#else
 	const char *packet = (char *) &(m_E131.E131Packet);
 	uint16_t nForeignPort;
-	uint32_t IPAddressFrom;
 
-	const int nBytesReceived = Network::Get()->RecvFrom((const uint8_t *)packet, (const uint16_t)sizeof(m_E131.E131Packet), &IPAddressFrom, &nForeignPort) ;
+	const int nBytesReceived = Network::Get()->RecvFrom((const uint8_t *)packet, (const uint16_t)sizeof(m_E131.E131Packet), &m_E131.IPAddressFrom, &nForeignPort) ;
+	const uint16_t nDatagrams = (nBytesReceived == 0) ? 0 : 1;
+#endif
 
 	m_nCurrentPacketMillis = Hardware::Get()->Millis();
 
@@ -554,13 +720,36 @@ int E131Bridge::Run(void) {
 		SendDiscoveryPacket();
 	}
 
-	if (nBytesReceived == 0) {
+	if (nDatagrams == 0) {
 		if ((m_nCurrentPacketMillis - m_nPreviousPacketMillis) >= (uint32_t)(E131_NETWORK_DATA_LOSS_TIMEOUT_SECONDS * 1000)) {
 			SetNetworkDataLossCondition();
 		}
 		return 0;
 	}
 
+#if defined (NETWORK_HAVE_RECV_BURST)
+	int nBytesHandled = 0;
+
+	// Drain the whole burst, the timers above are evaluated once per burst
+	for (unsigned i = 0; i < nDatagrams; i++) {
+		const uint16_t nLength = MIN(aDatagrams[i].nLength, (uint16_t) sizeof(m_E131.E131Packet));
+
+		memcpy(&m_E131.E131Packet, aDatagrams[i].pData, nLength);
+		m_E131.IPAddressFrom = aDatagrams[i].nFromIp;
+		m_E131.length = nLength;
+
+		nBytesHandled += HandleE131Packet();
+	}
+
+	return nBytesHandled;
+#else
+	m_E131.length = nBytesReceived;
+
+	return HandleE131Packet();
+#endif
+}
+
+int E131Bridge::HandleE131Packet(void) {
 	if (!IsValidRoot()) {
 		return 0;
 	}
@@ -576,10 +765,16 @@ int E131Bridge::Run(void) {
 	const uint32_t nRootVector = __builtin_bswap32(m_E131.E131Packet.Raw.RootLayer.Vector);
 
 	if (nRootVector == E131_VECTOR_ROOT_DATA) {
-		if (!IsValidDataPacket()) {
+		// 8.2 Association of Multicast Addresses and Universe
+		// Note: The identity of the universe shall be determined by the universe number in the
+		// packet and not assumed from the multicast address.
+		const uint8_t nPortIndex = LookupPort(__builtin_bswap16(m_E131.E131Packet.Data.FrameLayer.Universe));
+
+		if ((nPortIndex == E131_MAX_PORTS) || !IsValidDataPacket()) {
 			return 0;
 		}
-		HandleDmx();
+
+		HandleDmx(nPortIndex);
 	} else if (nRootVector == E131_VECTOR_ROOT_EXTENDED) {
 		const uint32_t nFramingVector = __builtin_bswap32(m_E131.E131Packet.Raw.FrameLayer.Vector);
 
@@ -589,5 +784,5 @@ int E131Bridge::Run(void) {
 
 	}
 
-	return nBytesReceived;
+	return m_E131.length;
 }
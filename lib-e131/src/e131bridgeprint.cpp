@@ -32,7 +32,7 @@
 
 #include "network.h"
 
-void E131Bridge::Print(uint32_t nMulticastIp) {
+void E131Bridge::Print(void) {
 	char uuid_str[UUID_STRING_LENGTH + 1];
 
 	uuid_str[UUID_STRING_LENGTH] = '\0';
@@ -44,8 +44,13 @@ void E131Bridge::Print(uint32_t nMulticastIp) {
 	const uint8_t *firmware_version = GetSoftwareVersion();
 	printf(" Firmware     : %d.%d\n", firmware_version[0], firmware_version[1]);
 	printf(" CID          : %s\n", uuid_str);
-	printf(" Universe     : %d\n", getUniverse());
-	printf(" Merge mode   : %s\n", getMergeMode() == E131_MERGE_HTP ? "HTP" : "LTP");
-	printf(" Multicast ip : " IPSTR "\n", IP2STR(nMulticastIp));
+	printf(" Active ports : %d\n", GetActivePorts());
+
+	for (unsigned i = 0; i < E131_MAX_PORTS; i++) {
+		if (m_OutputPorts[i].bIsEnabled) {
+			printf(" Port %-2d      : Universe %d, %s, Multicast ip " IPSTR "\n", i, m_OutputPorts[i].nUniverse, m_OutputPorts[i].mergeMode == E131_MERGE_HTP ? "HTP" : "LTP", IP2STR(UniverseToMulticastIp(m_OutputPorts[i].nUniverse)));
+		}
+	}
+
 	printf(" Unicast ip   : " IPSTR "\n", IP2STR(ip));
 }
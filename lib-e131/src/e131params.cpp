@@ -48,12 +48,14 @@
 #define SET_MERGE_MODE_MASK	1<<1
 #define SET_OUTPUT_MASK		1<<2
 #define SET_CID_MASK		1<<3
+#define SET_UNIVERSES_MASK	1<<4
 
 static const char PARAMS_FILE_NAME[] ALIGNED = "e131.txt";
 static const char PARAMS_UNIVERSE[] ALIGNED = "universe";
 static const char PARAMS_MERGE_MODE[] ALIGNED = "merge_mode";
 static const char PARAMS_OUTPUT[] ALIGNED = "output";
 static const char PARAMS_CID[] ALIGNED = "cid";
+static const char PARAMS_UNIVERSES[] ALIGNED = "universes";
 
 void E131Params::staticCallbackFunction(void *p, const char *s) {
 	assert(p != 0);
@@ -79,6 +81,18 @@ void E131Params::callbackFunction(const char *pLine) {
 		return;
 	}
 
+	uint8_t value8;
+
+	if (Sscan::Uint8(pLine, PARAMS_UNIVERSES, &value8) == SSCAN_OK) {
+		if (value8 == 0 || value8 > E131_MAX_PORTS) {
+			m_nUniverses = 1;
+		} else {
+			m_nUniverses = value8;
+		}
+		m_bSetList |= SET_UNIVERSES_MASK;
+		return;
+	}
+
 	len = 3;
 	if (Sscan::Char(pLine, PARAMS_OUTPUT, value, &len) == SSCAN_OK) {
 		if(memcmp(value, "mon", 3) == 0) {
@@ -109,6 +123,7 @@ void E131Params::callbackFunction(const char *pLine) {
 
 E131Params::E131Params(void): m_bSetList(0) {
 	m_nUniverse = E131_UNIVERSE_DEFAULT;
+	m_nUniverses = 1;
 	m_tMergeMode = E131_MERGE_HTP;
 	m_tOutputType = OUTPUT_TYPE_DMX;
 	memset(m_aCidString, 0, sizeof(m_aCidString));
@@ -133,8 +148,10 @@ void E131Params::Set(E131Bridge *pE131Bridge) {
 		return;
 	}
 
-	if (isMaskSet(SET_UNIVERSE_MASK)) {
-		pE131Bridge->setUniverse(m_nUniverse);
+	if (isMaskSet(SET_UNIVERSE_MASK) || isMaskSet(SET_UNIVERSES_MASK)) {
+		for (unsigned i = 0; i < m_nUniverses; i++) {
+			pE131Bridge->setUniverse(i, GetUniverse(i));
+		}
 	}
 
 	if (isMaskSet(SET_MERGE_MODE_MASK)) {
@@ -155,6 +172,10 @@ void E131Params::Dump(void) {
 		printf(" %s=%d\n", PARAMS_UNIVERSE, (int) m_nUniverse);
 	}
 
+	if (isMaskSet(SET_UNIVERSES_MASK)) {
+		printf(" %s=%d\n", PARAMS_UNIVERSES, (int) m_nUniverses);
+	}
+
 	if (isMaskSet(SET_CID_MASK)) {
 		printf(" %s=%s\n", PARAMS_CID, m_aCidString);
 	}
@@ -173,6 +194,23 @@ uint16_t E131Params::GetUniverse(void) const {
 	return m_nUniverse;
 }
 
+uint8_t E131Params::GetUniverses(void) const {
+	return m_nUniverses;
+}
+
+/**
+ * The ports receive consecutive universes, starting at \ref PARAMS_UNIVERSE
+ */
+uint16_t E131Params::GetUniverse(uint8_t nPortIndex) const {
+	const uint32_t nUniverse = (uint32_t) m_nUniverse + nPortIndex;
+
+	if (nUniverse > E131_UNIVERSE_MAX) {
+		return E131_UNIVERSE_MAX;
+	}
+
+	return (uint16_t) nUniverse;
+}
+
 TOutputType E131Params::GetOutputType(void) const {
 	return m_tOutputType;
 }
@@ -0,0 +1,53 @@
+/**
+ * @file glyph.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef GLYPH_H_
+#define GLYPH_H_
+
+#include <stdint.h>
+
+#define GLYPH_W		8	///< Character cell width in pixels
+#define GLYPH_H		16	///< Character cell height in pixels
+
+/**
+ * A 16 bits per pixel (RGB565) frame buffer. This can be the display or a buffer in memory.
+ */
+struct glyph_surface {
+	void *address;		///< First pixel, 32-bit aligned
+	uint32_t width;		///< In pixels, even. The pitch is width * 2 bytes
+	uint32_t height;	///< In pixels
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void glyph_draw_char(const struct glyph_surface *, const int, const int, const int, const uint16_t, const uint16_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GLYPH_H_ */
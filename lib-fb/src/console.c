@@ -34,11 +34,10 @@
 #include "bcm2835_vc.h"
 
 #include "console.h"
+#include "glyph.h"
 
-extern unsigned char FONT[];
-
-#define CHAR_W				8							///<
-#define CHAR_H				16							///<
+#define CHAR_W				GLYPH_W						///<
+#define CHAR_H				GLYPH_H						///<
 #define WIDTH				800							///< Requested width of physical display
 #define HEIGHT				480							///< Requested height of physical display
 #define BYTES_PER_PIXEL		2							///< bytes per pixel for requested depth (BPP)
@@ -56,6 +55,7 @@ static uint16_t saved_back = CONSOLE_BLACK;	///<
 static uint32_t fb_addr;					///< Address of buffer allocated by VC
 static uint32_t fb_size;					///< Size of buffer allocated by VC
 static uint32_t fb_depth;					///< Depth (bits per pixel)
+static struct glyph_surface surface;		///< The frame buffer for glyph_draw_char
 
 static uint16_t top_row = (uint16_t) 0;		///<
 
@@ -182,44 +182,6 @@ inline static void newline() {
 	}
 }
 
-/**
- *
- * @param x
- * @param y
- * @param color
- */
-inline static void draw_pixel(const int x, const int y, const uint16_t color) {
-	volatile uint16_t *address = (volatile uint16_t *)(fb_addr + (x * BYTES_PER_PIXEL) + (y * WIDTH * BYTES_PER_PIXEL));
-	*address = color;
-}
-
-/**
- *
- * @param c
- * @param x
- * @param y
- * @param fore
- * @param back
- */
-inline static void draw_char(const int c, const int x, int y, const uint16_t fore, const uint16_t back) {
-	int i, j;
-	uint8_t line;
-	unsigned char *p = FONT + (c * (int) CHAR_H);
-
-	for (i = 0; i < CHAR_H; i++) {
-		line = (uint8_t) *p++;
-		for (j = x; j < (CHAR_W + x); j++) {
-			if ((line & 0x1) != 0) {
-				draw_pixel(j, y, fore);
-			} else {
-				draw_pixel(j, y, back);
-			}
-			line >>= 1;
-		}
-		y++;
-	}
-}
-
 /**
  * Prints character ch with the specified color at position (col, row).
  *
@@ -231,7 +193,7 @@ inline static void draw_char(const int c, const int x, int y, const uint16_t for
  * @return
  */
 int console_draw_char(const int ch, const int x, const int y, const uint16_t fore, const uint16_t back) {
-	draw_char(ch, x * CHAR_W, y * CHAR_H, fore, back);
+	glyph_draw_char(&surface, ch, x, y, fore, back);
 	return (int)ch;
 }
 
@@ -260,7 +222,7 @@ int console_putc(const int ch) {
 	} else if (ch == (int)'\t') {
 		current_x += 4;
 	} else {
-		draw_char(ch, current_x * CHAR_W, current_y * CHAR_H, cur_fore, cur_back);
+		glyph_draw_char(&surface, ch, current_x, current_y, cur_fore, cur_back);
 		current_x++;
 		if (current_x == WIDTH / CHAR_W) {
 			newline();
@@ -601,6 +563,10 @@ int console_init() {
 
 	fb_depth = mailbuffer[15];
 
+	surface.address = (void *) fb_addr;
+	surface.width = WIDTH;
+	surface.height = HEIGHT;
+
 #if defined (ARM_ALLOW_MULTI_CORE)
 	lock = 0;
 #endif
@@ -0,0 +1,67 @@
+/**
+ * @file glyph.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "glyph.h"
+
+extern unsigned char FONT[];
+
+/**
+ * Prints character ch with the specified color at position (col, row).
+ *
+ * A font row is 8 pixels, which are written as 4 words of 2 pixels.
+ * The least significant bit of the font row is the left pixel, which is the lower half of the word.
+ *
+ * @param surface The frame buffer.
+ * @param ch The character to display.
+ * @param x The column in which to display the character.
+ * @param y The row in which to display the character.
+ * @param fore The foreground color to use to display the character.
+ * @param back The background color to use to display the character.
+ */
+void glyph_draw_char(const struct glyph_surface *surface, const int ch, const int x, const int y, const uint16_t fore, const uint16_t back) {
+	const uint32_t pitch = surface->width / 2;
+	uint32_t *address = (uint32_t *) surface->address + (uint32_t) (y * GLYPH_H) * pitch + (uint32_t) (x * GLYPH_W) / 2;
+	const unsigned char *p = FONT + (ch * GLYPH_H);
+	uint32_t pattern[4];
+	int i;
+
+	pattern[0] = ((uint32_t) back << 16) | (uint32_t) back;
+	pattern[1] = ((uint32_t) back << 16) | (uint32_t) fore;
+	pattern[2] = ((uint32_t) fore << 16) | (uint32_t) back;
+	pattern[3] = ((uint32_t) fore << 16) | (uint32_t) fore;
+
+	for (i = 0; i < GLYPH_H; i++) {
+		const uint8_t line = (uint8_t) *p++;
+
+		address[0] = pattern[line & 0x3];
+		address[1] = pattern[(line >> 2) & 0x3];
+		address[2] = pattern[(line >> 4) & 0x3];
+		address[3] = pattern[line >> 6];
+
+		address += pitch;
+	}
+}
@@ -30,6 +30,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "i2c_queue.h"
+
 typedef enum {
 	I2C_CLOCK_DIVIDER_100kHz	= 2500,		///< 2500 = 10us = 100 kHz
 	I2C_CLOCK_DIVIDER_400kHz	= 626		///< 622 = 2.504us = 399.3610 kHz
@@ -42,11 +44,15 @@ extern "C" {
 extern bool i2c_begin(void);
 extern void i2c_set_address(uint8_t);
 extern void i2c_set_clockdivider(uint16_t);
+extern void i2c_set_priority(i2c_priority_t);
+extern void i2c_set_gap(uint16_t);
 
 extern bool i2c_is_connected(uint8_t);
 
+extern uint8_t i2c_read(/*@out@*/char *, uint32_t);
 extern uint8_t i2c_read_uint8(void);
 extern uint16_t i2c_read_uint16(void);
+extern uint8_t i2c_read_reg_uint8(uint8_t);
 extern uint16_t i2c_read_reg_uint16(uint8_t);
 extern uint16_t i2c_read_reg_uint16_delayus(uint8_t, uint32_t);
 
@@ -57,6 +63,8 @@ extern void i2c_write_uint16(uint16_t);
 extern void i2c_write_reg_uint16(uint8_t, uint16_t);
 extern void i2c_write_reg_uint16_mask(uint8_t, uint16_t, uint16_t);
 
+extern void i2c_delayus(uint32_t);
+
 extern /*@observer@*/const char *i2c_lookup_device(uint8_t);
 
 #ifdef __cplusplus
@@ -0,0 +1,74 @@
+/**
+ * @file i2c_mock.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef I2C_MOCK_H_
+#define I2C_MOCK_H_
+
+#include <stdint.h>
+
+#define I2C_MOCK_ADDRESSES		128
+#define I2C_MOCK_REGISTERS		256
+#define I2C_MOCK_SERVICE_NS		10000	///< Virtual time passing with each call of the service and the micros function
+
+/*
+ * The i2c_backend_mock is a bus with pluggable devices, for testing on Linux without hardware.
+ * Install it with i2c_queue_init(&i2c_backend_mock) before i2c_begin.
+ * A transaction takes its bus time on a virtual clock which advances when the queue is serviced,
+ * so it completes asynchronously, as with the interrupt driven backend.
+ * A slave address without a device returns a NACK.
+ */
+
+struct i2c_mock_device {
+	uint8_t (*write)(uint8_t, const uint8_t *, uint32_t);	///< Returns the i2c_reason_t
+	uint8_t (*read)(uint8_t, uint8_t *, uint32_t);			///< Returns the i2c_reason_t
+};
+
+struct i2c_mock_statistics {
+	uint32_t writes;			// Transactions
+	uint32_t reads;				// Transactions
+	uint32_t bytes;				// Including the address byte
+	uint32_t nacks;
+	uint64_t bus_time;			// ns, at the clock divider of the transaction
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void i2c_mock_reset(void);
+extern void i2c_mock_attach(uint8_t, /*@null@*/const struct i2c_mock_device *);
+extern void i2c_mock_attach_registers(uint8_t);
+
+extern uint8_t i2c_mock_get_register(uint8_t, uint8_t);
+extern void i2c_mock_set_register(uint8_t, uint8_t, uint8_t);
+
+extern const struct i2c_mock_statistics *i2c_mock_get_statistics(void);
+extern uint64_t i2c_mock_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_MOCK_H_ */
@@ -0,0 +1,130 @@
+/**
+ * @file i2c_queue.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef I2C_QUEUE_H_
+#define I2C_QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define I2C_QUEUE_SIZE		16	///< Transactions per priority level, must be a power of 2
+#define I2C_QUEUE_DATA_SIZE	72	///< Bytes copied into a transaction, the PCA9685 all channels burst is 65
+
+typedef enum {
+	I2C_PRIORITY_HIGH = 0,		///< Outputs, PCA9685
+	I2C_PRIORITY_NORMAL,		///< Sensors, the default
+	I2C_PRIORITY_LOW,			///< Displays
+	I2C_PRIORITY_LEVELS
+} i2c_priority_t;
+
+typedef enum {
+	I2C_REASON_OK			= 0x00,	///< Success
+	I2C_REASON_ERROR_NACK	= 0x01,	///< Received a NACK
+	I2C_REASON_ERROR_CLKT	= 0x02,	///< Received Clock Stretch Timeout
+	I2C_REASON_ERROR_DATA	= 0x04	///< Not all data is sent / received
+} i2c_reason_t;
+
+typedef void (*i2c_callback_t)(void *, uint8_t);
+
+/**
+ * A write, an optional bus idle time and a read, to one slave.
+ * Without a write and without a read the transaction only keeps the bus idle for delay_us.
+ * Without a write, a read and a delay it is an address only write (probe).
+ */
+struct i2c_transaction {
+	uint8_t address;
+	uint8_t priority;
+	uint16_t clock_divider;
+	const uint8_t *write_data;		///< Points to buffer, or to caller data which must stay valid until done
+	uint32_t write_length;
+	uint32_t delay_us;
+	char *read_data;				///< Caller data, valid when the callback is called
+	uint32_t read_length;
+	i2c_callback_t callback;		///< Called from i2c_queue_run, never from the interrupt handler
+	void *arg;
+	volatile bool is_done;
+	volatile uint8_t reason;
+	uint8_t state;					///< Backend
+	uint32_t index;					///< Backend
+	uint32_t timestamp;				///< Backend
+	uint8_t buffer[I2C_QUEUE_DATA_SIZE];
+};
+
+/**
+ * start is called when the bus is free. service is called until it returns true, with the reason set.
+ * In interrupt mode both are called with the interrupts disabled or from the interrupt handler.
+ */
+struct i2c_backend {
+	bool (*begin)(void);
+	void (*set_irq)(bool);			///< NULL, the backend has no interrupt
+	void (*start)(struct i2c_transaction *);
+	bool (*service)(struct i2c_transaction *);
+	uint32_t (*micros)(void);		///< NULL, the gap is kept as a bus idle time after each write
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const struct i2c_backend i2c_backend_bcm2835;	///< BSC1, Bare metal and Circle
+extern const struct i2c_backend i2c_backend_linux;		///< /dev/i2c-1
+extern const struct i2c_backend i2c_backend_mock;		///< See i2c_mock.h
+
+extern void i2c_queue_init(/*@null@*/const struct i2c_backend *);
+extern /*@null@*/const struct i2c_backend *i2c_queue_get_backend(void);
+extern bool i2c_queue_begin(void);
+
+extern void i2c_queue_set_priority(uint8_t, i2c_priority_t);
+extern i2c_priority_t i2c_queue_get_priority(uint8_t);
+
+/*
+ * The minimum time between the end of a transfer and the start of the next transfer to the same slave.
+ * Only the remaining time is waited for, and the other slaves can use the bus meanwhile.
+ */
+extern void i2c_queue_set_gap(uint8_t, uint16_t);
+extern uint16_t i2c_queue_get_gap(uint8_t);
+
+/*
+ * Interrupt mode, bare metal only. The application calls i2c_queue_irq_handler from its IRQ handler,
+ * enables the interrupts and calls i2c_queue_run from its main loop, for the callbacks and the bus idle times.
+ * Without interrupts the queue is run by the lib-i2c functions while they wait.
+ */
+extern void i2c_queue_set_irq(bool);
+extern bool i2c_queue_is_irq(void);
+extern void i2c_queue_irq_handler(void);
+
+extern struct i2c_transaction *i2c_queue_alloc(uint8_t, uint16_t);
+extern void i2c_queue_submit(struct i2c_transaction *);
+extern uint8_t i2c_queue_submit_wait(struct i2c_transaction *);
+
+extern void i2c_queue_run(void);
+extern void i2c_queue_flush(void);
+extern bool i2c_queue_is_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_QUEUE_H_ */
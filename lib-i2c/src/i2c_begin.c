@@ -23,44 +23,23 @@
  * THE SOFTWARE.
  */
 
-#include <stdio.h>
 #include <stdbool.h>
-
-#include "bcm2835.h"
-
 #if defined(__linux__)
-#include <stdlib.h>
-#include <unistd.h>
-#include <sys/types.h>
-static bool _begin = false;
-#else
-#include "bcm2835_i2c.h"
+ #include <stdio.h>
 #endif
 
+#include "i2c.h"
+
+/*
+ * Without a backend set with i2c_queue_init, Linux uses /dev/i2c-1 and bare metal the BSC1 registers.
+ */
 bool i2c_begin(void) {
+	if (!i2c_queue_begin()) {
 #if defined(__linux__)
-	if (_begin) {
-		return true;
-	}
-
-	if (getuid() != 0) {
-		fprintf(stderr, "Error: Not started with 'root'\n");
-		return false;
-	}
-
-	if (bcm2835_init() != 1) {
-		fprintf(stderr, "bcm2835_init() failed\n");
+		fprintf(stderr, "i2c_queue_begin() failed\n");
+#endif
 		return false;
-	} else {
-		_begin = true;
 	}
 
-	if (bcm2835_i2c_begin() != 1) {
-		fprintf(stderr, "bcm2835_i2c_begin() failed\n");
-	}
-#else
-	bcm2835_i2c_begin();
-#endif
-
 	return true;
 }
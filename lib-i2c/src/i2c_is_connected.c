@@ -27,24 +27,24 @@
 #include <stddef.h>
 #include <stdbool.h>
 
-#if defined(__linux__)
-#include "bcm2835.h"
-#else
-#include "bcm2835_i2c.h"
-#endif
+#include "i2c.h"
+
+#include "i2c_internal.h"
 
 const bool i2c_is_connected(const uint8_t address) {
-	uint8_t ret;
+	struct i2c_transaction *txn;
 	char buf;
 
-	bcm2835_i2c_setSlaveAddress(address);
+	i2c_set_address(address);
+
+	txn = i2c_queue_alloc(address, i2c_clock_divider);
 
 	if ((address >= 0x30 && address <= 0x37) || (address >= 0x50 && address <= 0x5F)) {
-		ret = bcm2835_i2c_read(&buf, 1);
+		txn->read_data = &buf;
+		txn->read_length = 1;
 	} else {
 		/* This is known to corrupt the Atmel AT24RF08 EEPROM */
-		ret = bcm2835_i2c_write(NULL, 0);
 	}
 
-	return (ret == (uint8_t) 0) ? true : false;
+	return (i2c_queue_submit_wait(txn) == (uint8_t) I2C_REASON_OK) ? true : false;
 }
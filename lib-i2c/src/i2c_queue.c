@@ -0,0 +1,347 @@
+/**
+ * @file i2c_queue.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+#if defined(BARE_METAL)
+ #include "bcm2835.h"
+#endif
+
+#include "i2c_queue.h"
+
+#define I2C_QUEUE_MASK		(I2C_QUEUE_SIZE - 1)
+
+#if defined(__linux__)
+ #define I2C_BACKEND_DEFAULT	i2c_backend_linux
+#else
+ #define I2C_BACKEND_DEFAULT	i2c_backend_bcm2835
+#endif
+
+/*
+ * One ring for each priority level.
+ * [head, next) is started and waits for the callback, [next, tail) waits for the bus.
+ */
+struct i2c_ring {
+	uint32_t head;
+	volatile uint32_t next;
+	volatile uint32_t tail;
+	struct i2c_transaction txn[I2C_QUEUE_SIZE];
+};
+
+static struct i2c_ring s_ring[I2C_PRIORITY_LEVELS];
+static uint8_t s_priority[128] = { [0 ... 127] = I2C_PRIORITY_NORMAL };
+static uint16_t s_gap[128];
+static uint32_t s_done_us[128];
+
+static /*@null@*/const struct i2c_backend *s_backend = NULL;
+static /*@null@*/struct i2c_transaction * volatile s_active = NULL;
+static bool s_is_begin = false;
+static volatile bool s_is_irq = false;
+
+inline static void queue_lock(void) {
+#if defined(BARE_METAL)
+	if (s_is_irq) {
+		__disable_irq();
+	}
+#endif
+}
+
+inline static void queue_unlock(void) {
+#if defined(BARE_METAL)
+	if (s_is_irq) {
+		__enable_irq();
+	}
+#endif
+}
+
+inline static bool has_transfer(const struct i2c_transaction *txn) {
+	return (txn->write_length != 0) || (txn->read_length != 0) || (txn->delay_us == 0);
+}
+
+/*
+ * A bus idle time only transaction is not held up by the gap, and does not restart it.
+ */
+static bool is_gap_over(struct i2c_transaction *txn) {
+	const uint16_t gap = s_gap[txn->address];
+
+	if ((gap == 0) || !has_transfer(txn)) {
+		return true;
+	}
+
+	if (s_backend->micros == NULL) {
+		if ((txn->read_length == 0) && (txn->delay_us < gap)) {
+			txn->delay_us = gap;
+		}
+		return true;
+	}
+
+	return (s_backend->micros() - s_done_us[txn->address]) >= (uint32_t) gap;
+}
+
+/*
+ * A ring waiting for a gap lets the lower priority levels use the bus.
+ * In interrupt mode it is started by the next i2c_queue_run.
+ */
+static bool start_next(void) {
+	uint32_t level;
+
+	for (level = 0; level < (uint32_t) I2C_PRIORITY_LEVELS; level++) {
+		struct i2c_ring *ring = &s_ring[level];
+
+		if ((ring->next != ring->tail) && is_gap_over(&ring->txn[ring->next & I2C_QUEUE_MASK])) {
+			s_active = &ring->txn[ring->next & I2C_QUEUE_MASK];
+			ring->next++;
+			s_backend->start(s_active);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Called with the interrupts disabled, or from the interrupt handler.
+ */
+static void engine(void) {
+	for (;;) {
+		if (s_active != NULL) {
+			if (!s_backend->service(s_active)) {
+				return;
+			}
+
+			if ((s_gap[s_active->address] != 0) && (s_backend->micros != NULL) && has_transfer(s_active)) {
+				s_done_us[s_active->address] = s_backend->micros();
+			}
+
+			s_active->is_done = true;
+			s_active = NULL;
+		}
+
+		if (!start_next()) {
+			return;
+		}
+	}
+}
+
+/*
+ * The slot is released before the callback is called, so a callback can submit again.
+ */
+static void deliver(void) {
+	uint32_t level;
+
+	for (level = 0; level < (uint32_t) I2C_PRIORITY_LEVELS; level++) {
+		struct i2c_ring *ring = &s_ring[level];
+
+		while (ring->head != ring->next) {
+			const struct i2c_transaction *txn = &ring->txn[ring->head & I2C_QUEUE_MASK];
+
+			if (!txn->is_done) {
+				break;
+			}
+
+			const i2c_callback_t callback = txn->callback;
+			void *arg = txn->arg;
+			const uint8_t reason = txn->reason;
+
+			ring->head++;
+
+			if (callback != NULL) {
+				callback(arg, reason);
+			}
+		}
+	}
+}
+
+void i2c_queue_init(const struct i2c_backend *backend) {
+	uint32_t level;
+
+	if ((s_backend != NULL) && s_is_irq) {
+		i2c_queue_set_irq(false);
+	}
+
+	for (level = 0; level < (uint32_t) I2C_PRIORITY_LEVELS; level++) {
+		s_ring[level].head = 0;
+		s_ring[level].next = 0;
+		s_ring[level].tail = 0;
+	}
+
+	s_active = NULL;
+	s_backend = backend;
+	s_is_begin = false;
+}
+
+const struct i2c_backend *i2c_queue_get_backend(void) {
+	return s_backend;
+}
+
+bool i2c_queue_begin(void) {
+	if (s_backend == NULL) {
+		s_backend = &I2C_BACKEND_DEFAULT;
+	}
+
+	if (!s_is_begin) {
+		s_is_begin = s_backend->begin();
+	}
+
+	return s_is_begin;
+}
+
+void i2c_queue_set_priority(uint8_t address, i2c_priority_t priority) {
+	assert(priority < I2C_PRIORITY_LEVELS);
+
+	s_priority[address & 0x7F] = (uint8_t) priority;
+}
+
+i2c_priority_t i2c_queue_get_priority(uint8_t address) {
+	return (i2c_priority_t) s_priority[address & 0x7F];
+}
+
+void i2c_queue_set_gap(uint8_t address, uint16_t gap_us) {
+	s_gap[address & 0x7F] = gap_us;
+
+	if ((s_backend != NULL) && (s_backend->micros != NULL)) {
+		s_done_us[address & 0x7F] = s_backend->micros() - (uint32_t) gap_us;
+	}
+}
+
+uint16_t i2c_queue_get_gap(uint8_t address) {
+	return s_gap[address & 0x7F];
+}
+
+void i2c_queue_set_irq(bool is_irq) {
+	if ((s_backend == NULL) || (s_backend->set_irq == NULL)) {
+		return;
+	}
+
+	i2c_queue_flush();
+
+	s_backend->set_irq(is_irq);
+	s_is_irq = is_irq;
+}
+
+bool i2c_queue_is_irq(void) {
+	return s_is_irq;
+}
+
+void i2c_queue_irq_handler(void) {
+	if (s_active != NULL) {
+		engine();
+	}
+}
+
+struct i2c_transaction *i2c_queue_alloc(uint8_t address, uint16_t clock_divider) {
+	const uint8_t priority = s_priority[address & 0x7F];
+	struct i2c_ring *ring = &s_ring[priority];
+	struct i2c_transaction *txn;
+
+	if (!s_is_begin) {
+		(void) i2c_queue_begin();
+	}
+
+	while ((ring->tail - ring->head) == (uint32_t) I2C_QUEUE_SIZE) {
+		i2c_queue_run();
+	}
+
+	txn = &ring->txn[ring->tail & I2C_QUEUE_MASK];
+
+	txn->address = address & 0x7F;
+	txn->priority = priority;
+	txn->clock_divider = clock_divider;
+	txn->write_data = txn->buffer;
+	txn->write_length = 0;
+	txn->delay_us = 0;
+	txn->read_data = NULL;
+	txn->read_length = 0;
+	txn->callback = NULL;
+	txn->arg = NULL;
+	txn->is_done = false;
+	txn->reason = I2C_REASON_OK;
+
+	return txn;
+}
+
+void i2c_queue_submit(struct i2c_transaction *txn) {
+	struct i2c_ring *ring = &s_ring[txn->priority];
+
+	assert(txn == &ring->txn[ring->tail & I2C_QUEUE_MASK]);
+
+	queue_lock();
+
+	ring->tail++;
+
+	if (s_active == NULL) {
+		engine();
+	}
+
+	queue_unlock();
+}
+
+uint8_t i2c_queue_submit_wait(struct i2c_transaction *txn) {
+	i2c_queue_submit(txn);
+
+	// The slot is not reused before the next i2c_queue_alloc
+	while (!txn->is_done) {
+		i2c_queue_run();
+	}
+
+	return txn->reason;
+}
+
+void i2c_queue_run(void) {
+	if (s_backend == NULL) {
+		return;
+	}
+
+	queue_lock();
+	engine();
+	queue_unlock();
+
+	deliver();
+}
+
+bool i2c_queue_is_idle(void) {
+	uint32_t level;
+
+	if (s_active != NULL) {
+		return false;
+	}
+
+	for (level = 0; level < (uint32_t) I2C_PRIORITY_LEVELS; level++) {
+		if (s_ring[level].head != s_ring[level].tail) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void i2c_queue_flush(void) {
+	while (!i2c_queue_is_idle()) {
+		i2c_queue_run();
+	}
+}
@@ -25,18 +25,39 @@
 
 #include <stdint.h>
 
-#if defined(__linux__)
-#include "bcm2835.h"
-#define udelay bcm2835_delayMicroseconds
-#else
-#include "bcm2835_i2c.h"
-#endif
+#include "i2c.h"
 
+#include "i2c_internal.h"
+
+/*
+ * A read waits for its own transaction, the writes queued before are done first.
+ */
+
+static uint8_t read_reg(uint8_t reg, char *buf, uint32_t len, uint32_t delayus) {
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
+
+	txn->buffer[0] = reg;
+	txn->write_length = 1;
+	txn->delay_us = delayus;
+	txn->read_data = buf;
+	txn->read_length = len;
+
+	return i2c_queue_submit_wait(txn);
+}
+
+uint8_t i2c_read(char *buf, uint32_t len) {
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
+
+	txn->read_data = buf;
+	txn->read_length = len;
+
+	return i2c_queue_submit_wait(txn);
+}
 
 uint8_t i2c_read_uint8(void) {
 	uint8_t buf[1] = { 0 };
 
-	(void) bcm2835_i2c_read((char *) buf, (uint32_t) 1);
+	(void) i2c_read((char *) buf, (uint32_t) 1);
 
 	return buf[0];
 }
@@ -44,29 +65,31 @@ uint8_t i2c_read_uint8(void) {
 uint16_t i2c_read_uint16(void) {
 	uint8_t buf[2] = { 0, 0 };
 
-	(void) bcm2835_i2c_read((char *) buf, (uint32_t) 2);
+	(void) i2c_read((char *) buf, (uint32_t) 2);
 
 	return (uint16_t) ((uint16_t) buf[0] << 8 | (uint16_t) buf[1]);
 }
 
+uint8_t i2c_read_reg_uint8(uint8_t reg) {
+	uint8_t buf[1] = { 0 };
+
+	(void) read_reg(reg, (char *) buf, (uint32_t) 1, 0);
+
+	return buf[0];
+}
+
 uint16_t i2c_read_reg_uint16(uint8_t reg) {
 	uint8_t buf[2] = { 0, 0 };
 
-	buf[0] = reg;
+	(void) read_reg(reg, (char *) buf, (uint32_t) 2, 0);
 
-	(void) bcm2835_i2c_write((char *) &buf[0], (uint32_t) 1);
-
-	return i2c_read_uint16();
+	return (uint16_t) ((uint16_t) buf[0] << 8 | (uint16_t) buf[1]);
 }
 
 uint16_t i2c_read_reg_uint16_delayus(uint8_t reg, uint32_t delayus) {
 	uint8_t buf[2] = { 0, 0 };
 
-	buf[0] = reg;
-
-	(void) bcm2835_i2c_write((char *) &buf[0], (uint32_t) 1);
+	(void) read_reg(reg, (char *) buf, (uint32_t) 2, delayus);
 
-	udelay(delayus);
-
-	return i2c_read_uint16();
+	return (uint16_t) ((uint16_t) buf[0] << 8 | (uint16_t) buf[1]);
 }
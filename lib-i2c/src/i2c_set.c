@@ -25,16 +25,29 @@
 
 #include <stdint.h>
 
-#if defined(__linux__)
-#include "bcm2835.h"
-#else
-#include "bcm2835_i2c.h"
-#endif
+#include "i2c.h"
+
+#include "i2c_internal.h"
+
+/*
+ * The transactions are queued, the slave address and the clock divider are taken when a transaction is queued.
+ */
+
+uint8_t i2c_address = 0;
+uint16_t i2c_clock_divider = I2C_CLOCK_DIVIDER_100kHz;
 
 void i2c_set_address(uint8_t address) {
-	bcm2835_i2c_setSlaveAddress(address);
+	i2c_address = address;
 }
 
 void i2c_set_clockdivider(uint16_t divider) {
-	bcm2835_i2c_setClockDivider(divider);
+	i2c_clock_divider = divider;
+}
+
+void i2c_set_priority(i2c_priority_t priority) {
+	i2c_queue_set_priority(i2c_address, priority);
+}
+
+void i2c_set_gap(uint16_t gap_us) {
+	i2c_queue_set_gap(i2c_address, gap_us);
 }
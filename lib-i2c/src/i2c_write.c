@@ -25,104 +25,83 @@
 
 #include <stdint.h>
 
-#include "bcm2835.h"
+#include "i2c.h"
 
-#if defined(__linux__)
-#else
-#include "bcm2835_i2c.h"
-#endif
+#include "i2c_internal.h"
 
-#include "i2c.h"
+/*
+ * In interrupt mode a write returns when it is queued, the data is copied.
+ * Otherwise it returns when it is on the bus, as the bcm2835_i2c_write did.
+ */
 
-void i2c_write_nb(const char *data, uint32_t length) {
-	(void) bcm2835_i2c_write(data, length);
-}
+static void write_submit(struct i2c_transaction *txn) {
+	i2c_queue_submit(txn);
 
-#if defined(__linux__)
-void i2c_write(uint8_t data) {
-	bcm2835_i2c_write((char *)&data, 1);
+	if (!i2c_queue_is_irq()) {
+		i2c_queue_flush();
+	}
 }
 
-void i2c_write_reg_uint8(uint8_t reg, uint8_t data) {
-	char buffer[2];
-	buffer[0] = reg;
-	buffer[1] = data;
-	bcm2835_i2c_write(buffer, 2);
-}
+void i2c_write_nb(const char *data, uint32_t length) {
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
+	uint32_t i;
+
+	if (length > (uint32_t) I2C_QUEUE_DATA_SIZE) {
+		// Does not fit, the caller data is used and the write waits
+		txn->write_data = (const uint8_t *) data;
+		txn->write_length = length;
+		(void) i2c_queue_submit_wait(txn);
+		return;
+	}
 
-void i2c_write_reg_uint16(uint8_t reg, uint16_t data) {
-	char buffer[3];
-	buffer[0] = reg;
-	buffer[1] = (char) (data >> 8);
-	buffer[2] = (char) (data & 0xFF);
+	for (i = 0; i < length; i++) {
+		txn->buffer[i] = (uint8_t) data[i];
+	}
 
-	bcm2835_i2c_write(buffer, 3);
-}
-#else
-void i2c_write(uint8_t data) {
-	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
-	BCM2835_BSC1->S = (uint32_t) (BCM2835_BSC_S_CLKT | BCM2835_BSC_S_ERR | BCM2835_BSC_S_DONE);
+	txn->write_length = length;
 
-	BCM2835_BSC1->DLEN = (uint32_t) 1;
-	BCM2835_BSC1->FIFO = (uint32_t) data;
+	write_submit(txn);
+}
 
-	BCM2835_BSC1->C = (uint32_t) (BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST);
+void i2c_write(uint8_t data) {
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
 
-	while ((BCM2835_BSC1->S & BCM2835_BSC_S_DONE) != BCM2835_BSC_S_DONE) {
-	}
+	txn->buffer[0] = data;
+	txn->write_length = 1;
 
-	BCM2835_BSC1->S = BCM2835_BSC_S_DONE;
+	write_submit(txn);
 }
 
 void i2c_write_uint16(uint16_t data) {
-	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
-	BCM2835_BSC1->S = (uint32_t) (BCM2835_BSC_S_CLKT | BCM2835_BSC_S_ERR | BCM2835_BSC_S_DONE);
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
 
-	BCM2835_BSC1->DLEN = (uint32_t) 2;
-	BCM2835_BSC1->FIFO = (uint32_t) data >> 8;
-	BCM2835_BSC1->FIFO = (uint32_t) data & 0xFF;
+	txn->buffer[0] = (uint8_t) (data >> 8);
+	txn->buffer[1] = (uint8_t) (data & 0xFF);
+	txn->write_length = 2;
 
-	BCM2835_BSC1->C = (uint32_t) (BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST);
-
-	while ((BCM2835_BSC1->S & BCM2835_BSC_S_DONE) != BCM2835_BSC_S_DONE) {
-	}
-
-	BCM2835_BSC1->S = BCM2835_BSC_S_DONE;
+	write_submit(txn);
 }
 
 void i2c_write_reg_uint8(uint8_t reg, uint8_t data) {
-	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
-	BCM2835_BSC1->S = (uint32_t) (BCM2835_BSC_S_CLKT | BCM2835_BSC_S_ERR | BCM2835_BSC_S_DONE);
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
 
-	BCM2835_BSC1->DLEN = (uint32_t) 2;
-	BCM2835_BSC1->FIFO = (uint32_t) reg;
-	BCM2835_BSC1->FIFO = (uint32_t) data;
+	txn->buffer[0] = reg;
+	txn->buffer[1] = data;
+	txn->write_length = 2;
 
-	BCM2835_BSC1->C = (uint32_t) (BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST);
-
-	while ((BCM2835_BSC1->S & BCM2835_BSC_S_DONE) != BCM2835_BSC_S_DONE) {
-	}
-
-	BCM2835_BSC1->S = BCM2835_BSC_S_DONE;
+	write_submit(txn);
 }
 
 void i2c_write_reg_uint16(uint8_t reg, uint16_t data) {
-	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
-	BCM2835_BSC1->S = (uint32_t) (BCM2835_BSC_S_CLKT | BCM2835_BSC_S_ERR | BCM2835_BSC_S_DONE);
-
-	BCM2835_BSC1->DLEN = (uint32_t) 3;
-	BCM2835_BSC1->FIFO = (uint32_t) reg;
-	BCM2835_BSC1->FIFO = (uint32_t) data >> 8;
-	BCM2835_BSC1->FIFO = (uint32_t) data & 0xFF;
+	struct i2c_transaction *txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
 
-	BCM2835_BSC1->C = (uint32_t) (BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST);
-
-	while ((BCM2835_BSC1->S & BCM2835_BSC_S_DONE) != BCM2835_BSC_S_DONE) {
-	}
+	txn->buffer[0] = reg;
+	txn->buffer[1] = (uint8_t) (data >> 8);
+	txn->buffer[2] = (uint8_t) (data & 0xFF);
+	txn->write_length = 3;
 
-	BCM2835_BSC1->S = BCM2835_BSC_S_DONE;
+	write_submit(txn);
 }
-#endif
 
 void i2c_write_reg_uint16_mask(uint8_t reg, uint16_t data, uint16_t mask) {
 	uint16_t current;
@@ -134,3 +113,21 @@ void i2c_write_reg_uint16_mask(uint8_t reg, uint16_t data, uint16_t mask) {
 
 	i2c_write_reg_uint16(reg, new);
 }
+
+/*
+ * Keeps the bus idle after the transactions queued before, for a device which needs time to execute them.
+ * Use it instead of a udelay, which would not be in step with the bus in interrupt mode.
+ */
+void i2c_delayus(uint32_t delayus) {
+	struct i2c_transaction *txn;
+
+	if (delayus == 0) {
+		return;
+	}
+
+	txn = i2c_queue_alloc(i2c_address, i2c_clock_divider);
+
+	txn->delay_us = delayus;
+
+	write_submit(txn);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file i2c_backend_linux.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "i2c_queue.h"
+
+#define I2C_DEVICE	"/dev/i2c-1"	///< BSC1 on the header pins
+
+static int s_fd = -1;
+
+static uint8_t transfer(struct i2c_msg *msg) {
+	struct i2c_rdwr_ioctl_data data;
+
+	data.msgs = msg;
+	data.nmsgs = 1;
+
+	if (ioctl(s_fd, I2C_RDWR, &data) < 0) {
+		return (errno == ETIMEDOUT) ? I2C_REASON_ERROR_CLKT : I2C_REASON_ERROR_NACK;
+	}
+
+	return I2C_REASON_OK;
+}
+
+static bool backend_begin(void) {
+	if (s_fd < 0) {
+		s_fd = open(I2C_DEVICE, O_RDWR);
+	}
+
+	if (s_fd < 0) {
+		perror("open(" I2C_DEVICE ")");
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * The kernel driver is blocking, the transaction is done when started.
+ * The clock divider is ignored, the bus speed is set with the device tree (dtparam=i2c_arm_baudrate).
+ */
+static void backend_start(struct i2c_transaction *txn) {
+	struct i2c_msg msg;
+	uint8_t reason = I2C_REASON_OK;
+
+	if (s_fd < 0) {
+		txn->reason = I2C_REASON_ERROR_NACK;
+		return;
+	}
+
+	msg.addr = txn->address;
+
+	if ((txn->write_length != 0) || ((txn->delay_us == 0) && (txn->read_length == 0))) {
+		msg.flags = 0;
+		msg.len = (uint16_t) txn->write_length;
+		msg.buf = (uint8_t *) txn->write_data;
+		reason = transfer(&msg);
+	}
+
+	if ((reason == I2C_REASON_OK) && (txn->delay_us != 0)) {
+		usleep(txn->delay_us);
+	}
+
+	if ((reason == I2C_REASON_OK) && (txn->read_length != 0)) {
+		msg.flags = I2C_M_RD;
+		msg.len = (uint16_t) txn->read_length;
+		msg.buf = (uint8_t *) txn->read_data;
+		reason = transfer(&msg);
+	}
+
+	txn->reason = reason;
+}
+
+static bool backend_service(struct i2c_transaction *txn) {
+	return true;
+}
+
+static uint32_t backend_micros(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint32_t) ((uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000);
+}
+
+const struct i2c_backend i2c_backend_linux = { backend_begin, NULL, backend_start, backend_service, backend_micros };
@@ -0,0 +1,182 @@
+/**
+ * @file i2c_backend_mock.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "i2c_queue.h"
+#include "i2c_mock.h"
+
+#define CORE_CLK_MHZ		250
+
+static const struct i2c_mock_device *s_devices[I2C_MOCK_ADDRESSES];
+static uint8_t s_registers[I2C_MOCK_ADDRESSES][I2C_MOCK_REGISTERS];
+static uint8_t s_pointer[I2C_MOCK_ADDRESSES];
+static struct i2c_mock_statistics s_statistics;
+static uint64_t s_time;
+static uint64_t s_time_done;
+
+static uint64_t bus_time(const struct i2c_transaction *txn, uint32_t length) {
+	// 9 clocks a byte, plus START and STOP
+	return ((uint64_t) ((1 + length) * 9 + 2) * txn->clock_divider * 1000) / CORE_CLK_MHZ;
+}
+
+static uint8_t registers_write(uint8_t address, const uint8_t *data, uint32_t length) {
+	uint32_t i;
+
+	if (length == 0) {
+		return I2C_REASON_OK;
+	}
+
+	s_pointer[address] = data[0];
+
+	for (i = 1; i < length; i++) {
+		s_registers[address][s_pointer[address]++] = data[i];
+	}
+
+	return I2C_REASON_OK;
+}
+
+static uint8_t registers_read(uint8_t address, uint8_t *data, uint32_t length) {
+	uint32_t i;
+
+	for (i = 0; i < length; i++) {
+		data[i] = s_registers[address][s_pointer[address]++];
+	}
+
+	return I2C_REASON_OK;
+}
+
+static const struct i2c_mock_device s_registers_device = { registers_write, registers_read };
+
+void i2c_mock_reset(void) {
+	memset(s_devices, 0, sizeof(s_devices));
+	memset(s_registers, 0, sizeof(s_registers));
+	memset(s_pointer, 0, sizeof(s_pointer));
+	memset(&s_statistics, 0, sizeof(struct i2c_mock_statistics));
+
+	s_time = 0;
+	s_time_done = 0;
+}
+
+void i2c_mock_attach(uint8_t address, const struct i2c_mock_device *device) {
+	s_devices[address & 0x7F] = device;
+}
+
+void i2c_mock_attach_registers(uint8_t address) {
+	i2c_mock_attach(address, &s_registers_device);
+}
+
+uint8_t i2c_mock_get_register(uint8_t address, uint8_t reg) {
+	return s_registers[address & 0x7F][reg];
+}
+
+void i2c_mock_set_register(uint8_t address, uint8_t reg, uint8_t value) {
+	s_registers[address & 0x7F][reg] = value;
+}
+
+const struct i2c_mock_statistics *i2c_mock_get_statistics(void) {
+	return &s_statistics;
+}
+
+uint64_t i2c_mock_get_time(void) {
+	return s_time;
+}
+
+static bool backend_begin(void) {
+	return true;
+}
+
+static bool has_write(const struct i2c_transaction *txn) {
+	return (txn->write_length != 0) || ((txn->delay_us == 0) && (txn->read_length == 0));
+}
+
+static void backend_start(struct i2c_transaction *txn) {
+	s_time_done = s_time + (uint64_t) txn->delay_us * 1000;
+
+	if (has_write(txn)) {
+		s_time_done += bus_time(txn, txn->write_length);
+	}
+
+	if (txn->read_length != 0) {
+		s_time_done += bus_time(txn, txn->read_length);
+	}
+}
+
+/*
+ * The device sees the transaction when it is done on the virtual clock.
+ */
+static bool backend_service(struct i2c_transaction *txn) {
+	const struct i2c_mock_device *device = s_devices[txn->address];
+	uint8_t reason = I2C_REASON_OK;
+
+	s_time += I2C_MOCK_SERVICE_NS;
+
+	if (s_time < s_time_done) {
+		return false;
+	}
+
+	if (has_write(txn)) {
+		s_statistics.writes++;
+		s_statistics.bytes += 1 + txn->write_length;
+		s_statistics.bus_time += bus_time(txn, txn->write_length);
+
+		if (device == NULL) {
+			reason = I2C_REASON_ERROR_NACK;
+		} else if (txn->write_length != 0) {
+			reason = device->write(txn->address, txn->write_data, txn->write_length);
+		}
+	}
+
+	if ((reason == I2C_REASON_OK) && (txn->read_length != 0)) {
+		s_statistics.reads++;
+		s_statistics.bytes += 1 + txn->read_length;
+		s_statistics.bus_time += bus_time(txn, txn->read_length);
+
+		if (device == NULL) {
+			reason = I2C_REASON_ERROR_NACK;
+		} else {
+			reason = device->read(txn->address, (uint8_t *) txn->read_data, txn->read_length);
+		}
+	}
+
+	if (reason == I2C_REASON_ERROR_NACK) {
+		s_statistics.nacks++;
+	}
+
+	txn->reason = reason;
+
+	return true;
+}
+
+static uint32_t backend_micros(void) {
+	s_time += I2C_MOCK_SERVICE_NS;
+
+	return (uint32_t) (s_time / 1000);
+}
+
+const struct i2c_backend i2c_backend_mock = { backend_begin, NULL, backend_start, backend_service, backend_micros };
@@ -0,0 +1,242 @@
+/**
+ * @file i2c_backend_bcm2835.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "bcm2835.h"
+#if defined(__circle__)
+#else
+ #include "bcm2835_i2c.h"
+#endif
+
+#include "i2c_queue.h"
+
+#if defined(__circle__)
+/*
+ * The Circle I2C master is blocking, the transaction is done when started.
+ */
+static bool backend_begin(void) {
+	return bcm2835_i2c_begin() == 1;
+}
+
+static void backend_start(struct i2c_transaction *txn) {
+	uint8_t reason = I2C_REASON_OK;
+
+	if ((txn->write_length != 0) || ((txn->delay_us == 0) && (txn->read_length == 0))) {
+		bcm2835_i2c_setSlaveAddress(txn->address);
+		bcm2835_i2c_setClockDivider(txn->clock_divider);
+		reason = bcm2835_i2c_write((const char *) txn->write_data, txn->write_length);
+	}
+
+	if ((reason == I2C_REASON_OK) && (txn->delay_us != 0)) {
+		bcm2835_delayMicroseconds(txn->delay_us);
+	}
+
+	if ((reason == I2C_REASON_OK) && (txn->read_length != 0)) {
+		bcm2835_i2c_setSlaveAddress(txn->address);
+		bcm2835_i2c_setClockDivider(txn->clock_divider);
+		reason = bcm2835_i2c_read(txn->read_data, txn->read_length);
+	}
+
+	txn->reason = reason;
+}
+
+static bool backend_service(struct i2c_transaction *txn) {
+	return true;
+}
+
+const struct i2c_backend i2c_backend_bcm2835 = { backend_begin, NULL, backend_start, backend_service, NULL };
+#else
+/*
+ * BSC1 register level. In interrupt mode the TX, RX and DONE interrupts
+ * refill and drain the FIFO, the bus idle time is timed by i2c_queue_run.
+ */
+
+#define STATE_WRITE		0
+#define STATE_DELAY		1
+#define STATE_READ		2
+
+#define BSC_S_CLEAR		(BCM2835_BSC_S_CLKT | BCM2835_BSC_S_ERR | BCM2835_BSC_S_DONE)
+
+static bool s_is_irq = false;
+
+static void fifo_fill(struct i2c_transaction *txn) {
+	while ((txn->index < txn->write_length) && (BCM2835_BSC1->S & BCM2835_BSC_S_TXD)) {
+		BCM2835_BSC1->FIFO = (uint32_t) txn->write_data[txn->index++];
+	}
+
+	if (s_is_irq && (txn->index == txn->write_length)) {
+		// Nothing left to write, TXW would keep the interrupt asserted
+		BCM2835_BSC1->C &= ~BCM2835_BSC_C_INTT;
+	}
+}
+
+static void fifo_drain(struct i2c_transaction *txn) {
+	while ((txn->index < txn->read_length) && (BCM2835_BSC1->S & BCM2835_BSC_S_RXD)) {
+		txn->read_data[txn->index++] = (char) (BCM2835_BSC1->FIFO & 0xFF);
+	}
+}
+
+static void start_write(struct i2c_transaction *txn) {
+	txn->state = STATE_WRITE;
+	txn->index = 0;
+
+	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
+	BCM2835_BSC1->S = BSC_S_CLEAR;
+	BCM2835_BSC1->DLEN = txn->write_length;
+
+	fifo_fill(txn);
+
+	BCM2835_BSC1->C = BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST | (s_is_irq ? (BCM2835_BSC_C_INTD | (txn->index < txn->write_length ? BCM2835_BSC_C_INTT : 0)) : 0);
+}
+
+static void start_delay(struct i2c_transaction *txn) {
+	txn->state = STATE_DELAY;
+	txn->timestamp = BCM2835_ST->CLO;
+
+	BCM2835_BSC1->C = 0;
+}
+
+static void start_read(struct i2c_transaction *txn) {
+	txn->state = STATE_READ;
+	txn->index = 0;
+
+	BCM2835_BSC1->C = BCM2835_BSC_C_CLEAR_1;
+	BCM2835_BSC1->S = BSC_S_CLEAR;
+	BCM2835_BSC1->DLEN = txn->read_length;
+	BCM2835_BSC1->C = BCM2835_BSC_C_I2CEN | BCM2835_BSC_C_ST | BCM2835_BSC_C_READ | (s_is_irq ? (BCM2835_BSC_C_INTR | BCM2835_BSC_C_INTD) : 0);
+}
+
+/*
+ * Returns true when the phase is over, with the reason set when it failed.
+ */
+static bool phase_done(struct i2c_transaction *txn, uint32_t length) {
+	const uint32_t s = BCM2835_BSC1->S;
+
+	if ((s & BSC_S_CLEAR) == 0) {
+		return false;
+	}
+
+	if (s & BCM2835_BSC_S_ERR) {
+		txn->reason = I2C_REASON_ERROR_NACK;
+	} else if (s & BCM2835_BSC_S_CLKT) {
+		txn->reason = I2C_REASON_ERROR_CLKT;
+	} else if (txn->index != length) {
+		txn->reason = I2C_REASON_ERROR_DATA;
+	}
+
+	BCM2835_BSC1->S = BSC_S_CLEAR;
+	BCM2835_BSC1->C = 0;
+
+	return true;
+}
+
+static bool backend_begin(void) {
+	bcm2835_i2c_begin();
+	return true;
+}
+
+static void backend_set_irq(bool is_irq) {
+	s_is_irq = is_irq;
+
+	if (is_irq) {
+		BCM2835_IRQ->IRQ_ENABLE2 = BCM2835_I2C_IRQn;
+	} else {
+		BCM2835_IRQ->IRQ_DISABLE2 = BCM2835_I2C_IRQn;
+	}
+}
+
+static void backend_start(struct i2c_transaction *txn) {
+	BCM2835_BSC1->A = txn->address;
+	BCM2835_BSC1->DIV = txn->clock_divider;
+
+	if (txn->write_length != 0) {
+		start_write(txn);
+	} else if (txn->delay_us != 0) {
+		start_delay(txn);
+	} else if (txn->read_length != 0) {
+		start_read(txn);
+	} else {
+		start_write(txn);	// Address only
+	}
+}
+
+static bool backend_service(struct i2c_transaction *txn) {
+	switch (txn->state) {
+	case STATE_WRITE:
+		fifo_fill(txn);
+
+		if (!phase_done(txn, txn->write_length)) {
+			return false;
+		}
+
+		if ((txn->reason != I2C_REASON_OK) || ((txn->delay_us == 0) && (txn->read_length == 0))) {
+			return true;
+		}
+
+		if (txn->delay_us != 0) {
+			start_delay(txn);
+			return false;
+		}
+
+		start_read(txn);
+		return false;
+	case STATE_DELAY:
+		if ((BCM2835_ST->CLO - txn->timestamp) < txn->delay_us) {
+			return false;
+		}
+
+		if (txn->read_length == 0) {
+			return true;
+		}
+
+		start_read(txn);
+		return false;
+	case STATE_READ:
+		fifo_drain(txn);
+
+		if ((BCM2835_BSC1->S & BSC_S_CLEAR) == 0) {
+			return false;
+		}
+
+		// Transfer has finished, grab any remaining stuff in FIFO
+		fifo_drain(txn);
+
+		return phase_done(txn, txn->read_length);
+	default:
+		break;
+	}
+
+	return true;
+}
+
+static uint32_t backend_micros(void) {
+	return BCM2835_ST->CLO;
+}
+
+const struct i2c_backend i2c_backend_bcm2835 = { backend_begin, backend_set_irq, backend_start, backend_service, backend_micros };
+#endif
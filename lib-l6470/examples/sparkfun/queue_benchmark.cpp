@@ -0,0 +1,174 @@
+/**
+ * @file queue_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "l6470.h"
+#include "l6470queue.h"
+#include "l6470transportsimulated.h"
+#include "l6470constants.h"
+
+#define MOTORS			8
+#define FRAMES			1000
+#define SPI_CS0			0
+
+/*
+ * No hardware needed: the chain is L6470TransportSimulated.
+ * QueuedMotor is the queued path of AutoDriver without the GPIO,
+ * so only the L6470 sources are needed, not the bcm2835 library.
+ */
+class QueuedMotor: public L6470 {
+public:
+	QueuedMotor(uint8_t nPosition, L6470Queue *pQueue) : m_nPosition(nPosition), m_pQueue(pQueue) {
+		m_nMotorNumber = nPosition;
+		m_pQueue->AddDevice(nPosition);
+	}
+
+	bool IsConnected(void) {
+		return getParam(L6470_PARAM_CONFIG) == 0x2e88;
+	}
+
+	int busyCheck(void) {
+		return 0;
+	}
+
+private:
+	uint8_t SPIXfer(uint8_t data) {
+		return m_pQueue->Xfer(m_nPosition, data);
+	}
+
+	void SPIReadBegin(void) {
+		m_pQueue->ReadBegin();
+	}
+
+	void SPIReadEnd(void) {
+		m_pQueue->ReadEnd();
+	}
+
+private:
+	uint8_t m_nPosition;
+	L6470Queue *m_pQueue;
+};
+
+/*
+ * A DMX frame gives every motor a run and a goToDir, as with the DMX modes.
+ */
+static void frame(QueuedMotor **pBoard, unsigned nFrame) {
+	for (unsigned i = 0; i < MOTORS; i++) {
+		pBoard[i]->run((nFrame & 1) ? L6470_DIR_FWD : L6470_DIR_REV, 100 + nFrame + i);
+		pBoard[i]->goToDir(L6470_DIR_FWD, (long) (nFrame * MOTORS + i));
+	}
+}
+
+static bool check(const L6470TransportSimulated &chain, unsigned nFrame) {
+	for (unsigned i = 0; i < MOTORS; i++) {
+		const struct TL6470SimulatedDevice *pDevice = chain.GetDevice(i);
+
+		if ((pDevice->nLastCommand != L6470_CMD_GOTO_DIR + L6470_DIR_FWD) || (pDevice->aRegister[L6470_PARAM_ABS_POS] != nFrame * MOTORS + i)) {
+			printf("Motor %u: command 0x%.2x, ABS_POS %u\n", i, pDevice->nLastCommand, (unsigned) pDevice->aRegister[L6470_PARAM_ABS_POS]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool benchmark(bool bQueued) {
+	L6470TransportSimulated chain(MOTORS);
+	L6470Queue queue(SPI_CS0, &chain);
+	QueuedMotor *pBoard[MOTORS];
+
+	for (unsigned i = 0; i < MOTORS; i++) {
+		pBoard[i] = new QueuedMotor(i, &queue);
+
+		if (!pBoard[i]->IsConnected()) {
+			printf("Motor %u not connected\n", i);
+			return false;
+		}
+	}
+
+	chain.ResetStatistics();
+
+	uint32_t nCommands = 0;
+	uint32_t nMaxLatency = 0;
+
+	for (unsigned nFrame = 0; nFrame < FRAMES; nFrame++) {
+		const uint32_t nWireStart = chain.GetWireNanos();
+		uint32_t nCommandsStart = 0;
+
+		for (unsigned i = 0; i < MOTORS; i++) {
+			nCommandsStart += chain.GetDevice(i)->nCommands;
+		}
+
+		if (bQueued) {
+			queue.Begin();
+		}
+
+		frame(pBoard, nFrame);
+
+		if (bQueued) {
+			queue.End();
+		}
+
+		// The last motor moves when the whole frame is on the wire
+		const uint32_t nLatency = chain.GetWireNanos() - nWireStart;
+
+		if (nLatency > nMaxLatency) {
+			nMaxLatency = nLatency;
+		}
+
+		for (unsigned i = 0; i < MOTORS; i++) {
+			nCommands += chain.GetDevice(i)->nCommands;
+		}
+		nCommands -= nCommandsStart;
+
+		if (!check(chain, nFrame)) {
+			return false;
+		}
+	}
+
+	const uint32_t nWireMicros = chain.GetWireNanos() / 1000;
+
+	printf("%-8s: %u motors, %u frames, %u cycles, wire time %u us\n", bQueued ? "queued" : "per byte", MOTORS, FRAMES, (unsigned) chain.GetCycles(), (unsigned) nWireMicros);
+	printf("          %u commands/s, DMX to motion latency %u us\n", (unsigned) (((uint64_t) nCommands * 1000000) / nWireMicros), (unsigned) (nMaxLatency / 1000));
+
+	for (unsigned i = 0; i < MOTORS; i++) {
+		delete pBoard[i];
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv) {
+	if (!benchmark(false) || !benchmark(true)) {
+		puts("Failed!");
+		return -1;
+	}
+
+	puts("Done!");
+
+	return 0;
+}
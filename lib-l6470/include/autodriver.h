@@ -32,11 +32,15 @@
 #include <stdint.h>
 
 #include "l6470.h"
+#include "l6470queue.h"
 
 class AutoDriver: public L6470 {
 public:
-	AutoDriver(uint8_t, uint8_t, uint8_t, uint8_t);
-	AutoDriver(uint8_t, uint8_t, uint8_t);
+	/**
+	 * With pQueue, all the transfers for the chain on that chip select go through the queue
+	 */
+	AutoDriver(uint8_t, uint8_t, uint8_t, uint8_t, L6470Queue *pQueue = 0);
+	AutoDriver(uint8_t, uint8_t, uint8_t, L6470Queue *pQueue = 0);
 
 	~AutoDriver(void);
 
@@ -44,6 +48,8 @@ public:
 
 private:
 	uint8_t SPIXfer(uint8_t);
+	void SPIReadBegin(void);
+	void SPIReadEnd(void);
 
 	/*
 	 * Additional methods
@@ -83,6 +89,7 @@ private:
 	bool m_bIsBusy;
 	static uint8_t m_nNumBoards[2];
 	bool m_bIsConnected;
+	L6470Queue *m_pQueue;
 };
 
 #endif /* AUTODRIVER_H_ */
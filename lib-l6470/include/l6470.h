@@ -198,6 +198,15 @@ public:
 private:
 	virtual uint8_t SPIXfer(uint8_t)=0;
 
+	/**
+	 * Around the commands which return data (GetParam, GetStatus).
+	 * A transport which queues the bytes has to send them right away.
+	 */
+	virtual void SPIReadBegin(void) {
+	}
+	virtual void SPIReadEnd(void) {
+	}
+
 private:
 	long paramHandler(uint8_t, unsigned long);
 	long xferParam(unsigned long, uint8_t);
@@ -0,0 +1,108 @@
+/**
+ * @file l6470queue.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef L6470QUEUE_H_
+#define L6470QUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "l6470transport.h"
+
+#define L6470_QUEUE_MAX_DEVICES		8	///< Daisy-chained devices on one chip select
+#define L6470_QUEUE_MAX_BYTES		16	///< For each device, a full queue is sent out
+
+/**
+ * The devices on one chip select are daisy-chained: each chip select cycle
+ * carries one byte for every device. Between Begin and End the command
+ * bytes are collected for each device, and End clocks them out together,
+ * one chip select cycle for each byte position. A device with fewer bytes
+ * gets NOPs.
+ *
+ * Outside Begin / End, and for the reads, each byte is a cycle of its own.
+ */
+class L6470Queue {
+public:
+	L6470Queue(uint8_t nChipSelect, L6470Transport *pTransport);
+	~L6470Queue(void);
+
+	void AddDevice(uint8_t nPosition);
+
+	inline uint8_t GetDevices(void) const {
+		return m_nDevices;
+	}
+
+	inline uint8_t GetChipSelect(void) const {
+		return m_nChipSelect;
+	}
+
+	void Begin(void);
+	void End(void);
+
+	inline bool IsCollecting(void) const {
+		return m_bCollecting;
+	}
+
+	/**
+	 * A read needs the reply right away: what is collected so far is sent,
+	 * and the bytes up to ReadEnd bypass the queue.
+	 */
+	void ReadBegin(void);
+	void ReadEnd(void);
+
+	uint8_t Xfer(uint8_t nPosition, uint8_t nData);
+
+	/// Chip select cycles
+	inline uint32_t GetCycles(void) const {
+		return m_nCycles;
+	}
+
+	/// Bytes sent for the devices, not counting the NOPs
+	inline uint32_t GetBytes(void) const {
+		return m_nBytes;
+	}
+
+	inline void ResetStatistics(void) {
+		m_nCycles = 0;
+		m_nBytes = 0;
+	}
+
+private:
+	void Flush(void);
+
+private:
+	uint8_t m_nChipSelect;
+	L6470Transport *m_pTransport;
+	uint8_t m_nDevices;
+	bool m_bCollecting;
+	bool m_bReading;
+	uint8_t m_aLength[L6470_QUEUE_MAX_DEVICES];
+	uint8_t m_aQueue[L6470_QUEUE_MAX_DEVICES][L6470_QUEUE_MAX_BYTES];
+	uint8_t m_aFrame[L6470_QUEUE_MAX_DEVICES];
+	uint32_t m_nCycles;
+	uint32_t m_nBytes;
+};
+
+#endif /* L6470QUEUE_H_ */
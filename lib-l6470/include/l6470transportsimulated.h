@@ -0,0 +1,95 @@
+/**
+ * @file l6470transportsimulated.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef L6470TRANSPORTSIMULATED_H_
+#define L6470TRANSPORTSIMULATED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "l6470transport.h"
+
+#define L6470_SIMULATED_MAX_DEVICES	8
+
+struct TL6470SimulatedDevice {
+	uint32_t aRegister[32];		///< Indexed with TL6470ParamRegisters
+	uint8_t nCommand;			///< Command being received
+	uint8_t nArgumentBytes;		///< Still to receive
+	uint32_t nArgument;
+	uint8_t aReply[3];
+	uint8_t nReplyBytes;		///< Still to send
+	uint8_t nLastCommand;		///< Last completed command, NOPs are not counted
+	uint32_t nLastArgument;
+	uint32_t nCommands;
+	uint32_t nNops;
+};
+
+/**
+ * A chain of L6470 devices without hardware. Each device decodes the bytes
+ * it receives in its slot of a chip select cycle: the motion commands
+ * update ABS_POS and SPEED immediately (a motion is never busy),
+ * GetParam and GetStatus reply in the following cycles.
+ *
+ * The wire time assumes the SPI clock of L6470TransportSpi and the
+ * minimum chip select high time (tDISCS) between the cycles.
+ */
+class L6470TransportSimulated: public L6470Transport {
+public:
+	L6470TransportSimulated(uint8_t nDevices, uint32_t nSpeedHz = 250000000 / 64);
+	~L6470TransportSimulated(void);
+
+	void Transfer(uint8_t nChipSelect, uint8_t *pBuffer, uint32_t nLength);
+
+	inline const struct TL6470SimulatedDevice *GetDevice(uint8_t nPosition) const {
+		return &m_aDevice[nPosition];
+	}
+
+	inline uint32_t GetCycles(void) const {
+		return m_nCycles;
+	}
+
+	inline uint32_t GetWireNanos(void) const {
+		return m_nWireNanos;
+	}
+
+	inline void ResetStatistics(void) {
+		m_nCycles = 0;
+		m_nWireNanos = 0;
+	}
+
+private:
+	void Reset(struct TL6470SimulatedDevice *pDevice);
+	uint8_t Clock(struct TL6470SimulatedDevice *pDevice, uint8_t nData);
+	void Execute(struct TL6470SimulatedDevice *pDevice);
+
+private:
+	uint8_t m_nDevices;
+	uint32_t m_nSpeedHz;
+	struct TL6470SimulatedDevice m_aDevice[L6470_SIMULATED_MAX_DEVICES];
+	uint32_t m_nCycles;
+	uint32_t m_nWireNanos;
+};
+
+#endif /* L6470TRANSPORTSIMULATED_H_ */
@@ -46,10 +46,11 @@
 
 uint8_t AutoDriver::m_nNumBoards[2];
 
-AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin, uint8_t nBusyPin) : m_bIsBusy(false), m_bIsConnected(false) {
+AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin, uint8_t nBusyPin, L6470Queue *pQueue) : m_bIsBusy(false), m_bIsConnected(false), m_pQueue(pQueue) {
 	assert(nSpiChipSelect <= BCM2835_SPI_CS1);
 	assert(nResetPin <= 31);
 	assert(nBusyPin <= 31);
+	assert((pQueue == 0) || (pQueue->GetChipSelect() == nSpiChipSelect));
 
 	m_nSpiChipSelect = nSpiChipSelect;
 	m_nPosition = nPosition;
@@ -57,14 +58,19 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 	m_nBusyPin = nBusyPin;
 	m_nNumBoards[nSpiChipSelect]++;
 
+	if (m_pQueue != 0) {
+		m_pQueue->AddDevice(nPosition);
+	}
+
 	if (getParam(L6470_PARAM_CONFIG) == 0x2e88) {
 		m_bIsConnected = true;
 	}
 }
 
-AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin) : m_bIsBusy(false), m_bIsConnected(false) {
+AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nResetPin, L6470Queue *pQueue) : m_bIsBusy(false), m_bIsConnected(false), m_pQueue(pQueue) {
 	assert(nSpiChipSelect <= BCM2835_SPI_CS1);
 	assert(nResetPin <= 31);
+	assert((pQueue == 0) || (pQueue->GetChipSelect() == nSpiChipSelect));
 
 	m_nSpiChipSelect = nSpiChipSelect;
 	m_nPosition = nPosition;
@@ -72,6 +78,10 @@ AutoDriver::AutoDriver(uint8_t nPosition, uint8_t nSpiChipSelect, uint8_t nReset
 	m_nBusyPin = BUSY_PIN_NOT_USED;
 	m_nNumBoards[nSpiChipSelect]++;
 
+	if (m_pQueue != 0) {
+		m_pQueue->AddDevice(nPosition);
+	}
+
 	if (getParam(L6470_PARAM_CONFIG) == 0x2e88) {
 		m_bIsConnected = true;
 	}
@@ -111,6 +121,10 @@ int AutoDriver::busyCheck(void) {
 }
 
 uint8_t AutoDriver::SPIXfer(uint8_t data) {
+	if (m_pQueue != 0) {
+		return m_pQueue->Xfer(m_nPosition, data);
+	}
+
 	uint8_t dataPacket[m_nNumBoards[m_nSpiChipSelect]];
 
 	for (int i = 0; i < m_nNumBoards[m_nSpiChipSelect]; i++) {
@@ -127,6 +141,18 @@ uint8_t AutoDriver::SPIXfer(uint8_t data) {
 	return dataPacket[m_nPosition];
 }
 
+void AutoDriver::SPIReadBegin(void) {
+	if (m_pQueue != 0) {
+		m_pQueue->ReadBegin();
+	}
+}
+
+void AutoDriver::SPIReadEnd(void) {
+	if (m_pQueue != 0) {
+		m_pQueue->ReadEnd();
+	}
+}
+
 /*
  * Additional method
  */
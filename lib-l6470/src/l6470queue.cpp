@@ -0,0 +1,135 @@
+/**
+ * @file l6470queue.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "l6470queue.h"
+#include "l6470transport.h"
+
+#include "l6470constants.h"
+
+L6470Queue::L6470Queue(uint8_t nChipSelect, L6470Transport *pTransport):
+	m_nChipSelect(nChipSelect),
+	m_pTransport(pTransport),
+	m_nDevices(0),
+	m_bCollecting(false),
+	m_bReading(false),
+	m_nCycles(0),
+	m_nBytes(0)
+{
+	assert(pTransport != 0);
+
+	for (unsigned i = 0; i < L6470_QUEUE_MAX_DEVICES; i++) {
+		m_aLength[i] = 0;
+		m_aFrame[i] = L6470_CMD_NOP;
+	}
+}
+
+L6470Queue::~L6470Queue(void) {
+	Flush();
+}
+
+void L6470Queue::AddDevice(uint8_t nPosition) {
+	assert(nPosition < L6470_QUEUE_MAX_DEVICES);
+
+	if (nPosition >= m_nDevices) {
+		m_nDevices = nPosition + 1;
+	}
+}
+
+void L6470Queue::Begin(void) {
+	m_bCollecting = true;
+}
+
+void L6470Queue::End(void) {
+	Flush();
+	m_bCollecting = false;
+}
+
+void L6470Queue::ReadBegin(void) {
+	Flush();
+	m_bReading = true;
+}
+
+void L6470Queue::ReadEnd(void) {
+	m_bReading = false;
+}
+
+uint8_t L6470Queue::Xfer(uint8_t nPosition, uint8_t nData) {
+	assert(nPosition < m_nDevices);
+
+	m_nBytes++;
+
+	if (m_bCollecting && !m_bReading) {
+		if (m_aLength[nPosition] == L6470_QUEUE_MAX_BYTES) {
+			Flush();
+		}
+
+		m_aQueue[nPosition][m_aLength[nPosition]++] = nData;
+		return 0;
+	}
+
+	for (unsigned i = 0; i < m_nDevices; i++) {
+		m_aFrame[i] = L6470_CMD_NOP;
+	}
+
+	m_aFrame[nPosition] = nData;
+
+	m_pTransport->Transfer(m_nChipSelect, m_aFrame, m_nDevices);
+	m_nCycles++;
+
+	return m_aFrame[nPosition];
+}
+
+/*
+ * A device only gets NOPs after its last queued byte, so a NOP never
+ * lands in the middle of a command (it would be taken as an argument).
+ * A queue which runs full is sent out as it is; the remaining bytes of
+ * that command follow in the next cycles, the other devices get NOPs.
+ */
+void L6470Queue::Flush(void) {
+	unsigned nCycles = 0;
+
+	for (unsigned i = 0; i < m_nDevices; i++) {
+		if (m_aLength[i] > nCycles) {
+			nCycles = m_aLength[i];
+		}
+	}
+
+	for (unsigned nByte = 0; nByte < nCycles; nByte++) {
+		for (unsigned i = 0; i < m_nDevices; i++) {
+			m_aFrame[i] = (nByte < m_aLength[i]) ? m_aQueue[i][nByte] : (uint8_t) L6470_CMD_NOP;
+		}
+
+		m_pTransport->Transfer(m_nChipSelect, m_aFrame, m_nDevices);
+		m_nCycles++;
+	}
+
+	for (unsigned i = 0; i < m_nDevices; i++) {
+		m_aLength[i] = 0;
+	}
+}
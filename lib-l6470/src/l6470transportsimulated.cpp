@@ -0,0 +1,240 @@
+/**
+ * @file l6470transportsimulated.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "l6470transportsimulated.h"
+
+#include "l6470.h"
+#include "l6470constants.h"
+
+#define TDISCS_NANOS	800	///< Minimum chip select high time
+
+/*
+ * Register length in bits, indexed with TL6470ParamRegisters
+ */
+static const uint8_t s_aParamBits[32] = {
+	0, 22, 9, 22, 20, 12, 12, 10, 13, 8, 8, 8, 8, 14, 8, 8,
+	8, 8, 8, 8, 8, 10, 8, 8, 16, 16, 8, 8, 8, 8, 8, 8
+};
+
+static uint8_t ParamBytes(uint8_t nParam) {
+	return (s_aParamBits[nParam & 0x1F] + 7) / 8;
+}
+
+static uint32_t ParamMask(uint8_t nParam) {
+	return ((uint32_t) 1 << s_aParamBits[nParam & 0x1F]) - 1;
+}
+
+L6470TransportSimulated::L6470TransportSimulated(uint8_t nDevices, uint32_t nSpeedHz):
+	m_nDevices(nDevices),
+	m_nSpeedHz(nSpeedHz),
+	m_nCycles(0),
+	m_nWireNanos(0)
+{
+	assert(nDevices <= L6470_SIMULATED_MAX_DEVICES);
+	assert(nSpeedHz != 0);
+
+	for (unsigned i = 0; i < L6470_SIMULATED_MAX_DEVICES; i++) {
+		Reset(&m_aDevice[i]);
+	}
+}
+
+L6470TransportSimulated::~L6470TransportSimulated(void) {
+}
+
+void L6470TransportSimulated::Reset(struct TL6470SimulatedDevice *pDevice) {
+	for (unsigned i = 0; i < sizeof(pDevice->aRegister) / sizeof(pDevice->aRegister[0]); i++) {
+		pDevice->aRegister[i] = 0;
+	}
+
+	// Power up values
+	pDevice->aRegister[L6470_PARAM_ACC] = 0x08A;
+	pDevice->aRegister[L6470_PARAM_DECEL] = 0x08A;
+	pDevice->aRegister[L6470_PARAM_MAX_SPEED] = 0x041;
+	pDevice->aRegister[L6470_PARAM_KVAL_HOLD] = 0x29;
+	pDevice->aRegister[L6470_PARAM_KVAL_RUN] = 0x29;
+	pDevice->aRegister[L6470_PARAM_KVAL_ACC] = 0x29;
+	pDevice->aRegister[L6470_PARAM_KVAL_DEC] = 0x29;
+	pDevice->aRegister[L6470_PARAM_INT_SPD] = 0x0408;
+	pDevice->aRegister[L6470_PARAM_ST_SLP] = 0x19;
+	pDevice->aRegister[L6470_PARAM_FN_SLP_ACC] = 0x29;
+	pDevice->aRegister[L6470_PARAM_FN_SLP_DEC] = 0x29;
+	pDevice->aRegister[L6470_PARAM_OCD_TH] = 0x08;
+	pDevice->aRegister[L6470_PARAM_STALL_TH] = 0x40;
+	pDevice->aRegister[L6470_PARAM_FS_SPD] = 0x027;
+	pDevice->aRegister[L6470_PARAM_STEP_MODE] = 0x07;
+	pDevice->aRegister[L6470_PARAM_ALARM_EN] = 0xFF;
+	pDevice->aRegister[L6470_PARAM_CONFIG] = 0x2E88;
+	pDevice->aRegister[L6470_PARAM_STATUS] = 0x7E00 | L6470_STATUS_BUSY | L6470_STATUS_HIZ;
+
+	pDevice->nCommand = L6470_CMD_NOP;
+	pDevice->nArgumentBytes = 0;
+	pDevice->nArgument = 0;
+	pDevice->nReplyBytes = 0;
+	pDevice->nLastCommand = L6470_CMD_NOP;
+	pDevice->nLastArgument = 0;
+	pDevice->nCommands = 0;
+	pDevice->nNops = 0;
+}
+
+void L6470TransportSimulated::Transfer(uint8_t nChipSelect, uint8_t *pBuffer, uint32_t nLength) {
+	assert(pBuffer != 0);
+	assert(nLength <= m_nDevices);
+
+	for (unsigned i = 0; i < nLength; i++) {
+		pBuffer[i] = Clock(&m_aDevice[i], pBuffer[i]);
+	}
+
+	m_nCycles++;
+	m_nWireNanos += (uint32_t) (((uint64_t) nLength * 8 * 1000000000) / m_nSpeedHz) + TDISCS_NANOS;
+}
+
+uint8_t L6470TransportSimulated::Clock(struct TL6470SimulatedDevice *pDevice, uint8_t nData) {
+	if (pDevice->nReplyBytes != 0) {
+		// The input is ignored while the reply is shifted out
+		pDevice->nReplyBytes--;
+		return pDevice->aReply[pDevice->nReplyBytes];
+	}
+
+	if (pDevice->nArgumentBytes != 0) {
+		pDevice->nArgument = (pDevice->nArgument << 8) | nData;
+		pDevice->nArgumentBytes--;
+
+		if (pDevice->nArgumentBytes == 0) {
+			Execute(pDevice);
+		}
+
+		return 0;
+	}
+
+	pDevice->nCommand = nData;
+	pDevice->nArgument = 0;
+
+	if (nData == L6470_CMD_NOP) {
+		pDevice->nNops++;
+		return 0;
+	}
+
+	if (nData < L6470_CMD_GET_PARAM) {							// SET_PARAM
+		pDevice->nArgumentBytes = ParamBytes(nData);
+	} else if ((nData & 0xFE) == L6470_CMD_RUN
+			|| (nData & 0xFE) == L6470_CMD_MOVE
+			|| nData == L6470_CMD_GOTO
+			|| (nData & 0xFE) == L6470_CMD_GOTO_DIR
+			|| (nData & 0xF6) == L6470_CMD_GO_UNTIL) {
+		pDevice->nArgumentBytes = 3;
+	}
+
+	if (pDevice->nArgumentBytes == 0) {
+		Execute(pDevice);
+	}
+
+	return 0;
+}
+
+void L6470TransportSimulated::Execute(struct TL6470SimulatedDevice *pDevice) {
+	uint32_t *pRegister = pDevice->aRegister;
+	const uint8_t nCommand = pDevice->nCommand;
+	const uint32_t nArgument = pDevice->nArgument;
+
+	pDevice->nLastCommand = nCommand;
+	pDevice->nLastArgument = nArgument;
+	pDevice->nCommands++;
+
+	if (nCommand < L6470_CMD_GET_PARAM) {
+		pRegister[nCommand] = nArgument & ParamMask(nCommand);
+		return;
+	}
+
+	if ((nCommand & 0xE0) == L6470_CMD_GET_PARAM) {
+		const uint8_t nParam = nCommand & 0x1F;
+		uint32_t nValue = pRegister[nParam];
+
+		pDevice->nReplyBytes = ParamBytes(nParam);
+
+		for (unsigned i = 0; i < pDevice->nReplyBytes; i++) {
+			pDevice->aReply[i] = (uint8_t) nValue;
+			nValue >>= 8;
+		}
+
+		return;
+	}
+
+	const bool bForward = (nCommand & L6470_DIR_FWD) == L6470_DIR_FWD;
+
+	switch (nCommand & 0xFE) {
+	case L6470_CMD_RUN:
+		pRegister[L6470_PARAM_SPEED] = nArgument & 0xFFFFF;
+		break;
+	case L6470_CMD_MOVE:
+		pRegister[L6470_PARAM_ABS_POS] = (pRegister[L6470_PARAM_ABS_POS] + (bForward ? nArgument : -nArgument)) & 0x3FFFFF;
+		break;
+	case L6470_CMD_GOTO:
+	case L6470_CMD_GOTO_DIR:
+		pRegister[L6470_PARAM_ABS_POS] = nArgument & 0x3FFFFF;
+		break;
+	case L6470_CMD_STEP_CLOCK:
+		break;
+	case L6470_CMD_GO_HOME:
+	case L6470_CMD_RESET_POS:
+		pRegister[L6470_PARAM_ABS_POS] = 0;
+		break;
+	case L6470_CMD_GO_MARK:
+		pRegister[L6470_PARAM_ABS_POS] = pRegister[L6470_PARAM_MARK];
+		break;
+	case L6470_CMD_SOFT_STOP:
+	case L6470_CMD_HARD_STOP:
+		pRegister[L6470_PARAM_SPEED] = 0;
+		break;
+	case L6470_CMD_SOFT_HIZ:
+	case L6470_CMD_HARD_HIZ:
+		pRegister[L6470_PARAM_SPEED] = 0;
+		pRegister[L6470_PARAM_STATUS] |= L6470_STATUS_HIZ;
+		return;
+	case L6470_CMD_RESET_DEVICE:
+		Reset(pDevice);
+		return;
+	case L6470_CMD_GET_STATUS:
+		pDevice->aReply[1] = (uint8_t) (pRegister[L6470_PARAM_STATUS] >> 8);
+		pDevice->aReply[0] = (uint8_t) pRegister[L6470_PARAM_STATUS];
+		pDevice->nReplyBytes = 2;
+		return;
+	default:
+		if ((nCommand & 0xF6) == L6470_CMD_GO_UNTIL) {
+			pRegister[L6470_PARAM_SPEED] = nArgument & 0xFFFFF;
+			break;
+		}
+		if ((nCommand & 0xF6) == L6470_CMD_RELEASE_SW) {
+			break;
+		}
+		pRegister[L6470_PARAM_STATUS] |= L6470_STATUS_WRONG_CMD;
+		return;
+	}
+
+	pRegister[L6470_PARAM_STATUS] &= ~L6470_STATUS_HIZ;
+}
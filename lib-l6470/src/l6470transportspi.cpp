@@ -0,0 +1,53 @@
+/**
+ * @file l6470transportspi.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#include "bcm2835.h"
+
+#if defined(__linux__)
+#elif defined(__circle__)
+#else
+ #include "bcm2835_spi.h"
+#endif
+
+#include "l6470transportspi.h"
+
+L6470TransportSpi::L6470TransportSpi(void) {
+}
+
+L6470TransportSpi::~L6470TransportSpi(void) {
+}
+
+void L6470TransportSpi::Transfer(uint8_t nChipSelect, uint8_t *pBuffer, uint32_t nLength) {
+	assert(nChipSelect <= BCM2835_SPI_CS1);
+	assert(pBuffer != 0);
+
+	bcm2835_spi_chipSelect(nChipSelect);
+	bcm2835_spi_setClockDivider(BCM2835_SPI_CLOCK_DIVIDER_64);
+	bcm2835_spi_setDataMode(BCM2835_SPI_MODE3);
+	bcm2835_spi_transfern((char *) pBuffer, nLength);
+}
@@ -36,8 +36,11 @@
 #include "modeparams.h"
 
 #include "autodriver.h"
+#include "l6470queue.h"
+#include "l6470transport.h"
 
 #define SPARKFUN_DMX_MAX_MOTORS	4
+#define SPARKFUN_DMX_MAX_CS		2
 
 class SparkFunDmx: public LightSet {
 public:
@@ -66,12 +69,16 @@ public:
 
 private:
     void callbackFunction(const char *s);
+    void QueueBegin(void);
+    void QueueEnd(void);
 
 private:
 	AutoDriver *m_pAutoDriver[SPARKFUN_DMX_MAX_MOTORS];
 	MotorParams *m_pMotorParams[SPARKFUN_DMX_MAX_MOTORS];
 	ModeParams *m_pModeParams[SPARKFUN_DMX_MAX_MOTORS];
 	L6470DmxModes *m_pL6470DmxModes[SPARKFUN_DMX_MAX_MOTORS];
+	L6470Transport *m_pTransport;
+	L6470Queue *m_pQueue[SPARKFUN_DMX_MAX_CS];	///< A daisy chain for each chip select
 
 	uint8_t m_nPosition;
 	uint8_t m_nSpiCs;
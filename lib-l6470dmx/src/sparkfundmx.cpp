@@ -39,6 +39,8 @@
 #endif
 
 #include "sparkfundmx.h"
+#include "l6470queue.h"
+#include "l6470transportspi.h"
 
 #include "readconfigfile.h"
 #include "sscan.h"
@@ -124,6 +126,10 @@ SparkFunDmx::SparkFunDmx(void): m_nDmxStartAddress(DMX_ADDRESS_INVALID), m_nDmxF
 		m_pL6470DmxModes[i] = 0;
 	}
 
+	for (int i = 0; i < SPARKFUN_DMX_MAX_CS; i++) {
+		m_pQueue[i] = 0;
+	}
+
 #if defined(__linux__) || defined(__circle__)
 	if (bcm2835_init() == 0) {
 		printf("Not able to init the bmc2835 library\n");
@@ -131,6 +137,9 @@ SparkFunDmx::SparkFunDmx(void): m_nDmxStartAddress(DMX_ADDRESS_INVALID), m_nDmxF
 	}
 #endif
 
+	m_pTransport = new L6470TransportSpi;
+	assert(m_pTransport != 0);
+
 	DEBUG_EXIT;
 }
 
@@ -159,30 +168,64 @@ SparkFunDmx::~SparkFunDmx(void) {
 		}
 	}
 
+	for (int i = 0; i < SPARKFUN_DMX_MAX_CS; i++) {
+		if (m_pQueue[i] != 0) {
+			delete m_pQueue[i];
+			m_pQueue[i] = 0;
+		}
+	}
+
+	delete m_pTransport;
+	m_pTransport = 0;
+
 	DEBUG_EXIT;
 }
 
+void SparkFunDmx::QueueBegin(void) {
+	for (int i = 0; i < SPARKFUN_DMX_MAX_CS; i++) {
+		if (m_pQueue[i] != 0) {
+			m_pQueue[i]->Begin();
+		}
+	}
+}
+
+void SparkFunDmx::QueueEnd(void) {
+	for (int i = 0; i < SPARKFUN_DMX_MAX_CS; i++) {
+		if (m_pQueue[i] != 0) {
+			m_pQueue[i]->End();
+		}
+	}
+}
+
 void SparkFunDmx::Start(void) {
 	DEBUG_ENTRY;
 
+	QueueBegin();
+
 	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->Start();
 		}
 	}
 
+	QueueEnd();
+
 	DEBUG_EXIT;
 }
 
 void SparkFunDmx::Stop(void) {
 	DEBUG_ENTRY;
 
+	QueueBegin();
+
 	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->Stop();
 		}
 	}
 
+	QueueEnd();
+
 	DEBUG_EXIT;
 }
 
@@ -262,10 +305,20 @@ void SparkFunDmx::ReadConfigFiles(void) {
 #endif
 				if ((m_nDmxStartAddressMode <= DMX_MAX_CHANNELS) && (L6470DmxModes::GetDmxFootPrintMode(m_nDmxMode) != 0)) {
 
+					L6470Queue *pQueue = 0;
+
+					if ((m_nSpiCs < SPARKFUN_DMX_MAX_CS) && (m_nPosition < L6470_QUEUE_MAX_DEVICES)) {
+						if (m_pQueue[m_nSpiCs] == 0) {
+							m_pQueue[m_nSpiCs] = new L6470Queue(m_nSpiCs, m_pTransport);
+							assert(m_pQueue[m_nSpiCs] != 0);
+						}
+						pQueue = m_pQueue[m_nSpiCs];
+					}
+
 					if (m_bIsBusyPinSet) {
-						m_pAutoDriver[i] = new AutoDriver(m_nPosition, m_nSpiCs, m_nResetPin, m_nBusyPin);
+						m_pAutoDriver[i] = new AutoDriver(m_nPosition, m_nSpiCs, m_nResetPin, m_nBusyPin, pQueue);
 					} else {
-						m_pAutoDriver[i] = new AutoDriver(m_nPosition, m_nSpiCs, m_nResetPin);
+						m_pAutoDriver[i] = new AutoDriver(m_nPosition, m_nSpiCs, m_nResetPin, pQueue);
 					}
 
 					assert(m_pAutoDriver[i] != 0);
@@ -347,12 +400,17 @@ void SparkFunDmx::SetData(uint8_t nPortId, const uint8_t *pData, uint16_t nLengt
 	assert(pData != 0);
 	assert(nLength <= DMX_MAX_CHANNELS);
 
+	// The commands for the motors on a daisy chain go out together
+	QueueBegin();
+
 	for (int i = 0; i < SPARKFUN_DMX_MAX_MOTORS; i++) {
 		if (m_pL6470DmxModes[i] != 0) {
 			m_pL6470DmxModes[i]->DmxData(pData, nLength);
 		}
 	}
 
+	QueueEnd();
+
 	DEBUG_EXIT;
 }
 
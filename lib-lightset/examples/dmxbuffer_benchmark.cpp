@@ -0,0 +1,257 @@
+/**
+ * @file dmxbuffer_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dmxbuffer.h"
+
+#define UNIVERSES		200000
+#define SLOTS			512
+#define ARTDMX_OFFSET	18		///< The slot data in an ArtDmx packet, not word aligned
+
+/*
+ * The loops of the bridges before DmxBuffer, a byte at a time
+ */
+static bool compare_copy_bytes(uint8_t *pDst, const uint8_t *pSrc, uint16_t nLength) {
+	bool isChanged = false;
+
+	for (unsigned i = 0; i < nLength; i++) {
+		if (pDst[i] != pSrc[i]) {
+			pDst[i] = pSrc[i];
+			isChanged = true;
+		}
+	}
+
+	return isChanged;
+}
+
+static bool merge_htp_bytes(uint8_t *pDst, const uint8_t *pSourceA, const uint8_t *pSourceB, uint16_t nLength) {
+	bool isChanged = false;
+
+	for (unsigned i = 0; i < nLength; i++) {
+		const uint8_t data = pSourceA[i] > pSourceB[i] ? pSourceA[i] : pSourceB[i];
+
+		if (pDst[i] != data) {
+			pDst[i] = data;
+			isChanged = true;
+		}
+	}
+
+	return isChanged;
+}
+
+static void clear_bytes(uint8_t *pDst, uint16_t nLength) {
+	for (unsigned i = 0; i < nLength; i++) {
+		pDst[i] = 0;
+	}
+}
+
+static uint8_t s_Dst[SLOTS + 64];
+static uint8_t s_DstReference[SLOTS + 64];
+static uint8_t s_SourceA[SLOTS + 64];
+static uint8_t s_SourceB[SLOTS + 64];
+
+static void fill(uint8_t *p, uint32_t nLength) {
+	for (uint32_t i = 0; i < nLength; i++) {
+		p[i] = (uint8_t) rand();
+	}
+}
+
+/*
+ * Every length and alignment, the bytes outside nLength must not be touched
+ */
+static bool verify(void) {
+	for (uint16_t nLength = 0; nLength <= SLOTS; nLength++) {
+		const uint32_t nOffset = nLength % 8;
+		uint8_t *pDst = &s_Dst[nOffset];
+		uint8_t *pDstReference = &s_DstReference[nOffset];
+		const uint8_t *pSourceA = &s_SourceA[(nOffset + 3) % 8];
+		const uint8_t *pSourceB = &s_SourceB[(nOffset + 5) % 8];
+
+		fill(s_Dst, sizeof(s_Dst));
+		fill(s_SourceA, sizeof(s_SourceA));
+		fill(s_SourceB, sizeof(s_SourceB));
+
+		// Some equal slots, so that the maximum and the change detection also see ties
+		for (uint32_t i = 0; i < nLength; i += 3) {
+			s_SourceB[(nOffset + 5) % 8 + i] = pSourceA[i];
+		}
+
+		memcpy(s_DstReference, s_Dst, sizeof(s_Dst));
+
+		if (DmxBuffer::CompareCopy(pDst, pSourceA, nLength) != compare_copy_bytes(pDstReference, pSourceA, nLength)) {
+			return false;
+		}
+
+		if (DmxBuffer::CompareCopy(pDst, pSourceA, nLength) != compare_copy_bytes(pDstReference, pSourceA, nLength)) {
+			return false;
+		}
+
+		if (DmxBuffer::MergeHtp(pDst, pSourceA, pSourceB, nLength) != merge_htp_bytes(pDstReference, pSourceA, pSourceB, nLength)) {
+			return false;
+		}
+
+		if (DmxBuffer::MergeHtp(pDst, pSourceA, pSourceB, nLength) != merge_htp_bytes(pDstReference, pSourceA, pSourceB, nLength)) {
+			return false;
+		}
+
+		if (memcmp(s_Dst, s_DstReference, sizeof(s_Dst)) != 0) {
+			return false;
+		}
+
+		DmxBuffer::Clear(pDst, nLength);
+		clear_bytes(pDstReference, nLength);
+
+		if (memcmp(s_Dst, s_DstReference, sizeof(s_Dst)) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * The time stamp counter on x86, else the monotonic clock in ns
+ */
+static uint64_t ticks(void) {
+#if defined (__x86_64__) || defined (__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+#if defined (__x86_64__) || defined (__i386__)
+ static const char s_Unit[] = "cycles";
+#else
+ static const char s_Unit[] = "ns";
+#endif
+
+static volatile bool s_bSink;
+
+static void report(const char *pName, uint64_t nBytes, uint64_t nWords) {
+	printf("%-27s: %7.1f %s/universe, %7.1f %s/universe byte wise, %4.1fx\n", pName,
+			(double) nWords / UNIVERSES, s_Unit, (double) nBytes / UNIVERSES, s_Unit, (double) nBytes / (double) (nWords == 0 ? 1 : nWords));
+}
+
+/*
+ * bIsChanging, every universe has new levels (i.e. a moving scene), else the same universe is received again
+ */
+static void benchmark_compare_copy(const char *pName, bool bIsChanging) {
+	uint8_t *pDst = &s_Dst[ARTDMX_OFFSET % 8];
+	uint8_t *pSrc = &s_SourceA[ARTDMX_OFFSET];
+	uint64_t nBytes = 0;
+	uint64_t nWords = 0;
+
+	fill(pSrc, SLOTS);
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		if (bIsChanging) {
+			pSrc[i % SLOTS]++;
+		}
+		const uint64_t nStart = ticks();
+		s_bSink = compare_copy_bytes(pDst, pSrc, SLOTS);
+		nBytes += ticks() - nStart;
+	}
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		if (bIsChanging) {
+			pSrc[i % SLOTS]++;
+		}
+		const uint64_t nStart = ticks();
+		s_bSink = DmxBuffer::CompareCopy(pDst, pSrc, SLOTS);
+		nWords += ticks() - nStart;
+	}
+
+	report(pName, nBytes, nWords);
+}
+
+static void benchmark_merge_htp(void) {
+	uint8_t *pDst = &s_Dst[ARTDMX_OFFSET % 8];
+	uint64_t nBytes = 0;
+	uint64_t nWords = 0;
+
+	fill(s_SourceA, SLOTS);
+	fill(s_SourceB, SLOTS);
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		s_SourceA[i % SLOTS]++;
+		const uint64_t nStart = ticks();
+		s_bSink = merge_htp_bytes(pDst, s_SourceA, s_SourceB, SLOTS);
+		nBytes += ticks() - nStart;
+	}
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		s_SourceA[i % SLOTS]++;
+		const uint64_t nStart = ticks();
+		s_bSink = DmxBuffer::MergeHtp(pDst, s_SourceA, s_SourceB, SLOTS);
+		nWords += ticks() - nStart;
+	}
+
+	report("MergeHtp", nBytes, nWords);
+}
+
+static void benchmark_clear(void) {
+	uint8_t *pDst = &s_Dst[ARTDMX_OFFSET % 8];
+	uint64_t nBytes = 0;
+	uint64_t nWords = 0;
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		pDst[i % SLOTS] = 1;
+		const uint64_t nStart = ticks();
+		clear_bytes(pDst, SLOTS);
+		nBytes += ticks() - nStart;
+	}
+
+	for (uint32_t i = 0; i < UNIVERSES; i++) {
+		pDst[i % SLOTS] = 1;
+		const uint64_t nStart = ticks();
+		DmxBuffer::Clear(pDst, SLOTS);
+		nWords += ticks() - nStart;
+	}
+
+	report("Clear", nBytes, nWords);
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+
+	const bool bIsOk = verify();
+
+	printf("Compare with byte wise kernels : %s\n", bIsOk ? "OK" : "FAILED");
+
+	benchmark_compare_copy("CompareCopy, unchanged", false);
+	benchmark_compare_copy("CompareCopy, 1 slot changed", true);
+	benchmark_merge_htp();
+	benchmark_clear();
+
+	return bIsOk ? 0 : 1;
+}
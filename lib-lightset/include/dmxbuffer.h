@@ -0,0 +1,55 @@
+/**
+ * @file dmxbuffer.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXBUFFER_H_
+#define DMXBUFFER_H_
+
+#include <stdint.h>
+
+/**
+ * DMX slot buffer kernels shared by the network bridges.
+ *
+ * The NEON version is used when the compiler targets it (Raspberry Pi 2/3),
+ * otherwise the buffers are processed a machine word at a time.
+ * Only the first nLength slots of each buffer are read or written.
+ */
+class DmxBuffer {
+public:
+	/**
+	 * Copies pSrc into pDst.
+	 * @return true when at least one slot in pDst has changed.
+	 */
+	static bool CompareCopy(uint8_t *pDst, const uint8_t *pSrc, uint16_t nLength);
+
+	/**
+	 * Stores the HTP (highest takes precedence) merge of pSourceA and pSourceB into pDst.
+	 * @return true when at least one slot in pDst has changed.
+	 */
+	static bool MergeHtp(uint8_t *pDst, const uint8_t *pSourceA, const uint8_t *pSourceB, uint16_t nLength);
+
+	static void Clear(uint8_t *pDst, uint16_t nLength);
+};
+
+#endif /* DMXBUFFER_H_ */
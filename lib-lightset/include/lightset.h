@@ -46,6 +46,12 @@ public:
 
 	virtual void SetData(uint8_t, const uint8_t *, uint16_t)= 0;
 
+public: // Optional
+	// Called after the pending data of all ports has been passed on by an ArtSync or E1.31 Synchronization packet
+	virtual void Sync(void);
+	// Called before SetData and Sync with the sender and the Art-Net OpCode or the E1.31 framing layer vector
+	virtual void SetSource(uint32_t nIpAddress, uint16_t nOpCode);
+
 public: // RDM Optional
 	virtual bool SetDmxStartAddress(uint16_t nDmxStartAddress);
 	virtual uint16_t GetDmxStartAddress(void);
@@ -0,0 +1,104 @@
+/**
+ * @file lightsetcurve.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LIGHTSETCURVE_H_
+#define LIGHTSETCURVE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LIGHTSET_CURVE_TABLE_SIZE		256
+#define LIGHTSET_CURVE_POINTS_MAX		16
+#define LIGHTSET_CURVE_POINTS_LENGTH	((LIGHTSET_CURVE_POINTS_MAX * 10) - 1)	///< "255:65535," for each point, the config file line buffer must fit it
+#define LIGHTSET_CURVE_GAMMA_DEFAULT	2.2f
+
+enum TLightSetCurve {
+	LIGHTSET_CURVE_LINEAR = 0,
+	LIGHTSET_CURVE_GAMMA,
+	LIGHTSET_CURVE_SQUARE,
+	LIGHTSET_CURVE_CUSTOM,
+	LIGHTSET_CURVE_UNDEFINED
+};
+
+/*
+ * Dimming curve from a DMX value to a 16-bit output value.
+ * The table is built once, before the first frame. A value is then a table look-up
+ * with a linear interpolation on the low byte.
+ */
+class LightSetCurve {
+public:
+	LightSetCurve(void);
+	~LightSetCurve(void);
+
+	void SetType(TLightSetCurve tLightSetCurve);
+	inline TLightSetCurve GetType(void) const {
+		return m_tType;
+	}
+
+	void SetGamma(float fGamma);
+	inline float GetGamma(void) const {
+		return m_fGamma;
+	}
+
+	// "dmx:output,dmx:output,..." with dmx 0-255 ascending, output 0-65535
+	bool SetPoints(const char *pPoints);
+
+	void Build(void);
+
+	inline bool IsLinear(void) const {
+		return m_tType == LIGHTSET_CURVE_LINEAR;
+	}
+
+	inline uint16_t Get(uint16_t nValue) const {
+		const uint32_t i = nValue >> 8;
+		const int32_t nFrom = (int32_t) m_aTable[i];
+		const int32_t nTo = (int32_t) m_aTable[i + 1];
+
+		return (uint16_t) (nFrom + (((nTo - nFrom) * (int32_t) (nValue & 0xFF)) >> 8));
+	}
+
+	inline uint16_t Get(uint8_t nValue) const {
+		return Get((uint16_t) (((uint16_t) nValue << 8) | nValue));
+	}
+
+	void Dump(void);
+
+public:
+	static const char *GetTypeString(TLightSetCurve tLightSetCurve);
+	static TLightSetCurve GetType(const char *pString);
+
+private:
+	uint16_t GetPoints(uint32_t nIndex) const;
+
+private:
+	TLightSetCurve m_tType;
+	float m_fGamma;
+	uint32_t m_nPoints;
+	uint8_t m_aPointDmx[LIGHTSET_CURVE_POINTS_MAX];
+	uint16_t m_aPointOutput[LIGHTSET_CURVE_POINTS_MAX];
+	uint16_t m_aTable[LIGHTSET_CURVE_TABLE_SIZE + 1];
+};
+
+#endif /* LIGHTSETCURVE_H_ */
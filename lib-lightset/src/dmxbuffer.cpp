@@ -0,0 +1,175 @@
+/**
+ * @file dmxbuffer.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#include "dmxbuffer.h"
+
+/*
+ * The buffers are not guaranteed to be word aligned (i.e. the ArtDmx slot data
+ * starts at offset 18). The loads and stores are done with __builtin_memcpy,
+ * which the compiler turns into (unaligned) single loads and stores. It does
+ * not depend on the C library, so it is also usable for the bare-metal builds.
+ */
+
+#if defined (__ARM_NEON__) || defined (__ARM_NEON)
+ typedef uint8_t vector_t __attribute__ ((vector_size (16)));
+ #define DMX_BUFFER_NEON
+#endif
+
+#if defined (__LP64__)
+ typedef uint64_t word_t;
+#else
+ typedef uint32_t word_t;
+#endif
+
+#define WORD_ONES	((word_t) ~0 / 0xFF)	///< 0x01 in every byte
+#define WORD_HIGHS	(WORD_ONES * 0x80)		///< 0x80 in every byte
+
+/**
+ * Byte wise unsigned maximum of two words.
+ *
+ * (a | 0x80) - (b & 0x7F) never borrows from the next byte, so the high bit
+ * of each byte of d tells whether the lower 7 bits of a are >= those of b.
+ * When the high bits of a and b differ, that high bit decides instead.
+ */
+inline static word_t max_bytes(word_t a, word_t b) {
+	const word_t d = (a | WORD_HIGHS) - (b & ~WORD_HIGHS);
+	const word_t ge = ((a & ~b) | (~(a ^ b) & d)) & WORD_HIGHS;
+	const word_t mask = (ge >> 7) * 0xFF;
+
+	return (a & mask) | (b & ~mask);
+}
+
+bool DmxBuffer::CompareCopy(uint8_t *pDst, const uint8_t *pSrc, uint16_t nLength) {
+	assert(pDst != 0);
+	assert(pSrc != 0);
+
+	unsigned i = 0;
+
+#if defined (DMX_BUFFER_NEON)
+	vector_t vChanged = {0};
+
+	for (; i + sizeof(vector_t) <= nLength; i += sizeof(vector_t)) {
+		vector_t vDst, vSrc;
+		__builtin_memcpy(&vDst, &pDst[i], sizeof(vector_t));
+		__builtin_memcpy(&vSrc, &pSrc[i], sizeof(vector_t));
+		vChanged |= vDst ^ vSrc;
+		__builtin_memcpy(&pDst[i], &vSrc, sizeof(vector_t));
+	}
+
+	word_t nChanged = 0;
+
+	for (unsigned j = 0; j < sizeof(vector_t); j += sizeof(word_t)) {
+		word_t w;
+		__builtin_memcpy(&w, reinterpret_cast<uint8_t *>(&vChanged) + j, sizeof(word_t));
+		nChanged |= w;
+	}
+#else
+	word_t nChanged = 0;
+#endif
+
+	for (; i + sizeof(word_t) <= nLength; i += sizeof(word_t)) {
+		word_t nDst, nSrc;
+		__builtin_memcpy(&nDst, &pDst[i], sizeof(word_t));
+		__builtin_memcpy(&nSrc, &pSrc[i], sizeof(word_t));
+		nChanged |= nDst ^ nSrc;
+		__builtin_memcpy(&pDst[i], &nSrc, sizeof(word_t));
+	}
+
+	for (; i < nLength; i++) {
+		nChanged |= pDst[i] ^ pSrc[i];
+		pDst[i] = pSrc[i];
+	}
+
+	return nChanged != 0;
+}
+
+bool DmxBuffer::MergeHtp(uint8_t *pDst, const uint8_t *pSourceA, const uint8_t *pSourceB, uint16_t nLength) {
+	assert(pDst != 0);
+	assert(pSourceA != 0);
+	assert(pSourceB != 0);
+
+	unsigned i = 0;
+
+#if defined (DMX_BUFFER_NEON)
+	vector_t vChanged = {0};
+
+	for (; i + sizeof(vector_t) <= nLength; i += sizeof(vector_t)) {
+		vector_t vDst, vA, vB;
+		__builtin_memcpy(&vDst, &pDst[i], sizeof(vector_t));
+		__builtin_memcpy(&vA, &pSourceA[i], sizeof(vector_t));
+		__builtin_memcpy(&vB, &pSourceB[i], sizeof(vector_t));
+		const vector_t vMask = (vector_t) (vA > vB);
+		const vector_t vMax = (vA & vMask) | (vB & ~vMask);
+		vChanged |= vDst ^ vMax;
+		__builtin_memcpy(&pDst[i], &vMax, sizeof(vector_t));
+	}
+
+	word_t nChanged = 0;
+
+	for (unsigned j = 0; j < sizeof(vector_t); j += sizeof(word_t)) {
+		word_t w;
+		__builtin_memcpy(&w, reinterpret_cast<uint8_t *>(&vChanged) + j, sizeof(word_t));
+		nChanged |= w;
+	}
+#else
+	word_t nChanged = 0;
+#endif
+
+	for (; i + sizeof(word_t) <= nLength; i += sizeof(word_t)) {
+		word_t nDst, nA, nB;
+		__builtin_memcpy(&nDst, &pDst[i], sizeof(word_t));
+		__builtin_memcpy(&nA, &pSourceA[i], sizeof(word_t));
+		__builtin_memcpy(&nB, &pSourceB[i], sizeof(word_t));
+		const word_t nMax = max_bytes(nA, nB);
+		nChanged |= nDst ^ nMax;
+		__builtin_memcpy(&pDst[i], &nMax, sizeof(word_t));
+	}
+
+	for (; i < nLength; i++) {
+		const uint8_t nMax = pSourceA[i] > pSourceB[i] ? pSourceA[i] : pSourceB[i];
+		nChanged |= pDst[i] ^ nMax;
+		pDst[i] = nMax;
+	}
+
+	return nChanged != 0;
+}
+
+void DmxBuffer::Clear(uint8_t *pDst, uint16_t nLength) {
+	assert(pDst != 0);
+
+	const word_t nZero = 0;
+	unsigned i = 0;
+
+	for (; i + sizeof(word_t) <= nLength; i += sizeof(word_t)) {
+		__builtin_memcpy(&pDst[i], &nZero, sizeof(word_t));
+	}
+
+	for (; i < nLength; i++) {
+		pDst[i] = 0;
+	}
+}
@@ -31,6 +31,14 @@ LightSet::~LightSet(void) {
 
 }
 
+void LightSet::Sync(void) {
+
+}
+
+void LightSet::SetSource(uint32_t nIpAddress, uint16_t nOpCode) {
+
+}
+
 uint16_t LightSet::GetDmxStartAddress(void) {
 	return 1;
 }
@@ -0,0 +1,212 @@
+/**
+ * @file lightsetcurve.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#ifndef NDEBUG
+ #include <stdio.h>
+#endif
+#include <assert.h>
+
+#include "lightsetcurve.h"
+
+static const char s_aTypes[LIGHTSET_CURVE_UNDEFINED][7] = { "linear", "gamma", "square", "custom" };
+
+static bool is_equal(const char *pString, const char *pType) {
+	while (*pType != '\0') {
+		if ((*pString | 0x20) != *pType) {
+			return false;
+		}
+		pString++;
+		pType++;
+	}
+
+	return (*pString == '\0');
+}
+
+LightSetCurve::LightSetCurve(void):
+	m_tType(LIGHTSET_CURVE_LINEAR),
+	m_fGamma(LIGHTSET_CURVE_GAMMA_DEFAULT),
+	m_nPoints(0)
+{
+	Build();
+}
+
+LightSetCurve::~LightSetCurve(void) {
+}
+
+void LightSetCurve::SetType(TLightSetCurve tLightSetCurve) {
+	if (tLightSetCurve < LIGHTSET_CURVE_UNDEFINED) {
+		m_tType = tLightSetCurve;
+	}
+}
+
+void LightSetCurve::SetGamma(float fGamma) {
+	if ((fGamma > 0) && (fGamma <= 10)) {
+		m_fGamma = fGamma;
+	}
+}
+
+bool LightSetCurve::SetPoints(const char *pPoints) {
+	assert(pPoints != 0);
+
+	const char *p = pPoints;
+	uint32_t nPoints = 0;
+
+	while (*p != '\0') {
+		uint32_t nDmx = 0;
+		uint32_t nOutput = 0;
+		uint32_t nDigits = 0;
+
+		while ((*p >= '0') && (*p <= '9') && (nDigits++ < 3)) {
+			nDmx = nDmx * 10 + (uint32_t) (*p++ - '0');
+		}
+
+		if ((nDigits == 0) || (nDmx > 255) || (*p++ != ':')) {
+			return false;
+		}
+
+		nDigits = 0;
+
+		while ((*p >= '0') && (*p <= '9') && (nDigits++ < 5)) {
+			nOutput = nOutput * 10 + (uint32_t) (*p++ - '0');
+		}
+
+		if ((nDigits == 0) || (nOutput > 0xFFFF) || (nPoints == LIGHTSET_CURVE_POINTS_MAX)) {
+			return false;
+		}
+
+		if ((nPoints != 0) && (nDmx <= m_aPointDmx[nPoints - 1])) {
+			return false;
+		}
+
+		m_aPointDmx[nPoints] = (uint8_t) nDmx;
+		m_aPointOutput[nPoints] = (uint16_t) nOutput;
+		nPoints++;
+
+		if (*p == ',') {
+			p++;
+		} else if (*p != '\0') {
+			return false;
+		}
+	}
+
+	m_nPoints = nPoints;
+
+	return (nPoints != 0);
+}
+
+/*
+ * Piecewise linear through the points, flat before the first and after the last one.
+ * nIndex is on the table scale, 0 to LIGHTSET_CURVE_TABLE_SIZE.
+ */
+uint16_t LightSetCurve::GetPoints(uint32_t nIndex) const {
+	const uint32_t nDmx256 = nIndex * 255;	// DMX value times 256
+
+	if (nDmx256 <= ((uint32_t) m_aPointDmx[0] << 8)) {
+		return m_aPointOutput[0];
+	}
+
+	for (uint32_t i = 1; i < m_nPoints; i++) {
+		const uint32_t nTo = (uint32_t) m_aPointDmx[i] << 8;
+
+		if (nDmx256 <= nTo) {
+			const uint32_t nFrom = (uint32_t) m_aPointDmx[i - 1] << 8;
+			const float fDelta = (float) m_aPointOutput[i] - (float) m_aPointOutput[i - 1];
+
+			return (uint16_t) (0.5f + (float) m_aPointOutput[i - 1] + (fDelta * (float) (nDmx256 - nFrom)) / (float) (nTo - nFrom));
+		}
+	}
+
+	return m_aPointOutput[m_nPoints - 1];
+}
+
+void LightSetCurve::Build(void) {
+	TLightSetCurve tType = m_tType;
+
+	if ((tType == LIGHTSET_CURVE_CUSTOM) && (m_nPoints == 0)) {
+		tType = LIGHTSET_CURVE_LINEAR;
+	}
+
+	for (uint32_t i = 0; i <= LIGHTSET_CURVE_TABLE_SIZE; i++) {
+		const float x = (float) i / LIGHTSET_CURVE_TABLE_SIZE;
+		uint32_t nValue;
+
+		switch (tType) {
+		case LIGHTSET_CURVE_GAMMA:
+			nValue = (uint32_t) (0.5f + 65535 * powf(x, m_fGamma));
+			break;
+		case LIGHTSET_CURVE_SQUARE:
+			nValue = (i * i * 65535) / (LIGHTSET_CURVE_TABLE_SIZE * LIGHTSET_CURVE_TABLE_SIZE);
+			break;
+		case LIGHTSET_CURVE_CUSTOM:
+			nValue = GetPoints(i);
+			break;
+		default:
+			nValue = i << 8;
+			break;
+		}
+
+		m_aTable[i] = (uint16_t) (nValue > 0xFFFF ? 0xFFFF : nValue);
+	}
+}
+
+void LightSetCurve::Dump(void) {
+#ifndef NDEBUG
+	printf("%s::%s\n", __FILE__, __FUNCTION__);
+	printf(" type=%s", GetTypeString(m_tType));
+
+	if (m_tType == LIGHTSET_CURVE_GAMMA) {
+		printf(", gamma=%d.%02d", (int) m_fGamma, (int) (100 * (m_fGamma - (int) m_fGamma)));
+	}
+
+	printf("\n");
+
+	for (uint32_t i = 0; i <= LIGHTSET_CURVE_TABLE_SIZE; i += 32) {
+		printf(" [%3d]=%5d\n", (int) i, (int) m_aTable[i]);
+	}
+#endif
+}
+
+const char *LightSetCurve::GetTypeString(TLightSetCurve tLightSetCurve) {
+	if (tLightSetCurve < LIGHTSET_CURVE_UNDEFINED) {
+		return s_aTypes[tLightSetCurve];
+	}
+
+	return "undefined";
+}
+
+TLightSetCurve LightSetCurve::GetType(const char *pString) {
+	assert(pString != 0);
+
+	for (uint32_t i = 0; i < LIGHTSET_CURVE_UNDEFINED; i++) {
+		if (is_equal(pString, s_aTypes[i])) {
+			return (TLightSetCurve) i;
+		}
+	}
+
+	return LIGHTSET_CURVE_UNDEFINED;
+}
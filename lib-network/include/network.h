@@ -47,6 +47,23 @@
 #define MACSTR "%.2x:%.2x:%.2x:%.2x:%.2x:%.2x"
 #endif
 
+#define NETWORK_WAIT_FOREVER	((uint32_t) ~0)	///< No timer pending, wait until a datagram arrives
+
+#if !defined (BARE_METAL) && !defined (__circle__)
+ #define NETWORK_HAVE_RECV_BURST
+ #define NETWORK_HAVE_WAIT
+ #define NETWORK_RECV_BURST_MAX	32	///< Maximum number of datagrams returned by one RecvBurst call
+#endif
+
+#if defined (NETWORK_HAVE_RECV_BURST)
+struct TNetworkDatagram {
+	const uint8_t *pData;	///< Points into a receive slot owned by the Network. Valid until the next RecvBurst call.
+	uint16_t nLength;		///< Number of bytes received
+	uint32_t nFromIp;		///<
+	uint16_t nFromPort;		///<
+};
+#endif
+
 class Network {
 public:
 	Network(void);
@@ -82,6 +99,24 @@ public:
 	virtual uint16_t RecvFrom(const uint8_t *packet, uint16_t size, uint32_t *from_ip, uint16_t *from_port)=0;
 	virtual void SendTo(const uint8_t *packet, uint16_t size, uint32_t to_ip, uint16_t remote_port)=0;
 
+#if defined (NETWORK_HAVE_RECV_BURST)
+	/**
+	 * Receive all datagrams that are queued on the socket, up to nMaxDatagrams, with one call.
+	 * Waits at most the socket receive timeout for the first datagram.
+	 * @return The number of datagrams filled in pDatagrams.
+	 */
+	virtual uint16_t RecvBurst(struct TNetworkDatagram *pDatagrams, uint16_t nMaxDatagrams)=0;
+#endif
+
+#if defined (NETWORK_HAVE_WAIT)
+	/**
+	 * Block until a datagram can be received or nTimeoutMillis has elapsed.
+	 * @param nTimeoutMillis Time to the next deadline of the caller, or \ref NETWORK_WAIT_FOREVER.
+	 * @return true when a datagram is ready to be received.
+	 */
+	virtual bool WaitForPacket(uint32_t nTimeoutMillis)=0;
+#endif
+
 #if !defined(__circle__)
 	virtual void SetIp(uint32_t nIp)=0;
 #endif
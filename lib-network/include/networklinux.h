@@ -36,6 +36,14 @@
  #define HOST_NAME_MAX 255
 #endif
 
+#define NETWORK_LINUX_SLOT_SIZE		1500	///< Receive slot size, one Ethernet MTU
+
+#if defined (__linux__)
+struct mmsghdr;
+struct iovec;
+struct sockaddr_in;
+#endif
+
 class NetworkLinux: public Network {
 public:
 	NetworkLinux(void);
@@ -55,6 +63,10 @@ public:
 	uint16_t RecvFrom(const uint8_t *packet, uint16_t size, uint32_t *from_ip, uint16_t *from_port);
 	void SendTo(const uint8_t *packet, uint16_t size, uint32_t to_ip, uint16_t remote_port);
 
+	uint16_t RecvBurst(struct TNetworkDatagram *pDatagrams, uint16_t nMaxDatagrams);
+
+	bool WaitForPacket(uint32_t nTimeoutMillis);
+
 private:
 	bool is_dhclient(const char *if_name);
 	int if_get_by_address(const char *ip, char *name, size_t len);
@@ -62,8 +74,15 @@ private:
 
 private:
 	int _socket;
+	int _poll_fd;
 	char _if_name[IFNAMSIZ];
 	char _hostname[HOST_NAME_MAX + 1];
+	uint8_t (*_burst_slots)[NETWORK_LINUX_SLOT_SIZE];
+#if defined (__linux__)
+	struct mmsghdr *_burst_msgs;
+	struct iovec *_burst_iovecs;
+	struct sockaddr_in *_burst_from;
+#endif
 };
 
 #endif /* NETWORKLINUX_H_ */
@@ -30,10 +30,17 @@
 #include <arpa/inet.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 #include <net/if.h>
 #include <ifaddrs.h>
 #include <errno.h>
 #include <assert.h>
+#if defined (__linux__)
+ #include <sys/epoll.h>
+#else
+ #include <poll.h>
+#endif
 
 #if defined (__APPLE__)
  #include <sys/sysctl.h>
@@ -88,7 +95,7 @@ static bool osx_get_macaddress(const char *if_name, uint8_t *mac_address) {
 
 
 
-NetworkLinux::NetworkLinux(void): _socket(-1) {
+NetworkLinux::NetworkLinux(void): _socket(-1), _poll_fd(-1) {
 	for (unsigned i = 0; i < sizeof(_if_name); i++) {
 		_if_name[i] = '\0';
 	}
@@ -96,6 +103,30 @@ NetworkLinux::NetworkLinux(void): _socket(-1) {
 	for (unsigned i = 0; i < sizeof(_hostname); i++) {
 		_hostname[i] = '\0';
 	}
+
+	_burst_slots = new uint8_t[NETWORK_RECV_BURST_MAX][NETWORK_LINUX_SLOT_SIZE];
+	assert(_burst_slots != 0);
+
+#if defined (__linux__)
+	_burst_msgs = new struct mmsghdr[NETWORK_RECV_BURST_MAX];
+	_burst_iovecs = new struct iovec[NETWORK_RECV_BURST_MAX];
+	_burst_from = new struct sockaddr_in[NETWORK_RECV_BURST_MAX];
+
+	assert(_burst_msgs != 0);
+	assert(_burst_iovecs != 0);
+	assert(_burst_from != 0);
+
+	memset(_burst_msgs, 0, NETWORK_RECV_BURST_MAX * sizeof(struct mmsghdr));
+
+	// The message headers point at fixed slots, so they are set up only once
+	for (unsigned i = 0; i < NETWORK_RECV_BURST_MAX; i++) {
+		_burst_iovecs[i].iov_base = _burst_slots[i];
+		_burst_iovecs[i].iov_len = NETWORK_LINUX_SLOT_SIZE;
+		_burst_msgs[i].msg_hdr.msg_iov = &_burst_iovecs[i];
+		_burst_msgs[i].msg_hdr.msg_iovlen = 1;
+		_burst_msgs[i].msg_hdr.msg_name = &_burst_from[i];
+	}
+#endif
 }
 
 NetworkLinux::~NetworkLinux(void) {
@@ -104,6 +135,13 @@ NetworkLinux::~NetworkLinux(void) {
 #endif
 
 	End();
+
+#if defined (__linux__)
+	delete[] _burst_from;
+	delete[] _burst_iovecs;
+	delete[] _burst_msgs;
+#endif
+	delete[] _burst_slots;
 }
 
 int NetworkLinux::Init(const char *s) {
@@ -177,6 +215,27 @@ void NetworkLinux::Begin(uint16_t nPort) {
 		perror("bind");
 		exit(EXIT_FAILURE);
 	}
+
+#if defined (__linux__)
+	if (_poll_fd > 0) {
+		close(_poll_fd);
+	}
+
+	if ((_poll_fd = epoll_create1(0)) == -1) {
+		perror("epoll_create1");
+		exit(EXIT_FAILURE);
+	}
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = _socket;
+
+	if (epoll_ctl(_poll_fd, EPOLL_CTL_ADD, _socket, &event) == -1) {
+		perror("epoll_ctl(EPOLL_CTL_ADD)");
+		exit(EXIT_FAILURE);
+	}
+#endif
 }
 
 
@@ -194,6 +253,11 @@ void NetworkLinux::End(void) {
 	printf("NetworkLinux::End, _socket = %d\n", _socket);
 #endif
 
+	if (_poll_fd > 0) {
+		close(_poll_fd);
+	}
+	_poll_fd = -1;
+
 	if (_socket > 0) {
 		close(_socket);
 	}
@@ -286,6 +350,84 @@ uint16_t NetworkLinux::RecvFrom(const uint8_t* packet, uint16_t size, uint32_t*
 	return recv_len;
 }
 
+bool NetworkLinux::WaitForPacket(uint32_t nTimeoutMillis) {
+	assert(_socket != -1);
+
+	// Both epoll_wait and poll take an int, where -1 means no timeout
+	const int nTimeout = (nTimeoutMillis == NETWORK_WAIT_FOREVER) ? -1 : (nTimeoutMillis > (uint32_t) INT_MAX ? INT_MAX : (int) nTimeoutMillis);
+
+#if defined (__linux__)
+	struct epoll_event event;
+
+	const int nReady = epoll_wait(_poll_fd, &event, 1, nTimeout);
+#else
+	struct pollfd fds;
+	fds.fd = _socket;
+	fds.events = POLLIN;
+	fds.revents = 0;
+
+	const int nReady = poll(&fds, 1, nTimeout);
+#endif
+
+	if (nReady == -1) {
+		if (errno != EINTR) {
+			perror("WaitForPacket");
+		}
+		return false;
+	}
+
+	return (nReady > 0);
+}
+
+uint16_t NetworkLinux::RecvBurst(struct TNetworkDatagram *pDatagrams, uint16_t nMaxDatagrams) {
+	assert(pDatagrams != NULL);
+
+	if (nMaxDatagrams > NETWORK_RECV_BURST_MAX) {
+		nMaxDatagrams = NETWORK_RECV_BURST_MAX;
+	}
+
+#if defined (__linux__)
+	for (unsigned i = 0; i < nMaxDatagrams; i++) {
+		_burst_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	// MSG_WAITFORONE : block (up to SO_RCVTIMEO) for the first datagram only, then take what is queued
+	const int nReceived = recvmmsg(_socket, _burst_msgs, nMaxDatagrams, MSG_WAITFORONE, NULL);
+
+	if (nReceived == -1) {
+		if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+			perror("recvmmsg");
+		}
+		return 0;
+	}
+
+	for (int i = 0; i < nReceived; i++) {
+		pDatagrams[i].pData = _burst_slots[i];
+		pDatagrams[i].nLength = (uint16_t) _burst_msgs[i].msg_len;
+		pDatagrams[i].nFromIp = _burst_from[i].sin_addr.s_addr;
+		pDatagrams[i].nFromPort = ntohs(_burst_from[i].sin_port);
+	}
+
+	return (uint16_t) nReceived;
+#else
+	uint16_t nReceived = 0;
+
+	while (nReceived < nMaxDatagrams) {
+		const uint16_t nLength = RecvFrom(_burst_slots[nReceived], NETWORK_LINUX_SLOT_SIZE, &pDatagrams[nReceived].nFromIp, &pDatagrams[nReceived].nFromPort);
+
+		if (nLength == 0) {
+			break;
+		}
+
+		pDatagrams[nReceived].pData = _burst_slots[nReceived];
+		pDatagrams[nReceived].nLength = nLength;
+		nReceived++;
+	}
+
+	return nReceived;
+#endif
+}
+
 void NetworkLinux::SendTo(const uint8_t* packet, uint16_t size, uint32_t to_ip, uint16_t remote_port) {
 	struct sockaddr_in si_other;
 	int slen = sizeof(si_other);
@@ -0,0 +1,241 @@
+/**
+ * @file messageview_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "oscmessage.h"
+#include "oscmessageview.h"
+#include "oscblob.h"
+#include "osc.h"
+
+/*
+ * OSCMessageView against OSCMessage, on the messages OscServer receives.
+ * Both must give the same path, types and arguments, then both are timed with reading the arguments.
+ */
+
+#define MESSAGES	1000000
+#define BLOB_SIZE	512
+
+struct TPacket {
+	const char *pName;
+	uint8_t aData[64 + BLOB_SIZE];
+	unsigned nSize;
+};
+
+static unsigned add_string(uint8_t *p, unsigned nSize, const char *pString) {
+	const unsigned nLength = (unsigned) strlen(pString);
+
+	memcpy(&p[nSize], pString, nLength);
+	memset(&p[nSize + nLength], 0, 4 - (nLength & 3));
+
+	return nSize + ((nLength + 4) & ~3U);
+}
+
+static unsigned add_uint32(uint8_t *p, unsigned nSize, uint32_t n) {
+	p[nSize] = (uint8_t) (n >> 24);
+	p[nSize + 1] = (uint8_t) (n >> 16);
+	p[nSize + 2] = (uint8_t) (n >> 8);
+	p[nSize + 3] = (uint8_t) n;
+
+	return nSize + 4;
+}
+
+static unsigned add_float(uint8_t *p, unsigned nSize, float f) {
+	uint32_t n;
+	memcpy(&n, &f, sizeof(uint32_t));
+
+	return add_uint32(p, nSize, n);
+}
+
+static TPacket s_Packets[5];
+
+static void build(void) {
+	TPacket *p = s_Packets;
+	unsigned nSize;
+
+	p->pName = "/dmx1/12 ,f";
+	nSize = add_string(p->aData, 0, "/dmx1/12");
+	nSize = add_string(p->aData, nSize, ",f");
+	p->nSize = add_float(p->aData, nSize, 0.5f);
+	p++;
+
+	p->pName = "/dmx1 ,ii";
+	nSize = add_string(p->aData, 0, "/dmx1");
+	nSize = add_string(p->aData, nSize, ",ii");
+	nSize = add_uint32(p->aData, nSize, 11);
+	p->nSize = add_uint32(p->aData, nSize, 255);
+	p++;
+
+	p->pName = "/dmx1 ,b";
+	nSize = add_string(p->aData, 0, "/dmx1");
+	nSize = add_string(p->aData, nSize, ",b");
+	nSize = add_uint32(p->aData, nSize, BLOB_SIZE);
+	for (unsigned i = 0; i < BLOB_SIZE; i++) {
+		p->aData[nSize++] = (uint8_t) i;
+	}
+	p->nSize = nSize;
+	p++;
+
+	p->pName = "/2/label ,s";
+	nSize = add_string(p->aData, 0, "/2/label");
+	nSize = add_string(p->aData, nSize, ",s");
+	p->nSize = add_string(p->aData, nSize, "fader");
+	p++;
+
+	p->pName = "/ping ,";
+	nSize = add_string(p->aData, 0, "/ping");
+	p->nSize = add_string(p->aData, nSize, ",");
+}
+
+/*
+ * The sum of the arguments, as OscServer would use them
+ */
+static uint32_t read_message(OSCMessage &Msg) {
+	uint32_t nSum = 0;
+
+	for (int i = 0; i < Msg.GetArgc(); i++) {
+		switch (Msg.GetType((unsigned) i)) {
+		case OSC_INT32:
+			nSum += (uint32_t) Msg.GetInt((unsigned) i);
+			break;
+		case OSC_FLOAT:
+			nSum += (uint32_t) (Msg.GetFloat((unsigned) i) * 255);
+			break;
+		case OSC_STRING:
+			nSum += (uint32_t) Msg.GetString((unsigned) i)[0];
+			break;
+		case OSC_BLOB: {
+			OSCBlob blob = Msg.GetBlob((unsigned) i);
+			nSum += (uint32_t) blob.GetDataSize() + (uint32_t) blob.GetByte(1);
+		}
+			break;
+		default:
+			break;
+		}
+	}
+
+	return nSum;
+}
+
+static uint32_t read_view(const OSCMessageView &View) {
+	uint32_t nSum = 0;
+
+	for (int i = 0; i < View.GetArgc(); i++) {
+		switch (View.GetType((unsigned) i)) {
+		case OSC_INT32:
+			nSum += (uint32_t) View.GetInt((unsigned) i);
+			break;
+		case OSC_FLOAT:
+			nSum += (uint32_t) (View.GetFloat((unsigned) i) * 255);
+			break;
+		case OSC_STRING:
+			nSum += (uint32_t) View.GetString((unsigned) i)[0];
+			break;
+		case OSC_BLOB: {
+			OSCBlob blob = View.GetBlob((unsigned) i);
+			nSum += (uint32_t) blob.GetDataSize() + (uint32_t) blob.GetByte(1);
+		}
+			break;
+		default:
+			break;
+		}
+	}
+
+	return nSum;
+}
+
+static bool compare(TPacket *p) {
+	OSCMessage Msg(p->aData, p->nSize);
+	OSCMessageView View(p->aData, p->nSize);
+
+	if ((Msg.GetResult() != OSC_OK) || (View.GetResult() != OSC_OK)) {
+		return false;
+	}
+
+	if ((strcmp(View.GetPath(), (const char *) p->aData) != 0) || (Msg.GetArgc() != View.GetArgc())) {
+		return false;
+	}
+
+	for (int i = 0; i < Msg.GetArgc(); i++) {
+		if (Msg.GetType((unsigned) i) != View.GetType((unsigned) i)) {
+			return false;
+		}
+	}
+
+	return read_message(Msg) == read_view(View);
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static volatile uint32_t s_nSink;
+
+int main(int argc, char **argv) {
+	bool bIsOk = true;
+
+	build();
+
+	for (unsigned i = 0; i < sizeof(s_Packets) / sizeof(s_Packets[0]); i++) {
+		TPacket *p = &s_Packets[i];
+		const bool bIsSame = compare(p);
+
+		double fStart = now();
+		for (uint32_t n = 0; n < MESSAGES; n++) {
+			OSCMessage Msg(p->aData, p->nSize);
+			s_nSink = read_message(Msg);
+		}
+		const double fMessage = now() - fStart;
+
+		fStart = now();
+		for (uint32_t n = 0; n < MESSAGES; n++) {
+			OSCMessageView View(p->aData, p->nSize);
+			s_nSink = read_view(View);
+		}
+		const double fView = now() - fStart;
+
+		printf("%-12s: OSCMessage %5.1fM msg/s, OSCMessageView %5.1fM msg/s, %4.1fx, %s\n", p->pName,
+				MESSAGES / fMessage / 1e6, MESSAGES / fView / 1e6, fMessage / fView, bIsSame ? "OK" : "WRONG");
+
+		bIsOk &= bIsSame;
+	}
+
+	// A message the view must reject as OSCMessage does
+	TPacket *p = &s_Packets[0];
+	p->aData[9] = 'x';	// Type tag without the ','
+
+	const bool bIsRejected = (OSCMessage(p->aData, p->nSize).GetResult() != OSC_OK) && (OSCMessageView(p->aData, p->nSize).GetResult() != OSC_OK);
+
+	printf("%-12s: %s\n", "Invalid tag", bIsRejected ? "OK" : "WRONG");
+
+	bIsOk &= bIsRejected;
+
+	return bIsOk ? 0 : 1;
+}
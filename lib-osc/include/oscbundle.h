@@ -0,0 +1,80 @@
+/**
+ * @file oscbundle.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OSCBUNDLE_H_
+#define OSCBUNDLE_H_
+
+#include <stdint.h>
+
+#include "osc.h"
+
+#define OSCBUNDLE_HEADER_SIZE		16	///< "#bundle\0" followed by the timetag
+#define OSCBUNDLE_MAX_DEPTH			4	///< Nested bundles deeper than this are rejected
+
+#define OSC_TIMETAG_IMMEDIATELY		((uint64_t) 1)
+
+/**
+ * A read-only view on a received OSC bundle.
+ * The element sizes are validated up front, the elements themselves
+ * (messages or nested bundles) are returned in place with \ref GetNext.
+ */
+class OSCBundle {
+public:
+	OSCBundle(const void *pData, unsigned nSize);
+
+	/**
+	 * @return OSC_OK, or one of the \ref _osc_message_deserialise errors
+	 */
+	int GetResult(void) const {
+		return m_nResult;
+	}
+
+	/**
+	 * The NTP timetag: seconds since 1900 in the upper 32 bits, fraction in the lower 32 bits
+	 */
+	uint64_t GetTimeTag(void) const {
+		return m_nTimeTag;
+	}
+
+	/**
+	 * @return false when there are no more elements
+	 */
+	bool GetNext(const uint8_t **ppElement, unsigned *pSize);
+
+	void Rewind(void) {
+		m_nOffset = OSCBUNDLE_HEADER_SIZE;
+	}
+
+	static bool IsBundle(const void *pData, unsigned nSize);
+
+private:
+	int m_nResult;
+	const uint8_t *m_pData;
+	unsigned m_nSize;
+	unsigned m_nOffset;
+	uint64_t m_nTimeTag;
+};
+
+#endif /* OSCBUNDLE_H_ */
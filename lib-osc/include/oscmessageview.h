@@ -0,0 +1,83 @@
+/**
+ * @file oscmessageview.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OSCMESSAGEVIEW_H_
+#define OSCMESSAGEVIEW_H_
+
+#include <stdint.h>
+
+#include "osc.h"
+#include "oscblob.h"
+#include "oscmessage.h"
+
+#define OSCMESSAGEVIEW_MAX_ARGS		16
+
+/**
+ * The arguments are read from the packet buffer, keep it while the view is used.
+ */
+class OSCMessageView {
+public:
+	OSCMessageView(void);
+	OSCMessageView(const void *pData, unsigned nSize);
+
+	/**
+	 * @return OSC_OK, or one of the \ref _osc_message_deserialise errors
+	 */
+	int Parse(const void *pData, unsigned nSize);
+
+	int GetResult(void) const {
+		return m_nResult;
+	}
+
+	const char *GetPath(void) const {
+		return m_pPath;
+	}
+
+	int GetArgc(void) const {
+		return m_nArgc;
+	}
+
+	osc_type GetType(unsigned nArg) const {
+		return (nArg < m_nArgc) ? (osc_type) m_pTypes[nArg] : OSC_UNKNOWN;
+	}
+
+	int32_t GetInt(unsigned nArg) const;
+	float GetFloat(unsigned nArg) const;
+	const char *GetString(unsigned nArg) const;
+	OSCBlob GetBlob(unsigned nArg) const;
+
+private:
+	static uint32_t ReadUint32(const uint8_t *p);
+	static int ArgSize(osc_type tType, const uint8_t *p, unsigned nSize);
+
+private:
+	int m_nResult;
+	const char *m_pPath;
+	const char *m_pTypes;	///< The type tags without the leading ','
+	unsigned m_nArgc;
+	const uint8_t *m_apArgv[OSCMESSAGEVIEW_MAX_ARGS];
+};
+
+#endif /* OSCMESSAGEVIEW_H_ */
@@ -0,0 +1,101 @@
+/**
+ * @file oscrouter.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OSCROUTER_H_
+#define OSCROUTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OSCROUTER_MAX_ROUTES		32
+#define OSCROUTER_TABLE_SIZE		64	///< Power of 2, at least twice \ref OSCROUTER_MAX_ROUTES
+#define OSCROUTER_MAX_INDEX_DIGITS	5
+
+#define OSCROUTER_NO_INDEX			(-1)
+
+/**
+ * @param pContext As given with \ref OSCRouter::Add
+ * @param pMessage The complete OSC message, starting with the path
+ * @param nIndex The numeric last path segment for routes ending with a '*' segment, otherwise \ref OSCROUTER_NO_INDEX
+ */
+typedef void (*OSCRouterHandlerPtr)(void *pContext, const uint8_t *pMessage, unsigned nSize, int nIndex);
+
+/**
+ * Dispatches OSC messages on their path.
+ * A route is either a literal path, or a path with '*' as its last segment,
+ * which matches a decimal number, such as "/dmx1/12". The routes are compiled
+ * into a hash table, so a lookup costs one pass over the path, whatever the
+ * number of routes.
+ */
+class OSCRouter {
+public:
+	OSCRouter(void);
+
+	void Clear(void);
+
+	/**
+	 * The path is not copied and must stay valid until the next \ref Clear.
+	 * @return false when there is no room left, or the path is not a valid route
+	 */
+	bool Add(const char *pPath, OSCRouterHandlerPtr pHandler, void *pContext);
+
+	/**
+	 * Builds the lookup table. Must be called after the last \ref Add.
+	 */
+	void Compile(void);
+
+	/**
+	 * @return false when no route matched
+	 */
+	bool Dispatch(const uint8_t *pMessage, unsigned nSize) const;
+
+	unsigned GetRoutes(void) const {
+		return m_nRoutes;
+	}
+
+private:
+	struct TOSCRoute {
+		const char *pPath;
+		uint32_t nHash;				///< Of the literal part
+		uint16_t nLength;			///< Of the literal part, without the '*' segment
+		bool bIndex;				///< A numeric last segment is expected
+		OSCRouterHandlerPtr pHandler;
+		void *pContext;
+	};
+
+	static uint32_t Hash(uint32_t nHash, char c) {
+		return (nHash ^ (uint8_t) c) * 16777619U;	// FNV-1a
+	}
+
+	int Find(const char *pPath, uint16_t nLength, uint32_t nHash, bool bIndex) const;
+
+private:
+	struct TOSCRoute m_aRoutes[OSCROUTER_MAX_ROUTES];
+	unsigned m_nRoutes;
+	uint8_t m_aTable[OSCROUTER_TABLE_SIZE];	///< Route number + 1, 0 is an empty slot
+	bool m_bCompiled;
+};
+
+#endif /* OSCROUTER_H_ */
@@ -0,0 +1,109 @@
+/**
+ * @file oscbundle.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#elif defined(__circle__)
+ #include "circle/util.h"
+#else
+ #include <string.h>
+#endif
+
+#include "oscbundle.h"
+#include "oscmessage.h"
+#include "osc.h"
+
+static const char BUNDLE_TAG[8] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0' };
+
+static uint32_t ReadUint32(const uint8_t *p) {
+	uint32_t n;
+	memcpy(&n, p, sizeof(uint32_t));
+	return __builtin_bswap32(n);
+}
+
+OSCBundle::OSCBundle(const void *pData, unsigned nSize) :
+	m_nResult(OSC_OK),
+	m_pData((const uint8_t *) pData),
+	m_nSize(nSize),
+	m_nOffset(OSCBUNDLE_HEADER_SIZE),
+	m_nTimeTag(0)
+{
+	assert(pData != 0);
+
+	if (!IsBundle(pData, nSize)) {
+		m_nResult = OSC_INVALID_PATH;
+		return;
+	}
+
+	m_nTimeTag = ((uint64_t) ReadUint32(&m_pData[8]) << 32) | ReadUint32(&m_pData[12]);
+
+	unsigned nOffset = OSCBUNDLE_HEADER_SIZE;
+
+	while (nOffset < nSize) {
+		if ((nSize - nOffset) < 4) {
+			m_nResult = OSC_INVALID_SIZE;
+			return;
+		}
+
+		const uint32_t nElementSize = ReadUint32(&m_pData[nOffset]);
+		nOffset += 4;
+
+		if ((nElementSize == 0) || ((nElementSize & 0x3) != 0) || (nElementSize > (nSize - nOffset))) {
+			m_nResult = OSC_INVALID_SIZE;
+			return;
+		}
+
+		nOffset += nElementSize;
+	}
+}
+
+bool OSCBundle::IsBundle(const void *pData, unsigned nSize) {
+	assert(pData != 0);
+
+	if ((nSize < OSCBUNDLE_HEADER_SIZE) || ((nSize & 0x3) != 0)) {
+		return false;
+	}
+
+	return memcmp(pData, BUNDLE_TAG, sizeof(BUNDLE_TAG)) == 0;
+}
+
+bool OSCBundle::GetNext(const uint8_t **ppElement, unsigned *pSize) {
+	assert(ppElement != 0);
+	assert(pSize != 0);
+
+	if ((m_nResult != OSC_OK) || (m_nOffset >= m_nSize)) {
+		return false;
+	}
+
+	*pSize = ReadUint32(&m_pData[m_nOffset]);
+	*ppElement = &m_pData[m_nOffset + 4];
+
+	m_nOffset += 4 + *pSize;
+
+	return true;
+}
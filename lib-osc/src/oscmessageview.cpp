@@ -0,0 +1,185 @@
+/**
+ * @file oscmessageview.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#elif defined(__circle__)
+ #include "circle/util.h"
+#else
+ #include <string.h>
+#endif
+
+#include "oscmessageview.h"
+#include "oscmessage.h"
+#include "oscstring.h"
+#include "oscblob.h"
+#include "osc.h"
+
+OSCMessageView::OSCMessageView(void) :
+	m_nResult(OSC_MESSAGE_NULL),
+	m_pPath(0),
+	m_pTypes(0),
+	m_nArgc(0)
+{
+}
+
+OSCMessageView::OSCMessageView(const void *pData, unsigned nSize) {
+	(void) Parse(pData, nSize);
+}
+
+uint32_t OSCMessageView::ReadUint32(const uint8_t *p) {
+	uint32_t n;
+	memcpy(&n, p, sizeof(uint32_t));
+	return __builtin_bswap32(n);
+}
+
+int OSCMessageView::ArgSize(osc_type tType, const uint8_t *p, unsigned nSize) {
+	switch (tType) {
+	case OSC_TRUE:
+	case OSC_FALSE:
+	case OSC_NIL:
+	case OSC_INFINITUM:
+		return 0;
+	case OSC_INT32:
+	case OSC_FLOAT:
+	case OSC_MIDI:
+	case OSC_CHAR:
+		return nSize >= 4 ? 4 : -OSC_INVALID_SIZE;
+	case OSC_INT64:
+	case OSC_TIMETAG:
+	case OSC_DOUBLE:
+		return nSize >= 8 ? 8 : -OSC_INVALID_SIZE;
+	case OSC_STRING:
+	case OSC_SYMBOL:
+		return (int) OSCString::Validate((void *) p, nSize);
+	case OSC_BLOB:
+		if (nSize < 4) {
+			return -OSC_INVALID_SIZE;
+		}
+		return (int) OSCBlob::Validate((void *) p, nSize);
+	default:
+		return -OSC_INVALID_TYPE;
+	}
+}
+
+int OSCMessageView::Parse(const void *pData, unsigned nSize) {
+	const uint8_t *p = (const uint8_t *) pData;
+	int nLength;
+
+	m_pPath = 0;
+	m_pTypes = 0;
+	m_nArgc = 0;
+
+	if ((pData == 0) || (nSize == 0)) {
+		return m_nResult = OSC_INVALID__INVALID_SIZE;
+	}
+
+	nLength = (int) OSCString::Validate((void *) p, nSize);
+
+	if (nLength < 0) {
+		return m_nResult = OSC_INVALID_PATH;
+	}
+
+	const char *pPath = (const char *) p;
+
+	p += nLength;
+	nSize -= nLength;
+
+	if (nSize == 0) {
+		return m_nResult = OSC_NO_TYPE_TAG;
+	}
+
+	nLength = (int) OSCString::Validate((void *) p, nSize);
+
+	if (nLength < 0) {
+		return m_nResult = OSC_INVALID_TYPE;
+	}
+
+	if (*p != ',') {
+		return m_nResult = OSC_INVALID_TYPE_TAG;
+	}
+
+	const char *pTypes = (const char *) p + 1;
+
+	p += nLength;
+	nSize -= nLength;
+
+	unsigned nArgc = 0;
+
+	for (; pTypes[nArgc] != '\0'; nArgc++) {
+		if (nArgc == OSCMESSAGEVIEW_MAX_ARGS) {
+			return m_nResult = OSC_INVALID_ARGUMENT;
+		}
+
+		nLength = ArgSize((osc_type) pTypes[nArgc], p, nSize);
+
+		if (nLength < 0) {
+			return m_nResult = OSC_INVALID_ARGUMENT;
+		}
+
+		m_apArgv[nArgc] = p;
+
+		p += nLength;
+		nSize -= nLength;
+	}
+
+	if (nSize != 0) {
+		return m_nResult = OSC_INVALID_SIZE;
+	}
+
+	m_pPath = pPath;
+	m_pTypes = pTypes;
+	m_nArgc = nArgc;
+
+	return m_nResult = OSC_OK;
+}
+
+int32_t OSCMessageView::GetInt(unsigned nArg) const {
+	assert(nArg < m_nArgc);
+	return (int32_t) ReadUint32(m_apArgv[nArg]);
+}
+
+float OSCMessageView::GetFloat(unsigned nArg) const {
+	assert(nArg < m_nArgc);
+
+	const uint32_t n = ReadUint32(m_apArgv[nArg]);
+	float f;
+	memcpy(&f, &n, sizeof(float));
+
+	return f;
+}
+
+const char *OSCMessageView::GetString(unsigned nArg) const {
+	assert(nArg < m_nArgc);
+	return (const char *) m_apArgv[nArg];
+}
+
+OSCBlob OSCMessageView::GetBlob(unsigned nArg) const {
+	assert(nArg < m_nArgc);
+	return OSCBlob((const char *) m_apArgv[nArg] + 4, (int) ReadUint32(m_apArgv[nArg]));
+}
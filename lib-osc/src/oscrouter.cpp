@@ -0,0 +1,196 @@
+/**
+ * @file oscrouter.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#elif defined(__circle__)
+ #include "circle/util.h"
+#else
+ #include <string.h>
+#endif
+
+#include "oscrouter.h"
+#include "oscstring.h"
+
+#define FNV_OFFSET_BASIS	2166136261U
+
+OSCRouter::OSCRouter(void) {
+	Clear();
+}
+
+void OSCRouter::Clear(void) {
+	m_nRoutes = 0;
+	m_bCompiled = false;
+	memset(m_aTable, 0, sizeof(m_aTable));
+}
+
+bool OSCRouter::Add(const char *pPath, OSCRouterHandlerPtr pHandler, void *pContext) {
+	assert(pPath != 0);
+	assert(pHandler != 0);
+
+	if ((m_nRoutes == OSCROUTER_MAX_ROUTES) || (*pPath != '/')) {
+		return false;
+	}
+
+	unsigned nLength = strlen(pPath);
+	bool bIndex = false;
+
+	if ((nLength >= 2) && (pPath[nLength - 2] == '/') && (pPath[nLength - 1] == '*')) {
+		nLength -= 2;
+		bIndex = true;
+	}
+
+	if ((nLength == 0) || (nLength > 0xFFFF)) {
+		return false;
+	}
+
+	uint32_t nHash = FNV_OFFSET_BASIS;
+
+	for (unsigned i = 0; i < nLength; i++) {
+		nHash = Hash(nHash, pPath[i]);
+	}
+
+	struct TOSCRoute *pRoute = &m_aRoutes[m_nRoutes++];
+
+	pRoute->pPath = pPath;
+	pRoute->nHash = nHash;
+	pRoute->nLength = (uint16_t) nLength;
+	pRoute->bIndex = bIndex;
+	pRoute->pHandler = pHandler;
+	pRoute->pContext = pContext;
+
+	m_bCompiled = false;
+
+	return true;
+}
+
+void OSCRouter::Compile(void) {
+	memset(m_aTable, 0, sizeof(m_aTable));
+
+	for (unsigned i = 0; i < m_nRoutes; i++) {
+		const struct TOSCRoute *pRoute = &m_aRoutes[i];
+
+		if (Find(pRoute->pPath, pRoute->nLength, pRoute->nHash, pRoute->bIndex) >= 0) {
+			continue;	// Duplicate, the first one wins
+		}
+
+		// Open addressing, an index route is stored at the slot next to its literal twin
+		unsigned nSlot = (pRoute->nHash + (pRoute->bIndex ? 1 : 0)) & (OSCROUTER_TABLE_SIZE - 1);
+
+		while (m_aTable[nSlot] != 0) {
+			nSlot = (nSlot + 1) & (OSCROUTER_TABLE_SIZE - 1);
+		}
+
+		m_aTable[nSlot] = (uint8_t) (i + 1);
+	}
+
+	m_bCompiled = true;
+}
+
+int OSCRouter::Find(const char *pPath, uint16_t nLength, uint32_t nHash, bool bIndex) const {
+	unsigned nSlot = (nHash + (bIndex ? 1 : 0)) & (OSCROUTER_TABLE_SIZE - 1);
+
+	while (m_aTable[nSlot] != 0) {
+		const unsigned nRoute = m_aTable[nSlot] - 1;
+		const struct TOSCRoute *pRoute = &m_aRoutes[nRoute];
+
+		if ((pRoute->nHash == nHash) && (pRoute->nLength == nLength) && (pRoute->bIndex == bIndex) && (memcmp(pRoute->pPath, pPath, nLength) == 0)) {
+			return (int) nRoute;
+		}
+
+		nSlot = (nSlot + 1) & (OSCROUTER_TABLE_SIZE - 1);
+	}
+
+	return -1;
+}
+
+bool OSCRouter::Dispatch(const uint8_t *pMessage, unsigned nSize) const {
+	assert(pMessage != 0);
+	assert(m_bCompiled);
+
+	if (OSCString::Validate((void *) pMessage, nSize) < 4) {
+		return false;
+	}
+
+	const char *pPath = (const char *) pMessage;
+
+	// One pass: the hash of the whole path, and of the path up to the last '/'
+	uint32_t nHash = FNV_OFFSET_BASIS;
+	uint32_t nHashPrefix = FNV_OFFSET_BASIS;
+	unsigned nLastSlash = 0;
+	unsigned nLength;
+
+	for (nLength = 0; pPath[nLength] != '\0'; nLength++) {
+		if (pPath[nLength] == '/') {
+			nLastSlash = nLength;
+			nHashPrefix = nHash;
+		}
+		nHash = Hash(nHash, pPath[nLength]);
+	}
+
+	if (nLength > 0xFFFF) {
+		return false;
+	}
+
+	int nRoute = Find(pPath, (uint16_t) nLength, nHash, false);
+
+	if (nRoute >= 0) {
+		const struct TOSCRoute *pRoute = &m_aRoutes[nRoute];
+		pRoute->pHandler(pRoute->pContext, pMessage, nSize, OSCROUTER_NO_INDEX);
+		return true;
+	}
+
+	const unsigned nDigits = nLength - nLastSlash - 1;
+
+	if ((nLastSlash == 0) || (nDigits == 0) || (nDigits > OSCROUTER_MAX_INDEX_DIGITS)) {
+		return false;
+	}
+
+	int nIndex = 0;
+
+	for (unsigned i = nLastSlash + 1; i < nLength; i++) {
+		const char c = pPath[i];
+
+		if ((c < '0') || (c > '9')) {
+			return false;
+		}
+
+		nIndex = nIndex * 10 + (c - '0');
+	}
+
+	nRoute = Find(pPath, (uint16_t) nLastSlash, nHashPrefix, true);
+
+	if (nRoute >= 0) {
+		const struct TOSCRoute *pRoute = &m_aRoutes[nRoute];
+		pRoute->pHandler(pRoute->pContext, pMessage, nSize, nIndex);
+		return true;
+	}
+
+	return false;
+}
@@ -29,12 +29,22 @@
 #include <stdint.h>
 
 #include "lightset.h"
+#include "oscrouter.h"
 
 #define OSCSERVER_DEFAULT_PORT_INCOMING	8000
 #define OSCSERVER_DEFAULT_PORT_OUTGOING	9000
 
 #define OSCSERVER_PATH_LENGTH_MAX	128
 
+#define OSCSERVER_SCHEDULE_ENTRIES	8	///< Bundles with a future timetag waiting to be applied
+
+struct TOscServerSchedule {
+	uint64_t nTimeTag;		///< NTP timetag at which the updates are applied
+	uint16_t nLastChannel;	///< Highest channel updated
+	uint32_t aMask[512 / 32];	///< A bit for each channel updated
+	uint8_t aData[512];
+};
+
 class OscServer {
 public:
 	OscServer(void);
@@ -56,14 +66,33 @@ public:
 
 	void Print(void);
 
+	/**
+	 * Adds a route next to the built-in ones (/ping and the DMX path), see \ref OSCRouter::Add.
+	 * On a duplicate path the route added first is used, so a built-in route is replaced by adding it before \ref Start.
+	 */
+	bool AddRoute(const char *pPath, OSCRouterHandlerPtr pHandler, void *pContext);
+
 	void Start(void);
 	void Stop(void);
 
 	int Run(void);
 
 private:
-	int GetChannel(const char *p);
 	bool IsDmxDataChanged(const uint8_t *pData, uint16_t nStartChannel, uint16_t nLength);
+	void Store(uint16_t nStartChannel, const uint8_t *pData, uint16_t nLength, struct TOscServerSchedule *pEntry);
+	void Flush(void);
+	void HandlePath(const uint8_t *pMessage, unsigned nSize);
+	void HandleChannel(const uint8_t *pMessage, unsigned nSize, int nChannel);
+	int HandleBundle(const uint8_t *pBundle, unsigned nSize, uint64_t nParentTimeTag, unsigned nDepth);
+	struct TOscServerSchedule *Schedule(uint64_t nTimeTag);
+	void RunSchedule(void);
+	void Checkpoint(void);
+	void Rollback(void);
+	uint64_t GetTimeTag(void);
+
+	static void staticPing(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+	static void staticPath(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+	static void staticChannel(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
 
 private:
 	uint16_t m_nPortIncoming;
@@ -76,6 +105,21 @@ private:
 	uint8_t *m_pBuffer;
 	uint8_t *m_pData;
 	uint8_t *m_pOsc;
+	bool m_bDataChanged;
+	struct TOscServerSchedule *m_pSchedule;	///< Sorted on timetag, the first entry is due first
+	unsigned m_nScheduled;
+	uint64_t m_nTimeTagNow;
+	uint64_t m_nStartSeconds;
+	uint32_t m_nLastMicros;
+	uint64_t m_nElapsedMicros;
+	uint32_t m_nRemoteIp;
+	struct TOscServerSchedule *m_pEntry;	///< Where the handlers store the updates, 0 is immediately
+	uint8_t *m_pDataSaved;					///< Checkpoint taken before a bundle is handled
+	uint16_t m_nLastChannelSaved;
+	struct TOscServerSchedule *m_pScheduleSaved;
+	unsigned m_nScheduledSaved;
+	OSCRouter m_Router;
+	bool m_bBuiltinRoutes;	///< Added on the first Start
 };
 
 #endif /* OSCSERVER_H_ */
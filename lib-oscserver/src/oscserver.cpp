@@ -27,6 +27,19 @@
 #include <stdio.h>
 #include <assert.h>
 
+#if defined(__circle__)
+ #include <circle/timer.h>
+ #define OSCSERVER_MICROS()		CTimer::GetClockTicks()
+ #define OSCSERVER_SECONDS()	CTimer::Get()->GetTime()
+#elif defined(BARE_METAL)
+ #include <time.h>
+ #include "bcm2835.h"
+ #define OSCSERVER_MICROS()		BCM2835_ST->CLO
+ #define OSCSERVER_SECONDS()	time(0)
+#else
+ #include <sys/time.h>
+#endif
+
 #if defined (BARE_METAL)
  #include "util.h"
 #elif defined(__circle__)
@@ -37,11 +50,13 @@
 
 #include "oscserver.h"
 #include "osc.h"
-#include "oscmessage.h"
+#include "oscmessageview.h"
+#include "oscbundle.h"
 #include "oscsend.h"
 #include "oscblob.h"
 
 #include "lightset.h"
+#include "dmxbuffer.h"
 #include "network.h"
 
 #include "debug.h"
@@ -51,6 +66,9 @@
 #define OSCSERVER_DEFAULT_PATH_PRIMARY		"/dmx1"
 #define OSCSERVER_DEFAULT_PATH_SECONDARY	OSCSERVER_DEFAULT_PATH_PRIMARY"/*"
 
+#define OSC_TIMETAG_UNIX_OFFSET		2208988800ULL	///< Seconds from 1900 to 1970
+#define OSCSERVER_SCHEDULE_HORIZON	((uint64_t) 60 << 32)	///< 60 seconds
+
 enum {
 	DMX_UNIVERSE = 512,
 	DMX_MAX_VALUE = 255
@@ -61,7 +79,18 @@ OscServer::OscServer(void):
 	m_nPortOutgoing(OSCSERVER_DEFAULT_PORT_OUTGOING),
 	m_bPartialTransmission(false),
 	m_nLastChannel(0),
-	m_pLightSet(0)
+	m_pLightSet(0),
+	m_bDataChanged(false),
+	m_nScheduled(0),
+	m_nTimeTagNow(0),
+	m_nStartSeconds(0),
+	m_nLastMicros(0),
+	m_nElapsedMicros(0),
+	m_nRemoteIp(0),
+	m_pEntry(0),
+	m_nLastChannelSaved(0),
+	m_nScheduledSaved(0),
+	m_bBuiltinRoutes(false)
 {
 	memset(m_aPath, 0, sizeof(m_aPath));
 	strcpy(m_aPath, OSCSERVER_DEFAULT_PATH_PRIMARY);
@@ -81,6 +110,15 @@ OscServer::OscServer(void):
 
 	m_pOsc  = new uint8_t[DMX_UNIVERSE];
 	assert(m_pOsc != 0);
+
+	m_pSchedule = new struct TOscServerSchedule[OSCSERVER_SCHEDULE_ENTRIES];
+	assert(m_pSchedule != 0);
+
+	m_pDataSaved = new uint8_t[DMX_UNIVERSE];
+	assert(m_pDataSaved != 0);
+
+	m_pScheduleSaved = new struct TOscServerSchedule[OSCSERVER_SCHEDULE_ENTRIES];
+	assert(m_pScheduleSaved != 0);
 }
 
 OscServer::~OscServer(void) {
@@ -93,13 +131,49 @@ OscServer::~OscServer(void) {
 	delete[] m_pOsc;
 	m_pOsc = 0;
 
+	delete[] m_pSchedule;
+	m_pSchedule = 0;
+
+	delete[] m_pDataSaved;
+	m_pDataSaved = 0;
+
+	delete[] m_pScheduleSaved;
+	m_pScheduleSaved = 0;
+
 	if (m_pLightSet != 0) {
 		m_pLightSet->Stop();
 		m_pLightSet = 0;
 	}
 }
 
+bool OscServer::AddRoute(const char *pPath, OSCRouterHandlerPtr pHandler, void *pContext) {
+	if (!m_Router.Add(pPath, pHandler, pContext)) {
+		return false;
+	}
+
+	m_Router.Compile();
+
+	return true;
+}
+
 void OscServer::Start(void) {
+	// The routes given with AddRoute are kept
+	if (!m_bBuiltinRoutes) {
+		m_bBuiltinRoutes = true;
+
+		(void) m_Router.Add("/ping", OscServer::staticPing, this);
+		(void) m_Router.Add(m_aPath, OscServer::staticPath, this);
+		(void) m_Router.Add(m_aPathSecond, OscServer::staticChannel, this);
+	}
+
+	m_Router.Compile();
+
+#if defined(__circle__) || defined(BARE_METAL)
+	m_nStartSeconds = (uint64_t) OSCSERVER_SECONDS() + OSC_TIMETAG_UNIX_OFFSET;
+	m_nLastMicros = OSCSERVER_MICROS();
+	m_nElapsedMicros = 0;
+#endif
+
 	Network::Get()->Begin(m_nPortIncoming);
 
 	OSCSend MsgSend(Network::Get()->GetIp() | ~(Network::Get()->GetNetmask()), m_nPortIncoming, "/ping", 0);
@@ -171,165 +245,318 @@ void OscServer::SetPartialTransmission(bool bPartialTransmission) {
 	m_bPartialTransmission = bPartialTransmission;
 }
 
-int OscServer::GetChannel(const char* p) {
+bool OscServer::IsDmxDataChanged(const uint8_t* pData, uint16_t nStartChannel, uint16_t nLength) {
+	assert(nLength <= DMX_UNIVERSE);
+	assert(nStartChannel >= 1);
+	assert((nStartChannel - 1 + nLength) <= DMX_UNIVERSE);
+
+	return DmxBuffer::CompareCopy(&m_pData[nStartChannel - 1], pData, nLength);
+}
+
+void OscServer::Store(uint16_t nStartChannel, const uint8_t *pData, uint16_t nLength, struct TOscServerSchedule *pEntry) {
+	assert(nStartChannel >= 1);
+	assert((nStartChannel - 1 + nLength) <= DMX_UNIVERSE);
+
+	const uint16_t nLastChannel = nStartChannel - 1 + nLength;
+
+	if (pEntry == 0) {
+		if (IsDmxDataChanged(pData, nStartChannel, nLength)) {
+			m_bDataChanged = true;
+			m_nLastChannel = nLastChannel > m_nLastChannel ? nLastChannel : m_nLastChannel;
+		}
+		return;
+	}
+
+	memcpy(&pEntry->aData[nStartChannel - 1], pData, nLength);
+
+	for (unsigned i = nStartChannel - 1; i < nLastChannel; i++) {
+		pEntry->aMask[i / 32] |= (1U << (i & 31));
+	}
+
+	pEntry->nLastChannel = nLastChannel > pEntry->nLastChannel ? nLastChannel : pEntry->nLastChannel;
+}
+
+void OscServer::Flush(void) {
+	if (!m_bDataChanged) {
+		return;
+	}
+
+	m_bDataChanged = false;
+
+	if (!m_bPartialTransmission) {
+		m_pLightSet->SetData(0, m_pData, DMX_UNIVERSE);
+	} else {
+		m_pLightSet->SetData(0, m_pData, m_nLastChannel);
+	}
+}
+
+void OscServer::staticPing(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
 	assert(p != 0);
 
-	char *s = (char *)p + strlen(m_aPath) + 1;
-	int nChannel = 0;
-	int i;
+	DEBUG_PUTS("ping received");
+	OSCSend MsgSend(((OscServer *) p)->m_nRemoteIp, ((OscServer *) p)->m_nPortOutgoing, "/pong", 0);
+}
 
-	for (i = 0; (i < 3) && (*s != '\0'); i++) {
-		int c = *s;
+void OscServer::staticPath(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
 
-		if ((c < (int) '0') || (c > (int) '9')) {
-			return -1;
+	((OscServer *) p)->HandlePath(pMessage, nSize);
+}
+
+void OscServer::staticChannel(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
+
+	((OscServer *) p)->HandleChannel(pMessage, nSize, nIndex);
+}
+
+void OscServer::HandlePath(const uint8_t *pMessage, unsigned nSize) {
+	OSCMessageView Msg(pMessage, nSize);
+
+	DEBUG_PRINTF("[%d] path : %s", nSize, (const char *) pMessage);
+
+	if (Msg.GetResult() != OSC_OK) {
+		return;
+	}
+
+	const int nArgc = Msg.GetArgc();
+
+	if ((nArgc == 1) && (Msg.GetType(0) == OSC_BLOB)) {
+		DEBUG_PUTS("Blob received");
+
+		OSCBlob blob = Msg.GetBlob(0);
+		const int size = (int) blob.GetDataSize();
+
+		if ((size == 0) || (size > DMX_UNIVERSE)) {
+			DEBUG_PUTS("Too many channels");
+			return;
 		}
 
-		nChannel = nChannel * 10 + c - (int) '0';
-		s++;
+		Store(1, (const uint8_t *) blob.GetDataPtr(), (uint16_t) size, m_pEntry);
+	} else if ((nArgc == 2) && (Msg.GetType(0) == OSC_INT32)) {
+		const int nChannel = 1 + Msg.GetInt(0);
+
+		if ((nChannel < 1) || (nChannel > DMX_UNIVERSE)) {
+			DEBUG_PRINTF("Invalid channel [%d]", nChannel);
+			return;
+		}
+
+		uint8_t nData;
+
+		if (Msg.GetType(1) == OSC_INT32) {
+			DEBUG_PUTS("ii received");
+			nData = (uint8_t) Msg.GetInt(1);
+		} else if (Msg.GetType(1) == OSC_FLOAT) {
+			DEBUG_PUTS("if received");
+			nData = (uint8_t) (Msg.GetFloat(1) * DMX_MAX_VALUE);
+		} else {
+			return;
+		}
+
+		DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
+
+		Store((uint16_t) nChannel, &nData, 1, m_pEntry);
+	}
+}
+
+void OscServer::HandleChannel(const uint8_t *pMessage, unsigned nSize, int nChannel) {
+	// /path/N 'i' or 'f'
+	if ((nChannel < 1) || (nChannel > DMX_UNIVERSE)) {
+		DEBUG_PRINTF("Invalid channel [%d]", nChannel);
+		return;
 	}
 
-	if (nChannel > DMX_UNIVERSE) {
+	OSCMessageView Msg(pMessage, nSize);
+
+	if ((Msg.GetResult() != OSC_OK) || (Msg.GetArgc() != 1)) {
+		return;
+	}
+
+	uint8_t nData;
+
+	if (Msg.GetType(0) == OSC_INT32) {
+		DEBUG_PUTS("i received");
+		nData = (uint8_t) Msg.GetInt(0);
+	} else if (Msg.GetType(0) == OSC_FLOAT) {
+		DEBUG_PUTS("f received");
+		nData = (uint8_t) (Msg.GetFloat(0) * DMX_MAX_VALUE);
+	} else {
+		return;
+	}
+
+	DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
+
+	Store((uint16_t) nChannel, &nData, 1, m_pEntry);
+}
+
+int OscServer::HandleBundle(const uint8_t *pBundle, unsigned nSize, uint64_t nParentTimeTag, unsigned nDepth) {
+	OSCBundle Bundle(pBundle, nSize);
+
+	if (Bundle.GetResult() != OSC_OK) {
+		DEBUG_PUTS("Invalid bundle");
 		return -1;
 	}
 
-	return nChannel;
+	// A nested bundle is never applied before its enclosing bundle
+	uint64_t nTimeTag = Bundle.GetTimeTag();
+
+	if (nTimeTag < nParentTimeTag) {
+		nTimeTag = nParentTimeTag;
+	}
+
+	// Timetags too far ahead most likely come from an unsynchronised clock
+	const bool bSchedule = (nTimeTag > m_nTimeTagNow) && ((nTimeTag - m_nTimeTagNow) <= OSCSERVER_SCHEDULE_HORIZON);
+
+	DEBUG_PRINTF("Bundle %d : %s", nDepth, bSchedule ? "scheduled" : "immediately");
+
+	const uint8_t *pElement;
+	unsigned nElementSize;
+
+	while (Bundle.GetNext(&pElement, &nElementSize)) {
+		if (OSCBundle::IsBundle(pElement, nElementSize)) {
+			if ((nDepth + 1) >= OSCBUNDLE_MAX_DEPTH) {
+				DEBUG_PUTS("Bundles nested too deep");
+				return -1;
+			}
+
+			if (HandleBundle(pElement, nElementSize, nTimeTag, nDepth + 1) < 0) {
+				return -1;
+			}
+		} else if (OSC::GetPath((void *) pElement, nElementSize) != 0) {
+			// Looked up for each message; a nested bundle may have moved the entries
+			m_pEntry = bSchedule ? Schedule(nTimeTag) : 0;
+			(void) m_Router.Dispatch(pElement, nElementSize);
+			m_pEntry = 0;
+		}
+	}
+
+	return 0;
 }
 
-bool OscServer::IsDmxDataChanged(const uint8_t* pData, uint16_t nStartChannel, uint16_t nLength) {
-	assert(nLength <= DMX_UNIVERSE);
+struct TOscServerSchedule *OscServer::Schedule(uint64_t nTimeTag) {
+	unsigned nIndex;
+
+	for (nIndex = 0; nIndex < m_nScheduled; nIndex++) {
+		if (m_pSchedule[nIndex].nTimeTag == nTimeTag) {
+			return &m_pSchedule[nIndex];
+		}
+
+		if (m_pSchedule[nIndex].nTimeTag > nTimeTag) {
+			break;
+		}
+	}
+
+	if (m_nScheduled == OSCSERVER_SCHEDULE_ENTRIES) {
+		DEBUG_PUTS("Schedule is full");
+		return 0;	// Applied immediately instead
+	}
 
-	bool isChanged = false;
+	memmove(&m_pSchedule[nIndex + 1], &m_pSchedule[nIndex], (m_nScheduled - nIndex) * sizeof(struct TOscServerSchedule));
+	m_nScheduled++;
 
-	const uint8_t *src = pData;
-	uint8_t *dst = (uint8_t *)&m_pData[--nStartChannel];
+	struct TOscServerSchedule *pEntry = &m_pSchedule[nIndex];
 
-	uint16_t nEnd = nStartChannel + nLength;
+	pEntry->nTimeTag = nTimeTag;
+	pEntry->nLastChannel = 0;
+	memset(pEntry->aMask, 0, sizeof(pEntry->aMask));
 
-	assert(nEnd <= DMX_UNIVERSE);
+	return pEntry;
+}
+
+void OscServer::RunSchedule(void) {
+	unsigned nDue = 0;
+
+	while ((nDue < m_nScheduled) && (m_pSchedule[nDue].nTimeTag <= m_nTimeTagNow)) {
+		const struct TOscServerSchedule *pEntry = &m_pSchedule[nDue];
 
-	for (unsigned i = nStartChannel; i < nEnd; i++) {
-		if (*dst != *src) {
-			*dst = *src;
-			isChanged = true;
+		for (unsigned i = 0; i < pEntry->nLastChannel; i++) {
+			if ((pEntry->aMask[i / 32] & (1U << (i & 31))) != 0) {
+				Store((uint16_t) (i + 1), &pEntry->aData[i], 1, 0);
+			}
 		}
-		dst++;
-		src++;
+
+		nDue++;
 	}
 
-	return isChanged;
+	if (nDue != 0) {
+		m_nScheduled -= nDue;
+		memmove(&m_pSchedule[0], &m_pSchedule[nDue], m_nScheduled * sizeof(struct TOscServerSchedule));
+		Flush();
+	}
+}
+
+/*
+ * A bundle is applied as a whole or not at all. The updates of its messages are staged
+ * in m_pData and the schedule, so these are saved before the bundle is handled.
+ */
+void OscServer::Checkpoint(void) {
+	memcpy(m_pDataSaved, m_pData, DMX_UNIVERSE);
+	m_nLastChannelSaved = m_nLastChannel;
+
+	memcpy(m_pScheduleSaved, m_pSchedule, m_nScheduled * sizeof(struct TOscServerSchedule));
+	m_nScheduledSaved = m_nScheduled;
+}
+
+void OscServer::Rollback(void) {
+	memcpy(m_pData, m_pDataSaved, DMX_UNIVERSE);
+	m_nLastChannel = m_nLastChannelSaved;
+	m_bDataChanged = false;
+
+	memcpy(m_pSchedule, m_pScheduleSaved, m_nScheduledSaved * sizeof(struct TOscServerSchedule));
+	m_nScheduled = m_nScheduledSaved;
+}
+
+uint64_t OscServer::GetTimeTag(void) {
+#if defined(__circle__) || defined(BARE_METAL)
+	const uint32_t nMicros = OSCSERVER_MICROS();
+
+	m_nElapsedMicros += (uint32_t) (nMicros - m_nLastMicros);
+	m_nLastMicros = nMicros;
+
+	const uint64_t nSeconds = m_nStartSeconds + (m_nElapsedMicros / 1000000);
+	const uint64_t nFraction = ((m_nElapsedMicros % 1000000) << 32) / 1000000;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+
+	const uint64_t nSeconds = (uint64_t) tv.tv_sec + OSC_TIMETAG_UNIX_OFFSET;
+	const uint64_t nFraction = ((uint64_t) tv.tv_usec << 32) / 1000000;
+#endif
+
+	return (nSeconds << 32) | nFraction;
 }
 
 int OscServer::Run(void) {
-	uint32_t nRemoteIp;
 	uint16_t nRemotePort;
 
-	const int nBytesReceived = Network::Get()->RecvFrom(m_pBuffer, OSCSERVER_MAX_BUFFER, &nRemoteIp, &nRemotePort);
+	m_nTimeTagNow = GetTimeTag();
+
+	if (m_nScheduled != 0) {
+		RunSchedule();
+	}
+
+	const int nBytesReceived = Network::Get()->RecvFrom(m_pBuffer, OSCSERVER_MAX_BUFFER, &m_nRemoteIp, &nRemotePort);
 
 	if (nBytesReceived == 0) {
 		return 0;
 	}
 
-	if (OSC::isMatch((const char*) m_pBuffer, "/ping")) {
-		DEBUG_PUTS("ping received");
-		OSCSend MsgSend(nRemoteIp, m_nPortOutgoing, "/pong", 0);
-	} else {
-		OSCMessage Msg((char *) m_pBuffer, nBytesReceived);
-
-		DEBUG_PRINTF("[%d] path : %s", nBytesReceived, OSC::GetPath((char*) m_pBuffer, nBytesReceived));
-
-		if (OSC::isMatch((const char*) m_pBuffer, m_aPath)) {
-			const int nArgc = Msg.GetArgc();
-
-			if ((nArgc == 1) && (Msg.GetType(0) == OSC_BLOB)) {
-				DEBUG_PUTS("Blob received");
-
-				OSCBlob blob = Msg.GetBlob(0);
-				const int size = (int) blob.GetDataSize();
-
-				if (size <= DMX_UNIVERSE) {
-					const uint8_t *ptr = (const uint8_t *) blob.GetDataPtr();
-					if (IsDmxDataChanged(ptr, 1, size)) {
-						if ((!m_bPartialTransmission) || (size == DMX_UNIVERSE)) {
-							m_pLightSet->SetData(0, m_pData, DMX_UNIVERSE);
-						} else {
-							m_nLastChannel = size > m_nLastChannel ? size : m_nLastChannel;
-							m_pLightSet->SetData(0, m_pData, m_nLastChannel);
-						}
-					}
-				} else {
-					DEBUG_PUTS("Too many channels");
-					return -1;
-				}
-			} else if ((nArgc == 2) && (Msg.GetType(0) == OSC_INT32)) {
-				uint16_t nChannel = (uint16_t) (1 + Msg.GetInt(0));
-
-				if ((nChannel < 1) || (nChannel > DMX_UNIVERSE)) {
-					DEBUG_PRINTF("Invalid channel [%d]", nChannel);
-					return -1;
-				}
-
-				uint8_t nData;
-
-				if (Msg.GetType(1) == OSC_INT32) {
-					DEBUG_PUTS("ii received");
-					nData = (uint8_t) Msg.GetInt(1);
-				} else if (Msg.GetType(1) == OSC_FLOAT) {
-					DEBUG_PUTS("if received");
-					nData = (uint8_t) (Msg.GetFloat(1) * DMX_MAX_VALUE);
-				} else {
-					return -1;
-				}
-
-				DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
-
-				if (IsDmxDataChanged(&nData, nChannel, 1)) {
-					if (!m_bPartialTransmission) {
-						m_pLightSet->SetData(0, m_pData, DMX_UNIVERSE);
-					} else {
-						m_nLastChannel = nChannel > m_nLastChannel ? nChannel : m_nLastChannel;
-						m_pLightSet->SetData(0, m_pData, m_nLastChannel);
-					}
-				}
-			}
-		} else if (OSC::isMatch((const char*) m_pBuffer, m_aPathSecond)) {
-			const int nArgc = Msg.GetArgc();
-
-			if (nArgc == 1) { // /path/N 'i' or 'f'
-				const uint16_t nChannel = GetChannel((const char*) m_pBuffer);
-
-				if (nChannel >= 1 && nChannel <= DMX_UNIVERSE) {
-					uint8_t nData;
-
-					if (Msg.GetType(0) == OSC_INT32) {
-						DEBUG_PUTS("i received");
-						nData = (uint8_t) Msg.GetInt(0);
-					} else if (Msg.GetType(0) == OSC_FLOAT) {
-						DEBUG_PUTS("f received");
-						nData = (uint8_t) (Msg.GetFloat(0) * DMX_MAX_VALUE);
-					} else {
-						return -1;
-					}
-
-					DEBUG_PRINTF("Channel = %d, Data = %.2x", nChannel, nData);
-
-					if (IsDmxDataChanged(&nData, nChannel, 1)) {
-						if (!m_bPartialTransmission) {
-							m_pLightSet->SetData(0, m_pData, DMX_UNIVERSE);
-						} else {
-							m_nLastChannel = nChannel > m_nLastChannel ? nChannel : m_nLastChannel;
-							m_pLightSet->SetData(0, m_pData, m_nLastChannel);
-						}
-					}
-				} else {
-					return -1;
-				}
-			} else {
-				return -1;
-			}
+	if (OSCBundle::IsBundle(m_pBuffer, nBytesReceived)) {
+		Checkpoint();
+
+		if (HandleBundle(m_pBuffer, nBytesReceived, OSC_TIMETAG_IMMEDIATELY, 0) < 0) {
+			// A malformed nested bundle fails the whole packet, so nothing it staged is sent
+			Rollback();
+			return -1;
 		}
+
+		// All the updates of a bundle (and its nested bundles) go out with a single SetData
+		Flush();
+		return nBytesReceived;
+	}
+
+	if (m_Router.Dispatch(m_pBuffer, nBytesReceived)) {
+		Flush();
 	}
 
 	return nBytesReceived;
 }
-
@@ -0,0 +1,148 @@
+/**
+ * @file frame_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "pca9685.h"
+
+#include "pca9685_i2c_mock.h"
+
+/*
+ * No hardware needed: built with -DPCA9685_I2C_MOCK, the PCA9685 is a register model on the lib-i2c mock backend.
+ * Checks the number of I2C transactions WriteFrame needs for a pattern of changed channels,
+ * and that the registers have the frame afterwards.
+ */
+
+struct TCase {
+	const char *pName;
+	uint16_t nChanged;			///< Bit n, channel n is changed
+	uint32_t nTransactions;		///< Expected from WriteFrame
+};
+
+static const struct TCase s_Cases[] = {
+		{ "Nothing changed", 0x0000, 0 },
+		{ "One channel", 0x0010, 1 },
+		{ "All channels", 0xFFFF, 1 },
+		{ "Channels 0 and 15", 0x8001, 2 },
+		{ "Gap of 1 channel", 0x0005, 1 },		// PCA9685_FRAME_GAP_MAX
+		{ "Gap of 2 channels", 0x0009, 2 },
+		{ "Every other channel", 0x5555, 1 },
+		{ "Every third channel", 0x9249, 6 },
+		{ "RGB fixtures 0-2, 6-8", 0x01C7, 2 },
+};
+
+static uint16_t s_aOn[PCA9685_PWM_CHANNELS];
+static uint16_t s_aOff[PCA9685_PWM_CHANNELS];
+
+static uint32_t get_writes(void) {
+	return pca9685_i2c_mock_get_statistics()->writes;
+}
+
+static bool is_frame_in_registers(void) {
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		uint16_t nOn, nOff;
+
+		pca9685_i2c_mock_get_channel(PCA9685_I2C_ADDRESS_DEFAULT, i, &nOn, &nOff);
+
+		if ((nOn != s_aOn[i]) || (nOff != s_aOff[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char **argv) {
+	pca9685_i2c_mock_reset();
+
+	PCA9685 pca9685;
+	bool bIsOk = true;
+
+	// The frame starts as what is in the registers after the set up
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		pca9685.Read(i, &s_aOn[i], &s_aOff[i]);
+	}
+
+	for (uint32_t nCase = 0; nCase < sizeof(s_Cases) / sizeof(s_Cases[0]); nCase++) {
+		const struct TCase *pCase = &s_Cases[nCase];
+
+		for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+			if ((pCase->nChanged & (1 << i)) != 0) {
+				s_aOff[i] = (uint16_t) ((s_aOff[i] + 1 + 7 * nCase) % PCA9685_VALUE_MAX);
+			}
+			pca9685.SetFrame(i, s_aOn[i], s_aOff[i]);
+		}
+
+		const struct _pca9685_i2c_mock_statistics *pStatistics = pca9685_i2c_mock_get_statistics();
+		const uint32_t nWrites = pStatistics->writes;
+		const uint32_t nBytes = pStatistics->bytes;
+		const uint64_t nBusTime = pStatistics->bus_time;
+
+		pca9685.WriteFrame();
+
+		const uint32_t nTransactions = get_writes() - nWrites;
+		const bool bIsCaseOk = (nTransactions == pCase->nTransactions) && is_frame_in_registers();
+
+		printf("%-22s: %2u transactions, %3u bytes, %4u us, %s\n", pCase->pName, nTransactions,
+				pca9685_i2c_mock_get_statistics()->bytes - nBytes, (uint32_t) ((pca9685_i2c_mock_get_statistics()->bus_time - nBusTime) / 1000),
+				bIsCaseOk ? "OK" : "WRONG");
+
+		bIsOk &= bIsCaseOk;
+	}
+
+	// The same frame again, nothing goes out
+	uint32_t nWrites = get_writes();
+
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		pca9685.SetFrame(i, s_aOn[i], s_aOff[i]);
+	}
+
+	pca9685.WriteFrame();
+
+	const bool bIsRepeatOk = (get_writes() == nWrites);
+
+	printf("%-22s: %2u transactions, %s\n", "Same frame again", get_writes() - nWrites, bIsRepeatOk ? "OK" : "WRONG");
+
+	bIsOk &= bIsRepeatOk;
+
+	// A channel at a time, as before SetFrame
+	const struct _pca9685_i2c_mock_statistics *pStatistics = pca9685_i2c_mock_get_statistics();
+	const uint32_t nBytes = pStatistics->bytes;
+	const uint64_t nBusTime = pStatistics->bus_time;
+
+	nWrites = pStatistics->writes;
+
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		pca9685.Write(i, s_aOn[i], (uint16_t) (s_aOff[i] ^ 1));
+	}
+
+	printf("%-22s: %2u transactions, %3u bytes, %4u us, Write per channel\n", "All channels", get_writes() - nWrites,
+			pca9685_i2c_mock_get_statistics()->bytes - nBytes, (uint32_t) ((pca9685_i2c_mock_get_statistics()->bus_time - nBusTime) / 1000));
+
+	printf("%s\n", bIsOk ? "OK" : "FAILED");
+
+	return bIsOk ? 0 : 1;
+}
@@ -41,6 +41,11 @@
 
 #define PCA9685_PWM_CHANNELS	16
 
+#define PCA9685_FULL_ON_OFF	VALUE(0x1000)
+
+// Unchanged channels in between which are sent anyway, so that two runs become one transaction
+#define PCA9685_FRAME_GAP_MAX	1
+
 enum TPCA9685FrequencyRange {
 	PCA9685_FREQUENCY_MIN = 24,
 	PCA9685_FREQUENCY_MAX = 1526
@@ -83,6 +88,9 @@ public:
 	void SetFullOn(uint8_t, bool);
 	void SetFullOff(uint8_t, bool);
 
+	void SetFrame(uint8_t, uint16_t, uint16_t);
+	void WriteFrame(void);
+
 	void Dump(void);
 
 private:
@@ -104,8 +112,13 @@ private:
 
 	void I2cWriteReg(uint8_t, uint16_t, uint16_t);
 
+	void I2cWrite(const uint8_t *, uint32_t);
+
 private:
 	uint8_t m_nAddress;
+	uint16_t m_nFrameChanged;
+	uint16_t m_aFrameOn[PCA9685_PWM_CHANNELS];
+	uint16_t m_aFrameOff[PCA9685_PWM_CHANNELS];
 };
 
 #endif /* PCA9685_H_ */
@@ -0,0 +1,61 @@
+/**
+ * @file pca9685_i2c_mock.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PCA9685_I2C_MOCK_H_
+#define PCA9685_I2C_MOCK_H_
+
+#include <stdint.h>
+
+#define PCA9685_I2C_MOCK_ADDRESSES	128
+#define PCA9685_I2C_MOCK_REGISTERS	256
+
+/*
+ * Build with -DPCA9685_I2C_MOCK. A register model of PCA9685 devices is then attached to the
+ * lib-i2c mock backend, at every slave address. There is no hardware needed.
+ * Call pca9685_i2c_mock_reset before the first PCA9685 is constructed, it installs the mock backend.
+ */
+
+struct _pca9685_i2c_mock_statistics {
+	uint32_t writes;			// Transactions
+	uint32_t reads;				// Transactions
+	uint32_t bytes;				// Including the address byte
+	uint64_t bus_time;			// ns, at the clock divider set
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void pca9685_i2c_mock_reset(void);
+extern const struct _pca9685_i2c_mock_statistics *pca9685_i2c_mock_get_statistics(void);
+
+extern uint8_t pca9685_i2c_mock_get_register(uint8_t, uint8_t);
+extern void pca9685_i2c_mock_get_channel(uint8_t, uint8_t, uint16_t *, uint16_t *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PCA9685_I2C_MOCK_H_ */
@@ -40,6 +40,9 @@ public:
 	void Set(uint8_t nChannel, uint16_t nData);
 	void Set(uint8_t nChannel, uint8_t nData);
 
+	void SetFrame(uint8_t nChannel, uint16_t nData);
+	void SetFrame(uint8_t nChannel, uint8_t nData);
+
 private:
 };
 
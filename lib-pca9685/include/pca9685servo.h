@@ -50,11 +50,14 @@ public:
 	void Set(uint8_t nChannel, uint16_t nData);
 	void Set(uint8_t nChannel, uint8_t nData);
 
+	void SetFrame(uint8_t nChannel, uint8_t nData);
+
 	void SetAngle(uint8_t nChannel, uint8_t nAngle);
 
 private:
 	void CalcLeftCount(void);
 	void CalcRightCount(void);
+	uint16_t CalcCount(uint8_t nData) const;
 
 private:
 	uint16_t m_nLeftUs;
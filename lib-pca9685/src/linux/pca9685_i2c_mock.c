@@ -0,0 +1,161 @@
+/**
+ * @file pca9685_i2c_mock.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined (PCA9685_I2C_MOCK)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "i2c.h"
+#include "i2c_mock.h"
+
+#include "pca9685_i2c_mock.h"
+
+#define REG_MODE1			0x00
+#define REG_LED0_ON_L		0x06
+#define REG_LED15_OFF_H		0x45
+#define REG_ALL_LED_ON_L	0xFA
+#define REG_ALL_LED_OFF_H	0xFD
+
+#define MODE1_AI			(1 << 5)
+
+static uint8_t s_registers[PCA9685_I2C_MOCK_ADDRESSES][PCA9685_I2C_MOCK_REGISTERS];
+static uint8_t s_pointer[PCA9685_I2C_MOCK_ADDRESSES];
+static struct _pca9685_i2c_mock_statistics s_statistics;
+
+static void register_reset(uint8_t *reg) {
+	uint32_t i;
+
+	memset(reg, 0, PCA9685_I2C_MOCK_REGISTERS);
+
+	reg[REG_MODE1] = 0x11;	// SLEEP, ALLCALL
+
+	for (i = 0; i < 16; i++) {
+		reg[REG_LED0_ON_L + (i << 2) + 3] = 0x10;	// Full off
+	}
+
+	reg[0xFE] = 0x1E;	// PRE_SCALE, 200Hz
+}
+
+static uint8_t pointer_next(uint8_t *reg, uint8_t pointer) {
+	if ((reg[REG_MODE1] & MODE1_AI) == 0) {
+		return pointer;
+	}
+
+	if (pointer == REG_LED15_OFF_H) {
+		return 0;
+	}
+
+	if (pointer == REG_ALL_LED_OFF_H) {
+		return REG_ALL_LED_ON_L;
+	}
+
+	return pointer + 1;
+}
+
+static void register_write(uint8_t *reg, uint8_t pointer, uint8_t data) {
+	uint32_t i;
+
+	reg[pointer] = data;
+
+	if ((pointer >= REG_ALL_LED_ON_L) && (pointer <= REG_ALL_LED_OFF_H)) {
+		for (i = 0; i < 16; i++) {
+			reg[REG_LED0_ON_L + (i << 2) + (pointer - REG_ALL_LED_ON_L)] = data;
+		}
+	}
+}
+
+static uint8_t device_write(uint8_t address, const uint8_t *buf, uint32_t len) {
+	uint8_t *reg = s_registers[address];
+	uint32_t i;
+
+	s_pointer[address] = buf[0];
+
+	for (i = 1; i < len; i++) {
+		register_write(reg, s_pointer[address], buf[i]);
+		s_pointer[address] = pointer_next(reg, s_pointer[address]);
+	}
+
+	return I2C_REASON_OK;
+}
+
+static uint8_t device_read(uint8_t address, uint8_t *buf, uint32_t len) {
+	uint8_t *reg = s_registers[address];
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = reg[s_pointer[address]];
+		s_pointer[address] = pointer_next(reg, s_pointer[address]);
+	}
+
+	return I2C_REASON_OK;
+}
+
+static const struct i2c_mock_device s_device = { device_write, device_read };
+
+void pca9685_i2c_mock_reset(void) {
+	uint32_t i;
+
+	i2c_queue_init(&i2c_backend_mock);
+	i2c_mock_reset();
+
+	for (i = 0; i < PCA9685_I2C_MOCK_ADDRESSES; i++) {
+		register_reset(s_registers[i]);
+		s_pointer[i] = 0;
+		i2c_mock_attach((uint8_t) i, &s_device);
+	}
+
+	memset(&s_statistics, 0, sizeof(struct _pca9685_i2c_mock_statistics));
+}
+
+const struct _pca9685_i2c_mock_statistics *pca9685_i2c_mock_get_statistics(void) {
+	const struct i2c_mock_statistics *statistics = i2c_mock_get_statistics();
+
+	i2c_queue_flush();
+
+	s_statistics.writes = statistics->writes;
+	s_statistics.reads = statistics->reads;
+	s_statistics.bytes = statistics->bytes;
+	s_statistics.bus_time = statistics->bus_time;
+
+	return &s_statistics;
+}
+
+uint8_t pca9685_i2c_mock_get_register(uint8_t address, uint8_t reg) {
+	i2c_queue_flush();
+
+	return s_registers[address & 0x7F][reg];
+}
+
+void pca9685_i2c_mock_get_channel(uint8_t address, uint8_t channel, uint16_t *on, uint16_t *off) {
+	const uint8_t *reg = &s_registers[address & 0x7F][REG_LED0_ON_L + ((channel & 0x0F) << 2)];
+
+	i2c_queue_flush();
+
+	*on = (uint16_t) reg[0] | (uint16_t) ((uint16_t) reg[1] << 8);
+	*off = (uint16_t) reg[2] | (uint16_t) ((uint16_t) reg[3] << 8);
+}
+
+#endif
@@ -29,23 +29,13 @@
 #endif
 #include <assert.h>
 
-#include "bcm2835.h"
-
-#if defined(__linux__)
-#elif defined(__circle__)
-#else
- #include "bcm2835_i2c.h"
+#if defined(__circle__)
+ #include "bcm2835.h"
 #endif
 
-#include "pca9685.h"
+#include "i2c.h"
 
-extern "C" {
-#if defined(__linux__) || defined(__circle__)
-extern void bcm2835_delayMicroseconds (const uint64_t);
-#define udelay bcm2835_delayMicroseconds
-#else
-#endif
-}
+#include "pca9685.h"
 
 #define DIV_ROUND_UP(n,d)	(((n) + (d) - 1) / (d))
 
@@ -92,14 +82,15 @@ enum TPCA9685Mode2 {
 	PCA9685_MODE2_INVRT = 1 << 4
 };
 
-PCA9685::PCA9685(uint8_t nAddress) : m_nAddress(nAddress) {
-#if defined (__linux__) || defined(__circle__)
+PCA9685::PCA9685(uint8_t nAddress) : m_nAddress(nAddress), m_nFrameChanged(0) {
+#if defined(__circle__)
 	if (bcm2835_init() == 0) {
 		printf("Not able to init the bmc2835 library\n");
 	}
 #endif
 
-	bcm2835_i2c_begin();
+	i2c_begin();
+	i2c_queue_set_priority(m_nAddress, I2C_PRIORITY_HIGH);
 
 	AutoIncrement(true);
 
@@ -125,7 +116,7 @@ void PCA9685::Sleep(bool bMode) {
 	I2cWriteReg(PCA9685_REG_MODE1, Data);
 
 	if (Data & ~PCA9685_MODE1_RESTART) {
-		udelay(500);
+		i2c_delayus(500);
 		Data |= PCA9685_MODE1_RESTART;
 	}
 }
@@ -214,6 +205,14 @@ void PCA9685::Write(uint8_t nChannel, uint16_t nOn, uint16_t nOff) {
 	}
 
 	I2cWriteReg(reg, nOn, nOff);
+
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		if ((nChannel == i) || (nChannel > 15)) {
+			m_aFrameOn[i] = nOn;
+			m_aFrameOff[i] = nOff;
+			m_nFrameChanged &= ~(1 << i);
+		}
+	}
 }
 
 void PCA9685::Write(uint8_t nChannel, uint16_t nValue) {
@@ -268,6 +267,12 @@ void PCA9685::SetFullOn(uint8_t nChannel, bool bMode) {
 
 	I2cWriteReg(reg, Data);
 
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		if ((nChannel == i) || (nChannel > 15)) {
+			m_aFrameOn[i] = bMode ? (m_aFrameOn[i] | PCA9685_FULL_ON_OFF) : (m_aFrameOn[i] & ~PCA9685_FULL_ON_OFF);
+		}
+	}
+
 	if (bMode) {
 		SetFullOff(nChannel, false);
 	}
@@ -288,6 +293,66 @@ void PCA9685::SetFullOff(uint8_t nChannel, bool bMode) {
 	Data = bMode ? (Data | 0x10) : (Data & 0xEF);
 
 	I2cWriteReg(reg, Data);
+
+	for (uint8_t i = 0; i < PCA9685_PWM_CHANNELS; i++) {
+		if ((nChannel == i) || (nChannel > 15)) {
+			m_aFrameOff[i] = bMode ? (m_aFrameOff[i] | PCA9685_FULL_ON_OFF) : (m_aFrameOff[i] & ~PCA9685_FULL_ON_OFF);
+		}
+	}
+}
+
+/*
+ * The frame is sent with WriteFrame. Only the channels which differ from what is in the PCA9685 are sent.
+ * Full on is nOn = PCA9685_FULL_ON_OFF, nOff = 0. Full off is nOff = PCA9685_FULL_ON_OFF.
+ */
+void PCA9685::SetFrame(uint8_t nChannel, uint16_t nOn, uint16_t nOff) {
+	assert(nChannel < PCA9685_PWM_CHANNELS);
+
+	if (nChannel >= PCA9685_PWM_CHANNELS) {
+		return;
+	}
+
+	if ((m_aFrameOn[nChannel] != nOn) || (m_aFrameOff[nChannel] != nOff)) {
+		m_aFrameOn[nChannel] = nOn;
+		m_aFrameOff[nChannel] = nOff;
+		m_nFrameChanged |= (1 << nChannel);
+	}
+}
+
+/*
+ * The changed channels go out as runs of LEDn_ON_L..LEDn_OFF_H, one auto-increment burst per run.
+ * When all channels changed, that is a single transaction of 65 bytes.
+ */
+void PCA9685::WriteFrame(void) {
+	uint8_t buffer[1 + 4 * PCA9685_PWM_CHANNELS];
+
+	while (m_nFrameChanged != 0) {
+		const uint8_t nFirst = (uint8_t) __builtin_ctz(m_nFrameChanged);
+		uint8_t nLast = nFirst;
+
+		for (uint8_t i = nFirst + 1; i < PCA9685_PWM_CHANNELS; i++) {
+			if ((m_nFrameChanged & (1 << i)) != 0) {
+				nLast = i;
+			} else if ((i - nLast) > PCA9685_FRAME_GAP_MAX) {
+				break;
+			}
+		}
+
+		uint8_t *p = buffer;
+
+		*p++ = PCA9685_REG_LED0_ON_L + (nFirst << 2);
+
+		for (uint8_t i = nFirst; i <= nLast; i++) {
+			*p++ = (uint8_t) (m_aFrameOn[i] & 0xFF);
+			*p++ = (uint8_t) (m_aFrameOn[i] >> 8);
+			*p++ = (uint8_t) (m_aFrameOff[i] & 0xFF);
+			*p++ = (uint8_t) (m_aFrameOff[i] >> 8);
+		}
+
+		I2cWrite(buffer, (uint32_t) (p - buffer));
+
+		m_nFrameChanged &= ~((1 << (nLast + 1)) - 1);
+	}
 }
 
 uint8_t PCA9685::CalcPresScale(uint16_t nFreq) {
@@ -380,30 +445,20 @@ void PCA9685::AutoIncrement(bool bMode) {
 }
 
 void PCA9685::I2cSetup(void) {
-	bcm2835_i2c_setSlaveAddress(m_nAddress);
-	bcm2835_i2c_setClockDivider(BCM2835_I2C_CLOCK_DIVIDER_626);
+	i2c_set_address(m_nAddress);
+	i2c_set_clockdivider(I2C_CLOCK_DIVIDER_400kHz);
 }
 
 void PCA9685::I2cWriteReg(uint8_t reg, uint8_t data) {
-	uint8_t buffer[2];
-
-	buffer[0] = reg;
-	buffer[1] = data;
-
 	I2cSetup();
 
-	bcm2835_i2c_write((char *)buffer, 2);
+	i2c_write_reg_uint8(reg, data);
 }
 
 uint8_t PCA9685::I2cReadReg(uint8_t reg) {
-	char data = reg;
-
 	I2cSetup();
 
-	(void) bcm2835_i2c_write((char *)&data, 1);
-	(void) bcm2835_i2c_read((char *)&data, 1);
-
-	return data;
+	return i2c_read_reg_uint8(reg);
 }
 
 void PCA9685::I2cWriteReg(uint8_t reg, uint16_t data) {
@@ -415,19 +470,15 @@ void PCA9685::I2cWriteReg(uint8_t reg, uint16_t data) {
 
 	I2cSetup();
 
-	bcm2835_i2c_write((char *) buffer, 3);
+	i2c_write_nb((char *) buffer, 3);
 }
 
 uint16_t PCA9685::I2cReadReg16(uint8_t reg) {
-	char data = reg;
-	char buffer[2] = { 0, 0 };
-
 	I2cSetup();
 
-	(void) bcm2835_i2c_write((char *)&data, 1);
-	(void) bcm2835_i2c_read((char *)&buffer, 2);
+	const uint16_t data = i2c_read_reg_uint16(reg);
 
-	return (uint16_t) ((uint16_t) buffer[1] << 8 | (uint16_t) buffer[0]);
+	return (uint16_t) ((data >> 8) | (data << 8));
 }
 
 void PCA9685::I2cWriteReg(uint8_t reg, uint16_t data, uint16_t data2) {
@@ -441,6 +492,11 @@ void PCA9685::I2cWriteReg(uint8_t reg, uint16_t data, uint16_t data2) {
 
 	I2cSetup();
 
-	bcm2835_i2c_write((char *) buffer, 5);
+	i2c_write_nb((char *) buffer, 5);
 }
 
+void PCA9685::I2cWrite(const uint8_t *pBuffer, uint32_t nLength) {
+	I2cSetup();
+
+	i2c_write_nb((const char *) pBuffer, nLength);
+}
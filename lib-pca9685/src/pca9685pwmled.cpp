@@ -59,3 +59,26 @@ void PCA9685PWMLed::Set(uint8_t nChannel, uint8_t nData) {
 		Write(nChannel, nValue);
 	}
 }
+
+void PCA9685PWMLed::SetFrame(uint8_t nChannel, uint16_t nData) {
+
+	if (nData >= MAX_12BIT) {
+		PCA9685::SetFrame(nChannel, PCA9685_FULL_ON_OFF, (uint16_t) 0);
+	} else if (nData == 0) {
+		PCA9685::SetFrame(nChannel, (uint16_t) 0, PCA9685_FULL_ON_OFF);
+	} else {
+		PCA9685::SetFrame(nChannel, (uint16_t) 0, nData);
+	}
+}
+
+void PCA9685PWMLed::SetFrame(uint8_t nChannel, uint8_t nData) {
+
+	if (nData == MAX_8BIT) {
+		PCA9685::SetFrame(nChannel, PCA9685_FULL_ON_OFF, (uint16_t) 0);
+	} else if (nData == 0) {
+		PCA9685::SetFrame(nChannel, (uint16_t) 0, PCA9685_FULL_ON_OFF);
+	} else {
+		const uint16_t nValue = (uint16_t) (nData << 4) | (uint16_t) (nData >> 4);
+		PCA9685::SetFrame(nChannel, (uint16_t) 0, nValue);
+	}
+}
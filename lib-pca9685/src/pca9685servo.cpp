@@ -87,18 +87,25 @@ void PCA9685Servo::Set(uint8_t nChannel, uint16_t nData) {
 	Write(nChannel, nData);
 }
 
-void PCA9685Servo::Set(uint8_t nChannel, uint8_t nData) {
+uint16_t PCA9685Servo::CalcCount(uint8_t nData) const {
 
 	if (nData == 0) {
-		Write(nChannel, m_nLeftCount);
+		return m_nLeftCount;
 	} else if (nData == (MAX_8BIT + 1) / 2) {
-		Write(nChannel, MID_COUNT);
+		return MID_COUNT;
 	}  else if (nData == MAX_8BIT) {
-		Write(nChannel, m_nRightCount);
-	} else {
-		const uint16_t nCount = m_nLeftCount + (.5 + ((float) (m_nRightCount - m_nLeftCount) / MAX_8BIT) * nData);
-		Write(nChannel, nCount);
+		return m_nRightCount;
 	}
+
+	return m_nLeftCount + (.5 + ((float) (m_nRightCount - m_nLeftCount) / MAX_8BIT) * nData);
+}
+
+void PCA9685Servo::Set(uint8_t nChannel, uint8_t nData) {
+	Write(nChannel, CalcCount(nData));
+}
+
+void PCA9685Servo::SetFrame(uint8_t nChannel, uint8_t nData) {
+	PCA9685::SetFrame(nChannel, (uint16_t) 0, CalcCount(nData));
 }
 
 void PCA9685Servo::SetAngle(uint8_t nChannel, uint8_t nAngle) {
@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "lightset.h"
+#include "lightsetcurve.h"
 
 #include "pca9685pwmled.h"
 
@@ -79,6 +80,15 @@ public:
 
 	void SetDmxFootprint(uint16_t nDmxFootprint);
 
+	inline bool GetDmx16Bit(void) const {
+		return m_bDmx16Bit;
+	}
+	void SetDmx16Bit(bool bDmx16Bit);
+
+	inline LightSetCurve *GetCurve(void) {
+		return &m_Curve;
+	}
+
 private:
 	void Initialize(void);
 
@@ -91,6 +101,8 @@ private:
 	bool m_bOutputInvert;
 	bool m_bOutputDriver;
 	bool m_bIsStarted;
+	bool m_bDmx16Bit;
+	LightSetCurve m_Curve;
 	PCA9685PWMLed **m_pPWMLed;
 	uint8_t *m_pDmxData;
 	char *m_pSlotInfoRaw;
@@ -31,6 +31,10 @@
 #include "pca9685dmxparams.h"
 #include "pca9685dmxled.h"
 
+#include "lightsetcurve.h"
+
+#define PCA9685_DMX_CURVE_POINTS_LENGTH	LIGHTSET_CURVE_POINTS_LENGTH
+
 class PCA9685DmxLedParams: public PCA9685DmxParams {
 public:
 	PCA9685DmxLedParams(void);
@@ -56,6 +60,10 @@ private:
     uint16_t m_nPwmFrequency;
 	bool m_bOutputInvert;
 	bool m_bOutputDriver;
+	bool m_bDmx16Bit;
+	TLightSetCurve m_tCurve;
+	float m_fCurveGamma;
+	char m_aCurvePoints[PCA9685_DMX_CURVE_POINTS_LENGTH + 1];
 };
 
 #endif /* PCA9685DMXLEDPARAMS_H_ */
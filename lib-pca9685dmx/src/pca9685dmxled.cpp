@@ -53,6 +53,7 @@ PCA9685DmxLed::PCA9685DmxLed(void):
 	m_bOutputInvert(false), // Output logic state not inverted. Value to use when external driver used.
 	m_bOutputDriver(true),	// The 16 LEDn outputs are configured with a totem pole structure.
 	m_bIsStarted(false),
+	m_bDmx16Bit(false),
 	m_pPWMLed(0),
 	m_pDmxData(0),
 	m_pSlotInfoRaw(0),
@@ -107,25 +108,52 @@ void PCA9685DmxLed::SetData(uint8_t nPort, const uint8_t* pDmxData, uint16_t nLe
 	uint8_t *p = (uint8_t *)pDmxData + m_nDmxStartAddress - 1;
 	uint8_t *q = m_pDmxData;
 
-	uint16_t nChannel = m_nDmxStartAddress;
+	const uint16_t nSlots = m_bDmx16Bit ? 2 : 1;
+	uint16_t nChannel = m_nDmxStartAddress + nSlots - 1;	// Last slot of the output
 
 	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		bool bIsLast = false;
+
 		for (unsigned i = 0; i < PCA9685_PWM_CHANNELS; i++) {
 			if ((nChannel >= (m_nDmxFootprint + m_nDmxStartAddress)) || (nChannel > nLength)) {
-				j = m_nBoardInstances;
+				bIsLast = true;
 				break;
 			}
-			if (*p != *q) {
-				uint8_t value = *p;
+
+			if (m_bDmx16Bit) {
+				if ((p[0] != q[0]) || (p[1] != q[1])) {
+					const uint16_t value = ((uint16_t) p[0] << 8) | (uint16_t) p[1];
 #ifndef NDEBUG
-				printf("m_pPWMLed[%d]->SetDmx(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
+					printf("m_pPWMLed[%d]->SetFrame(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
 #endif
-				m_pPWMLed[j]->Set(CHANNEL(i), value);
+					m_pPWMLed[j]->SetFrame(CHANNEL(i), (uint16_t) (m_Curve.Get(value) >> 4));
+				}
+				q[0] = p[0];
+				q[1] = p[1];
+			} else {
+				if (*p != *q) {
+					uint8_t value = *p;
+#ifndef NDEBUG
+					printf("m_pPWMLed[%d]->SetFrame(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
+#endif
+					if (m_Curve.IsLinear()) {
+						m_pPWMLed[j]->SetFrame(CHANNEL(i), value);
+					} else {
+						m_pPWMLed[j]->SetFrame(CHANNEL(i), (uint16_t) (m_Curve.Get(value) >> 4));
+					}
+				}
+				*q = *p;
 			}
-			*q = *p;
-			p++;
-			q++;
-			nChannel++;
+
+			p += nSlots;
+			q += nSlots;
+			nChannel += nSlots;
+		}
+
+		m_pPWMLed[j]->WriteFrame();
+
+		if (bIsLast) {
+			break;
 		}
 	}
 }
@@ -167,7 +195,7 @@ void PCA9685DmxLed::SetI2cAddress(uint8_t nI2cAddress) {
 void PCA9685DmxLed::SetBoardInstances(uint8_t nBoardInstances) {
 	if ((nBoardInstances != 0) && (nBoardInstances <= BOARD_INSTANCES_MAX)) {
 		m_nBoardInstances = nBoardInstances;
-		m_nDmxFootprint = nBoardInstances * PCA9685_PWM_CHANNELS;
+		m_nDmxFootprint = nBoardInstances * PCA9685_PWM_CHANNELS * (m_bDmx16Bit ? 2 : 1);
 	}
 }
 
@@ -193,10 +221,27 @@ void PCA9685DmxLed::SetOutDriver(bool bOutputDriver) {
 
 void PCA9685DmxLed::SetDmxFootprint(uint16_t nDmxFootprint) {
 	m_nDmxFootprint = nDmxFootprint;
-	m_nBoardInstances = (uint16_t) ceil((float) nDmxFootprint / PCA9685_PWM_CHANNELS);
+	m_nBoardInstances = (uint16_t) ceil((float) nDmxFootprint / (PCA9685_PWM_CHANNELS * (m_bDmx16Bit ? 2 : 1)));
+}
+
+/*
+ * Coarse and fine slot for each output. The footprint doubles for the same number of boards.
+ */
+void PCA9685DmxLed::SetDmx16Bit(bool bDmx16Bit) {
+	if (bDmx16Bit == m_bDmx16Bit) {
+		return;
+	}
+
+	m_bDmx16Bit = bDmx16Bit;
+	m_nDmxFootprint = m_nBoardInstances * PCA9685_PWM_CHANNELS * (m_bDmx16Bit ? 2 : 1);
 }
 
 void PCA9685DmxLed::Initialize(void) {
+	m_Curve.Build();
+#ifndef NDEBUG
+	m_Curve.Dump();
+#endif
+
 	assert(m_pDmxData == 0);
 	m_pDmxData = new uint8_t[m_nDmxFootprint];
 	assert(m_pDmxData != 0);
@@ -242,8 +287,13 @@ void PCA9685DmxLed::Initialize(void) {
 		}
 
 		if (!isSet) {
-			m_pSlotInfo[i].nType = 0x00; // ST_PRIMARY
-			m_pSlotInfo[i].nCategory = 0x0001; // SD_INTENSITY
+			if (m_bDmx16Bit && ((i & 0x1) == 0x1)) {
+				m_pSlotInfo[i].nType = 0x01; // ST_SEC_FINE
+				m_pSlotInfo[i].nCategory = (uint16_t) (i - 1); // Slot offset of the coarse slot
+			} else {
+				m_pSlotInfo[i].nType = 0x00; // ST_PRIMARY
+				m_pSlotInfo[i].nCategory = 0x0001; // SD_INTENSITY
+			}
 		}
 	}
 }
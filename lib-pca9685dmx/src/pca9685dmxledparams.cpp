@@ -43,12 +43,20 @@
 #define SET_OUTPUT_INVERT_MASK	1<<1
 #define SET_OUTPUT_DRIVER_MASK	1<<2
 #define I2C_SLAVE_ADDRESS_MASK	1<<3
+#define SET_DMX_16BIT_MASK		1<<4
+#define SET_CURVE_MASK			1<<5
+#define SET_CURVE_GAMMA_MASK	1<<6
+#define SET_CURVE_POINTS_MASK	1<<7
 
 static const char PARAMS_FILE_NAME[] ALIGNED = "pwmled.txt";
 static const char PARAMS_I2C_SLAVE_ADDRESS[] ALIGNED = "i2c_slave_address";
 static const char PARAMS_PWM_FREQUENCY[] ALIGNED = "pwm_frequency";
 static const char PARAMS_OUTPUT_INVERT[] ALIGNED = "output_invert";
 static const char PARAMS_OUTPUT_DRIVER[] ALIGNED = "output_driver";
+static const char PARAMS_DMX_16BIT[] ALIGNED = "dmx_16bit";
+static const char PARAMS_DMX_CURVE[] ALIGNED = "dmx_curve";
+static const char PARAMS_DMX_CURVE_GAMMA[] ALIGNED = "dmx_curve_gamma";
+static const char PARAMS_DMX_CURVE_POINTS[] ALIGNED = "dmx_curve_points";
 
 PCA9685DmxLedParams::PCA9685DmxLedParams(void) :
 	PCA9685DmxParams(PARAMS_FILE_NAME),
@@ -56,8 +64,12 @@ PCA9685DmxLedParams::PCA9685DmxLedParams(void) :
 	m_nI2cAddress(PCA9685_I2C_ADDRESS_DEFAULT),
 	m_nPwmFrequency(PWMLED_DEFAULT_FREQUENCY),
 	m_bOutputInvert(false), // Output logic state not inverted. Value to use when external driver used.
-	m_bOutputDriver(true)	// The 16 LEDn outputs are configured with a totem pole structure.
+	m_bOutputDriver(true),	// The 16 LEDn outputs are configured with a totem pole structure.
+	m_bDmx16Bit(false),
+	m_tCurve(LIGHTSET_CURVE_LINEAR),
+	m_fCurveGamma(LIGHTSET_CURVE_GAMMA_DEFAULT)
 {
+	m_aCurvePoints[0] = '\0';
 }
 
 PCA9685DmxLedParams::~PCA9685DmxLedParams(void) {
@@ -93,6 +105,23 @@ void PCA9685DmxLedParams::Set(PCA9685DmxLed* pDmxLed) {
 		pDmxLed->SetOutDriver(m_bOutputDriver);
 	}
 
+	// Before the footprint, which counts two slots for each output in 16-bit mode
+	if(IsMaskSet(SET_DMX_16BIT_MASK)) {
+		pDmxLed->SetDmx16Bit(m_bDmx16Bit);
+	}
+
+	if(IsMaskSet(SET_CURVE_MASK)) {
+		pDmxLed->GetCurve()->SetType(m_tCurve);
+	}
+
+	if(IsMaskSet(SET_CURVE_GAMMA_MASK)) {
+		pDmxLed->GetCurve()->SetGamma(m_fCurveGamma);
+	}
+
+	if(IsMaskSet(SET_CURVE_POINTS_MASK)) {
+		(void) pDmxLed->GetCurve()->SetPoints(m_aCurvePoints);
+	}
+
 	const uint16_t DmxStartAddress = GetDmxStartAddress(isSet);
 	if (isSet) {
 		pDmxLed->SetDmxStartAddress(DmxStartAddress);
@@ -139,6 +168,22 @@ void PCA9685DmxLedParams::Dump(void) {
 		printf(" %s=%d [The 16 LEDn outputs are configured with %s structure]\n", PARAMS_OUTPUT_DRIVER, (int) m_bOutputDriver, m_bOutputDriver ? "a totem pole" : "an open-drain");
 	}
 
+	if(IsMaskSet(SET_DMX_16BIT_MASK)) {
+		printf(" %s=%d\n", PARAMS_DMX_16BIT, (int) m_bDmx16Bit);
+	}
+
+	if(IsMaskSet(SET_CURVE_MASK)) {
+		printf(" %s=%s\n", PARAMS_DMX_CURVE, LightSetCurve::GetTypeString(m_tCurve));
+	}
+
+	if(IsMaskSet(SET_CURVE_GAMMA_MASK)) {
+		printf(" %s=%d.%02d\n", PARAMS_DMX_CURVE_GAMMA, (int) m_fCurveGamma, (int) (100 * (m_fCurveGamma - (int) m_fCurveGamma)));
+	}
+
+	if(IsMaskSet(SET_CURVE_POINTS_MASK)) {
+		printf(" %s=%s\n", PARAMS_DMX_CURVE_POINTS, m_aCurvePoints);
+	}
+
 	PCA9685DmxParams::Dump();
 #endif
 }
@@ -159,6 +204,9 @@ void PCA9685DmxLedParams::callbackFunction(const char* pLine) {
 
 	uint8_t value8;
 	uint16_t value16;
+	float valuef;
+	uint8_t len;
+	char buffer[8];
 
 	if (Sscan::I2cAddress(pLine, PARAMS_I2C_SLAVE_ADDRESS, &value8) == SSCAN_OK) {
 		if ((value8 >= PCA9685_I2C_ADDRESS_DEFAULT) && (value8 != PCA9685_I2C_ADDRESS_FIXED)) {
@@ -191,5 +239,36 @@ void PCA9685DmxLedParams::callbackFunction(const char* pLine) {
 		}
 		return;
 	}
+
+	if (Sscan::Uint8(pLine, PARAMS_DMX_16BIT, &value8) == SSCAN_OK) {
+		m_bDmx16Bit = (value8 != 0);
+		m_bSetList |= SET_DMX_16BIT_MASK;
+		return;
+	}
+
+	len = 6;
+	if (Sscan::Char(pLine, PARAMS_DMX_CURVE, buffer, &len) == SSCAN_OK) {
+		buffer[len] = '\0';
+		const TLightSetCurve tCurve = LightSetCurve::GetType(buffer);
+		if (tCurve != LIGHTSET_CURVE_UNDEFINED) {
+			m_tCurve = tCurve;
+			m_bSetList |= SET_CURVE_MASK;
+		}
+		return;
+	}
+
+	if (Sscan::Float(pLine, PARAMS_DMX_CURVE_GAMMA, &valuef) == SSCAN_OK) {
+		if ((valuef > 0) && (valuef <= 10)) {
+			m_fCurveGamma = valuef;
+			m_bSetList |= SET_CURVE_GAMMA_MASK;
+		}
+		return;
+	}
+
+	len = PCA9685_DMX_CURVE_POINTS_LENGTH;
+	if (Sscan::Char(pLine, PARAMS_DMX_CURVE_POINTS, m_aCurvePoints, &len) == SSCAN_OK) {
+		m_aCurvePoints[len] = '\0';
+		m_bSetList |= SET_CURVE_POINTS_MASK;
+	}
 }
 
@@ -105,23 +105,31 @@ void PCA9685DmxServo::SetData(uint8_t nPort, const uint8_t* pDmxData, uint16_t n
 	uint16_t nChannel = m_nDmxStartAddress;
 
 	for (unsigned j = 0; j < m_nBoardInstances; j++) {
+		bool bIsLast = false;
+
 		for (unsigned i = 0; i < PCA9685_PWM_CHANNELS; i++) {
 			if ((nChannel >= (m_nDmxFootprint + m_nDmxStartAddress)) || (nChannel > nLength)) {
-				j = m_nBoardInstances;
+				bIsLast = true;
 				break;
 			}
 			if (*p != *q) {
 				uint8_t value = *p;
 #ifndef NDEBUG
-				printf("m_pServo[%d]->SetDmx(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
+				printf("m_pServo[%d]->SetFrame(CHANNEL(%d), %d)\n", (int) j, (int) i, (int) value);
 #endif
-				m_pServo[j]->Set(CHANNEL(i), value);
+				m_pServo[j]->SetFrame(CHANNEL(i), value);
 			}
 			*q = *p;
 			p++;
 			q++;
 			nChannel++;
 		}
+
+		m_pServo[j]->WriteFrame();
+
+		if (bIsLast) {
+			break;
+		}
 	}
 }
 
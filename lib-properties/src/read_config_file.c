@@ -30,7 +30,7 @@
 #include "read_config_file.h"
 
 const bool read_config_file(const char *file_name, funcptr pfi) {
-	char buffer[128];
+	char buffer[256];
 	FILE *fp;
 
 	assert(file_name != NULL);
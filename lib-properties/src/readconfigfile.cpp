@@ -43,7 +43,7 @@ ReadConfigFile::~ReadConfigFile(void) {
 }
 
 bool ReadConfigFile::Read(const char *pFileName) {
-	char buffer[128];
+	char buffer[256];
 	FILE *fp;
 
 	assert(pFileName != 0);
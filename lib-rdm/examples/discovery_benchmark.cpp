@@ -0,0 +1,169 @@
+/**
+ * @file discovery_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "rdmdiscovery.h"
+#include "rdmbussimulated.h"
+
+#include "rdm.h"
+
+#define RESPONDERS		50
+#define CLOSE_UIDS		10		///< Consecutive UIDs, these collide down to the last branches
+#define LOOP_MICROS		10		///< The time of one main loop pass
+
+/*
+ * No hardware needed: the line is RDMBusSimulated.
+ * Rdm (lib-dmx) is bare metal only, RDMMessage just needs it to link.
+ */
+uint8_t Rdm::m_TransactionNumber = 0;
+
+Rdm::Rdm(void) {
+}
+
+Rdm::~Rdm(void) {
+}
+
+void Rdm::Send(struct TRdmMessage *) {
+	abort();
+}
+
+static uint64_t aUid[RESPONDERS + 2];
+static bool aIsPresent[RESPONDERS + 2];
+
+static void ToUid(uint64_t nUid, uint8_t *pUid) {
+	for (int i = RDM_UID_SIZE - 1; i >= 0; i--) {
+		pUid[i] = (uint8_t) nUid;
+		nUid >>= 8;
+	}
+}
+
+static bool check(RDMDiscovery &discovery) {
+	uint16_t nExpected = 0;
+
+	for (unsigned i = 0; i < sizeof(aUid) / sizeof(aUid[0]); i++) {
+		uint8_t uid[RDM_UID_SIZE];
+		ToUid(aUid[i], uid);
+
+		if (aIsPresent[i]) {
+			nExpected++;
+		}
+
+		if (discovery.Exist(uid) != aIsPresent[i]) {
+			return false;
+		}
+	}
+
+	return discovery.GetUidCount() == nExpected;
+}
+
+/*
+ * The discovery is ticked as from the ArtNetNode main loop.
+ * The DMX gap is the longest time the discovery holds the line.
+ */
+static void run(const char *pName, RDMDiscovery &discovery, RDMBusSimulated &bus, bool bIncremental) {
+	const uint32_t nRequests = bus.GetRequests();
+	const uint32_t nCollisions = bus.GetCollisions();
+	const uint32_t nStart = bus.Micros();
+	uint32_t nHeld = 0;
+	uint32_t nMaxGap = 0;
+	bool bIsHeld = false;
+
+	discovery.Start(bIncremental);
+
+	do {
+		const bool bIsLineFree = discovery.IsLineFree();
+
+		if (!bIsLineFree && !bIsHeld) {
+			nHeld = bus.Micros();
+		} else if (bIsLineFree && bIsHeld && (bus.Micros() - nHeld > nMaxGap)) {
+			nMaxGap = bus.Micros() - nHeld;
+		}
+
+		bIsHeld = !bIsLineFree;
+		bus.Advance(LOOP_MICROS);
+	} while (discovery.Run());
+
+	if (bIsHeld && (bus.Micros() - nHeld > nMaxGap)) {
+		nMaxGap = bus.Micros() - nHeld;
+	}
+
+	printf("%-12s: %8u us, max DMX gap %8u us, %4u requests, %3u collisions, TOD %s\n", pName, bus.Micros() - nStart, nMaxGap, bus.GetRequests() - nRequests, bus.GetCollisions() - nCollisions, check(discovery) ? "OK" : "WRONG");
+}
+
+int main(void) {
+	RDMBusSimulated bus(RESPONDERS + 2);
+	RDMDiscovery discovery(TOD_TABLE_SIZE, &bus);
+	const uint8_t aController[RDM_UID_SIZE] = {0x7F, 0xF0, 0x00, 0x00, 0x00, 0x01};
+	uint8_t uid[RDM_UID_SIZE];
+
+	discovery.SetUid(aController);
+
+	srand(1);
+
+	for (unsigned i = 0; i < RESPONDERS; i++) {
+		if (i < CLOSE_UIDS) {
+			aUid[i] = 0x7FF000000100 + i;
+		} else {
+			aUid[i] = (((uint64_t) rand() << 24) ^ (uint64_t) rand()) & 0xFFFFFFFFFFFF;
+		}
+
+		ToUid(aUid[i], uid);
+		bus.AddResponder(uid);
+		aIsPresent[i] = true;
+	}
+
+	const uint32_t nStart = bus.Micros();
+	discovery.Full();
+	const uint32_t nBlocking = bus.Micros() - nStart;
+	printf("%-12s: %8u us, max DMX gap %8u us, TOD %s\n", "Blocking", nBlocking, nBlocking, check(discovery) ? "OK" : "WRONG");
+
+	run("Full", discovery, bus, false);
+
+	// Take some away and add new ones, then re-verify
+	for (unsigned i = 0; i < RESPONDERS; i += 7) {
+		ToUid(aUid[i], uid);
+		bus.RemoveResponder(uid);
+		aIsPresent[i] = false;
+	}
+
+	aUid[RESPONDERS] = 0x7FF000000180;
+	aUid[RESPONDERS + 1] = 0x123456789ABC;
+
+	for (unsigned i = RESPONDERS; i < RESPONDERS + 2; i++) {
+		ToUid(aUid[i], uid);
+		bus.AddResponder(uid);
+		aIsPresent[i] = true;
+	}
+
+	run("Incremental", discovery, bus, true);
+
+	discovery.SetSlice(0, 0);
+	run("No slices", discovery, bus, false);
+
+	return 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file rdmbus.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RDMBUS_H_
+#define RDMBUS_H_
+
+#include <stdint.h>
+
+#include "rdm.h"
+
+/**
+ * The RDM line as seen by the controller side (discovery)
+ */
+class RDMBus {
+public:
+	virtual ~RDMBus(void) {
+	}
+
+	/// Adds the transaction number and the checksum, and sends
+	virtual void Send(struct TRdmMessage *)=0;
+
+	/// Does not wait. The data starts with the start code (or 0xFE for a discovery response).
+	virtual const uint8_t *Receive(void)=0;
+
+	virtual uint32_t Micros(void)=0;
+};
+
+#endif /* RDMBUS_H_ */
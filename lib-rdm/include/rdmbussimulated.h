@@ -0,0 +1,103 @@
+/**
+ * @file rdmbussimulated.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RDMBUSSIMULATED_H_
+#define RDMBUSSIMULATED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "rdmbus.h"
+
+#include "rdm.h"
+
+#define RDM_BUS_SIMULATED_POLL_MICROS	1
+
+/**
+ * A line with virtual responders and a virtual clock, for running the
+ * discovery without hardware. The clock moves with Advance, with the wire
+ * time of what is sent, and by RDM_BUS_SIMULATED_POLL_MICROS on each
+ * Micros, so that a polling loop does not stand still. A response is available once its last
+ * byte would have arrived.
+ *
+ * Responders answer the discovery commands only (DISC_UNIQUE_BRANCH,
+ * DISC_MUTE, DISC_UN_MUTE). When more than one answers a
+ * DISC_UNIQUE_BRANCH, the encoded responses are ANDed, as on the line.
+ */
+class RDMBusSimulated: public RDMBus {
+public:
+	RDMBusSimulated(uint16_t nMaxResponders = 64);
+	~RDMBusSimulated(void);
+
+	bool AddResponder(const uint8_t *pUid);
+	bool RemoveResponder(const uint8_t *pUid);
+
+	inline uint16_t GetResponders(void) const {
+		return m_nResponders;
+	}
+
+	void Send(struct TRdmMessage *);
+	const uint8_t *Receive(void);
+
+	uint32_t Micros(void) {
+		m_nMicros += RDM_BUS_SIMULATED_POLL_MICROS;
+		return m_nMicros;
+	}
+
+	inline void Advance(uint32_t nMicros) {
+		m_nMicros += nMicros;
+	}
+
+	inline uint32_t GetRequests(void) const {
+		return m_nRequests;
+	}
+
+	inline uint32_t GetCollisions(void) const {
+		return m_nCollisions;
+	}
+
+private:
+	struct TResponder {
+		uint64_t nUid;
+		bool bIsMuted;
+	};
+
+	static uint64_t ToUid(const uint8_t *);
+	void Respond(const struct TResponder *);
+	void RespondDiscovery(uint64_t nLower, uint64_t nUpper);
+
+private:
+	uint16_t m_nMaxResponders;
+	uint16_t m_nResponders;
+	struct TResponder *m_pResponders;
+	uint32_t m_nMicros;
+	uint8_t m_aResponse[sizeof(struct TRdmMessage) + RDM_MESSAGE_CHECKSUM_SIZE];
+	bool m_bIsResponsePending;
+	uint32_t m_nResponseMicros;
+	uint32_t m_nRequests;
+	uint32_t m_nCollisions;
+};
+
+#endif /* RDMBUSSIMULATED_H_ */
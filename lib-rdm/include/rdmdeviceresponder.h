@@ -33,6 +33,7 @@
 #include "rdmpersonality.h"
 #include "rdmsensors.h"
 #include "rdmsubdevices.h"
+#include "rdmpidhandler.h"
 
 #include "lightset.h"
 
@@ -94,6 +95,12 @@ public:
 	uint16_t GetSubDeviceCount(void);
 	inline RDMSubDevices* GetRDMSubDevices(void) { return &m_RDMSubDevices; }
 
+	// Extra PIDs, pPids ascending on pid
+	bool SetPidHandler(RDMPidHandler *pRDMPidHandler, const struct TRDMPid *pPids, uint16_t nPidsCount);
+	inline RDMPidHandler* GetPidHandler(void) { return m_pRDMPidHandler; }
+	inline const struct TRDMPid* GetPids(void) { return m_pPids; }
+	inline uint16_t GetPidsCount(void) { return m_nPidsCount; }
+
 	void Print(void);
 
 private:
@@ -110,6 +117,9 @@ private:
 	RDMSubDevices m_RDMSubDevices;
 	struct TRDMDeviceInfo m_tRDMSubDeviceInfo;
 	char m_aLanguage[2];
+	RDMPidHandler *m_pRDMPidHandler;
+	const struct TRDMPid *m_pPids;
+	uint16_t m_nPidsCount;
 	//
 	bool m_IsFactoryDefaults;
 	uint16_t m_nCheckSum;
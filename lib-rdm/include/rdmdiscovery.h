@@ -31,22 +31,89 @@
 
 #include "rdm.h"
 
+#include "rdmbus.h"
 #include "rdmmessage.h"
 #include "rdmtod.h"
 
+#define RDM_DISCOVERY_STACK_SIZE			50		///< A 48-bit range splits at most 48 times
+#define RDM_DISCOVERY_RESPONSE_TIMEOUT		2800	///< Micros
+#define RDM_DISCOVERY_UNMUTE_SPACING		100000	///< Micros
+#define RDM_DISCOVERY_SLICE_TRANSACTIONS	4		///< Default, before the line is given back
+#define RDM_DISCOVERY_SLICE_YIELD			25000	///< Default micros, a DMX frame
+
+enum TRdmDiscoveryState {
+	RDM_DISCOVERY_STATE_IDLE,
+	RDM_DISCOVERY_STATE_UNMUTE,
+	RDM_DISCOVERY_STATE_UNMUTE_SPACING,
+	RDM_DISCOVERY_STATE_MUTE_KNOWN,
+	RDM_DISCOVERY_STATE_MUTE_KNOWN_WAIT,
+	RDM_DISCOVERY_STATE_BRANCH,
+	RDM_DISCOVERY_STATE_BRANCH_WAIT,
+	RDM_DISCOVERY_STATE_MUTE_WAIT,
+	RDM_DISCOVERY_STATE_QUICKFIND_MUTE_WAIT,
+	RDM_DISCOVERY_STATE_YIELD
+};
+
+/**
+ * Discovery as a state machine: Run does one step and never waits. At
+ * most one request is on the line; the response windows and the spacing
+ * between the broadcast UN_MUTEs are time-outs on RDMBus::Micros.
+ *
+ * The ranges still to search are kept on an explicit stack, depth first.
+ * After a number of transactions (SetSlice) the discovery gives the line
+ * back for a while, so that DMX frames can go out in between.
+ *
+ * An incremental discovery keeps the TOD: the known UIDs are muted one by
+ * one (and deleted when they do not respond), then the search only finds
+ * the devices that are new.
+ */
 class RDMDiscovery: public RDMTod {
 public:
-	RDMDiscovery(void);
+	/**
+	 * Without pRDMBus, on bare metal, the DMX port of lib-dmx is used (RDMBusDmx)
+	 */
+	RDMDiscovery(uint16_t nTodCapacity = TOD_TABLE_SIZE, RDMBus *pRDMBus = 0);
 	~RDMDiscovery(void);
 
 	void SetUid(const uint8_t *);
 	const char *GetUid(void);
 
+	void Start(bool bIncremental = false);
+	void Stop(void);
+
+	/**
+	 * @return false when the discovery has finished
+	 */
+	bool Run(void);
+
+	inline bool IsRunning(void) const {
+		return m_tState != RDM_DISCOVERY_STATE_IDLE;
+	}
+
+	/**
+	 * While false, the discovery owns the line: its next Run sends, or the
+	 * response window is open. The DMX output has to be stopped.
+	 */
+	bool IsLineFree(void) const;
+
+	/**
+	 * Give the line back for nYieldMicros after nTransactions requests.
+	 * With nTransactions 0 the line is kept until the discovery finishes.
+	 */
+	void SetSlice(uint8_t nTransactions, uint32_t nYieldMicros);
+
+	/// Blocking, as before the state machine
 	void Full(void);
 
 private:
-	bool FindDevices(uint64_t, uint64_t);
-	bool QuickFind(const uint8_t *);
+	void Push(uint64_t nLower, uint64_t nUpper);
+	bool Yield(void);
+	void Send(RDMMessage *pMessage, TRdmDiscoveryState tWaitState);
+	void SendMute(const uint8_t *, TRdmDiscoveryState tWaitState);
+	void SendBranch(void);
+	void Split(void);
+	bool IsTimeOut(void);
+	bool IsMuteResponse(const uint8_t *pResponse, const uint8_t *pUid);
 
 	bool IsValidDiscoveryResponse(const uint8_t *, uint8_t *);
 
@@ -60,6 +127,24 @@ private:
 	RDMMessage m_UnMute;
 	RDMMessage m_Mute;
 	RDMMessage m_DiscUniqueBranch;
+	RDMBus *m_pRDMBus;
+	bool m_bOwnRDMBus;
+	TRdmDiscoveryState m_tState;
+	TRdmDiscoveryState m_tStateAfterYield;
+	bool m_bIncremental;
+	bool m_bBlocking;
+	uint8_t m_nUnMuteCount;
+	uint16_t m_nKnownIndex;
+	uint8_t m_aMuteUid[RDM_UID_SIZE];
+	uint64_t m_nLower;
+	uint64_t m_nUpper;
+	uint64_t m_aStackLower[RDM_DISCOVERY_STACK_SIZE];
+	uint64_t m_aStackUpper[RDM_DISCOVERY_STACK_SIZE];
+	uint8_t m_nStackDepth;
+	uint32_t m_nTimeStart;
+	uint8_t m_nSliceTransactions;
+	uint8_t m_nSliceCount;
+	uint32_t m_nSliceYield;
 };
 
 #endif /* RDMDISCOVERY_H_ */
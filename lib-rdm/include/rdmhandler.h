@@ -48,6 +48,7 @@ public:
 
 private:
 	void Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nParamId, uint8_t nParamDataLength, uint16_t nSubDevice);
+	void HandlersExtra(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nParamId, uint8_t nParamDataLength, uint16_t nSubDevice);
 
 	typedef struct {
 		const uint16_t pid;
@@ -57,8 +58,11 @@ private:
 		const bool bIncludeInSupportedParams;
 	} pid_definition;
 
+	// constexpr, ascending on pid (checked at compile time)
 	static const pid_definition PID_DEFINITIONS[];
 	static const pid_definition PID_DEFINITIONS_SUB_DEVICES[];
+	static const uint16_t PID_DEFINITIONS_COUNT;
+	static const uint16_t PID_DEFINITIONS_SUB_DEVICES_COUNT;
 
 	// Get
 	void GetQueuedMessage(uint16_t nSubDevice);
@@ -28,6 +28,8 @@
 
 #include "rdm.h"
 
+class RDMBus;
+
 class RDMMessage: public Rdm {
 public:
 	RDMMessage(void);
@@ -44,6 +46,7 @@ public:
 	void SetPd(const uint8_t *, const uint8_t);
 
 	void Send(void);
+	void Send(RDMBus *);
 
 public:
 	static void Print(const uint8_t *);
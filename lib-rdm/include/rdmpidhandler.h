@@ -0,0 +1,89 @@
+/**
+ * @file rdmpidhandler.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RDMPIDHANDLER_H_
+#define RDMPIDHANDLER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * A PID table entry has a member pid. The tables are kept ascending on pid,
+ * so that the dispatch is a binary search.
+ */
+template<typename T>
+constexpr bool rdm_pid_table_is_sorted(const T *pTable, uint16_t nCount) {
+	return (nCount < 2) || ((pTable[0].pid < pTable[1].pid) && rdm_pid_table_is_sorted(pTable + 1, nCount - 1));
+}
+
+template<typename T>
+const T *rdm_pid_table_find(const T *pTable, uint16_t nCount, uint16_t nPid) {
+	uint16_t nLow = 0;
+	uint16_t nHigh = nCount;
+
+	while (nLow < nHigh) {
+		const uint16_t nMiddle = (nLow + nHigh) / 2;
+
+		if (pTable[nMiddle].pid < nPid) {
+			nLow = nMiddle + 1;
+		} else {
+			nHigh = nMiddle;
+		}
+	}
+
+	if ((nLow < nCount) && (pTable[nLow].pid == nPid)) {
+		return &pTable[nLow];
+	}
+
+	return 0;
+}
+
+struct TRDMPid {
+	uint16_t pid;
+	uint8_t nGetArgumentSize;
+	bool bHasGet;
+	bool bHasSet;
+	bool bIncludeInSupportedParams;
+};
+
+/**
+ * Extra PIDs (manufacturer specific), registered with
+ * RDMDeviceResponder::SetPidHandler. The RDMHandler does the checks
+ * (command class, broadcast GET, argument size) before calling.
+ */
+class RDMPidHandler {
+public:
+	virtual ~RDMPidHandler(void) {
+	}
+
+	/**
+	 * @param pParamDataOut Room for 231 bytes
+	 * @return false for a NACK with nReason
+	 */
+	virtual bool Get(uint16_t nPid, uint16_t nSubDevice, const uint8_t *pParamData, uint8_t nParamDataLength, uint8_t *pParamDataOut, uint8_t &nParamDataOutLength, uint16_t &nReason)=0;
+	virtual bool Set(uint16_t nPid, bool bIsBroadcast, uint16_t nSubDevice, const uint8_t *pParamData, uint8_t nParamDataLength, uint16_t &nReason)=0;
+};
+
+#endif /* RDMPIDHANDLER_H_ */
@@ -31,31 +31,51 @@
 
 #include "rdm.h"
 
-#define TOD_TABLE_SIZE	200
-
-struct TRdmTod {
-	uint8_t uid[RDM_UID_SIZE];
-};
+#define TOD_TABLE_SIZE	200	///< Default capacity
 
+/**
+ * The Table of Devices, kept sorted on the 48-bit UID.
+ * Lookups are a binary search; adding and deleting shift the tail with a single memmove.
+ */
 class RDMTod {
 public:
-	 RDMTod(void);
+	 RDMTod(uint16_t nCapacity = TOD_TABLE_SIZE);
 	 ~RDMTod(void);
 
 	 void Reset(void);
 	 bool AddUid(const uint8_t *);
-	 const uint8_t GetUidCount(void);
+	 const uint16_t GetUidCount(void);
+
+	 uint16_t GetCapacity(void) const {
+		 return m_nCapacity;
+	 }
+
+	 /**
+	  * Copies all the UIDs, in ascending order, as RDM_UID_SIZE bytes each.
+	  */
 	 void Copy(uint8_t *);
 
+	 /**
+	  * Copies at most nCount UIDs, starting at UID number nOffset.
+	  * @return The number of UIDs copied
+	  */
+	 uint16_t Copy(uint8_t *, uint16_t nOffset, uint16_t nCount);
+
 	 bool Delete(const uint8_t *);
 	 bool Exist(const uint8_t *);
 
 	 void Dump(void);
-	 void Dump(uint8_t);
+	 void Dump(uint16_t);
+
 private:
-	 uint8_t m_entries;
-	 TRdmTod *m_pTable;
-};
+	 static uint64_t ToKey(const uint8_t *);
+	 static void FromKey(uint64_t, uint8_t *);
+	 bool Find(uint64_t nKey, uint16_t &nIndex);
 
+private:
+	 uint16_t m_nCapacity;
+	 uint16_t m_entries;
+	 uint64_t *m_pTable;	///< The UIDs as 48-bit numbers, ascending
+};
 
 #endif /* RDMTOD_H_ */
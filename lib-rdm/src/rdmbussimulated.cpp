@@ -0,0 +1,224 @@
+/**
+ * @file rdmbussimulated.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#elif defined(__circle__)
+ #include "circle/util.h"
+#else
+ #include <string.h>
+#endif
+
+#include "rdmbussimulated.h"
+
+#include "rdm.h"
+#include "rdm_e120.h"
+
+#define BYTE_MICROS				44	///< 250 kbit/s, 11 bits
+#define DISCOVERY_RESPONSE_SIZE	24	///< 7 x 0xFE, 0xAA, 12 encoded UID, 4 encoded checksum
+
+RDMBusSimulated::RDMBusSimulated(uint16_t nMaxResponders):
+	m_nMaxResponders(nMaxResponders),
+	m_nResponders(0),
+	m_pResponders(0),
+	m_nMicros(0),
+	m_bIsResponsePending(false),
+	m_nResponseMicros(0),
+	m_nRequests(0),
+	m_nCollisions(0)
+{
+	m_pResponders = new struct TResponder[nMaxResponders];
+	assert(m_pResponders != 0);
+}
+
+RDMBusSimulated::~RDMBusSimulated(void) {
+	delete[] m_pResponders;
+	m_pResponders = 0;
+}
+
+uint64_t RDMBusSimulated::ToUid(const uint8_t *pUid) {
+	uint64_t nUid = 0;
+
+	for (unsigned i = 0; i < RDM_UID_SIZE; i++) {
+		nUid = (nUid << 8) | pUid[i];
+	}
+
+	return nUid;
+}
+
+bool RDMBusSimulated::AddResponder(const uint8_t *pUid) {
+	if (m_nResponders == m_nMaxResponders) {
+		return false;
+	}
+
+	m_pResponders[m_nResponders].nUid = ToUid(pUid);
+	m_pResponders[m_nResponders].bIsMuted = false;
+	m_nResponders++;
+
+	return true;
+}
+
+bool RDMBusSimulated::RemoveResponder(const uint8_t *pUid) {
+	const uint64_t nUid = ToUid(pUid);
+
+	for (unsigned i = 0; i < m_nResponders; i++) {
+		if (m_pResponders[i].nUid == nUid) {
+			m_nResponders--;
+			m_pResponders[i] = m_pResponders[m_nResponders];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void RDMBusSimulated::Send(struct TRdmMessage *pRdmMessage) {
+	assert(pRdmMessage != 0);
+
+	m_nRequests++;
+	m_nMicros += RDM_TRANSMIT_BREAK_TIME + RDM_TRANSMIT_MAB_TIME + (pRdmMessage->message_length + RDM_MESSAGE_CHECKSUM_SIZE) * BYTE_MICROS;
+
+	// An unanswered response is lost
+	m_bIsResponsePending = false;
+
+	if (pRdmMessage->command_class != E120_DISCOVERY_COMMAND) {
+		return;
+	}
+
+	const uint16_t nPid = ((uint16_t) pRdmMessage->param_id[0] << 8) | pRdmMessage->param_id[1];
+	const uint64_t nDestination = ToUid(pRdmMessage->destination_uid);
+	const bool bIsBroadcast = (nDestination == ToUid(UID_ALL));
+
+	if (nPid == E120_DISC_UNIQUE_BRANCH) {
+		RespondDiscovery(ToUid(&pRdmMessage->param_data[0]), ToUid(&pRdmMessage->param_data[RDM_UID_SIZE]));
+		return;
+	}
+
+	if ((nPid != E120_DISC_MUTE) && (nPid != E120_DISC_UN_MUTE)) {
+		return;
+	}
+
+	for (unsigned i = 0; i < m_nResponders; i++) {
+		if (bIsBroadcast || (m_pResponders[i].nUid == nDestination)) {
+			m_pResponders[i].bIsMuted = (nPid == E120_DISC_MUTE);
+
+			// No response to a broadcast
+			if (!bIsBroadcast) {
+				Respond(&m_pResponders[i]);
+			}
+		}
+	}
+}
+
+void RDMBusSimulated::Respond(const struct TResponder *pResponder) {
+	struct TRdmMessage *pResponse = (struct TRdmMessage *) m_aResponse;
+
+	memset(m_aResponse, 0, sizeof(m_aResponse));
+
+	pResponse->start_code = E120_SC_RDM;
+	pResponse->sub_start_code = E120_SC_SUB_MESSAGE;
+	pResponse->message_length = RDM_MESSAGE_MINIMUM_SIZE + 2;
+
+	for (unsigned i = 0; i < RDM_UID_SIZE; i++) {
+		pResponse->source_uid[i] = (uint8_t) (pResponder->nUid >> (8 * (RDM_UID_SIZE - 1 - i)));
+	}
+
+	pResponse->command_class = E120_DISCOVERY_COMMAND_RESPONSE;
+	pResponse->param_data_length = 2;	// Control field
+
+	m_bIsResponsePending = true;
+	m_nResponseMicros = m_nMicros + RDM_RESPONDER_PACKET_SPACING + RDM_TRANSMIT_BREAK_TIME + RDM_TRANSMIT_MAB_TIME + (pResponse->message_length + RDM_MESSAGE_CHECKSUM_SIZE) * BYTE_MICROS;
+}
+
+void RDMBusSimulated::RespondDiscovery(uint64_t nLower, uint64_t nUpper) {
+	unsigned nResponding = 0;
+
+	for (unsigned i = 0; i < DISCOVERY_RESPONSE_SIZE; i++) {
+		m_aResponse[i] = 0xFF;
+	}
+
+	for (unsigned i = 0; i < m_nResponders; i++) {
+		const struct TResponder *pResponder = &m_pResponders[i];
+
+		if (pResponder->bIsMuted || (pResponder->nUid < nLower) || (pResponder->nUid > nUpper)) {
+			continue;
+		}
+
+		uint8_t aEncoded[DISCOVERY_RESPONSE_SIZE];
+		uint16_t nChecksum = 0;
+
+		for (unsigned j = 0; j < 7; j++) {
+			aEncoded[j] = 0xFE;
+		}
+
+		aEncoded[7] = 0xAA;
+
+		for (unsigned j = 0; j < RDM_UID_SIZE; j++) {
+			const uint8_t nByte = (uint8_t) (pResponder->nUid >> (8 * (RDM_UID_SIZE - 1 - j)));
+			aEncoded[8 + 2 * j] = nByte | 0xAA;
+			aEncoded[9 + 2 * j] = nByte | 0x55;
+		}
+
+		for (unsigned j = 8; j < 20; j++) {
+			nChecksum += aEncoded[j];
+		}
+
+		aEncoded[20] = (uint8_t) (nChecksum >> 8) | 0xAA;
+		aEncoded[21] = (uint8_t) (nChecksum >> 8) | 0x55;
+		aEncoded[22] = (uint8_t) nChecksum | 0xAA;
+		aEncoded[23] = (uint8_t) nChecksum | 0x55;
+
+		// Open collector like: the dominant (low) bits win
+		for (unsigned j = 0; j < DISCOVERY_RESPONSE_SIZE; j++) {
+			m_aResponse[j] &= aEncoded[j];
+		}
+
+		nResponding++;
+	}
+
+	if (nResponding == 0) {
+		return;
+	}
+
+	if (nResponding > 1) {
+		m_nCollisions++;
+	}
+
+	m_bIsResponsePending = true;
+	m_nResponseMicros = m_nMicros + RDM_RESPONDER_PACKET_SPACING + DISCOVERY_RESPONSE_SIZE * BYTE_MICROS;
+}
+
+const uint8_t *RDMBusSimulated::Receive(void) {
+	if (m_bIsResponsePending && ((int32_t) (m_nMicros - m_nResponseMicros) >= 0)) {
+		m_bIsResponsePending = false;
+		return m_aResponse;
+	}
+
+	return 0;
+}
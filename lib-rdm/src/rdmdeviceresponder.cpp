@@ -67,6 +67,9 @@ RDMDeviceResponder::RDMDeviceResponder(RDMPersonality *pRDMPersonality, LightSet
 		m_pRDMPersonality(pRDMPersonality),
 		m_pLightSet(pLightSet),
 		m_IsSubDevicesEnabled(EnableSubDevices),
+		m_pRDMPidHandler(0),
+		m_pPids(0),
+		m_nPidsCount(0),
 		m_IsFactoryDefaults(true),
 		m_nCheckSum(0),
 		m_nDmxStartAddressFactoryDefault(DMX_DEFAULT_START_ADDRESS),
@@ -204,6 +207,24 @@ uint16_t RDMDeviceResponder::GetSubDeviceCount(void) {
 	return (m_tRDMDeviceInfo.sub_device_count[0] << 8) + m_tRDMDeviceInfo.sub_device_count[1];
 }
 
+/**
+ * The table is not copied. A constexpr table can be checked at compile time
+ * with rdm_pid_table_is_sorted.
+ */
+bool RDMDeviceResponder::SetPidHandler(RDMPidHandler *pRDMPidHandler, const struct TRDMPid *pPids, uint16_t nPidsCount) {
+	for (uint16_t i = 1; i < nPidsCount; i++) {
+		if (pPids[i - 1].pid >= pPids[i].pid) {
+			return false;
+		}
+	}
+
+	m_pRDMPidHandler = pRDMPidHandler;
+	m_pPids = pPids;
+	m_nPidsCount = (pRDMPidHandler == 0) ? 0 : nPidsCount;
+
+	return true;
+}
+
 uint8_t RDMDeviceResponder::GetSensorCount(uint16_t nSubDevice) {
 	return m_tRDMDeviceInfo.sensor_count;
 }
@@ -1,44 +1,33 @@
-#if defined (BARE_METAL)
 /**
  * @file rdmddiscovery.cpp
  *
  */
-/* Copyright (C) 2017-2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy
- * of this software and associated documentation files (the "Software"), to deal
- * in the Software without restriction, including without limitation the rights
- * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- * copies of the Software, and to permit persons to whom the Software is
- * furnished to do so, subject to the following conditions:
-
- * The above copyright notice and this permission notice shall be included in
- * all copies or substantial portions of the Software.
-
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- * THE SOFTWARE.
- */
 
 #include <stdint.h>
 #include <stdbool.h>
 #ifndef NDEBUG
-#include <stdio.h>
+ #include <stdio.h>
+#endif
+#include <assert.h>
+
+#if defined (BARE_METAL)
+ #include "util.h"
+#elif defined(__circle__)
+ #include "circle/util.h"
+#else
+ #include <string.h>
 #endif
 
 #include "rdm.h"
 #include "rdm_e120.h"
 #include "rdmdiscovery.h"
+#include "rdmbus.h"
 
-extern "C" {
- void udelay(uint32_t us);
-}
+#if defined (BARE_METAL)
+ #include "rdmbusdmx.h"
+#endif
 
-#include "util.h"
+#define UID_MAX		0xfffffffffffe	///< 0xffffffffffff is the broadcast UID
 
 static uint8_t pdl[2][RDM_UID_SIZE];
 
@@ -49,7 +38,31 @@ typedef union cast {
 
 static _cast uuid_cast;
 
-RDMDiscovery::RDMDiscovery(void) {
+RDMDiscovery::RDMDiscovery(uint16_t nTodCapacity, RDMBus *pRDMBus) : RDMTod(nTodCapacity),
+	m_pRDMBus(pRDMBus),
+	m_bOwnRDMBus(false),
+	m_tState(RDM_DISCOVERY_STATE_IDLE),
+	m_tStateAfterYield(RDM_DISCOVERY_STATE_IDLE),
+	m_bIncremental(false),
+	m_bBlocking(false),
+	m_nUnMuteCount(0),
+	m_nKnownIndex(0),
+	m_nLower(0),
+	m_nUpper(0),
+	m_nStackDepth(0),
+	m_nTimeStart(0),
+	m_nSliceTransactions(RDM_DISCOVERY_SLICE_TRANSACTIONS),
+	m_nSliceCount(0),
+	m_nSliceYield(RDM_DISCOVERY_SLICE_YIELD)
+{
+#if defined (BARE_METAL)
+	if (m_pRDMBus == 0) {
+		m_pRDMBus = new RDMBusDmx;
+		m_bOwnRDMBus = true;
+	}
+#endif
+	assert(m_pRDMBus != 0);
+
 	m_UnMute.SetDstUid(UID_ALL);
 	m_UnMute.SetCc(E120_DISCOVERY_COMMAND);
 	m_UnMute.SetPid(E120_DISC_UN_MUTE);
@@ -63,6 +76,10 @@ RDMDiscovery::RDMDiscovery(void) {
 }
 
 RDMDiscovery::~RDMDiscovery(void) {
+	if (m_bOwnRDMBus) {
+		delete m_pRDMBus;
+	}
+	m_pRDMBus = 0;
 }
 
 void RDMDiscovery::SetUid(const uint8_t *uid) {
@@ -77,92 +94,275 @@ const char *RDMDiscovery::GetUid(void) {
 	return (const char *) m_Uid;
 }
 
+void RDMDiscovery::SetSlice(uint8_t nTransactions, uint32_t nYieldMicros) {
+	m_nSliceTransactions = nTransactions;
+	m_nSliceYield = nYieldMicros;
+}
+
 void RDMDiscovery::Full(void) {
-	struct TRdmMessage *response;
+	m_bBlocking = true;
+
+	Start(false);
+
+	while (Run()) {
+	}
+
+	m_bBlocking = false;
+}
+
+void RDMDiscovery::Start(bool bIncremental) {
+#ifndef NDEBUG
+	printf("RDMDiscovery::Start(%s)\n", bIncremental ? "incremental" : "full");
+#endif
+
+	if (!bIncremental) {
+		Reset();
+	}
 
-	Reset();
+	m_bIncremental = bIncremental;
+	m_nUnMuteCount = 0;
+	m_nKnownIndex = 0;
+	m_nSliceCount = 0;
+	m_nStackDepth = 0;
 
-	m_UnMute.Send();
-	m_UnMute.ReceiveTimeOut(2800);
+	Push(0, UID_MAX);
 
-	udelay(100000);
+	m_tState = RDM_DISCOVERY_STATE_UNMUTE;
+}
 
-	m_UnMute.Send();
-	m_UnMute.ReceiveTimeOut(2800);
+void RDMDiscovery::Stop(void) {
+	m_tState = RDM_DISCOVERY_STATE_IDLE;
+}
 
-	udelay(100000);
+bool RDMDiscovery::IsLineFree(void) const {
+	return (m_tState == RDM_DISCOVERY_STATE_IDLE) || (m_tState == RDM_DISCOVERY_STATE_UNMUTE_SPACING) || (m_tState == RDM_DISCOVERY_STATE_YIELD);
+}
 
-	m_UnMute.Send();
-	response = (struct TRdmMessage *) m_Mute.ReceiveTimeOut(2800);
+void RDMDiscovery::Push(uint64_t nLower, uint64_t nUpper) {
+	assert(m_nStackDepth < RDM_DISCOVERY_STACK_SIZE);
 
-	if (response != NULL) {
-		FindDevices(ConvertUid((const uint8_t *)response->source_uid), ConvertUid((const uint8_t *)response->source_uid));
+	m_aStackLower[m_nStackDepth] = nLower;
+	m_aStackUpper[m_nStackDepth] = nUpper;
+	m_nStackDepth++;
+}
+
+/*
+ * The lower half is searched first
+ */
+void RDMDiscovery::Split(void) {
+	const uint64_t nMid = (m_nLower + m_nUpper) / 2;
+
+	Push(nMid + 1, m_nUpper);
+	Push(m_nLower, nMid);
+
+	m_tState = RDM_DISCOVERY_STATE_BRANCH;
+}
+
+/*
+ * Called before each request. Gives the line back when the slice is used up.
+ */
+bool RDMDiscovery::Yield(void) {
+	if (m_bBlocking || (m_nSliceTransactions == 0)) {
+		return false;
 	}
 
-	FindDevices(0x000000000000, 0xfffffffffffe);
+	if (m_nSliceCount < m_nSliceTransactions) {
+		m_nSliceCount++;
+		return false;
+	}
+
+	m_nSliceCount = 0;
+	m_tStateAfterYield = m_tState;
+	m_tState = RDM_DISCOVERY_STATE_YIELD;
+	m_nTimeStart = m_pRDMBus->Micros();
+
+	return true;
 }
 
-bool RDMDiscovery::FindDevices(uint64_t LowerBound, uint64_t UpperBound) {
-	struct TRdmMessage *response;
-	uint8_t uid[RDM_UID_SIZE];
-	bool bDeviceFound = false;
-	uint64_t MidPosition;
+void RDMDiscovery::Send(RDMMessage *pMessage, TRdmDiscoveryState tWaitState) {
+	while (m_pRDMBus->Receive() != 0) {
+		// Discard late responses
+	}
 
-#ifndef NDEBUG
-	printf("FindDevices : ");
-	PrintUid(LowerBound);
-	printf(" - ");
-	PrintUid(UpperBound);
-	printf("\n");
-#endif
+	pMessage->Send(m_pRDMBus);
 
-	if (LowerBound == UpperBound) {
-		memcpy(uid, ConvertUid(LowerBound), RDM_UID_SIZE);
+	m_nTimeStart = m_pRDMBus->Micros();
+	m_tState = tWaitState;
+}
 
-		m_Mute.SetDstUid(uid);
-		m_Mute.Send();
+void RDMDiscovery::SendMute(const uint8_t *pUid, TRdmDiscoveryState tWaitState) {
+	memcpy(m_aMuteUid, pUid, RDM_UID_SIZE);
 
-		response = (struct TRdmMessage *) m_Mute.ReceiveTimeOut(2800);
+	m_Mute.SetDstUid(pUid);
+	Send(&m_Mute, tWaitState);
+}
 
-		if (response != NULL) {
-			if ((response->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(uid, response->source_uid, RDM_UID_SIZE) == 0)) {
-				AddUid(uid);
-			}
-		} else {
-			return true;
+void RDMDiscovery::SendBranch(void) {
+	memcpy(pdl[0], ConvertUid(m_nLower), RDM_UID_SIZE);
+	memcpy(pdl[1], ConvertUid(m_nUpper), RDM_UID_SIZE);
+
+	m_DiscUniqueBranch.SetPd((const uint8_t *) pdl, 2 * RDM_UID_SIZE);
+	Send(&m_DiscUniqueBranch, RDM_DISCOVERY_STATE_BRANCH_WAIT);
+}
+
+bool RDMDiscovery::IsTimeOut(void) {
+	return (m_pRDMBus->Micros() - m_nTimeStart) >= RDM_DISCOVERY_RESPONSE_TIMEOUT;
+}
+
+bool RDMDiscovery::IsMuteResponse(const uint8_t *pResponse, const uint8_t *pUid) {
+	const struct TRdmMessage *p = (const struct TRdmMessage *) pResponse;
+
+	return (p->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(pUid, p->source_uid, RDM_UID_SIZE) == 0);
+}
+
+bool RDMDiscovery::Run(void) {
+	const uint8_t *pResponse;
+	uint8_t uid[RDM_UID_SIZE];
+
+	switch (m_tState) {
+	case RDM_DISCOVERY_STATE_IDLE:
+		return false;
+		break;
+	case RDM_DISCOVERY_STATE_UNMUTE:
+		if (Yield()) {
+			break;
 		}
-	} else {
-		memcpy(pdl[0], ConvertUid(LowerBound), RDM_UID_SIZE);
-		memcpy(pdl[1], ConvertUid(UpperBound), RDM_UID_SIZE);
 
-		m_DiscUniqueBranch.SetPd((const uint8_t *)pdl, 2* RDM_UID_SIZE);
-		m_DiscUniqueBranch.Send();
+		Send(&m_UnMute, RDM_DISCOVERY_STATE_UNMUTE_SPACING);
+		m_nUnMuteCount++;
+		break;
+	case RDM_DISCOVERY_STATE_UNMUTE_SPACING:
+		// A broadcast has no response, the line is free while waiting
+		if ((m_pRDMBus->Micros() - m_nTimeStart) < RDM_DISCOVERY_UNMUTE_SPACING) {
+			break;
+		}
 
-		response = (struct TRdmMessage *) m_DiscUniqueBranch.ReceiveTimeOut(2800);
+		if (m_nUnMuteCount < 2) {
+			m_tState = RDM_DISCOVERY_STATE_UNMUTE;
+		} else {
+			m_tState = m_bIncremental ? RDM_DISCOVERY_STATE_MUTE_KNOWN : RDM_DISCOVERY_STATE_BRANCH;
+		}
+		break;
+	case RDM_DISCOVERY_STATE_MUTE_KNOWN:
+		if (Copy(uid, m_nKnownIndex, 1) == 0) {
+			m_tState = RDM_DISCOVERY_STATE_BRANCH;
+			break;
+		}
 
-		if (response != NULL) {
-			bDeviceFound = true;
+		if (Yield()) {
+			break;
+		}
 
-			if (IsValidDiscoveryResponse((const uint8_t *)response, uid)) {
-				bDeviceFound = QuickFind(uid);
+		SendMute(uid, RDM_DISCOVERY_STATE_MUTE_KNOWN_WAIT);
+		break;
+	case RDM_DISCOVERY_STATE_MUTE_KNOWN_WAIT:
+		if ((pResponse = m_pRDMBus->Receive()) != 0) {
+			if (IsMuteResponse(pResponse, m_aMuteUid)) {
+				m_nKnownIndex++;
+			} else {
+				Delete(m_aMuteUid);
 			}
+			m_tState = RDM_DISCOVERY_STATE_MUTE_KNOWN;
+		} else if (IsTimeOut()) {
+#ifndef NDEBUG
+			printf("Lost : ");
+			PrintUid(m_aMuteUid);
+			printf("\n");
+#endif
+			Delete(m_aMuteUid);
+			m_tState = RDM_DISCOVERY_STATE_MUTE_KNOWN;
+		}
+		break;
+	case RDM_DISCOVERY_STATE_BRANCH:
+		if (m_nStackDepth == 0) {
+			m_tState = RDM_DISCOVERY_STATE_IDLE;
+#ifndef NDEBUG
+			printf("RDMDiscovery done, %d device(s)\n", (int) GetUidCount());
+#endif
+			return false;
+		}
+
+		if (Yield()) {
+			break;
+		}
 
-			if (bDeviceFound) {
-				MidPosition = ((LowerBound & (0x0000800000000000 - 1)) + (UpperBound & (0x0000800000000000 - 1))) / 2
-						+ (UpperBound & (0x0000800000000000) ? 0x0000400000000000 : 0 )
-						+ (LowerBound & (0x0000800000000000) ? 0x0000400000000000 : 0 );
+		m_nStackDepth--;
+		m_nLower = m_aStackLower[m_nStackDepth];
+		m_nUpper = m_aStackUpper[m_nStackDepth];
 
-				bDeviceFound = FindDevices(LowerBound, MidPosition);
-				bDeviceFound |= FindDevices(MidPosition + 1, UpperBound);
+#ifndef NDEBUG
+		printf("FindDevices : ");
+		PrintUid(m_nLower);
+		printf(" - ");
+		PrintUid(m_nUpper);
+		printf("\n");
+#endif
 
-				if (bDeviceFound) {
-					return true;
+		if (m_nLower == m_nUpper) {
+			SendMute(ConvertUid(m_nLower), RDM_DISCOVERY_STATE_MUTE_WAIT);
+		} else {
+			SendBranch();
+		}
+		break;
+	case RDM_DISCOVERY_STATE_BRANCH_WAIT:
+		if ((pResponse = m_pRDMBus->Receive()) != 0) {
+			if (IsValidDiscoveryResponse(pResponse, uid)) {
+#ifndef NDEBUG
+				printf("QuickFind : ");
+				PrintUid(uid);
+				printf("\n");
+#endif
+				// Mute it and ask the same range again
+				SendMute(uid, RDM_DISCOVERY_STATE_QUICKFIND_MUTE_WAIT);
+			} else {
+				// A collision
+				Split();
+			}
+		} else if (IsTimeOut()) {
+			// Nothing (left) in this range
+			m_tState = RDM_DISCOVERY_STATE_BRANCH;
+		}
+		break;
+	case RDM_DISCOVERY_STATE_MUTE_WAIT:
+		if ((pResponse = m_pRDMBus->Receive()) != 0) {
+			if (IsMuteResponse(pResponse, m_aMuteUid)) {
+				AddUid(m_aMuteUid);
+			}
+			m_tState = RDM_DISCOVERY_STATE_BRANCH;
+		} else if (IsTimeOut()) {
+			m_tState = RDM_DISCOVERY_STATE_BRANCH;
+		}
+		break;
+	case RDM_DISCOVERY_STATE_QUICKFIND_MUTE_WAIT:
+		if ((pResponse = m_pRDMBus->Receive()) != 0) {
+			if (IsMuteResponse(pResponse, m_aMuteUid)) {
+				AddUid(m_aMuteUid);
+
+				if (!Yield()) {
+					SendBranch();
+				} else {
+					m_tStateAfterYield = RDM_DISCOVERY_STATE_BRANCH;
+					Push(m_nLower, m_nUpper);
 				}
+			} else {
+				Split();
 			}
+		} else if (IsTimeOut()) {
+			// The checksum was valid by chance, the range has to be split
+			Split();
 		}
+		break;
+	case RDM_DISCOVERY_STATE_YIELD:
+		if ((m_pRDMBus->Micros() - m_nTimeStart) >= m_nSliceYield) {
+			m_tState = m_tStateAfterYield;
+		}
+		break;
+	default:
+		assert(0);
+		break;
 	}
 
-	return false;
+	return true;
 }
 
 const uint8_t *RDMDiscovery::ConvertUid(const uint64_t uid) {
@@ -225,40 +425,3 @@ bool RDMDiscovery::IsValidDiscoveryResponse(const uint8_t *response, uint8_t *ui
 
 	return bIsValid;
 }
-
-bool RDMDiscovery::QuickFind(const uint8_t *uid) {
-	uint8_t *response;
-	struct TRdmMessage *p;
-	uint8_t r_uid[RDM_UID_SIZE];
-
-#ifndef NDEBUG
-	printf("QuickFind : ");
-	PrintUid((uint8_t *)uid);
-	printf("\n");
-#endif
-
-	m_Mute.SetDstUid(uid);
-	m_Mute.Send();
-
-	response = (uint8_t *) m_Mute.ReceiveTimeOut(2800);
-
-	if (response != NULL) {
-		p = (struct TRdmMessage *) response;
-		if ((p->command_class == E120_DISCOVERY_COMMAND_RESPONSE) && (memcmp(uid, p->source_uid, RDM_UID_SIZE) == 0)) {
-			AddUid(uid);
-		}
-	}
-
-	m_DiscUniqueBranch.Send();
-
-	response = (uint8_t *) m_DiscUniqueBranch.ReceiveTimeOut(2800);
-
-	if ((response != NULL) && (IsValidDiscoveryResponse(response, r_uid))) {
-		QuickFind(r_uid);
-	} else {
-		return true;
-	}
-
-	return false;
-}
-#endif
@@ -45,6 +45,7 @@
 #endif
 
 #include "rdmhandler.h"
+#include "rdmpidhandler.h"
 
 #include "rdmidentify.h"
 #include "rdmsensor.h"
@@ -149,7 +150,7 @@ void RDMHandler::RespondMessageNack(uint16_t nReason) {
 	CreateRespondMessage(E120_RESPONSE_TYPE_NACK_REASON, nReason);
 }
 
-const RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS[] {
+constexpr RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS[] {
 	{E120_QUEUED_MESSAGE,              	&RDMHandler::GetQueuedMessage,           	0,                   				1, true },
 	{E120_SUPPORTED_PARAMETERS,        	&RDMHandler::GetSupportedParameters,      	0,             						0, false},
 	{E120_DEVICE_INFO,                	&RDMHandler::GetDeviceInfo,               	0,                					0, false},
@@ -179,7 +180,7 @@ const RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS[] {
 	{E137_1_IDENTIFY_MODE,			   	&RDMHandler::GetIdentifyMode,				&RDMHandler::SetIdentifyMode,		0, true }
 };
 
-const RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[] {
+constexpr RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[] {
 	{E120_SUPPORTED_PARAMETERS,        &RDMHandler::GetSupportedParameters,			0,                       			0, true },
 	{E120_DEVICE_INFO,                 &RDMHandler::GetDeviceInfo,					0,                        			0, true },
 	{E120_PRODUCT_DETAIL_ID_LIST, 	   &RDMHandler::GetProductDetailIdList,			0,						 			0, true },
@@ -190,7 +191,12 @@ const RDMHandler::pid_definition RDMHandler::PID_DEFINITIONS_SUB_DEVICES[] {
 	{E120_IDENTIFY_DEVICE,		       &RDMHandler::GetIdentifyDevice,		    	&RDMHandler::SetIdentifyDevice,		0, true }
 };
 
+constexpr uint16_t RDMHandler::PID_DEFINITIONS_COUNT = sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]);
+constexpr uint16_t RDMHandler::PID_DEFINITIONS_SUB_DEVICES_COUNT = sizeof(PID_DEFINITIONS_SUB_DEVICES) / sizeof(PID_DEFINITIONS_SUB_DEVICES[0]);
+
 RDMHandler::RDMHandler(RDMDeviceResponder *pRDMDeviceResponder): m_pRDMDeviceResponder(pRDMDeviceResponder), m_IsMuted(false), m_pRdmDataIn(0), m_pRdmDataOut(0) {
+	static_assert(rdm_pid_table_is_sorted(PID_DEFINITIONS, PID_DEFINITIONS_COUNT), "PID_DEFINITIONS must be ascending on pid");
+	static_assert(rdm_pid_table_is_sorted(PID_DEFINITIONS_SUB_DEVICES, PID_DEFINITIONS_SUB_DEVICES_COUNT), "PID_DEFINITIONS_SUB_DEVICES must be ascending on pid");
 }
 
 RDMHandler::~RDMHandler(void) {
@@ -336,8 +342,6 @@ void RDMHandler::HandleData(const uint8_t* pRdmDataIn, uint8_t *pRdmDataOut) {
 void RDMHandler::Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nParamId, uint8_t nParamDataLength, uint16_t nSubDevice) {
 	DEBUG1_ENTRY
 
-	pid_definition const *pid_handler = 0;
-
 	if (nCommandClass != E120_GET_COMMAND && nCommandClass != E120_SET_COMMAND) {
 		RespondMessageNack(E120_NR_UNSUPPORTED_COMMAND_CLASS);
 		return;
@@ -350,14 +354,10 @@ void RDMHandler::Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nPa
 		return;
 	}
 
-	uint8_t i;
-	for (i = 0; i < sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]); ++i) {
-		if (PID_DEFINITIONS[i].pid == nParamId)
-			pid_handler = &PID_DEFINITIONS[i];
-	}
+	const pid_definition *pid_handler = rdm_pid_table_find(PID_DEFINITIONS, PID_DEFINITIONS_COUNT, nParamId);
 
 	if (!pid_handler) {
-		RespondMessageNack(E120_NR_UNKNOWN_PID);
+		HandlersExtra(bIsBroadcast, nCommandClass, nParamId, nParamDataLength, nSubDevice);
 		DEBUG1_EXIT
 		return;
 	}
@@ -400,33 +400,89 @@ void RDMHandler::Handlers(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nPa
 	DEBUG1_EXIT
 }
 
+/**
+ * The PIDs registered with RDMDeviceResponder::SetPidHandler
+ */
+void RDMHandler::HandlersExtra(bool bIsBroadcast, uint8_t nCommandClass, uint16_t nParamId, uint8_t nParamDataLength, uint16_t nSubDevice) {
+	RDMPidHandler *pRDMPidHandler = m_pRDMDeviceResponder->GetPidHandler();
+	const struct TRDMPid *pPid = 0;
+
+	if (pRDMPidHandler != 0) {
+		pPid = rdm_pid_table_find(m_pRDMDeviceResponder->GetPids(), m_pRDMDeviceResponder->GetPidsCount(), nParamId);
+	}
+
+	if (pPid == 0) {
+		RespondMessageNack(E120_NR_UNKNOWN_PID);
+		return;
+	}
+
+	const struct TRdmMessageNoSc *pRdmDataIn = (struct TRdmMessageNoSc *) m_pRdmDataIn;
+	struct TRdmMessage *pRdmDataOut = (struct TRdmMessage *) m_pRdmDataOut;
+	uint16_t nReason = E120_NR_HARDWARE_FAULT;
+
+	if (nCommandClass == E120_GET_COMMAND) {
+		if (bIsBroadcast) {
+			return;
+		}
+
+		if (nSubDevice == E120_SUB_DEVICE_ALL_CALL) {
+			RespondMessageNack(E120_NR_SUB_DEVICE_OUT_OF_RANGE);
+			return;
+		}
+
+		if (!pPid->bHasGet) {
+			RespondMessageNack(E120_NR_UNSUPPORTED_COMMAND_CLASS);
+			return;
+		}
+
+		if (nParamDataLength != pPid->nGetArgumentSize) {
+			RespondMessageNack(E120_NR_FORMAT_ERROR);
+			return;
+		}
+
+		uint8_t nLength = 0;
+
+		if (pRDMPidHandler->Get(nParamId, nSubDevice, pRdmDataIn->param_data, nParamDataLength, pRdmDataOut->param_data, nLength, nReason)) {
+			pRdmDataOut->param_data_length = nLength;
+			RespondMessageAck();
+		} else {
+			RespondMessageNack(nReason);
+		}
+	} else {
+		if (!pPid->bHasSet) {
+			RespondMessageNack(E120_NR_UNSUPPORTED_COMMAND_CLASS);
+			return;
+		}
+
+		if (pRDMPidHandler->Set(nParamId, bIsBroadcast, nSubDevice, pRdmDataIn->param_data, nParamDataLength, nReason)) {
+			pRdmDataOut->param_data_length = 0;
+			RespondMessageAck();
+		} else {
+			RespondMessageNack(nReason);
+		}
+	}
+}
+
 void RDMHandler::GetQueuedMessage(/*@unused@*/uint16_t nSubDevice) {
 	m_RDMQueuedMessage.Handler(m_pRdmDataOut);
 	RespondMessageAck();
 }
 
 void RDMHandler::GetSupportedParameters(uint16_t nSubDevice) {
-	uint8_t nSupportedParams = 0;
 	pid_definition *pPidDefinitions;
 	int nTableSize = 0;
 	int i,j;
 
 	if (nSubDevice != 0) {
 		pPidDefinitions = (pid_definition *)&PID_DEFINITIONS_SUB_DEVICES[0];
-		nTableSize = (int) (sizeof(PID_DEFINITIONS_SUB_DEVICES) / sizeof(PID_DEFINITIONS_SUB_DEVICES[0]));
+		nTableSize = (int) PID_DEFINITIONS_SUB_DEVICES_COUNT;
 	} else {
 		pPidDefinitions = (pid_definition *)&PID_DEFINITIONS[0];
-		nTableSize = (int) (sizeof(PID_DEFINITIONS) / sizeof(PID_DEFINITIONS[0]));
-	}
-
-	for (i = 0; i < nTableSize; i++) {
-		if (pPidDefinitions[i].bIncludeInSupportedParams)
-			nSupportedParams++;
+		nTableSize = (int) PID_DEFINITIONS_COUNT;
 	}
 
 	struct TRdmMessage *pRdmDataOut = (struct TRdmMessage *)m_pRdmDataOut;
-
-	pRdmDataOut->param_data_length = (2 * nSupportedParams);
+	const int nMaxParams = (int) (sizeof(pRdmDataOut->param_data) / 2);
 
 	j = 0;
 	for (i = 0;	i < nTableSize; i++)
@@ -439,6 +495,22 @@ void RDMHandler::GetSupportedParameters(uint16_t nSubDevice) {
 		}
 	}
 
+	// The extra PIDs are for the root device only
+	if ((nSubDevice == 0) && (m_pRDMDeviceResponder->GetPidHandler() != 0)) {
+		const struct TRDMPid *pPids = m_pRDMDeviceResponder->GetPids();
+		const int nPidsCount = (int) m_pRDMDeviceResponder->GetPidsCount();
+
+		for (i = 0; (i < nPidsCount) && (j < nMaxParams); i++) {
+			if (pPids[i].bIncludeInSupportedParams) {
+				pRdmDataOut->param_data[j+j] = (uint8_t)(pPids[i].pid >> 8);
+				pRdmDataOut->param_data[j+j+1] = (uint8_t)pPids[i].pid;
+				j++;
+			}
+		}
+	}
+
+	pRdmDataOut->param_data_length = (uint8_t) (2 * j);
+
 	RespondMessageAck();
 }
 
@@ -40,6 +40,7 @@
 #endif
 
 #include "rdmmessage.h"
+#include "rdmbus.h"
 
 #include "rdm.h"
 #include "rdm_e120.h"
@@ -98,3 +99,7 @@ void RDMMessage::Send(void) {
 	Rdm::Send(m_pRdmCommand);
 }
 
+void RDMMessage::Send(RDMBus *pRDMBus) {
+	pRDMBus->Send(m_pRdmCommand);
+}
+
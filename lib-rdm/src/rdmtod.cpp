@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <assert.h>
 #ifndef NDEBUG
  #include <stdio.h>
 #endif
@@ -43,12 +44,11 @@
  #define ALIGNED __attribute__ ((aligned (4)))
 #endif
 
-RDMTod::RDMTod(void) : m_entries(0) {
-	m_pTable = new TRdmTod[TOD_TABLE_SIZE];
+RDMTod::RDMTod(uint16_t nCapacity) : m_nCapacity(nCapacity), m_entries(0) {
+	assert(nCapacity != 0);
 
-	for (unsigned i = 0 ; i < TOD_TABLE_SIZE; i++) {
-		memcpy(&m_pTable[i], UID_ALL, RDM_UID_SIZE);
-	}
+	m_pTable = new uint64_t[nCapacity];
+	assert(m_pTable != 0);
 }
 
 RDMTod::~RDMTod(void) {
@@ -56,30 +56,65 @@ RDMTod::~RDMTod(void) {
 	delete[] m_pTable;
 }
 
-const uint8_t RDMTod::GetUidCount(void) {
-	return m_entries;
+uint64_t RDMTod::ToKey(const uint8_t *uid) {
+	uint64_t nKey = 0;
+
+	for (unsigned i = 0; i < RDM_UID_SIZE; i++) {
+		nKey = (nKey << 8) | uid[i];
+	}
+
+	return nKey;
 }
 
-bool RDMTod::Exist(const uint8_t *uid) {
-	unsigned i;
+void RDMTod::FromKey(uint64_t nKey, uint8_t *uid) {
+	for (int i = RDM_UID_SIZE - 1; i >= 0; i--) {
+		uid[i] = (uint8_t) nKey;
+		nKey >>= 8;
+	}
+}
 
-	for (i = 0 ; i < m_entries; i++) {
-		if (memcmp(&m_pTable[i], uid, RDM_UID_SIZE) == 0) {
-			return true;
+/**
+ * @param nIndex Set to the position of the key, or to where it has to be inserted
+ */
+bool RDMTod::Find(uint64_t nKey, uint16_t &nIndex) {
+	unsigned nLow = 0;
+	unsigned nHigh = m_entries;
+
+	while (nLow < nHigh) {
+		const unsigned nMiddle = (nLow + nHigh) / 2;
+
+		if (m_pTable[nMiddle] < nKey) {
+			nLow = nMiddle + 1;
+		} else {
+			nHigh = nMiddle;
 		}
 	}
 
-	return false;
+	nIndex = (uint16_t) nLow;
+
+	return (nLow < m_entries) && (m_pTable[nLow] == nKey);
 }
 
-void RDMTod::Dump(uint8_t count) {
+const uint16_t RDMTod::GetUidCount(void) {
+	return m_entries;
+}
+
+bool RDMTod::Exist(const uint8_t *uid) {
+	uint16_t nIndex;
+
+	return Find(ToKey(uid), nIndex);
+}
+
+void RDMTod::Dump(uint16_t count) {
 #ifndef NDEBUG
-	if (count > TOD_TABLE_SIZE) {
-		count = TOD_TABLE_SIZE;
+	if (count > m_entries) {
+		count = m_entries;
 	}
 
 	for (unsigned i = 0 ; i < count; i++) {
-		printf("%.2x%.2x:%.2x%.2x%.2x%.2x\n", m_pTable[i].uid[0], m_pTable[i].uid[1], m_pTable[i].uid[2], m_pTable[i].uid[3], m_pTable[i].uid[4], m_pTable[i].uid[5]);
+		uint8_t uid[RDM_UID_SIZE];
+		FromKey(m_pTable[i], uid);
+		printf("%.2x%.2x:%.2x%.2x%.2x%.2x\n", uid[0], uid[1], uid[2], uid[3], uid[4], uid[5]);
 	}
 #endif
 }
@@ -91,59 +126,60 @@ void RDMTod::Dump(void) {
 }
 
 bool RDMTod::AddUid(const uint8_t *uid) {
-	if (m_entries == TOD_TABLE_SIZE) {
+	if (m_entries == m_nCapacity) {
 		return false;
 	}
 
-	if (Exist(uid)) {
+	const uint64_t nKey = ToKey(uid);
+	uint16_t nIndex;
+
+	if (Find(nKey, nIndex)) {
 		return false;
 	}
 
-	memcpy(&m_pTable[m_entries++], uid, RDM_UID_SIZE);
+	memmove(&m_pTable[nIndex + 1], &m_pTable[nIndex], (m_entries - nIndex) * sizeof(uint64_t));
+	m_pTable[nIndex] = nKey;
+	m_entries++;
 
 	return true;
 }
 
 bool RDMTod::Delete(const uint8_t *uid) {
-	bool found = false;
-	unsigned i;
-
-	for (i = 0 ; i < m_entries; i++) {
-		if (memcmp(&m_pTable[i], uid, RDM_UID_SIZE) == 0) {
-			found = true;
-			break;
-		}
-	}
+	uint16_t nIndex;
 
-	if (!found) {
+	if (!Find(ToKey(uid), nIndex)) {
 		return false;
 	}
 
-	if (i == TOD_TABLE_SIZE - 1) {
-		memcpy(&m_pTable[i], UID_ALL, RDM_UID_SIZE);
-	} else {
-		for (; i < m_entries; i++) {
-			memcpy(&m_pTable[i], &m_pTable[i + 1], RDM_UID_SIZE);
-		}
-	}
-
 	m_entries--;
+	memmove(&m_pTable[nIndex], &m_pTable[nIndex + 1], (m_entries - nIndex) * sizeof(uint64_t));
 
 	return true;
 }
 
 void RDMTod::Copy(uint8_t *table) {
-	uint8_t *src = (uint8_t *) m_pTable;
-	uint8_t *dst = (uint8_t *) table;
-	for (unsigned i = 0; i < (m_entries * RDM_UID_SIZE); i++) {
-		*dst++ = *src++;
-	}
+	(void) Copy(table, 0, m_entries);
 }
 
-void RDMTod::Reset(void) {
-	for (unsigned i = 0 ; i < m_entries; i++) {
-		memcpy(&m_pTable[i], UID_ALL, RDM_UID_SIZE);
+uint16_t RDMTod::Copy(uint8_t *table, uint16_t nOffset, uint16_t nCount) {
+	assert(table != 0);
+
+	if (nOffset >= m_entries) {
+		return 0;
 	}
 
+	if (nCount > (m_entries - nOffset)) {
+		nCount = m_entries - nOffset;
+	}
+
+	for (unsigned i = 0; i < nCount; i++) {
+		FromKey(m_pTable[nOffset + i], table);
+		table += RDM_UID_SIZE;
+	}
+
+	return nCount;
+}
+
+void RDMTod::Reset(void) {
 	m_entries = 0;
 }
@@ -43,8 +43,9 @@ public:
 	~ArtNetRdmResponder(void);
 
 	void Full(void);
-	const uint8_t GetUidCount(void);
+	const uint16_t GetUidCount(void);
 	void Copy(uint8_t *);
+	uint16_t Copy(uint8_t *, uint16_t nOffset, uint16_t nCount);
 	const uint8_t *Handler(const uint8_t *);
 
 	void DumpTod(void);
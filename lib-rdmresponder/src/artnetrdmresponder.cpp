@@ -60,7 +60,7 @@ void ArtNetRdmResponder::Full(void) {
 	// We are a Responder - no code needed
 }
 
-const uint8_t ArtNetRdmResponder::GetUidCount(void) {
+const uint16_t ArtNetRdmResponder::GetUidCount(void) {
 	return 1; // We are a Responder
 }
 
@@ -75,6 +75,16 @@ void ArtNetRdmResponder::Copy(unsigned char *tod) {
 	}
 }
 
+uint16_t ArtNetRdmResponder::Copy(unsigned char *tod, uint16_t nOffset, uint16_t nCount) {
+	if ((nOffset != 0) || (nCount == 0)) {
+		return 0;
+	}
+
+	Copy(tod);
+
+	return 1;
+}
+
 const uint8_t *ArtNetRdmResponder::Handler(const uint8_t *pRdmDataNoSC) {
 	DEBUG_ENTRY
 
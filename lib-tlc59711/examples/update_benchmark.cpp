@@ -0,0 +1,206 @@
+/**
+ * @file update_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "tlc59711.h"
+#include "tlc59711dmx.h"
+#include "tlc59711transportsimulated.h"
+
+/*
+ * TLC59711Dmx on TLC59711TransportSimulated. A frame is only sent when a board changed,
+ * and SetData must return at once while the previous frame is still on the wire : the
+ * changed boards stay marked and Run sends them.
+ */
+
+#define LED_COUNT		16										///< RGB, so 4 boards
+#define BOARDS			((LED_COUNT * 3) / TLC59711_OUT_CHANNELS)
+#define FRAME_SIZE		(BOARDS * TLC59711_16BIT_CHANNELS * 2)
+#define SPEED_HZ		1000000									///< Slow, so SetData often finds the wire busy
+#define WIRE_MICROS		((FRAME_SIZE * 8 * 1000000) / SPEED_HZ)
+
+static uint8_t s_aDmx[512];
+static uint8_t s_aExpected[FRAME_SIZE];
+
+static uint32_t micros(void) {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (uint32_t) (tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+// Each 16-bit value is sent MSB first, the last channel of a board comes first
+static void expected_channels(const uint8_t *pDmx) {
+	for (unsigned nChannel = 0; nChannel < BOARDS * TLC59711_OUT_CHANNELS; nChannel++) {
+		const unsigned nBoard = nChannel / TLC59711_OUT_CHANNELS;
+		const unsigned nIndex = 2 + (nBoard * TLC59711_16BIT_CHANNELS) + ((12 * nBoard) + 11 - nChannel);
+
+		s_aExpected[nIndex * 2] = pDmx[nChannel];
+		s_aExpected[nIndex * 2 + 1] = pDmx[nChannel];
+	}
+}
+
+static bool is_expected(const TLC59711TransportSimulated &transport) {
+	if (transport.GetLastFrameLength() != FRAME_SIZE) {
+		return false;
+	}
+
+	// The command word is not checked, only the channels
+	for (unsigned nBoard = 0; nBoard < BOARDS; nBoard++) {
+		const unsigned nOffset = nBoard * TLC59711_16BIT_CHANNELS * 2 + 4;
+
+		if (memcmp(&transport.GetLastFrame()[nOffset], &s_aExpected[nOffset], TLC59711_OUT_CHANNELS * 2) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void drain(TLC59711Dmx &dmx, TLC59711TransportSimulated &transport) {
+	uint32_t nFrames;
+
+	do {
+		nFrames = transport.GetFrameCount();
+
+		while (transport.IsBusy()) {
+		}
+
+		dmx.Run();
+	} while (nFrames != transport.GetFrameCount());
+
+	while (transport.IsBusy()) {
+	}
+}
+
+static bool report(const char *pName, bool bOk) {
+	printf("%-40s : %s\n", pName, bOk ? "OK" : "WRONG");
+	return bOk;
+}
+
+// SetRgb with the values already in the back buffer must not mark the board
+static bool run_setrgb(void) {
+	TLC59711TransportSimulated transport(SPEED_HZ, FRAME_SIZE);
+	TLC59711 tlc59711(BOARDS, 0, &transport);
+
+	tlc59711.SetRgb(5, (uint8_t) 0x10, (uint8_t) 0x20, (uint8_t) 0x30);
+	(void) tlc59711.Update();
+
+	bool bOk = !tlc59711.IsChanged();
+
+	tlc59711.SetRgb(5, (uint8_t) 0x10, (uint8_t) 0x20, (uint8_t) 0x30);
+	tlc59711.SetRgb(9, (uint16_t) 0, (uint16_t) 0, (uint16_t) 0);
+	bOk &= !tlc59711.IsChanged();
+
+	tlc59711.SetRgb(9, (uint16_t) 0, (uint16_t) 0x1234, (uint16_t) 0);
+	bOk &= tlc59711.IsChanged(2) && !tlc59711.IsChanged(0) && !tlc59711.IsChanged(1) && !tlc59711.IsChanged(3);
+
+	return report("SetRgb unchanged values", bOk);
+}
+
+int main(int argc, char **argv) {
+	bool bOk = true;
+
+	printf("TLC59711, %u boards, %u bytes at %u Hz, %u us on the wire\n", BOARDS, FRAME_SIZE, SPEED_HZ, WIRE_MICROS);
+
+	bOk &= run_setrgb();
+
+	TLC59711TransportSimulated transport(SPEED_HZ, FRAME_SIZE);
+	TLC59711Dmx dmx;
+
+	dmx.SetLEDCount(LED_COUNT);
+	dmx.SetTransport(&transport);
+
+	memset(s_aDmx, 0, sizeof(s_aDmx));
+
+	for (unsigned i = 0; i < LED_COUNT * 3; i++) {
+		s_aDmx[i] = (uint8_t) (i + 1);
+	}
+
+	dmx.SetData(0, s_aDmx, sizeof(s_aDmx));
+	drain(dmx, transport);
+
+	expected_channels(s_aDmx);
+	bOk &= report("first frame", (transport.GetFrameCount() == 1) && is_expected(transport));
+
+	// Identical frames are not sent
+	for (unsigned i = 0; i < 10; i++) {
+		dmx.SetData(0, s_aDmx, sizeof(s_aDmx));
+		drain(dmx, transport);
+	}
+
+	bOk &= report("10 identical frames", transport.GetFrameCount() == 1);
+
+	// A value outside the footprint does not change any board
+	s_aDmx[LED_COUNT * 3] = 0xFF;
+	dmx.SetData(0, s_aDmx, sizeof(s_aDmx));
+	drain(dmx, transport);
+
+	bOk &= report("change outside the footprint", transport.GetFrameCount() == 1);
+
+	// One channel of the third board
+	s_aDmx[2 * TLC59711_OUT_CHANNELS + 5] = 0xAA;
+	dmx.SetData(0, s_aDmx, sizeof(s_aDmx));
+	drain(dmx, transport);
+
+	expected_channels(s_aDmx);
+	bOk &= report("one board changed", (transport.GetFrameCount() == 2) && is_expected(transport));
+
+	// Back to back frames : the second one finds the wire busy
+	uint32_t nSetDataMaxMicros = 0;
+	const uint32_t nFramesBefore = transport.GetFrameCount();
+
+	for (unsigned nFrame = 0; nFrame < 100; nFrame++) {
+		for (unsigned i = 0; i < LED_COUNT * 3; i++) {
+			s_aDmx[i] = (uint8_t) (nFrame + i);
+		}
+
+		const uint32_t nStart = micros();
+		dmx.SetData(0, s_aDmx, sizeof(s_aDmx));
+		const uint32_t nMicros = micros() - nStart;
+
+		if (nMicros > nSetDataMaxMicros) {
+			nSetDataMaxMicros = nMicros;
+		}
+	}
+
+	const uint32_t nFramesBusy = transport.GetFrameCount() - nFramesBefore;
+
+	// Nothing arrives any more, Run sends the last frame that was held back
+	drain(dmx, transport);
+
+	expected_channels(s_aDmx);
+
+	printf("100 back to back SetData : %u started, SetData max %u us\n", nFramesBusy, nSetDataMaxMicros);
+
+	bOk &= report("SetData does not wait for the wire", (nFramesBusy < 100) && (nSetDataMaxMicros < (WIRE_MICROS / 2)));
+	bOk &= report("Run sends the pending frame", is_expected(transport));
+
+	printf("%s\n", bOk ? "OK" : "FAILED");
+
+	return bOk ? 0 : 1;
+}
@@ -38,9 +38,13 @@
 
 #include <stdint.h>
 
+#include "tlc59711transport.h"
+
 class TLC59711 {
 public:
-	TLC59711(uint8_t nBoards = 1, uint32_t nSpiSpeedHz = TLC59711_SPI_SPEED_DEFAULT);
+	// Without pTransport the chain is driven by SPI0 (TLC59711TransportSpi),
+	// built with TLC59711_TRANSPORT_SIMULATED by TLC59711TransportSimulated
+	TLC59711(uint8_t nBoards = 1, uint32_t nSpiSpeedHz = TLC59711_SPI_SPEED_DEFAULT, TLC59711Transport *pTransport = 0);
 	~TLC59711(void);
 
 	int GetBlank(void) const;
@@ -77,29 +81,46 @@ public:
 
 	void SetRgb(uint8_t nOut, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);
 
-	void Update(void);
+	// Returns false, without starting a transfer, while the previous one is still running
+	bool Update(void);
 
-#if defined (__circle__)
-	// returns TRUE while DMA operation is active
-	bool IsUpdating (void) const;
-#else
-	inline 	bool IsUpdating (void) const {
-		return false;
-	}
-#endif
+	// Returns true while the previous transfer is running
+	bool IsUpdating(void) const;
+
+	// Set since the last Update
+	bool IsChanged(void) const;
+	bool IsChanged(uint8_t nBoard) const;
 
 	void Dump(void);
 
 private:
 	void UpdateFirst32(void);
 
+	inline void SetChanged(uint8_t nBoard) {
+		m_pChanged[nBoard >> 5] |= (uint32_t) 1 << (nBoard & 0x1F);
+	}
+
+	// The board is only marked as changed when one of the values differs from the back buffer
+	inline void SetRgbData(uint8_t nBoard, uint32_t nIndex, uint16_t nBlue, uint16_t nGreen, uint16_t nRed) {
+		if ((m_pBuffer[nIndex] != nBlue) || (m_pBuffer[nIndex + 1] != nGreen) || (m_pBuffer[nIndex + 2] != nRed)) {
+			m_pBuffer[nIndex] = nBlue;
+			m_pBuffer[nIndex + 1] = nGreen;
+			m_pBuffer[nIndex + 2] = nRed;
+			SetChanged(nBoard);
+		}
+	}
+
 private:
 	uint8_t m_nBoards;
 	uint32_t m_nSpiSpeedHz;
 	uint16_t m_nClockDivider;
 	uint32_t m_nFirst32;
-	uint16_t *m_pBuffer;
+	uint16_t *m_pBuffer;			// Written by Set
+	uint16_t *m_pFrontBuffer;		// On the wire
 	uint32_t m_nBufSize;
+	uint32_t *m_pChanged;			// A bit for each board
+	TLC59711Transport *m_pTransport;
+	bool m_bOwnTransport;
 };
 
 #endif /* TLC59711_H_ */
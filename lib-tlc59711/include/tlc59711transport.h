@@ -0,0 +1,45 @@
+/**
+ * @file tlc59711transport.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TLC59711TRANSPORT_H_
+#define TLC59711TRANSPORT_H_
+
+#include <stdint.h>
+
+/**
+ * Shifts the TLC59711 chain data out.
+ * Start returns as soon as the transfer is running; the buffer must not be
+ * written until IsBusy returns false.
+ */
+class TLC59711Transport {
+public:
+	virtual ~TLC59711Transport(void) {
+	}
+
+	virtual void Start(const uint8_t *pBuffer, uint32_t nLength)=0;
+	virtual bool IsBusy(void)=0;
+};
+
+#endif /* TLC59711TRANSPORT_H_ */
@@ -0,0 +1,49 @@
+/**
+ * @file tlc59711transportspi.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TLC59711TRANSPORTSPI_H_
+#define TLC59711TRANSPORTSPI_H_
+
+#include <stdint.h>
+
+#include "tlc59711transport.h"
+
+/**
+ * SPI0 without chip select, mode 0. On bare metal the transfer runs with DMA.
+ * On Linux it is blocking, so IsBusy is always false.
+ */
+class TLC59711TransportSpi: public TLC59711Transport {
+public:
+	TLC59711TransportSpi(uint16_t nClockDivider);
+	~TLC59711TransportSpi(void);
+
+	void Start(const uint8_t *pBuffer, uint32_t nLength);
+	bool IsBusy(void);
+
+private:
+	uint16_t m_nClockDivider;
+};
+
+#endif /* TLC59711TRANSPORTSPI_H_ */
@@ -29,15 +29,21 @@
 #endif
 #include <assert.h>
 
-#include "bcm2835.h"
-
 #if defined(__linux__)
-#elif defined(__circle__)
+ #include <string.h>
 #else
- #include "bcm2835_spi.h"
+ #include "util.h"
 #endif
 
+#include "bcm2835.h"
+
 #include "tlc59711.h"
+#include "tlc59711transport.h"
+#if defined (TLC59711_TRANSPORT_SIMULATED)
+ #include "tlc59711transportsimulated.h"
+#else
+ #include "tlc59711transportspi.h"
+#endif
 
 #define TLC59711_COMMAND			0x25
 	#define TLC59711_COMMAND_SHIFT	26
@@ -63,25 +69,18 @@
 	#define TLC59711_GS_GREEN_SHIFT	7
 	#define TLC59711_GS_BLUE_SHIFT	14
 
-TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz):
+TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz, TLC59711Transport *pTransport):
 	m_nBoards(nBoards),
 	m_nSpiSpeedHz(nSpiSpeedHz),
 	m_nClockDivider((uint32_t) BCM2835_CORE_CLK_HZ / (uint32_t) TLC59711_SPI_SPEED_DEFAULT),
 	m_nFirst32(0),
 	m_pBuffer(0),
-	m_nBufSize(0)
+	m_pFrontBuffer(0),
+	m_nBufSize(0),
+	m_pChanged(0),
+	m_pTransport(pTransport),
+	m_bOwnTransport(false)
 {
-#if defined (__linux__)  || defined(__circle__)
-	if (bcm2835_init() == 0) {
-		printf("Not able to init the bmc2835 library\n");
-	}
-#endif
-
-
-	bcm2835_spi_begin();
-
-	bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);
-
 	if (m_nSpiSpeedHz != (uint32_t) 0) {
 		if (m_nSpiSpeedHz > TLC59711_SPI_SPEED_MAX) {
 			m_nSpiSpeedHz = TLC59711_SPI_SPEED_MAX;
@@ -91,15 +90,38 @@ TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz):
 
 	if (nBoards == 0) {
 		nBoards = 1;
+		m_nBoards = 1;
 	}
 
 	m_nBufSize = nBoards * TLC59711_16BIT_CHANNELS;
-	m_pBuffer = new uint16_t[m_nBufSize];
 
+	if (m_pTransport == 0) {
+#if defined (TLC59711_TRANSPORT_SIMULATED)
+		m_pTransport = new TLC59711TransportSimulated((uint32_t) BCM2835_CORE_CLK_HZ / m_nClockDivider, m_nBufSize * 2);
+#else
+		m_pTransport = new TLC59711TransportSpi(m_nClockDivider);
+#endif
+		assert(m_pTransport != 0);
+		m_bOwnTransport = true;
+	}
+
+	m_pBuffer = new uint16_t[m_nBufSize];
 	assert(m_pBuffer != 0);
 
+	// Sent by the transport while m_pBuffer is being filled
+	m_pFrontBuffer = new uint16_t[m_nBufSize];
+	assert(m_pFrontBuffer != 0);
+
 	for (unsigned i = 0; i < m_nBufSize; i++) {
 		m_pBuffer[i] = (uint16_t) 0;
+		m_pFrontBuffer[i] = (uint16_t) 0;
+	}
+
+	m_pChanged = new uint32_t[(nBoards + 31) / 32];
+	assert(m_pChanged != 0);
+
+	for (unsigned i = 0; i < (unsigned) ((nBoards + 31) / 32); i++) {
+		m_pChanged[i] = 0;
 	}
 
 	m_nFirst32 |= (uint32_t) TLC59711_COMMAND << TLC59711_COMMAND_SHIFT ;
@@ -114,6 +136,21 @@ TLC59711::TLC59711(uint8_t nBoards, uint32_t nSpiSpeedHz):
 }
 
 TLC59711::~TLC59711(void) {
+	while (m_pTransport->IsBusy()) {
+		// wait for completion
+	}
+
+	if (m_bOwnTransport) {
+		delete m_pTransport;
+	}
+	m_pTransport = 0;
+
+	delete[] m_pChanged;
+	m_pChanged = 0;
+
+	delete[] m_pFrontBuffer;
+	m_pFrontBuffer = 0;
+
 	delete[] m_pBuffer;
 	m_pBuffer = 0;
 }
@@ -135,7 +172,12 @@ void TLC59711::Set(uint8_t nChannel, uint16_t nValue) {
 
 	if (nBoardIndex < m_nBoards) {
 		const uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + ((12 * nBoardIndex) + 11 - nChannel);
-		m_pBuffer[nIndex] = __builtin_bswap16(nValue);
+		const uint16_t nData = __builtin_bswap16(nValue);
+
+		if (m_pBuffer[nIndex] != nData) {
+			m_pBuffer[nIndex] = nData;
+			SetChanged(nBoardIndex);
+		}
 	}
 #ifndef NDEBUG
 	else {
@@ -163,7 +205,12 @@ void TLC59711::Set(uint8_t nChannel, uint8_t nValue) {
 
 	if (nBoardIndex < m_nBoards) {
 		const uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + ((12 * nBoardIndex) + 11 - nChannel);
-		m_pBuffer[nIndex] = (uint16_t) nValue << 8 | (uint16_t) nValue;
+		const uint16_t nData = (uint16_t) nValue << 8 | (uint16_t) nValue;
+
+		if (m_pBuffer[nIndex] != nData) {
+			m_pBuffer[nIndex] = nData;
+			SetChanged(nBoardIndex);
+		}
 	}
 #ifndef NDEBUG
 	else {
@@ -176,10 +223,8 @@ void TLC59711::SetRgb(uint8_t nOut, uint16_t nRed, uint16_t nGreen, uint16_t nBl
 	const uint8_t nBoardIndex = nOut / 4;
 
 	if (nBoardIndex < m_nBoards) {
-		uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + (((4 * nBoardIndex) +3 - nOut) * 3);
-		m_pBuffer[nIndex++] = __builtin_bswap16(nBlue);
-		m_pBuffer[nIndex++] = __builtin_bswap16(nGreen);
-		m_pBuffer[nIndex] = __builtin_bswap16(nRed);
+		const uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + (((4 * nBoardIndex) +3 - nOut) * 3);
+		SetRgbData(nBoardIndex, nIndex, __builtin_bswap16(nBlue), __builtin_bswap16(nGreen), __builtin_bswap16(nRed));
 	}
 #ifndef NDEBUG
 	else {
@@ -192,10 +237,8 @@ void TLC59711::SetRgb(uint8_t nOut, uint8_t nRed, uint8_t nGreen, uint8_t nBlue)
 	const uint8_t nBoardIndex = nOut / 4;
 
 	if (nBoardIndex < m_nBoards) {
-		uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + (((4 * nBoardIndex) + 3 - nOut) * 3);
-		m_pBuffer[nIndex++] = (uint16_t) nBlue << 8 | (uint16_t) nBlue;
-		m_pBuffer[nIndex++] = (uint16_t) nGreen << 8 | (uint16_t) nGreen;
-		m_pBuffer[nIndex] = (uint16_t) nRed << 8 | (uint16_t) nRed;
+		const uint32_t nIndex = 2 + (nBoardIndex * TLC59711_16BIT_CHANNELS) + (((4 * nBoardIndex) + 3 - nOut) * 3);
+		SetRgbData(nBoardIndex, nIndex, (uint16_t) nBlue << 8 | (uint16_t) nBlue, (uint16_t) nGreen << 8 | (uint16_t) nGreen, (uint16_t) nRed << 8 | (uint16_t) nRed);
 	}
 #ifndef NDEBUG
 	else {
@@ -312,6 +355,7 @@ void TLC59711::UpdateFirst32(void) {
 		const unsigned nIndex = TLC59711_16BIT_CHANNELS * i;
 		m_pBuffer[nIndex] = __builtin_bswap16((uint16_t) (m_nFirst32 >> 16));
 		m_pBuffer[nIndex + 1] = __builtin_bswap16((uint16_t) m_nFirst32);
+		SetChanged((uint8_t) i);
 	}
 }
 
@@ -354,14 +398,42 @@ void TLC59711::Dump(void) {
 #endif
 }
 
-void TLC59711::Update(void) {
+bool TLC59711::Update(void) {
 	assert(m_pBuffer != 0);
 
-	__sync_synchronize();
+	if (m_pTransport->IsBusy()) {
+		return false;
+	}
+
+	memcpy(m_pFrontBuffer, m_pBuffer, m_nBufSize * 2);
+
+	for (unsigned i = 0; i < (unsigned) ((m_nBoards + 31) / 32); i++) {
+		m_pChanged[i] = 0;
+	}
+
+	m_pTransport->Start((const uint8_t *) m_pFrontBuffer, m_nBufSize * 2);
+
+	return true;
+}
+
+bool TLC59711::IsUpdating(void) const {
+	return m_pTransport->IsBusy();
+}
+
+bool TLC59711::IsChanged(void) const {
+	for (unsigned i = 0; i < (unsigned) ((m_nBoards + 31) / 32); i++) {
+		if (m_pChanged[i] != 0) {
+			return true;
+		}
+	}
 
-	bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);
-	bcm2835_spi_setClockDivider(m_nClockDivider);
-	bcm2835_spi_setDataMode(BCM2835_SPI_MODE0);
-	bcm2835_spi_writenb((char *) m_pBuffer, m_nBufSize * 2);
+	return false;
 }
 
+bool TLC59711::IsChanged(uint8_t nBoard) const {
+	if (nBoard >= m_nBoards) {
+		return false;
+	}
+
+	return (m_pChanged[nBoard >> 5] & ((uint32_t) 1 << (nBoard & 0x1F))) != 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file tlc59711transportspi.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#if defined(__linux__)
+ #include <stdio.h>
+#endif
+#include <assert.h>
+
+#include "bcm2835.h"
+
+#if !defined(__linux__)
+ #include "bcm2835_spi.h"
+ #include "bcm2835_spi_dma.h"
+#endif
+
+#include "tlc59711transportspi.h"
+
+TLC59711TransportSpi::TLC59711TransportSpi(uint16_t nClockDivider): m_nClockDivider(nClockDivider) {
+#if defined (__linux__)
+	if (bcm2835_init() == 0) {
+		printf("Not able to init the bmc2835 library\n");
+	}
+#endif
+
+	bcm2835_spi_begin();
+
+	bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);
+
+#if !defined(__linux__)
+	bcm2835_spi_dma_begin();
+#endif
+}
+
+TLC59711TransportSpi::~TLC59711TransportSpi(void) {
+#if !defined(__linux__)
+	bcm2835_spi_dma_end();
+#endif
+}
+
+void TLC59711TransportSpi::Start(const uint8_t *pBuffer, uint32_t nLength) {
+	assert(pBuffer != 0);
+
+	// The SPI can be shared, so the settings are made for each transfer
+	bcm2835_spi_chipSelect(BCM2835_SPI_CS_NONE);
+	bcm2835_spi_setClockDivider(m_nClockDivider);
+	bcm2835_spi_setDataMode(BCM2835_SPI_MODE0);
+
+#if defined(__linux__)
+	__sync_synchronize();
+	bcm2835_spi_writenb((char *) pBuffer, nLength);
+#else
+	bcm2835_spi_dma_tx_start(pBuffer, nLength);
+#endif
+}
+
+bool TLC59711TransportSpi::IsBusy(void) {
+#if defined(__linux__)
+	return false;
+#else
+	return bcm2835_spi_dma_tx_is_active();
+#endif
+}
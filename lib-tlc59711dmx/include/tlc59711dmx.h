@@ -29,8 +29,10 @@
 #include <stdint.h>
 
 #include "lightset.h"
+#include "lightsetcurve.h"
 
 #include "tlc59711.h"
+#include "tlc59711transport.h"
 
 enum TTLC59711Type {
 	TTLC59711_TYPE_RGB,
@@ -47,6 +49,9 @@ public:
 
 	void SetData(uint8_t nPort, const uint8_t *pDmxData, uint16_t nLength);
 
+	// Sends a frame that SetData could not start while the previous one was on the wire, call from the main loop
+	void Run(void);
+
 	void SetLEDType(TTLC59711Type tTLC59711Type);
 	TTLC59711Type GetLEDType(void) const;
 
@@ -56,6 +61,15 @@ public:
 	void SetSpiSpeedHz(uint32_t nSpiSpeedHz);
 	uint32_t GetSpiSpeedHz(void) const;
 
+	void SetDmx16Bit(bool bDmx16Bit);
+	bool GetDmx16Bit(void) const;
+
+	inline LightSetCurve *GetCurve(void) {
+		return &m_Curve;
+	}
+
+	// Before Start, the default is SPI0. The caller keeps the ownership.
+	void SetTransport(TLC59711Transport *pTransport);
 
 public: // RDM
 	bool SetDmxStartAddress(uint16_t nDmxStartAddress);
@@ -88,6 +102,9 @@ private:
 	uint32_t m_nSpiSpeedHz;
 	TTLC59711Type m_LEDType;
 	uint8_t m_nLEDCount;
+	bool m_bDmx16Bit;
+	LightSetCurve m_Curve;
+	TLC59711Transport *m_pTransport;
 };
 
 #endif /* TLC59711DMX_H_ */
@@ -30,6 +30,10 @@
 
 #include "tlc59711dmx.h"
 
+#include "lightsetcurve.h"
+
+#define TLC59711_DMX_CURVE_POINTS_LENGTH	LIGHTSET_CURVE_POINTS_LENGTH
+
 class TLC59711DmxParams {
 public:
 	TLC59711DmxParams(void);
@@ -61,6 +65,10 @@ private:
 	uint8_t m_nLEDCount;
 	uint16_t m_nDmxStartAddress;
     uint32_t m_nSpiSpeedHz;
+    bool m_bDmx16Bit;
+    TLightSetCurve m_tCurve;
+    float m_fCurveGamma;
+    char m_aCurvePoints[TLC59711_DMX_CURVE_POINTS_LENGTH + 1];
 };
 
 #endif /* PWMDMXTLC59711PARAMS_H_ */
@@ -53,7 +53,9 @@ TLC59711Dmx::TLC59711Dmx(void):
 	m_pTLC59711(0),
 	m_nSpiSpeedHz(0),
 	m_LEDType(TTLC59711_TYPE_RGB),
-	m_nLEDCount(TLC59711_RGB_CHANNELS)
+	m_nLEDCount(TLC59711_RGB_CHANNELS),
+	m_bDmx16Bit(false),
+	m_pTransport(0)
 {
 	UpdateMembers();
 }
@@ -95,31 +97,52 @@ void TLC59711Dmx::SetData(uint8_t nPort, const uint8_t* pDmxData, uint16_t nLeng
 
 	unsigned nDmxAddress = m_nDmxStartAddress;
 
-	for (unsigned i = 0; i < m_nDmxFootprint; i++) {
-		if (nDmxAddress > nLength) {
-			break;
+	if (m_bDmx16Bit) {
+		for (unsigned i = 0; i < (unsigned) (m_nDmxFootprint / 2); i++) {
+			if ((nDmxAddress + 1) > nLength) {
+				break;
+			}
+
+			const uint16_t nValue = ((uint16_t) p[0] << 8) | (uint16_t) p[1];
+
+			m_pTLC59711->Set((uint8_t) i, m_Curve.IsLinear() ? nValue : m_Curve.Get(nValue));
+
+			p += 2;
+			nDmxAddress += 2;
 		}
+	} else {
+		for (unsigned i = 0; i < m_nDmxFootprint; i++) {
+			if (nDmxAddress > nLength) {
+				break;
+			}
 
-		const uint16_t nValue = ((uint16_t) *p << 8) | (uint16_t) *p;
+			const uint16_t nValue = m_Curve.IsLinear() ? (((uint16_t) *p << 8) | (uint16_t) *p) : m_Curve.Get(*p);
 
-		m_pTLC59711->Set((uint8_t) i, nValue);
+			m_pTLC59711->Set((uint8_t) i, nValue);
 
-		p++;
-		nDmxAddress++;
+			p++;
+			nDmxAddress++;
+		}
 	}
 
 	if (__builtin_expect((nDmxAddress == m_nDmxStartAddress), 0)) {
 		return;
 	}
 
-	while (m_pTLC59711->IsUpdating()) {
-		// wait for completion
+	if (!m_pTLC59711->IsChanged()) {
+		return;
 	}
 
 	//m_pTLC59711->Dump();
 
-	m_pTLC59711->Update();
+	// While the previous frame is still being sent the boards stay marked as changed, Run or the next SetData sends them
+	(void) m_pTLC59711->Update();
+}
 
+void TLC59711Dmx::Run(void) {
+	if ((m_pTLC59711 != 0) && m_pTLC59711->IsChanged()) {
+		(void) m_pTLC59711->Update();
+	}
 }
 
 bool TLC59711Dmx::SetDmxStartAddress(uint16_t nDmxStartAddress) {
@@ -140,6 +163,16 @@ bool TLC59711Dmx::GetSlotInfo(uint16_t nSlotOffset, struct TLightSetSlotInfo& tS
 		return false;
 	}
 
+	if (m_bDmx16Bit) {
+		if ((nSlotOffset & 0x1) == 0x1) {
+			tSlotInfo.nType = 0x01;	// ST_SEC_FINE
+			tSlotInfo.nCategory = nSlotOffset - 1; // Slot offset of the coarse slot
+			return true;
+		}
+
+		nSlotOffset = nSlotOffset / 2;
+	}
+
 	if (m_LEDType == TTLC59711_TYPE_RGB) {
 		nIndex = MOD(nSlotOffset, 3);
 	} else {
@@ -194,20 +227,43 @@ uint32_t TLC59711Dmx::GetSpiSpeedHz(void) const {
 	return m_nSpiSpeedHz;
 }
 
+/*
+ * Coarse and fine slot for each output.
+ */
+void TLC59711Dmx::SetDmx16Bit(bool bDmx16Bit) {
+	m_bDmx16Bit = bDmx16Bit;
+	UpdateMembers();
+}
+
+bool TLC59711Dmx::GetDmx16Bit(void) const {
+	return m_bDmx16Bit;
+}
+
+void TLC59711Dmx::SetTransport(TLC59711Transport *pTransport) {
+	assert(m_pTLC59711 == 0);
+	m_pTransport = pTransport;
+}
+
 void TLC59711Dmx::Initialize(void) {
 	assert(m_pTLC59711 == 0);
-	m_pTLC59711 = new TLC59711(m_nBoardInstances, m_nSpiSpeedHz);
+	m_pTLC59711 = new TLC59711(m_nBoardInstances, m_nSpiSpeedHz, m_pTransport);
 	assert(m_pTLC59711 != 0);
 	m_pTLC59711->Dump();
+
+	m_Curve.Build();
+	m_Curve.Dump();
 }
 
 void TLC59711Dmx::UpdateMembers(void) {
+	uint16_t nChannels;
+
 	if (m_LEDType == TTLC59711_TYPE_RGB) {
-		m_nDmxFootprint = m_nLEDCount * 3;
+		nChannels = m_nLEDCount * 3;
 	} else {
-		m_nDmxFootprint = m_nLEDCount * 4;
+		nChannels = m_nLEDCount * 4;
 	}
 
-	m_nBoardInstances = (uint8_t) ceil((float) m_nDmxFootprint / TLC59711_OUT_CHANNELS);
+	m_nDmxFootprint = m_bDmx16Bit ? (2 * nChannels) : nChannels;
+	m_nBoardInstances = (uint8_t) ceil((float) nChannels / TLC59711_OUT_CHANNELS);
 }
 
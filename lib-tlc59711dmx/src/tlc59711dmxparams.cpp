@@ -51,20 +51,32 @@
 #define SET_LED_COUNT_MASK			1<<1
 #define SET_DMX_START_ADDRESS_MASK	1<<2
 #define SET_SPI_SPEED_MASK			1<<3
+#define SET_DMX_16BIT_MASK			1<<4
+#define SET_CURVE_MASK				1<<5
+#define SET_CURVE_GAMMA_MASK		1<<6
+#define SET_CURVE_POINTS_MASK		1<<7
 
 static const char PARAMS_FILE_NAME[] ALIGNED = "devices.txt";
 static const char PARAMS_LED_TYPE[] ALIGNED = "led_type";
 static const char PARAMS_LED_COUNT[] ALIGNED = "led_count";
 static const char PARAMS_DMX_START_ADDRESS[] ALIGNED = "dmx_start_address";
 static const char PARAMS_SPI_SPEED_HZ[] ALIGNED = "spi_speed_hz";
+static const char PARAMS_DMX_16BIT[] ALIGNED = "dmx_16bit";
+static const char PARAMS_DMX_CURVE[] ALIGNED = "dmx_curve";
+static const char PARAMS_DMX_CURVE_GAMMA[] ALIGNED = "dmx_curve_gamma";
+static const char PARAMS_DMX_CURVE_POINTS[] ALIGNED = "dmx_curve_points";
 
 TLC59711DmxParams::TLC59711DmxParams(void):
 	m_bSetList(0),
 	m_LEDType(TTLC59711_TYPE_RGB),
 	m_nLEDCount(4),
 	m_nDmxStartAddress(1),
-	m_nSpiSpeedHz(0)
+	m_nSpiSpeedHz(0),
+	m_bDmx16Bit(false),
+	m_tCurve(LIGHTSET_CURVE_LINEAR),
+	m_fCurveGamma(LIGHTSET_CURVE_GAMMA_DEFAULT)
 {
+	m_aCurvePoints[0] = '\0';
 }
 
 bool TLC59711DmxParams::Load(void) {
@@ -88,6 +100,22 @@ void TLC59711DmxParams::Set(TLC59711Dmx* pTLC59711Dmx) {
 		pTLC59711Dmx->SetLEDCount(m_nLEDCount);
 	}
 
+	if(IsMaskSet(SET_DMX_16BIT_MASK)) {
+		pTLC59711Dmx->SetDmx16Bit(m_bDmx16Bit);
+	}
+
+	if(IsMaskSet(SET_CURVE_MASK)) {
+		pTLC59711Dmx->GetCurve()->SetType(m_tCurve);
+	}
+
+	if(IsMaskSet(SET_CURVE_GAMMA_MASK)) {
+		pTLC59711Dmx->GetCurve()->SetGamma(m_fCurveGamma);
+	}
+
+	if(IsMaskSet(SET_CURVE_POINTS_MASK)) {
+		(void) pTLC59711Dmx->GetCurve()->SetPoints(m_aCurvePoints);
+	}
+
 	if(IsMaskSet(SET_DMX_START_ADDRESS_MASK)) {
 		pTLC59711Dmx->SetDmxStartAddress(m_nDmxStartAddress);
 	}
@@ -120,6 +148,22 @@ void TLC59711DmxParams::Dump(void) {
 	if(IsMaskSet(SET_SPI_SPEED_MASK)) {
 		printf(" %s=%d Hz\n", PARAMS_SPI_SPEED_HZ, m_nSpiSpeedHz);
 	}
+
+	if(IsMaskSet(SET_DMX_16BIT_MASK)) {
+		printf(" %s=%d\n", PARAMS_DMX_16BIT, (int) m_bDmx16Bit);
+	}
+
+	if(IsMaskSet(SET_CURVE_MASK)) {
+		printf(" %s=%s\n", PARAMS_DMX_CURVE, LightSetCurve::GetTypeString(m_tCurve));
+	}
+
+	if(IsMaskSet(SET_CURVE_GAMMA_MASK)) {
+		printf(" %s=%d.%02d\n", PARAMS_DMX_CURVE_GAMMA, (int) m_fCurveGamma, (int) (100 * (m_fCurveGamma - (int) m_fCurveGamma)));
+	}
+
+	if(IsMaskSet(SET_CURVE_POINTS_MASK)) {
+		printf(" %s=%s\n", PARAMS_DMX_CURVE_POINTS, m_aCurvePoints);
+	}
 #endif
 }
 
@@ -138,6 +182,7 @@ void TLC59711DmxParams::callbackFunction(const char* pLine) {
 	uint8_t value8;
 	uint16_t value16;
 	uint32_t value32;
+	float valuef;
 	uint8_t len;
 	char buffer[12];
 
@@ -175,6 +220,38 @@ void TLC59711DmxParams::callbackFunction(const char* pLine) {
 	if (Sscan::Uint32(pLine, PARAMS_SPI_SPEED_HZ, &value32) == SSCAN_OK) {
 		m_nSpiSpeedHz = value32;
 		m_bSetList |= SET_SPI_SPEED_MASK;
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, PARAMS_DMX_16BIT, &value8) == SSCAN_OK) {
+		m_bDmx16Bit = (value8 != 0);
+		m_bSetList |= SET_DMX_16BIT_MASK;
+		return;
+	}
+
+	len = 6;
+	if (Sscan::Char(pLine, PARAMS_DMX_CURVE, buffer, &len) == SSCAN_OK) {
+		buffer[len] = '\0';
+		const TLightSetCurve tCurve = LightSetCurve::GetType(buffer);
+		if (tCurve != LIGHTSET_CURVE_UNDEFINED) {
+			m_tCurve = tCurve;
+			m_bSetList |= SET_CURVE_MASK;
+		}
+		return;
+	}
+
+	if (Sscan::Float(pLine, PARAMS_DMX_CURVE_GAMMA, &valuef) == SSCAN_OK) {
+		if ((valuef > 0) && (valuef <= 10)) {
+			m_fCurveGamma = valuef;
+			m_bSetList |= SET_CURVE_GAMMA_MASK;
+		}
+		return;
+	}
+
+	len = TLC59711_DMX_CURVE_POINTS_LENGTH;
+	if (Sscan::Char(pLine, PARAMS_DMX_CURVE_POINTS, m_aCurvePoints, &len) == SSCAN_OK) {
+		m_aCurvePoints[len] = '\0';
+		m_bSetList |= SET_CURVE_POINTS_MASK;
 	}
 }
 
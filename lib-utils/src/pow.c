@@ -0,0 +1,74 @@
+/**
+ * @file pow.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#include "math.h"
+
+typedef union {
+	float number;
+	int32_t bits;
+} float2bits;
+
+/**
+ * On success, the function returns 2 raised to the power of x.
+ * maximum relative error ±0.00015
+ */
+float exp2f(float x) {
+	float2bits m;
+
+	if (x < -126) {
+		return (float) 0;
+	} else if (x > 127) {
+		m.bits = 0x7F800000;	// +inf
+		return m.number;
+	}
+
+	int32_t i = (int32_t) x;
+
+	if ((float) i > x) {
+		i--;
+	}
+
+	const float f = x - (float) i;
+
+	m.number = 1.0f + f * (0.69606564f + f * (0.22449434f + f * 0.07944024f));
+	m.bits += i << 23;
+
+	return m.number;
+}
+
+/**
+ * Only for x >= 0, as needed for curves on [0, 1]. The error is the one of \ref log2f times y.
+ */
+float powf(float x, float y) {
+	if (y == 0) {
+		return (float) 1;
+	} else if (x <= 0) {
+		return (float) 0;
+	}
+
+	return exp2f(y * log2f(x));
+}
@@ -0,0 +1,218 @@
+/**
+ * @file update_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "ws28xxstripe.h"
+#include "ws28xxtransportsimulated.h"
+
+/*
+ * WS28XXStripe on WS28XXTransportSimulated, with frames committed faster and slower than the wire.
+ * Update must never wait for the wire : a frame committed while the previous one is still being sent
+ * is pending, Run from the main loop starts it. Each commit writes one half of the stripe, so the
+ * frame on the wire must always hold the latest data of both halves.
+ */
+
+#define LED_COUNT		170
+#define BUFFER_SIZE		(LED_COUNT * 3 * 8)
+#define RUN_MICROS		1000000
+
+struct TCase {
+	const char *pName;
+	uint32_t nCommitMicros;
+	bool bCoalesce;		///< Commits are faster than the wire
+};
+
+static const struct TCase s_aCases[] = {
+		{ "commit every 1 ms", 1000, true },
+		{ "commit every 2 ms", 2000, true },
+		{ "commit every 10 ms", 10000, false },
+		{ "commit every 25 ms", 25000, false }
+};
+
+static uint8_t s_aLeds[LED_COUNT * 3];		///< What the stripe must show, R, G, B
+static uint8_t s_aExpected[BUFFER_SIZE];
+
+static uint32_t micros(void) {
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (uint32_t) (tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+// WS2812B : G, R, B and one SPI byte for each bit
+static void expand(const uint8_t *pLeds, uint8_t *pBuffer) {
+	static const unsigned aOrder[3] = { 1, 0, 2 };
+
+	for (unsigned i = 0; i < LED_COUNT; i++) {
+		for (unsigned c = 0; c < 3; c++) {
+			const uint8_t nValue = pLeds[i * 3 + aOrder[c]];
+
+			for (unsigned b = 0; b < 8; b++) {
+				*pBuffer++ = (nValue & (0x80 >> b)) ? 0xF8 : 0xC0;
+			}
+		}
+	}
+}
+
+static void drain(WS28XXStripe *pStripe, WS28XXTransportSimulated *pTransport) {
+	while (pStripe->IsUpdating()) {
+		(void) pStripe->Run();
+	}
+
+	(void) pTransport->IsBusy();
+}
+
+static bool run_case(const struct TCase *pCase) {
+	WS28XXTransportSimulated transport(WS28XX_SPI_SPEED_HZ, BUFFER_SIZE);
+	WS28XXStripe stripe(WS2812B, LED_COUNT, 0, &transport);
+
+	drain(&stripe, &transport);
+
+	const uint32_t nFramesStart = transport.GetFrameCount();
+
+	memset(s_aLeds, 0, sizeof(s_aLeds));
+
+	uint32_t nCommits = 0;
+	uint32_t nUpdateMaxMicros = 0;
+	uint64_t nUpdateTotalMicros = 0;
+
+	const uint32_t nStart = micros();
+	uint32_t nNextCommit = nStart;
+	uint32_t nNow;
+
+	while (((nNow = micros()) - nStart) < RUN_MICROS) {
+		(void) stripe.Run();
+
+		if ((int32_t) (nNow - nNextCommit) < 0) {
+			continue;
+		}
+
+		nNextCommit += pCase->nCommitMicros;
+
+		const unsigned nHalf = (nCommits & 1) * (LED_COUNT / 2);
+		const unsigned nCount = (nCommits & 1) ? LED_COUNT - LED_COUNT / 2 : LED_COUNT / 2;
+
+		for (unsigned i = 0; i < nCount * 3; i++) {
+			s_aLeds[nHalf * 3 + i] = (uint8_t) (nCommits + i);
+		}
+
+		stripe.SetLEDs(nHalf, &s_aLeds[nHalf * 3], nCount);
+
+		const uint32_t nUpdateStart = micros();
+		stripe.Update();
+		const uint32_t nUpdateMicros = micros() - nUpdateStart;
+
+		nUpdateTotalMicros += nUpdateMicros;
+
+		if (nUpdateMicros > nUpdateMaxMicros) {
+			nUpdateMaxMicros = nUpdateMicros;
+		}
+
+		nCommits++;
+	}
+
+	const uint32_t nElapsed = micros() - nStart;
+
+	drain(&stripe, &transport);
+
+	const uint32_t nFrames = transport.GetFrameCount() - nFramesStart;
+	const uint32_t nWireMicros = (uint32_t) (((uint64_t) BUFFER_SIZE * 8 * 1000000) / WS28XX_SPI_SPEED_HZ);
+
+	expand(s_aLeds, s_aExpected);
+
+	const bool bLastFrame = (transport.GetLastFrameLength() == BUFFER_SIZE) && (memcmp(transport.GetLastFrame(), s_aExpected, BUFFER_SIZE) == 0);
+	// Update may only swap the buffers, waiting for the wire would take up to a whole frame
+	const bool bNoWait = nUpdateMaxMicros < (nWireMicros / 2);
+	const bool bFrames = pCase->bCoalesce ? (nFrames < nCommits) : (nFrames == nCommits);
+
+	const bool bOk = bLastFrame && bNoWait && bFrames;
+
+	printf("%-20s : %4u commits, %4u frames on the wire (%4u coalesced), Update max %4u us avg %.2f us, wire busy %3u%% : %s\n",
+			pCase->pName, nCommits, nFrames, nCommits - nFrames, nUpdateMaxMicros,
+			nCommits == 0 ? 0.0 : (double) nUpdateTotalMicros / nCommits,
+			(unsigned) ((100 * (uint64_t) nFrames * nWireMicros) / nElapsed),
+			bOk ? "OK" : "WRONG");
+
+	if (!bLastFrame) {
+		printf("\tlast frame on the wire is not the last committed data\n");
+	}
+
+	if (!bFrames) {
+		printf("\tunexpected number of frames\n");
+	}
+
+	return bOk;
+}
+
+// A frame pending when the blackout comes must not be sent after it
+static bool run_blackout(void) {
+	WS28XXTransportSimulated transport(WS28XX_SPI_SPEED_HZ, BUFFER_SIZE);
+	WS28XXStripe stripe(WS2812B, LED_COUNT, 0, &transport);
+
+	drain(&stripe, &transport);
+
+	for (unsigned i = 0; i < LED_COUNT; i++) {
+		stripe.SetLED(i, 0xFF, 0xFF, 0xFF);
+	}
+
+	stripe.Update();	// on the wire
+
+	for (unsigned i = 0; i < LED_COUNT; i++) {
+		stripe.SetLED(i, 0x55, 0xAA, 0x55);
+	}
+
+	stripe.Update();	// pending
+	stripe.Blackout();
+
+	drain(&stripe, &transport);
+
+	memset(s_aLeds, 0, sizeof(s_aLeds));
+	expand(s_aLeds, s_aExpected);
+
+	const bool bOk = (memcmp(transport.GetLastFrame(), s_aExpected, BUFFER_SIZE) == 0) && !stripe.Run();
+
+	printf("%-20s : %s\n", "blackout", bOk ? "OK" : "WRONG");
+
+	return bOk;
+}
+
+int main(int argc, char **argv) {
+	bool bOk = true;
+
+	printf("WS2812B, %u LEDs, %u bytes at %u Hz\n", LED_COUNT, BUFFER_SIZE, WS28XX_SPI_SPEED_HZ);
+
+	for (unsigned i = 0; i < sizeof(s_aCases) / sizeof(s_aCases[0]); i++) {
+		bOk &= run_case(&s_aCases[i]);
+	}
+
+	bOk &= run_blackout();
+
+	printf("%s\n", bOk ? "OK" : "FAILED");
+
+	return bOk ? 0 : 1;
+}
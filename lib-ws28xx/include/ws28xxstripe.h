@@ -31,6 +31,8 @@
 #if defined (__circle__)
 #include <circle/interrupt.h>
 #include <circle/spimasterdma.h>
+#else
+#include "ws28xxtransport.h"
 #endif
 
 enum TWS28XXType {
@@ -46,13 +48,17 @@ enum TWS28XXType {
 #define WS2801_SPI_SPEED_MAX_HZ		25000000	///< 25 MHz
 #define WS2801_SPI_SPEED_DEFAULT_HZ	4000000		///< 4 MHz
 
+#define WS28XX_SPI_SPEED_HZ			6400000		///< 6.4 MHz, one SPI byte per WS28xx bit
+
 class WS28XXStripe {
 public:
 	// nClockSpeed is only variable on WS2801, otherwise ignored
 #if defined (__circle__)
 	WS28XXStripe (CInterruptSystem *pInterruptSystem, TWS28XXType Type, unsigned nLEDCount, unsigned nClockSpeed = WS2801_SPI_SPEED_DEFAULT_HZ);
 #else
-	WS28XXStripe(TWS28XXType Type, uint16_t nLEDCount, uint32_t nClockSpeed = WS2801_SPI_SPEED_DEFAULT_HZ);
+	// Without pTransport the stripe is driven by SPI0 (WS28XXTransportSpi),
+	// built with WS28XX_TRANSPORT_SIMULATED by WS28XXTransportSimulated
+	WS28XXStripe(TWS28XXType Type, uint16_t nLEDCount, uint32_t nClockSpeed = WS2801_SPI_SPEED_DEFAULT_HZ, WS28XXTransport *pTransport = 0);
 #endif
 	~WS28XXStripe(void);
 
@@ -70,20 +76,28 @@ public:
 	void SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue);					// nIndex is 0-based
 	void SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite);	// nIndex is 0-based
 
-	void Update(void);
-	void Blackout(void);
+	// pData holds nCount LEDs as R, G, B (W for SK6812W), nLEDIndex is 0-based
+	void SetLEDs(unsigned nLEDIndex, const uint8_t *pData, unsigned nCount);
 
+	// The SetLED* functions write the back buffer, which is never on the wire.
 #if defined (__circle__)
-	// returns TRUE while DMA operation is active
-	bool IsUpdating (void) const;
+	// Update waits for the previous frame to finish, swaps the buffers and starts the transfer.
+	void Update(void);
 #else
-	inline 	bool IsUpdating (void) const {
-		return false;
-	}
+	// Update swaps the buffers and starts the transfer when the wire is idle, otherwise
+	// the frame is pending and Run starts it. Later SetLED* calls go into the pending frame.
+	void Update(void);
+	// Call from the main loop, returns true when a pending frame was started
+	bool Run(void);
 #endif
+	void Blackout(void);
+
+	// returns TRUE while the front buffer is being sent, or a frame is pending (not Circle)
+	bool IsUpdating (void) const;
 
 private:
 	void SetColorWS28xx(unsigned nOffset, uint8_t nValue);
+	void FillBitExpansion(void);
 
 #if defined (__circle__)
 private:
@@ -95,13 +109,19 @@ private:
 	TWS28XXType			m_Type;
 	unsigned			m_nLEDCount;
 	unsigned			m_nBufSize;
-	uint8_t				*m_pBuffer;
+	uint8_t				*m_pBuffer;			///< Back buffer
+	uint8_t				*m_pFrontBuffer;
 	uint8_t				*m_pBlackoutBuffer;
-	volatile bool	 	m_bUpdating;
 	uint8_t				m_nHighCode;
+	uint64_t			m_aBitExpansion[256];	///< The 8 SPI bytes for each colour value
 #if defined (__circle__)
+	volatile bool	 	m_bUpdating;
 	uint8_t				*m_pReadBuffer;
 	CSPIMasterDMA	 	m_SPIMaster;
+#else
+	WS28XXTransport		*m_pTransport;
+	bool				m_bOwnTransport;
+	bool				m_bUpdatePending;
 #endif
 };
 
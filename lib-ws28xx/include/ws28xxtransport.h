@@ -0,0 +1,45 @@
+/**
+ * @file ws28xxtransport.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WS28XXTRANSPORT_H_
+#define WS28XXTRANSPORT_H_
+
+#include <stdint.h>
+
+/**
+ * Moves a prepared WS28xx bit stream out to the stripe.
+ * Start returns as soon as the transfer is running; the buffer must not be
+ * written until IsBusy returns false.
+ */
+class WS28XXTransport {
+public:
+	virtual ~WS28XXTransport(void) {
+	}
+
+	virtual void Start(const uint8_t *pBuffer, uint32_t nLength)=0;
+	virtual bool IsBusy(void)=0;
+};
+
+#endif /* WS28XXTRANSPORT_H_ */
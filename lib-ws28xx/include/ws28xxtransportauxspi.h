@@ -0,0 +1,49 @@
+/**
+ * @file ws28xxtransportauxspi.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WS28XXTRANSPORTAUXSPI_H_
+#define WS28XXTRANSPORTAUXSPI_H_
+
+#include <stdint.h>
+
+#include "ws28xxtransport.h"
+
+/**
+ * The auxiliary SPI1 (MOSI on GPIO20), for a second stripe output.
+ * The transfer is blocking, so IsBusy is always false. A WS28xx stripe cannot be fed from
+ * a polled FIFO, a gap on the wire latches it, so the stripe length is limited instead.
+ */
+#define WS28XX_AUX_SPI_MAX_LEDS	170	///< One universe, Start blocks for about 5 ms (WS2812 at 6.4 MHz)
+
+class WS28XXTransportAuxSpi: public WS28XXTransport {
+public:
+	WS28XXTransportAuxSpi(uint32_t nSpeedHz);
+	~WS28XXTransportAuxSpi(void);
+
+	void Start(const uint8_t *pBuffer, uint32_t nLength);
+	bool IsBusy(void);
+};
+
+#endif /* WS28XXTRANSPORTAUXSPI_H_ */
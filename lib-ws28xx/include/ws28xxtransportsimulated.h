@@ -0,0 +1,88 @@
+/**
+ * @file ws28xxtransportsimulated.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WS28XXTRANSPORTSIMULATED_H_
+#define WS28XXTRANSPORTSIMULATED_H_
+
+#include <stdint.h>
+
+#include "ws28xxtransport.h"
+
+/**
+ * Behaves like the DMA backend without touching any hardware: a transfer
+ * stays busy for as long as the bytes would take on the wire at nSpeedHz.
+ * The frame is captured when the transfer completes, so any write into
+ * the buffer while it is "on the wire" shows up in GetLastFrame.
+ */
+class WS28XXTransportSimulated: public WS28XXTransport {
+public:
+	WS28XXTransportSimulated(uint32_t nSpeedHz, uint32_t nMaxLength);
+	~WS28XXTransportSimulated(void);
+
+	void Start(const uint8_t *pBuffer, uint32_t nLength);
+	bool IsBusy(void);
+
+	uint32_t GetFrameCount(void) const {
+		return m_nFrameCount;
+	}
+
+	/// Time between the end of the previous transfer and the start of the last one
+	uint32_t GetLastIdleMicros(void) const {
+		return m_nLastIdleMicros;
+	}
+
+	/// Sum of the idle gaps between transfers, not counting the first one
+	uint64_t GetTotalIdleMicros(void) const {
+		return m_nTotalIdleMicros;
+	}
+
+	const uint8_t *GetLastFrame(void) const {
+		return m_pLastFrame;
+	}
+
+	uint32_t GetLastFrameLength(void) const {
+		return m_nLastFrameLength;
+	}
+
+private:
+	static uint32_t Micros(void);
+
+private:
+	uint32_t m_nSpeedHz;
+	uint32_t m_nMaxLength;
+	const uint8_t *m_pBuffer;
+	uint32_t m_nLength;
+	bool m_bBusy;
+	uint32_t m_nStartMicros;
+	uint32_t m_nDurationMicros;
+	uint32_t m_nEndMicros;
+	uint32_t m_nFrameCount;
+	uint32_t m_nLastIdleMicros;
+	uint64_t m_nTotalIdleMicros;
+	uint8_t *m_pLastFrame;
+	uint32_t m_nLastFrameLength;
+};
+
+#endif /* WS28XXTRANSPORTSIMULATED_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file ws28xxtransportspi.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WS28XXTRANSPORTSPI_H_
+#define WS28XXTRANSPORTSPI_H_
+
+#include <stdint.h>
+
+#include "ws28xxtransport.h"
+
+/**
+ * SPI0 with DMA on bare metal. On Linux the transfer is blocking,
+ * so IsBusy is always false.
+ */
+class WS28XXTransportSpi: public WS28XXTransport {
+public:
+	WS28XXTransportSpi(uint32_t nSpeedHz);
+	~WS28XXTransportSpi(void);
+
+	void Start(const uint8_t *pBuffer, uint32_t nLength);
+	bool IsBusy(void);
+};
+
+#endif /* WS28XXTRANSPORTSPI_H_ */
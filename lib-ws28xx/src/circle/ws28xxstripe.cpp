@@ -37,9 +37,9 @@
 WS28XXStripe::WS28XXStripe (CInterruptSystem *pInterruptSystem, TWS28XXType Type, unsigned nLEDCount, unsigned nClockSpeed)
 :	m_Type (Type),
 	m_nLEDCount (nLEDCount),
-	m_bUpdating (FALSE),
 	m_nHighCode(Type == WS2812B ? 0xF8 : 0xF0),
-	m_SPIMaster (pInterruptSystem, m_Type == WS2801 ? nClockSpeed : 6400000, 0, 0)
+	m_bUpdating (FALSE),
+	m_SPIMaster (pInterruptSystem, m_Type == WS2801 ? nClockSpeed : WS28XX_SPI_SPEED_HZ, 0, 0)
 {
 	assert(m_Type <= SK6812W);
 	assert(m_nLEDCount > 0);
@@ -54,6 +54,8 @@ WS28XXStripe::WS28XXStripe (CInterruptSystem *pInterruptSystem, TWS28XXType Type
 		m_nBufSize *= 8;
 	}
 
+	FillBitExpansion();
+
 	m_pBuffer = new u8[m_nBufSize];
 	assert(m_pBuffer != 0);
 
@@ -61,6 +63,10 @@ WS28XXStripe::WS28XXStripe (CInterruptSystem *pInterruptSystem, TWS28XXType Type
 		SetLED(nLEDIndex, 0, 0, 0);
 	}
 
+	m_pFrontBuffer = new u8[m_nBufSize];
+	assert(m_pFrontBuffer != 0);
+	memcpy(m_pFrontBuffer, m_pBuffer, m_nBufSize);
+
 	m_pReadBuffer = new u8[m_nBufSize];
 	assert(m_pReadBuffer != 0);
 
@@ -80,6 +86,9 @@ WS28XXStripe::~WS28XXStripe(void) {
 	delete[] m_pReadBuffer;
 	m_pReadBuffer = 0;
 
+	delete[] m_pFrontBuffer;
+	m_pFrontBuffer = 0;
+
 	delete[] m_pBuffer;
 	m_pBuffer = 0;
 }
@@ -89,18 +98,31 @@ bool WS28XXStripe::Initialize(void) {
 }
 
 void WS28XXStripe::Update(void) {
-	assert(!m_bUpdating);
+	assert(m_pBuffer != 0);
+	assert(m_pFrontBuffer != 0);
+	assert(m_pReadBuffer != 0);
+
+	while (m_bUpdating) {
+		// the previous frame is still on the wire
+	}
+
+	u8 *pBuffer = m_pFrontBuffer;
+	m_pFrontBuffer = m_pBuffer;
+	m_pBuffer = pBuffer;
+
+	memcpy(m_pBuffer, m_pFrontBuffer, m_nBufSize);
+
 	m_bUpdating = TRUE;
 
 	m_SPIMaster.SetCompletionRoutine(SPICompletionStub, this);
-
-	assert(m_pBuffer != 0);
-	assert(m_pReadBuffer != 0);
-	m_SPIMaster.StartWriteRead(0, m_pBuffer, m_pReadBuffer, m_nBufSize);
+	m_SPIMaster.StartWriteRead(0, m_pFrontBuffer, m_pReadBuffer, m_nBufSize);
 }
 
 void WS28XXStripe::Blackout(void) {
-	assert(!m_bUpdating);
+	while (m_bUpdating) {
+		// the previous frame is still on the wire
+	}
+
 	m_bUpdating = TRUE;
 
 	m_SPIMaster.SetCompletionRoutine(SPICompletionStub, this);
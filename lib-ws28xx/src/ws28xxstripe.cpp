@@ -28,19 +28,25 @@
 
 #if defined(__linux__)
  #include <string.h>
- #include "bcm2835.h"
 #else
- #include "bcm2835_spi.h"
  #include "util.h"
 #endif
 
 #include "ws28xxstripe.h"
+#include "ws28xxtransport.h"
+#if defined (WS28XX_TRANSPORT_SIMULATED)
+ #include "ws28xxtransportsimulated.h"
+#else
+ #include "ws28xxtransportspi.h"
+#endif
 
-WS28XXStripe::WS28XXStripe(TWS28XXType Type, uint16_t nLEDCount, uint32_t nClockSpeed) :
+WS28XXStripe::WS28XXStripe(TWS28XXType Type, uint16_t nLEDCount, uint32_t nClockSpeed, WS28XXTransport *pTransport) :
 	m_Type(Type),
 	m_nLEDCount(nLEDCount),
-	m_bUpdating(false),
-	m_nHighCode(Type == WS2812B ? 0xF8 : 0xF0)
+	m_nHighCode(Type == WS2812B ? 0xF8 : 0xF0),
+	m_pTransport(pTransport),
+	m_bOwnTransport(false),
+	m_bUpdatePending(false)
 {
 	if (Type == SK6812W) {
 		m_nBufSize = nLEDCount * 4;
@@ -52,50 +58,103 @@ WS28XXStripe::WS28XXStripe(TWS28XXType Type, uint16_t nLEDCount, uint32_t nClock
 		m_nBufSize *= 8;
 	}
 
-	m_pBuffer = new uint8_t[m_nBufSize];
+	FillBitExpansion();
+
+	// The DMA transfers whole 32-bit words
+	const unsigned nAllocSize = (m_nBufSize + 3) & ~3;
+
+	m_pBuffer = new uint8_t[nAllocSize];
 	assert(m_pBuffer != 0);
-	memset(m_pBuffer, m_Type == WS2801 ? 0 : 0xC0, m_nBufSize);
+	memset(m_pBuffer, m_Type == WS2801 ? 0 : 0xC0, nAllocSize);
 
-	m_pBlackoutBuffer = new uint8_t[m_nBufSize];
+	m_pFrontBuffer = new uint8_t[nAllocSize];
+	assert(m_pFrontBuffer != 0);
+	memset(m_pFrontBuffer, m_Type == WS2801 ? 0 : 0xC0, nAllocSize);
+
+	m_pBlackoutBuffer = new uint8_t[nAllocSize];
 	assert(m_pBlackoutBuffer != 0);
-	memset(m_pBlackoutBuffer, m_Type == WS2801 ? 0 : 0xC0, m_nBufSize);
+	memset(m_pBlackoutBuffer, m_Type == WS2801 ? 0 : 0xC0, nAllocSize);
 
-	bcm2835_spi_begin();
+	if (m_pTransport == 0) {
+		uint32_t nSpeedHz = WS28XX_SPI_SPEED_HZ;
 
-	if (Type == WS2801) {
-		if (nClockSpeed == (uint32_t) 0) {
-			bcm2835_spi_setClockDivider((uint16_t) ((uint32_t) BCM2835_CORE_CLK_HZ / (uint32_t) WS2801_SPI_SPEED_DEFAULT_HZ));
-		} else {
-			bcm2835_spi_setClockDivider((uint16_t) ((uint32_t) BCM2835_CORE_CLK_HZ / nClockSpeed));
+		if (Type == WS2801) {
+			nSpeedHz = (nClockSpeed == 0 ? WS2801_SPI_SPEED_DEFAULT_HZ : nClockSpeed);
 		}
-	} else {
-		bcm2835_spi_setClockDivider((uint16_t) ((uint32_t) BCM2835_CORE_CLK_HZ / (uint32_t) 6400000));
-	}
 
-	bcm2835_spi_chipSelect(BCM2835_SPI_CS0);
-	bcm2835_spi_setChipSelectPolarity(BCM2835_SPI_CS0, LOW);
+#if defined (WS28XX_TRANSPORT_SIMULATED)
+		m_pTransport = new WS28XXTransportSimulated(nSpeedHz, nAllocSize);
+#else
+		m_pTransport = new WS28XXTransportSpi(nSpeedHz);
+#endif
+		assert(m_pTransport != 0);
+		m_bOwnTransport = true;
+	}
 
 	Update();
 }
 
 WS28XXStripe::~WS28XXStripe(void) {
+	while (m_pTransport->IsBusy()) {
+		// wait for completion
+	}
+
+	if (m_bOwnTransport) {
+		delete m_pTransport;
+	}
+	m_pTransport = 0;
+
 	delete [] m_pBlackoutBuffer;
 	m_pBlackoutBuffer = 0;
 
+	delete [] m_pFrontBuffer;
+	m_pFrontBuffer = 0;
+
 	delete [] m_pBuffer;
 	m_pBuffer = 0;
 }
 
 void WS28XXStripe::Update(void) {
-	assert (m_pBuffer != 0);
+	m_bUpdatePending = true;
 
-	__sync_synchronize();
-	bcm2835_spi_writenb((char *) m_pBuffer, m_nBufSize);
+	(void) Run();
+}
+
+bool WS28XXStripe::Run(void) {
+	assert(m_pBuffer != 0);
+	assert(m_pFrontBuffer != 0);
+
+	if (!m_bUpdatePending || m_pTransport->IsBusy()) {
+		return false;
+	}
+
+	m_bUpdatePending = false;
+
+	uint8_t *pBuffer = m_pFrontBuffer;
+	m_pFrontBuffer = m_pBuffer;
+	m_pBuffer = pBuffer;
+
+	// Ports may update only a part of the stripe, so the back buffer continues from this frame
+	memcpy(m_pBuffer, m_pFrontBuffer, m_nBufSize);
+
+	m_pTransport->Start(m_pFrontBuffer, m_nBufSize);
+
+	return true;
 }
 
 void WS28XXStripe::Blackout(void) {
-	assert (m_pBlackoutBuffer != 0);
+	assert(m_pBlackoutBuffer != 0);
+
+	// A frame still waiting for the wire must not follow the blackout
+	m_bUpdatePending = false;
+
+	while (m_pTransport->IsBusy()) {
+		// the previous frame is still on the wire
+	}
+
+	m_pTransport->Start(m_pBlackoutBuffer, m_nBufSize);
+}
 
-	__sync_synchronize();
-	bcm2835_spi_writenb((char *) m_pBlackoutBuffer, m_nBufSize);
+bool WS28XXStripe::IsUpdating(void) const {
+	return m_bUpdatePending || m_pTransport->IsBusy();
 }
@@ -28,8 +28,6 @@
 #include "ws28xxstripe.h"
 
 void WS28XXStripe::SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue) {
-	assert(!m_bUpdating);
-
 	assert(m_pBuffer != 0);
 	assert(nLEDIndex < m_nLEDCount);
 	unsigned nOffset = nLEDIndex * 3;
@@ -55,8 +53,6 @@ void WS28XXStripe::SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint
 }
 
 void WS28XXStripe::SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint8_t nBlue, uint8_t nWhite) {
-	assert(!m_bUpdating);
-
 	assert(m_pBuffer != 0);
 	assert(nLEDIndex < m_nLEDCount);
 	assert(m_Type == SK6812W);
@@ -75,18 +71,89 @@ void WS28XXStripe::SetLED(unsigned nLEDIndex, uint8_t nRed, uint8_t nGreen, uint
 
 void WS28XXStripe::SetColorWS28xx(unsigned nOffset, uint8_t nValue) {
 	assert(m_Type != WS2801);
-	uint8_t mask;
-
 	assert(nOffset + 7 < m_nBufSize);
 
-	for (mask = 0x80; mask != 0; mask >>= 1) {
-		if (nValue & mask) {
-			m_pBuffer[nOffset] = m_nHighCode;
-		} else {
-			m_pBuffer[nOffset] = 0xC0;	// Same for all
+	__builtin_memcpy(&m_pBuffer[nOffset], &m_aBitExpansion[nValue], 8);
+}
+
+/*
+ * Each bit of a colour value is sent as one SPI byte : m_nHighCode for a 1, 0xC0 for a 0.
+ */
+void WS28XXStripe::FillBitExpansion(void) {
+	for (unsigned nValue = 0; nValue < 256; nValue++) {
+		uint8_t *p = (uint8_t *) &m_aBitExpansion[nValue];
+
+		for (unsigned nMask = 0x80; nMask != 0; nMask >>= 1) {
+			*p++ = (nValue & nMask) ? m_nHighCode : 0xC0;	// 0xC0 is the same for all
+		}
+	}
+}
+
+/*
+ * The order in which the colours are sent to the chip. The DMX data is always R, G, B [, W].
+ */
+template<TWS28XXType T> struct WS28XXWireOrder {
+	enum { CHANNELS = 3, FIRST = 1, SECOND = 0, THIRD = 2, FOURTH = 0 };	// GRB
+};
+
+template<> struct WS28XXWireOrder<WS2801> {
+	enum { CHANNELS = 3, FIRST = 0, SECOND = 1, THIRD = 2, FOURTH = 0 };	// RGB
+};
+
+template<> struct WS28XXWireOrder<WS2811> {
+	enum { CHANNELS = 3, FIRST = 0, SECOND = 1, THIRD = 2, FOURTH = 0 };	// RGB
+};
+
+template<> struct WS28XXWireOrder<SK6812W> {
+	enum { CHANNELS = 4, FIRST = 1, SECOND = 0, THIRD = 2, FOURTH = 3 };	// GRBW
+};
+
+template<class TOrder>
+static void CopyLEDs(uint8_t *pDst, const uint8_t *pSrc, unsigned nCount) {
+	for (unsigned i = 0; i < nCount; i++) {
+		pDst[0] = pSrc[TOrder::FIRST];
+		pDst[1] = pSrc[TOrder::SECOND];
+		pDst[2] = pSrc[TOrder::THIRD];
+
+		pDst += TOrder::CHANNELS;
+		pSrc += TOrder::CHANNELS;
+	}
+}
+
+template<class TOrder>
+static void ExpandLEDs(uint8_t *pDst, const uint8_t *pSrc, unsigned nCount, const uint64_t *pBitExpansion) {
+	for (unsigned i = 0; i < nCount; i++) {
+		__builtin_memcpy(&pDst[0], &pBitExpansion[pSrc[TOrder::FIRST]], 8);
+		__builtin_memcpy(&pDst[8], &pBitExpansion[pSrc[TOrder::SECOND]], 8);
+		__builtin_memcpy(&pDst[16], &pBitExpansion[pSrc[TOrder::THIRD]], 8);
+
+		if (TOrder::CHANNELS == 4) {
+			__builtin_memcpy(&pDst[24], &pBitExpansion[pSrc[TOrder::FOURTH]], 8);
 		}
 
-		nOffset++;
+		pDst += 8 * TOrder::CHANNELS;
+		pSrc += TOrder::CHANNELS;
+	}
+}
+
+void WS28XXStripe::SetLEDs(unsigned nLEDIndex, const uint8_t *pData, unsigned nCount) {
+	assert(m_pBuffer != 0);
+	assert(pData != 0);
+	assert(nLEDIndex + nCount <= m_nLEDCount);
+
+	switch (m_Type) {
+	case WS2801:
+		CopyLEDs<WS28XXWireOrder<WS2801> >(&m_pBuffer[nLEDIndex * 3], pData, nCount);
+		break;
+	case WS2811:
+		ExpandLEDs<WS28XXWireOrder<WS2811> >(&m_pBuffer[nLEDIndex * 3 * 8], pData, nCount, m_aBitExpansion);
+		break;
+	case SK6812W:
+		ExpandLEDs<WS28XXWireOrder<SK6812W> >(&m_pBuffer[nLEDIndex * 4 * 8], pData, nCount, m_aBitExpansion);
+		break;
+	default:
+		ExpandLEDs<WS28XXWireOrder<WS2812> >(&m_pBuffer[nLEDIndex * 3 * 8], pData, nCount, m_aBitExpansion);
+		break;
 	}
 }
 
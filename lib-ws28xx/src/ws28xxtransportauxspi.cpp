@@ -0,0 +1,56 @@
+/**
+ * @file ws28xxtransportauxspi.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#if defined(__linux__)
+ #include "bcm2835.h"
+#else
+ #include "bcm2835_aux_spi.h"
+#endif
+
+#include "ws28xxtransportauxspi.h"
+
+WS28XXTransportAuxSpi::WS28XXTransportAuxSpi(uint32_t nSpeedHz) {
+	assert(nSpeedHz != 0);
+
+	bcm2835_aux_spi_begin();
+	bcm2835_aux_spi_setClockDivider(bcm2835_aux_spi_CalcClockDivider(nSpeedHz));
+}
+
+WS28XXTransportAuxSpi::~WS28XXTransportAuxSpi(void) {
+}
+
+void WS28XXTransportAuxSpi::Start(const uint8_t *pBuffer, uint32_t nLength) {
+	assert(pBuffer != 0);
+
+	__sync_synchronize();
+	bcm2835_aux_spi_writenb((const char *) pBuffer, nLength);
+}
+
+bool WS28XXTransportAuxSpi::IsBusy(void) {
+	return false;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file ws28xxtransportsimulated.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+
+#if defined(__linux__)
+ #include <string.h>
+ #include <sys/time.h>
+#else
+ #include "bcm2835.h"
+ #include "util.h"
+#endif
+
+#include "ws28xxtransportsimulated.h"
+
+WS28XXTransportSimulated::WS28XXTransportSimulated(uint32_t nSpeedHz, uint32_t nMaxLength) :
+	m_nSpeedHz(nSpeedHz),
+	m_nMaxLength(nMaxLength),
+	m_pBuffer(0),
+	m_nLength(0),
+	m_bBusy(false),
+	m_nStartMicros(0),
+	m_nDurationMicros(0),
+	m_nEndMicros(0),
+	m_nFrameCount(0),
+	m_nLastIdleMicros(0),
+	m_nTotalIdleMicros(0),
+	m_nLastFrameLength(0)
+{
+	assert(nSpeedHz != 0);
+
+	m_pLastFrame = new uint8_t[nMaxLength];
+	assert(m_pLastFrame != 0);
+	memset(m_pLastFrame, 0, nMaxLength);
+}
+
+WS28XXTransportSimulated::~WS28XXTransportSimulated(void) {
+	delete [] m_pLastFrame;
+	m_pLastFrame = 0;
+}
+
+uint32_t WS28XXTransportSimulated::Micros(void) {
+#if defined(__linux__)
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return (uint32_t) (tv.tv_sec * 1000000 + tv.tv_usec);
+#else
+	return BCM2835_ST->CLO;
+#endif
+}
+
+void WS28XXTransportSimulated::Start(const uint8_t *pBuffer, uint32_t nLength) {
+	assert(pBuffer != 0);
+	assert(nLength <= m_nMaxLength);
+	assert(!IsBusy());
+
+	m_nStartMicros = Micros();
+
+	if (m_nFrameCount != 0) {
+		m_nLastIdleMicros = m_nStartMicros - m_nEndMicros;
+		m_nTotalIdleMicros += m_nLastIdleMicros;
+	}
+
+	m_pBuffer = pBuffer;
+	m_nLength = nLength;
+	m_nDurationMicros = (uint32_t) (((uint64_t) nLength * 8 * 1000000) / m_nSpeedHz);
+	m_bBusy = true;
+	m_nFrameCount++;
+}
+
+bool WS28XXTransportSimulated::IsBusy(void) {
+	if (!m_bBusy) {
+		return false;
+	}
+
+	const uint32_t nNowMicros = Micros();
+
+	if ((nNowMicros - m_nStartMicros) < m_nDurationMicros) {
+		return true;
+	}
+
+	// The last byte has left, so this is what the stripe has latched
+	memcpy(m_pLastFrame, m_pBuffer, m_nLength);
+	m_nLastFrameLength = m_nLength;
+
+	m_nEndMicros = m_nStartMicros + m_nDurationMicros;
+	m_bBusy = false;
+
+	return false;
+}
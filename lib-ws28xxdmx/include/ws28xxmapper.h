@@ -0,0 +1,132 @@
+/**
+ * @file ws28xxmapper.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WS28XXMAPPER_H_
+#define WS28XXMAPPER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ws28xxstripe.h"
+
+#define WS28XX_MAPPER_MAX_UNIVERSES			32		///< One bit each in the received mask, matches the Art-Net and E1.31 port count
+#define WS28XX_MAPPER_MAX_OUTPUTS			2		///< SPI0 and the auxiliary SPI1
+#define WS28XX_MAPPER_MAX_LEDS_PER_OUTPUT	2040	///< 32 SPI bytes per SK6812W LED must fit a 16-bit DMA length
+
+/**
+ * A run of LEDs on one output that is fed from consecutive DMX pixels of one universe.
+ */
+struct TWS28XXMapperSlice {
+	uint16_t nPixel;		///< First DMX pixel in the universe
+	uint16_t nLEDIndex;		///< LED fed by the first DMX pixel
+	uint16_t nLEDCount;
+	uint8_t nOutput;
+	uint8_t nGroupPhase;	///< Number of LEDs of the first DMX pixel that are in the previous slice
+	bool bReverse;			///< LED index is counting down
+};
+
+class WS28XXMapper {
+public:
+	WS28XXMapper(void);
+	~WS28XXMapper(void);
+
+	void SetChannelsPerLed(uint8_t nChannelsPerLed);
+	void SetLEDCount(uint16_t nLEDCount);	///< LEDs on each output
+	void SetOutputs(uint8_t nOutputs);
+	void SetPixelsPerUniverse(uint16_t nPixelsPerUniverse);
+	void SetGrouping(uint8_t nGrouping);	///< Adjacent LEDs showing the same DMX pixel
+	void SetSegmentLength(uint16_t nSegmentLength);
+	void SetZigzag(bool bZigzag);			///< Every other segment runs backwards
+	void SetReverse(bool bReverse);			///< Each output is fed from its far end
+
+	uint16_t GetLEDCount(void) const {
+		return m_nLEDCount;
+	}
+
+	uint16_t GetPixelsPerUniverse(void) const {
+		return m_nPixelsPerUniverse;
+	}
+
+	uint8_t GetGrouping(void) const {
+		return m_nGrouping;
+	}
+
+	uint16_t GetSegmentLength(void) const {
+		return m_nSegmentLength;
+	}
+
+	bool IsZigzag(void) const {
+		return m_bZigzag;
+	}
+
+	bool IsReverse(void) const {
+		return m_bReverse;
+	}
+
+	uint8_t GetOutputs(void) const {
+		return m_nOutputs;
+	}
+
+	/**
+	 * Precomputes the slice table. Must be called after any of the Set functions.
+	 */
+	void Build(void);
+
+	uint8_t GetUniverseCount(void) const {
+		return m_nUniverses;
+	}
+
+	uint16_t GetSliceCount(void) const {
+		return m_nSlices;
+	}
+
+	/**
+	 * Writes the universe into the back buffers of the outputs.
+	 * @return bitmask of the outputs that have been written
+	 */
+	uint8_t Map(uint8_t nUniverse, const uint8_t *pData, uint16_t nLength, WS28XXStripe * const *pOutputs);
+
+private:
+	uint16_t Orientate(uint16_t nLEDIndex) const;
+	uint16_t BuildSlices(struct TWS28XXMapperSlice *pSlices);
+
+private:
+	uint8_t m_nChannelsPerLed;
+	uint16_t m_nLEDCount;
+	uint8_t m_nOutputs;
+	uint16_t m_nPixelsPerUniverse;
+	uint8_t m_nGrouping;
+	uint16_t m_nSegmentLength;
+	bool m_bZigzag;
+	bool m_bReverse;
+	uint8_t m_nUniverses;
+	uint16_t m_nSlices;
+	struct TWS28XXMapperSlice *m_pSlices;
+	uint16_t m_aFirstSlice[WS28XX_MAPPER_MAX_UNIVERSES + 1];	///< Slices of universe n are [m_aFirstSlice[n], m_aFirstSlice[n + 1])
+	uint8_t *m_pScratch;	///< Reordered pixels for grouped and reversed slices
+	uint16_t m_nScratchLEDs;
+};
+
+#endif /* WS28XXMAPPER_H_ */
@@ -35,6 +35,7 @@
 #include "lightset.h"
 
 #include "ws28xxstripe.h"
+#include "ws28xxmapper.h"
 
 class SPISend: public LightSet {
 public:
@@ -49,6 +50,12 @@ public:
 	void Stop(void);
 
 	void SetData(uint8_t, const uint8_t *, uint16_t);
+	void Sync(void);
+
+#if !defined (__circle__)
+	// Starts the committed frames that were waiting for the wire, call from the main loop
+	void Run(void);
+#endif
 
 	void SetLEDType(const TWS28XXType);
 	TWS28XXType GetLEDType(void) const;
@@ -56,6 +63,30 @@ public:
 	void SetLEDCount(uint16_t);
 	uint16_t GetLEDCount(void) const;
 
+	void SetOutputs(uint8_t nOutputs);
+	uint8_t GetOutputs(void) const {
+		return m_Mapper.GetOutputs();
+	}
+
+	void SetPixelsPerUniverse(uint16_t nPixelsPerUniverse);
+	uint16_t GetPixelsPerUniverse(void) const {
+		return m_Mapper.GetPixelsPerUniverse();
+	}
+
+	void SetGrouping(uint8_t nGrouping);
+	uint8_t GetGrouping(void) const {
+		return m_Mapper.GetGrouping();
+	}
+
+	void SetSegmentLength(uint16_t nSegmentLength);
+	void SetZigzag(bool bZigzag);
+	void SetReverse(bool bReverse);
+
+	// Number of consecutive ports (universes) that feed the outputs
+	uint8_t GetUniverseCount(void) const {
+		return m_Mapper.GetUniverseCount();
+	}
+
 	void Print(void);
 
 public: // RDM
@@ -78,6 +109,7 @@ private:
 
 private:
 	void UpdateMembers(void);
+	void Commit(void);
 
 private:
 	uint16_t m_nDmxStartAddress;
@@ -85,15 +117,19 @@ private:
 
 	bool m_bIsStarted;
 
-	WS28XXStripe	*m_pLEDStripe;
+	WS28XXStripe	*m_pLEDStripes[WS28XX_MAPPER_MAX_OUTPUTS];
+#if !defined (__circle__)
+	WS28XXTransport	*m_pTransports[WS28XX_MAPPER_MAX_OUTPUTS];	///< Only for the outputs after SPI0
+#endif
 	TWS28XXType		m_LEDType;
 	uint16_t		m_nLEDCount;
 
-	uint16_t		m_nBeginIndexPortId1;
-	uint16_t		m_nBeginIndexPortId2;
-	uint16_t		m_nBeginIndexPortId3;
-
 	uint16_t		m_nChannelsPerLed;
+
+	WS28XXMapper	m_Mapper;
+	uint32_t		m_nReceivedMask;		///< Universes received since the last commit
+	uint32_t		m_nUniversesMask;		///< All mapped universes
+	uint8_t			m_nOutputsPending;		///< Outputs written since the last commit
 };
 
 #endif /* SPISEND_H_ */
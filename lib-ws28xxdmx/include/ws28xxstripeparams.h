@@ -59,6 +59,12 @@ private:
     uint32_t m_bSetList;
 	TWS28XXType tLedType;
 	uint16_t nLedCount;
+	uint8_t m_nOutputs;
+	uint16_t m_nPixelsPerUniverse;
+	uint8_t m_nGrouping;
+	uint16_t m_nSegmentLength;
+	bool m_bZigzag;
+	bool m_bReverse;
 };
 
 #endif /* WS28XXSTRIPEPARAMS_H_ */
@@ -0,0 +1,279 @@
+/**
+ * @file ws28xxmapper.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "ws28xxmapper.h"
+#include "ws28xxstripe.h"
+
+#define DMX_MAX_CHANNELS	512
+
+WS28XXMapper::WS28XXMapper(void) :
+	m_nChannelsPerLed(3),
+	m_nLEDCount(170),
+	m_nOutputs(1),
+	m_nPixelsPerUniverse(0),
+	m_nGrouping(1),
+	m_nSegmentLength(0),
+	m_bZigzag(false),
+	m_bReverse(false),
+	m_nUniverses(0),
+	m_nSlices(0),
+	m_pSlices(0),
+	m_pScratch(0),
+	m_nScratchLEDs(0)
+{
+	for (unsigned i = 0; i <= WS28XX_MAPPER_MAX_UNIVERSES; i++) {
+		m_aFirstSlice[i] = 0;
+	}
+}
+
+WS28XXMapper::~WS28XXMapper(void) {
+	delete [] m_pScratch;
+	m_pScratch = 0;
+
+	delete [] m_pSlices;
+	m_pSlices = 0;
+}
+
+void WS28XXMapper::SetChannelsPerLed(uint8_t nChannelsPerLed) {
+	assert((nChannelsPerLed == 3) || (nChannelsPerLed == 4));
+	m_nChannelsPerLed = nChannelsPerLed;
+}
+
+void WS28XXMapper::SetLEDCount(uint16_t nLEDCount) {
+	if ((nLEDCount != 0) && (nLEDCount <= WS28XX_MAPPER_MAX_LEDS_PER_OUTPUT)) {
+		m_nLEDCount = nLEDCount;
+	}
+}
+
+void WS28XXMapper::SetOutputs(uint8_t nOutputs) {
+	if ((nOutputs != 0) && (nOutputs <= WS28XX_MAPPER_MAX_OUTPUTS)) {
+		m_nOutputs = nOutputs;
+	}
+}
+
+void WS28XXMapper::SetPixelsPerUniverse(uint16_t nPixelsPerUniverse) {
+	// 0 is a full universe, the upper limit depends on the LED type and is checked in Build
+	m_nPixelsPerUniverse = nPixelsPerUniverse;
+}
+
+void WS28XXMapper::SetGrouping(uint8_t nGrouping) {
+	if (nGrouping != 0) {
+		m_nGrouping = nGrouping;
+	}
+}
+
+void WS28XXMapper::SetSegmentLength(uint16_t nSegmentLength) {
+	m_nSegmentLength = nSegmentLength;
+}
+
+void WS28XXMapper::SetZigzag(bool bZigzag) {
+	m_bZigzag = bZigzag;
+}
+
+void WS28XXMapper::SetReverse(bool bReverse) {
+	m_bReverse = bReverse;
+}
+
+uint16_t WS28XXMapper::Orientate(uint16_t nLEDIndex) const {
+	if (m_bZigzag && (m_nSegmentLength != 0)) {
+		const uint16_t nSegment = nLEDIndex / m_nSegmentLength;
+
+		if ((nSegment & 1) == 1) {
+			const uint16_t nFirst = nSegment * m_nSegmentLength;
+			uint16_t nLast = nFirst + m_nSegmentLength - 1;
+
+			if (nLast >= m_nLEDCount) {
+				nLast = m_nLEDCount - 1;
+			}
+
+			nLEDIndex = nLast - (nLEDIndex - nFirst);
+		}
+	}
+
+	if (m_bReverse) {
+		nLEDIndex = m_nLEDCount - 1 - nLEDIndex;
+	}
+
+	return nLEDIndex;
+}
+
+/*
+ * Walks all LEDs in DMX order and starts a new slice whenever the universe
+ * or the output changes, or the next LED is not adjacent to the previous one.
+ * With pSlices == 0 the slices are only counted.
+ */
+uint16_t WS28XXMapper::BuildSlices(struct TWS28XXMapperSlice *pSlices) {
+	const uint32_t nTotalLEDs = (uint32_t) m_nLEDCount * m_nOutputs;
+	struct TWS28XXMapperSlice tSlice;
+	bool bIsOpen = false;
+	uint16_t nSlices = 0;
+
+	m_nUniverses = 0;
+	m_nScratchLEDs = 0;
+
+	for (uint32_t i = 0; i <= nTotalLEDs; i++) {
+		uint32_t nUniverse = WS28XX_MAPPER_MAX_UNIVERSES;
+		uint8_t nOutput = 0;
+		uint16_t nLEDIndex = 0;
+
+		if (i < nTotalLEDs) {
+			nUniverse = (i / m_nGrouping) / m_nPixelsPerUniverse;
+			nOutput = (uint8_t) (i / m_nLEDCount);
+			nLEDIndex = Orientate((uint16_t) (i % m_nLEDCount));
+		}
+
+		if (bIsOpen && (nUniverse == (uint32_t) (m_nUniverses - 1)) && (nOutput == tSlice.nOutput)) {
+			const uint16_t nLast = tSlice.bReverse ? tSlice.nLEDIndex - (tSlice.nLEDCount - 1) : tSlice.nLEDIndex + (tSlice.nLEDCount - 1);
+
+			if ((tSlice.nLEDCount == 1) && (nLEDIndex + 1 == nLast)) {
+				tSlice.bReverse = true;
+			}
+
+			if ((!tSlice.bReverse && (nLEDIndex == nLast + 1)) || (tSlice.bReverse && (nLEDIndex + 1 == nLast))) {
+				tSlice.nLEDCount++;
+				continue;
+			}
+		}
+
+		if (bIsOpen) {
+			if (pSlices != 0) {
+				pSlices[nSlices] = tSlice;
+			}
+
+			nSlices++;
+
+			if ((tSlice.bReverse || (m_nGrouping != 1)) && (tSlice.nLEDCount > m_nScratchLEDs)) {
+				m_nScratchLEDs = tSlice.nLEDCount;
+			}
+
+			bIsOpen = false;
+		}
+
+		if (nUniverse >= WS28XX_MAPPER_MAX_UNIVERSES) {
+			break;
+		}
+
+		while (m_nUniverses <= nUniverse) {
+			m_aFirstSlice[m_nUniverses++] = nSlices;
+		}
+
+		tSlice.nPixel = (uint16_t) ((i / m_nGrouping) % m_nPixelsPerUniverse);
+		tSlice.nLEDIndex = nLEDIndex;
+		tSlice.nLEDCount = 1;
+		tSlice.nOutput = nOutput;
+		tSlice.nGroupPhase = (uint8_t) (i % m_nGrouping);
+		tSlice.bReverse = false;
+
+		bIsOpen = true;
+	}
+
+	for (unsigned i = m_nUniverses; i <= WS28XX_MAPPER_MAX_UNIVERSES; i++) {
+		m_aFirstSlice[i] = nSlices;
+	}
+
+	return nSlices;
+}
+
+void WS28XXMapper::Build(void) {
+	const uint16_t nMaxPixels = DMX_MAX_CHANNELS / m_nChannelsPerLed;
+
+	if ((m_nPixelsPerUniverse == 0) || (m_nPixelsPerUniverse > nMaxPixels)) {
+		m_nPixelsPerUniverse = nMaxPixels;
+	}
+
+	delete [] m_pScratch;
+	m_pScratch = 0;
+
+	delete [] m_pSlices;
+	m_pSlices = 0;
+
+	m_nSlices = BuildSlices(0);
+
+	m_pSlices = new struct TWS28XXMapperSlice[m_nSlices];
+	assert(m_pSlices != 0);
+
+	(void) BuildSlices(m_pSlices);
+
+	if (m_nScratchLEDs != 0) {
+		m_pScratch = new uint8_t[m_nScratchLEDs * m_nChannelsPerLed];
+		assert(m_pScratch != 0);
+	}
+}
+
+uint8_t WS28XXMapper::Map(uint8_t nUniverse, const uint8_t *pData, uint16_t nLength, WS28XXStripe * const *pOutputs) {
+	assert(pData != 0);
+	assert(pOutputs != 0);
+
+	if (nUniverse >= m_nUniverses) {
+		return 0;
+	}
+
+	const uint16_t nPixels = nLength / m_nChannelsPerLed;
+	uint8_t nOutputMask = 0;
+
+	for (unsigned i = m_aFirstSlice[nUniverse]; i < m_aFirstSlice[nUniverse + 1]; i++) {
+		const struct TWS28XXMapperSlice *pSlice = &m_pSlices[i];
+
+		// The slices of a universe are in DMX order
+		if (pSlice->nPixel >= nPixels) {
+			break;
+		}
+
+		uint32_t nLEDs = (uint32_t) (nPixels - pSlice->nPixel) * m_nGrouping - pSlice->nGroupPhase;
+
+		if (nLEDs > pSlice->nLEDCount) {
+			nLEDs = pSlice->nLEDCount;
+		}
+
+		const uint8_t *pSource = &pData[pSlice->nPixel * m_nChannelsPerLed];
+		WS28XXStripe *pStripe = pOutputs[pSlice->nOutput];
+		assert(pStripe != 0);
+
+		if (!pSlice->bReverse && (m_nGrouping == 1)) {
+			pStripe->SetLEDs(pSlice->nLEDIndex, pSource, nLEDs);
+		} else {
+			assert(nLEDs <= m_nScratchLEDs);
+
+			for (uint32_t j = 0; j < nLEDs; j++) {
+				const uint8_t *pPixel = &pSource[((pSlice->nGroupPhase + j) / m_nGrouping) * m_nChannelsPerLed];
+				uint8_t *pLED = &m_pScratch[(pSlice->bReverse ? (nLEDs - 1 - j) : j) * m_nChannelsPerLed];
+
+				for (unsigned k = 0; k < m_nChannelsPerLed; k++) {
+					pLED[k] = pPixel[k];
+				}
+			}
+
+			pStripe->SetLEDs(pSlice->bReverse ? pSlice->nLEDIndex - (nLEDs - 1) : pSlice->nLEDIndex, m_pScratch, nLEDs);
+		}
+
+		nOutputMask |= (1 << pSlice->nOutput);
+	}
+
+	return nOutputMask;
+}
@@ -38,13 +38,14 @@
 
 #include "ws28xxstripedmx.h"
 #include "ws28xxstripe.h"
+#include "ws28xxmapper.h"
 
-#define DMX_MAX_CHANNELS	512
-
-#ifndef MIN
- #define MIN(a, b) ((a) < (b) ? (a) : (b))
+#if !defined (__circle__)
+ #include "ws28xxtransportauxspi.h"
 #endif
 
+#define DMX_MAX_CHANNELS	512
+
 #define MOD(a,b)	((unsigned)a - b * ((unsigned)a/b))
 
 #if defined (__circle__)
@@ -56,19 +57,34 @@ SPISend::SPISend(void) :
 	m_nDmxStartAddress(1),
 	m_nDmxFootprint(170 * 3),
 	m_bIsStarted(false),
-	m_pLEDStripe(0),
 	m_LEDType(WS2801),
 	m_nLEDCount(170),
-	m_nBeginIndexPortId1(170),
-	m_nBeginIndexPortId2(340),
-	m_nBeginIndexPortId3(510),
-	m_nChannelsPerLed(3) {
+	m_nChannelsPerLed(3),
+	m_nReceivedMask(0),
+	m_nUniversesMask(0),
+	m_nOutputsPending(0)
+{
+	for (unsigned i = 0; i < WS28XX_MAPPER_MAX_OUTPUTS; i++) {
+		m_pLEDStripes[i] = 0;
+#if !defined (__circle__)
+		m_pTransports[i] = 0;
+#endif
+	}
+
+	UpdateMembers();
 }
 
 SPISend::~SPISend(void) {
 	Stop();
-	delete m_pLEDStripe;
-	m_pLEDStripe = 0;
+
+	for (unsigned i = 0; i < WS28XX_MAPPER_MAX_OUTPUTS; i++) {
+		delete m_pLEDStripes[i];
+		m_pLEDStripes[i] = 0;
+#if !defined (__circle__)
+		delete m_pTransports[i];
+		m_pTransports[i] = 0;
+#endif
+	}
 }
 
 void SPISend::Start(void) {
@@ -78,19 +94,26 @@ void SPISend::Start(void) {
 
 	m_bIsStarted = true;
 
-	if (m_pLEDStripe == 0) {
+	if (m_pLEDStripes[0] == 0) {
+		for (unsigned i = 0; i < m_Mapper.GetOutputs(); i++) {
 #if defined (__circle__)
-		m_pLEDStripe = new WS28XXStripe(m_pInterrupt, m_LEDType, m_nLEDCount);
+			m_pLEDStripes[i] = new WS28XXStripe(m_pInterrupt, m_LEDType, m_nLEDCount);
 #else
-		m_pLEDStripe = new WS28XXStripe(m_LEDType, m_nLEDCount);
+			if (i == 0) {
+				m_pLEDStripes[i] = new WS28XXStripe(m_LEDType, m_nLEDCount);
+			} else {
+				m_pTransports[i] = new WS28XXTransportAuxSpi(m_LEDType == WS2801 ? WS2801_SPI_SPEED_DEFAULT_HZ : WS28XX_SPI_SPEED_HZ);
+				assert(m_pTransports[i] != 0);
+				m_pLEDStripes[i] = new WS28XXStripe(m_LEDType, m_nLEDCount, 0, m_pTransports[i]);
+			}
 #endif
-		assert(m_pLEDStripe != 0);
-		m_pLEDStripe->Initialize();
+			assert(m_pLEDStripes[i] != 0);
+			m_pLEDStripes[i]->Initialize();
+		}
 	} else {
-		while (m_pLEDStripe->IsUpdating()) {
-			// wait for completion
+		for (unsigned i = 0; i < m_Mapper.GetOutputs(); i++) {
+			m_pLEDStripes[i]->Update();
 		}
-		m_pLEDStripe->Update();
 	}
 }
 
@@ -101,88 +124,75 @@ void SPISend::Stop(void) {
 
 	m_bIsStarted = false;
 
-	if (m_pLEDStripe != 0) {
-		while (m_pLEDStripe->IsUpdating()) {
-			// wait for completion
+	for (unsigned i = 0; i < WS28XX_MAPPER_MAX_OUTPUTS; i++) {
+		if (m_pLEDStripes[i] != 0) {
+			m_pLEDStripes[i]->Blackout();
 		}
-		m_pLEDStripe->Blackout();
 	}
 }
 
+/*
+ * A frame is committed when all mapped universes have been received, or on
+ * ArtSync / E1.31 Synchronization. When a universe arrives for the second
+ * time (its data is only passed on when changed), the frame so far is
+ * committed first.
+ */
 void SPISend::SetData(uint8_t nPortId, const uint8_t *data, uint16_t length) {
-	uint16_t i = (uint16_t) 0;
-	uint16_t j = (uint16_t) 0;
+	if (__builtin_expect((m_pLEDStripes[0] == 0), 0)) {
+		Start();
+	}
 
-	uint16_t beginIndex = (uint16_t) 0;
-	uint16_t endIndex = (uint16_t) 0;
+	if (nPortId >= m_Mapper.GetUniverseCount()) {
+		return;
+	}
 
-	bool bUpdate = false;
+	const uint32_t nMask = (uint32_t) 1 << nPortId;
 
-	if (__builtin_expect((m_pLEDStripe == 0), 0)) {
-		Start();
+	if ((m_nReceivedMask & nMask) == nMask) {
+		Commit();
 	}
 
-	switch (nPortId) {
-	case 0:
-		beginIndex = (uint16_t) 0;
-		endIndex = MIN(m_nLEDCount, (uint16_t) (length / (uint16_t) m_nChannelsPerLed));
-		bUpdate = (endIndex == m_nLEDCount);
-		break;
-	case 1:
-		beginIndex = (uint16_t) m_nBeginIndexPortId1;
-		endIndex = MIN(m_nLEDCount, (uint16_t) ((uint16_t) beginIndex + (length / (uint16_t) m_nChannelsPerLed)));
-		bUpdate = (endIndex == m_nLEDCount);
-		break;
-	case 2:
-		beginIndex = (uint16_t) m_nBeginIndexPortId2;
-		endIndex = MIN(m_nLEDCount, (uint16_t) ((uint16_t) beginIndex + (length / (uint16_t) m_nChannelsPerLed)));
-		bUpdate = (endIndex == m_nLEDCount);
-		break;
-	case 3:
-		beginIndex = (uint16_t) m_nBeginIndexPortId3;
-		endIndex = MIN(m_nLEDCount, (uint16_t) ((uint16_t) beginIndex + (length / (uint16_t) m_nChannelsPerLed)));
-		bUpdate = (endIndex == m_nLEDCount);
-		break;
-	default:
-		break;
-	}
+	// The back buffers are filled while the previous frame is still being sent
+	m_nOutputsPending |= m_Mapper.Map(nPortId, data, length, m_pLEDStripes);
+	m_nReceivedMask |= nMask;
 
-#if defined (__circle__)
-	// CLogger::Get ()->Write(__FUNCTION__, LogDebug, "%u %u %u %s", nPortId, beginIndex, endIndex, bUpdate == false ? "False" : "True");
-#else
-	//monitor_line(MONITOR_LINE_STATS, "%d-%x:%x:%x-%d|%s", nPortId, data[0], data[1], data[2], length, bUpdate == false ? "False" : "True");
-#endif
+	if (m_nReceivedMask == m_nUniversesMask) {
+		Commit();
+	}
+}
 
-	while (m_pLEDStripe->IsUpdating()) {
-		// wait for completion
+void SPISend::Sync(void) {
+	if (m_nReceivedMask != 0) {
+		Commit();
 	}
+}
 
-	for (j = beginIndex; j < endIndex; j++) {
-		if (m_LEDType == SK6812W) {
-			m_pLEDStripe->SetLED(j, data[i], data[i + 1], data[i + 2], data[i + 3]);
-			i = i + 4;
-		} else {
-			m_pLEDStripe->SetLED(j, data[i], data[i + 1], data[i + 2]);
-			i = i + 3;
+void SPISend::Commit(void) {
+	for (unsigned i = 0; i < m_Mapper.GetOutputs(); i++) {
+		if ((m_nOutputsPending & (1 << i)) != 0) {
+			m_pLEDStripes[i]->Update();
 		}
 	}
 
-	if (bUpdate) {
-		m_pLEDStripe->Update();
-		m_bIsStarted = true;
+	m_nOutputsPending = 0;
+	m_nReceivedMask = 0;
+	m_bIsStarted = true;
+}
+
+#if !defined (__circle__)
+void SPISend::Run(void) {
+	for (unsigned i = 0; i < WS28XX_MAPPER_MAX_OUTPUTS; i++) {
+		if (m_pLEDStripes[i] != 0) {
+			(void) m_pLEDStripes[i]->Run();
+		}
 	}
 }
+#endif
 
 void SPISend::SetLEDType(TWS28XXType type) {
 	m_LEDType = type;
 
-	if (type == SK6812W) {
-		m_nBeginIndexPortId1 = 128;
-		m_nBeginIndexPortId2 = 256;
-		m_nBeginIndexPortId3 = 384;
-
-		m_nChannelsPerLed = 4;
-	}
+	m_nChannelsPerLed = (type == SK6812W) ? 4 : 3;
 
 	UpdateMembers();
 }
@@ -197,6 +207,46 @@ void SPISend::SetLEDCount(uint16_t nCount) {
 	UpdateMembers();
 }
 
+void SPISend::SetOutputs(uint8_t nOutputs) {
+#if defined (__circle__)
+	// Only SPI0 is supported
+	nOutputs = 1;
+#endif
+	m_Mapper.SetOutputs(nOutputs);
+
+	UpdateMembers();
+}
+
+void SPISend::SetPixelsPerUniverse(uint16_t nPixelsPerUniverse) {
+	m_Mapper.SetPixelsPerUniverse(nPixelsPerUniverse);
+
+	UpdateMembers();
+}
+
+void SPISend::SetGrouping(uint8_t nGrouping) {
+	m_Mapper.SetGrouping(nGrouping);
+
+	UpdateMembers();
+}
+
+void SPISend::SetSegmentLength(uint16_t nSegmentLength) {
+	m_Mapper.SetSegmentLength(nSegmentLength);
+
+	UpdateMembers();
+}
+
+void SPISend::SetZigzag(bool bZigzag) {
+	m_Mapper.SetZigzag(bZigzag);
+
+	UpdateMembers();
+}
+
+void SPISend::SetReverse(bool bReverse) {
+	m_Mapper.SetReverse(bReverse);
+
+	UpdateMembers();
+}
+
 uint16_t SPISend::GetLEDCount(void) const {
 	return m_nLEDCount;
 }
@@ -248,9 +298,29 @@ bool SPISend::GetSlotInfo(uint16_t nSlotOffset, struct TLightSetSlotInfo& tSlotI
 }
 
 void SPISend::UpdateMembers(void) {
-	m_nDmxFootprint = m_nLEDCount * m_nChannelsPerLed;
+#if !defined (__circle__)
+	// Each output has the same LED count, and the second output is the blocking auxiliary SPI
+	if ((m_Mapper.GetOutputs() > 1) && (m_nLEDCount > WS28XX_AUX_SPI_MAX_LEDS)) {
+		m_nLEDCount = WS28XX_AUX_SPI_MAX_LEDS;
+	}
+#endif
+
+	m_Mapper.SetChannelsPerLed((uint8_t) m_nChannelsPerLed);
+	m_Mapper.SetLEDCount(m_nLEDCount);
+	m_Mapper.Build();
+
+	m_nLEDCount = m_Mapper.GetLEDCount();
+
+	const uint8_t nUniverses = m_Mapper.GetUniverseCount();
+	m_nUniversesMask = (nUniverses == 32) ? 0xFFFFFFFF : (((uint32_t) 1 << nUniverses) - 1);
+	m_nReceivedMask = 0;
+
+	// The RDM footprint covers the first universe only
+	m_nDmxFootprint = m_Mapper.GetPixelsPerUniverse() * m_nChannelsPerLed;
+
+	const uint32_t nPixels = ((uint32_t) m_nLEDCount * m_Mapper.GetOutputs() + m_Mapper.GetGrouping() - 1) / m_Mapper.GetGrouping();
 
-	if (m_nDmxFootprint > DMX_MAX_CHANNELS) {
-		m_nDmxFootprint = DMX_MAX_CHANNELS;
+	if (nPixels * m_nChannelsPerLed < m_nDmxFootprint) {
+		m_nDmxFootprint = (uint16_t) (nPixels * m_nChannelsPerLed);
 	}
 }
@@ -32,4 +32,22 @@ void SPISend::Print(void) {
 	printf("Led stripe parameters\n");
 	printf(" Type  : %s [%d]\n", WS28XXStripeParams::GetLedTypeString(m_LEDType), m_LEDType);
 	printf(" Count : %d", (int) m_nLEDCount);
+
+	if (m_Mapper.GetOutputs() > 1) {
+		printf(" x %d outputs", (int) m_Mapper.GetOutputs());
+	}
+
+	printf("\n Universes : %d, %d pixels each", (int) m_Mapper.GetUniverseCount(), (int) m_Mapper.GetPixelsPerUniverse());
+
+	if (m_Mapper.GetGrouping() > 1) {
+		printf("\n Grouping : %d", (int) m_Mapper.GetGrouping());
+	}
+
+	if (m_Mapper.IsZigzag() && (m_Mapper.GetSegmentLength() != 0)) {
+		printf("\n Zigzag : %d", (int) m_Mapper.GetSegmentLength());
+	}
+
+	if (m_Mapper.IsReverse()) {
+		printf("\n Reverse");
+	}
 }
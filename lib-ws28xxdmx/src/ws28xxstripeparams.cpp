@@ -44,13 +44,26 @@
 
 #include "ws28xxstripe.h"
 #include "ws28xxstripedmx.h"
+#include "ws28xxmapper.h"
 
 #define SET_LED_TYPE_MASK	1<<0
 #define SET_LED_COUNT_MASK	1<<1
+#define SET_OUTPUTS_MASK	1<<2
+#define SET_PIXELS_MASK		1<<3
+#define SET_GROUPING_MASK	1<<4
+#define SET_SEGMENT_MASK	1<<5
+#define SET_ZIGZAG_MASK		1<<6
+#define SET_REVERSE_MASK	1<<7
 
 static const char PARAMS_FILE_NAME[] ALIGNED = "devices.txt";
 static const char PARAMS_LED_TYPE[] ALIGNED = "led_type";
-static const char PARAMS_LED_COUNT[] ALIGNED = "led_count";
+static const char PARAMS_LED_COUNT[] ALIGNED = "led_count";						///< LEDs on each output
+static const char PARAMS_SPI_OUTPUTS[] ALIGNED = "spi_outputs";					///< 1 {default} or 2 (SPI0 and SPI1, at most WS28XX_AUX_SPI_MAX_LEDS LEDs each)
+static const char PARAMS_PIXELS_PER_UNIVERSE[] ALIGNED = "pixels_per_universe";	///< 0 {default} is a full universe
+static const char PARAMS_LED_GROUPING[] ALIGNED = "led_grouping";				///< LEDs per DMX pixel, 1 {default}
+static const char PARAMS_LED_SEGMENT[] ALIGNED = "led_segment";					///< LEDs per row of a matrix, 0 {default}
+static const char PARAMS_LED_ZIGZAG[] ALIGNED = "led_zigzag";					///< Every other segment runs backwards, 0 {default}
+static const char PARAMS_LED_REVERSE[] ALIGNED = "led_reverse";					///< The outputs are fed from the far end, 0 {default}
 
 #define LED_TYPES_COUNT 			7
 #define LED_TYPES_MAX_NAME_LENGTH 	8
@@ -66,6 +79,7 @@ void WS28XXStripeParams::staticCallbackFunction(void *p, const char *s) {
 void WS28XXStripeParams::callbackFunction(const char *pLine) {
 	assert(pLine != 0);
 
+	uint8_t value8;
 	uint16_t value16;
 	uint8_t len;
 	char buffer[16];
@@ -83,16 +97,64 @@ void WS28XXStripeParams::callbackFunction(const char *pLine) {
 	}
 
 	if (Sscan::Uint16(pLine, PARAMS_LED_COUNT, &value16) == SSCAN_OK) {
-		if (value16 != 0 && value16 <= (4 * 170)) {
+		if (value16 != 0 && value16 <= WS28XX_MAPPER_MAX_LEDS_PER_OUTPUT) {
 			nLedCount = value16;
 			m_bSetList |= SET_LED_COUNT_MASK;
 		}
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, PARAMS_SPI_OUTPUTS, &value8) == SSCAN_OK) {
+		if (value8 != 0 && value8 <= WS28XX_MAPPER_MAX_OUTPUTS) {
+			m_nOutputs = value8;
+			m_bSetList |= SET_OUTPUTS_MASK;
+		}
+		return;
+	}
+
+	if (Sscan::Uint16(pLine, PARAMS_PIXELS_PER_UNIVERSE, &value16) == SSCAN_OK) {
+		if (value16 <= 170) {
+			m_nPixelsPerUniverse = value16;
+			m_bSetList |= SET_PIXELS_MASK;
+		}
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, PARAMS_LED_GROUPING, &value8) == SSCAN_OK) {
+		if (value8 != 0) {
+			m_nGrouping = value8;
+			m_bSetList |= SET_GROUPING_MASK;
+		}
+		return;
+	}
+
+	if (Sscan::Uint16(pLine, PARAMS_LED_SEGMENT, &value16) == SSCAN_OK) {
+		m_nSegmentLength = value16;
+		m_bSetList |= SET_SEGMENT_MASK;
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, PARAMS_LED_ZIGZAG, &value8) == SSCAN_OK) {
+		m_bZigzag = (value8 != 0);
+		m_bSetList |= SET_ZIGZAG_MASK;
+		return;
+	}
+
+	if (Sscan::Uint8(pLine, PARAMS_LED_REVERSE, &value8) == SSCAN_OK) {
+		m_bReverse = (value8 != 0);
+		m_bSetList |= SET_REVERSE_MASK;
 	}
 }
 
 WS28XXStripeParams::WS28XXStripeParams(void): m_bSetList(0) {
 	tLedType = WS2801;
 	nLedCount = 170;
+	m_nOutputs = 1;
+	m_nPixelsPerUniverse = 0;
+	m_nGrouping = 1;
+	m_nSegmentLength = 0;
+	m_bZigzag = false;
+	m_bReverse = false;
 }
 
 WS28XXStripeParams::~WS28XXStripeParams(void) {
@@ -115,6 +177,30 @@ void WS28XXStripeParams::Set(SPISend *pSpiSend) {
 	if (IsMaskSet(SET_LED_COUNT_MASK)) {
 		pSpiSend->SetLEDCount(nLedCount);
 	}
+
+	if (IsMaskSet(SET_OUTPUTS_MASK)) {
+		pSpiSend->SetOutputs(m_nOutputs);
+	}
+
+	if (IsMaskSet(SET_PIXELS_MASK)) {
+		pSpiSend->SetPixelsPerUniverse(m_nPixelsPerUniverse);
+	}
+
+	if (IsMaskSet(SET_GROUPING_MASK)) {
+		pSpiSend->SetGrouping(m_nGrouping);
+	}
+
+	if (IsMaskSet(SET_SEGMENT_MASK)) {
+		pSpiSend->SetSegmentLength(m_nSegmentLength);
+	}
+
+	if (IsMaskSet(SET_ZIGZAG_MASK)) {
+		pSpiSend->SetZigzag(m_bZigzag);
+	}
+
+	if (IsMaskSet(SET_REVERSE_MASK)) {
+		pSpiSend->SetReverse(m_bReverse);
+	}
 }
 
 void WS28XXStripeParams::Dump(void) {
@@ -131,6 +217,30 @@ void WS28XXStripeParams::Dump(void) {
 	if (IsMaskSet(SET_LED_COUNT_MASK)) {
 		printf(" Count : %d\n", (int) nLedCount);
 	}
+
+	if (IsMaskSet(SET_OUTPUTS_MASK)) {
+		printf(" %s=%d\n", PARAMS_SPI_OUTPUTS, (int) m_nOutputs);
+	}
+
+	if (IsMaskSet(SET_PIXELS_MASK)) {
+		printf(" %s=%d\n", PARAMS_PIXELS_PER_UNIVERSE, (int) m_nPixelsPerUniverse);
+	}
+
+	if (IsMaskSet(SET_GROUPING_MASK)) {
+		printf(" %s=%d\n", PARAMS_LED_GROUPING, (int) m_nGrouping);
+	}
+
+	if (IsMaskSet(SET_SEGMENT_MASK)) {
+		printf(" %s=%d\n", PARAMS_LED_SEGMENT, (int) m_nSegmentLength);
+	}
+
+	if (IsMaskSet(SET_ZIGZAG_MASK)) {
+		printf(" %s=%d\n", PARAMS_LED_ZIGZAG, (int) m_bZigzag);
+	}
+
+	if (IsMaskSet(SET_REVERSE_MASK)) {
+		printf(" %s=%d\n", PARAMS_LED_REVERSE, (int) m_bReverse);
+	}
 }
 
 TWS28XXType WS28XXStripeParams::GetLedType(void) const {
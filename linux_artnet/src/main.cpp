@@ -37,6 +37,7 @@
 #include "artnetparams.h"
 
 #include "dmxmonitor.h"
+#include "dmxcapture.h"
 
 #include "rdmdeviceresponder.h"
 #include "rdmpersonality.h"
@@ -58,16 +59,17 @@ int main(int argc, char **argv) {
 	ArtNetParams artnetparams;
 	ArtNetNode node;
 	DMXMonitor monitor;
+	DMXCapture capture;
 #if defined (__linux__)
 	IpProg ipprog;
 #endif
 
 	if (argc < 2) {
-		printf("Usage: %s ip_address|interface_name [max_dmx_channels]\n", argv[0]);
+		printf("Usage: %s ip_address|interface_name [max_dmx_channels] [capture_file]\n", argv[0]);
 		return -1;
 	}
 
-	if (argc == 3) {
+	if (argc >= 3) {
 		uint16_t max_channels = atoi(argv[2]);
 		if (max_channels > 512) {
 			max_channels = 512;
@@ -75,6 +77,13 @@ int main(int argc, char **argv) {
 		monitor.SetMaxDmxChannels(max_channels);
 	}
 
+	if (argc == 4) {
+		if (!capture.Open(argv[3])) {
+			return -1;
+		}
+		monitor.SetCapture(&capture);
+	}
+
 	if (artnetparams.Load()) {
 		artnetparams.Dump();
 		artnetparams.Set(&node);
@@ -88,7 +97,9 @@ int main(int argc, char **argv) {
 		return -1;
 	}
 
-	node.SetUniverseSwitch(0, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse());
+	for (unsigned i = 0; i < artnetparams.GetUniverses(); i++) {
+		node.SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse(i));
+	}
 	node.SetOutput(&monitor);
 
 	RDMPersonality personality("Real-time DMX Monitor", monitor.GetDmxFootprint());
@@ -121,6 +132,9 @@ int main(int argc, char **argv) {
 	node.Start();
 
 	for (;;) {
+		// Sleep until a packet arrives or the node has a timer to service. Identify has no timer on Linux.
+		nw.WaitForPacket(node.GetMillisToNextTimer());
+
 		int bytes = node.HandlePacket();
 		if (bytes > 0) {
 #ifndef NDEBUG
@@ -40,6 +40,7 @@
 #include "e131params.h"
 
 #include "dmxmonitor.h"
+#include "dmxcapture.h"
 
 #include "software_version.h"
 
@@ -49,16 +50,17 @@ int main(int argc, char **argv) {
 	uint8_t nTextLength;
 	E131Params e131params;
 	DMXMonitor monitor;
+	DMXCapture capture;
 	E131Uuid e131uuid;
 	uuid_t uuid;
 	char uuid_str[UUID_STRING_LENGTH + 1];
 
 	if (argc < 2) {
-		printf("Usage: %s ip_address|interface_name [max_dmx_channels]\n", argv[0]);
+		printf("Usage: %s ip_address|interface_name [max_dmx_channels] [capture_file]\n", argv[0]);
 		return -1;
 	}
 
-	if (argc == 3) {
+	if (argc >= 3) {
 		uint16_t max_channels = atoi(argv[2]);
 		if (max_channels > 512) {
 			max_channels = 512;
@@ -66,6 +68,13 @@ int main(int argc, char **argv) {
 		monitor.SetMaxDmxChannels(max_channels);
 	}
 
+	if (argc == 4) {
+		if (!capture.Open(argv[3])) {
+			return -1;
+		}
+		monitor.SetCapture(&capture);
+	}
+
 	if (e131params.Load()) {
 		e131params.Dump();
 	}
@@ -86,27 +95,26 @@ int main(int argc, char **argv) {
 		e131uuid.GetHardwareUuid(uuid);
 	}
 
-	nw.Begin(E131_DEFAULT_PORT);
-
-	struct in_addr group_ip;
-	(void)inet_aton("239.255.0.0", &group_ip);
-	const uint16_t universe = e131params.GetUniverse();
-	group_ip.s_addr = group_ip.s_addr | ((uint32_t)(((uint32_t)universe & (uint32_t)0xFF) << 24)) | ((uint32_t)(((uint32_t)universe & (uint32_t)0xFF00) << 8));
-	nw.JoinGroup(group_ip.s_addr);
-
 	E131Bridge bridge;
 
 	bridge.setCid(uuid);
-	bridge.setUniverse(e131params.GetUniverse());
+
+	for (unsigned i = 0; i < e131params.GetUniverses(); i++) {
+		bridge.setUniverse(i, e131params.GetUniverse(i));
+	}
+
 	bridge.setMergeMode(e131params.GetMergeMode());
 	bridge.SetOutput(&monitor);
 
+	bridge.Begin();
+
 	nw.Print();
 	puts("-------------------------------------------------------------------------------------------");
-	bridge.Print(group_ip.s_addr); //FIXME bridge.Print(group_ip.s_addr)
+	bridge.Print();
 	puts("-------------------------------------------------------------------------------------------");
 
 	for (;;) {
+		nw.WaitForPacket(bridge.GetMillisToNextTimer());
 		(void) bridge.Run();
 	}
 
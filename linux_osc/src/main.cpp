@@ -34,19 +34,95 @@
 
 #include "osc.h"
 #include "oscsend.h"
-#include "oscmessage.h"
+#include "oscmessageview.h"
+#include "oscrouter.h"
 #include "oscparams.h"
 
 #include "software_version.h"
 
+static uint32_t remote_ip;
+static uint16_t outgoing_port;
+
+static void print_message(const uint8_t *buffer, unsigned size) {
+	if (OSC::GetPath((void *) buffer, size) == 0) {
+		printf("invalid path\n");
+		return;
+	}
+
+	OSCMessageView Msg(buffer, size);
+	printf("path : %s\n", (const char *) buffer);
+	const int result = Msg.GetResult();
+
+	if (result) {
+		printf("\tresult = %d\n", result);
+		return;
+	}
+
+	const int argc = Msg.GetArgc();
+
+	for (int i = 0; i < argc; i++) {
+		int type = (int) Msg.GetType(i);
+
+		printf("\targ %d, ", i);
+
+		switch (type) {
+		case OSC_INT32: {
+			printf("int, %d", Msg.GetInt(i));
+			break;
+		}
+		case OSC_FLOAT: {
+			printf("float, %f", Msg.GetFloat(i));
+			break;
+		}
+		case OSC_STRING: {
+			printf("string, %s", Msg.GetString(i));
+			break;
+		}
+		case OSC_BLOB: {
+			OSCBlob blob = Msg.GetBlob(i);
+
+			int size = (int) blob.GetDataSize();
+			printf("blob, size %d, [", (int) size);
+
+			for (int j = 0; j < size && j < 16; j++) {
+				printf("%02x", blob.GetByte(j));
+				if (j + 1 < size) {
+					printf(" ");
+				}
+			}
+
+			printf("]");
+			break;
+		}
+		}
+
+		puts("");
+	}
+}
+
+static void handle_ping(void *p, const uint8_t *buffer, unsigned size, int index) {
+	OSCSend MsgSend(remote_ip, outgoing_port, "/pong", 0);
+	printf("ping->pong\n");
+}
+
+static void handle_info(void *p, const uint8_t *buffer, unsigned size, int index) {
+	unsigned char nLength;
+
+	print_message(buffer, size);
+
+	OSCSend MsgSendModel(remote_ip, outgoing_port, "/info/model", "s", Hardware::Get()->GetBoardName(nLength));
+	OSCSend MsgSendInfo(remote_ip, outgoing_port, "/info/os", "s", Hardware::Get()->GetSysName(nLength));
+	OSCSend MsgSendSoc(remote_ip, outgoing_port, "/info/soc", "s", Hardware::Get()->GetSocName(nLength));
+}
+
 int main(int argc, char **argv) {
 	HardwareLinux hw;
 	NetworkLinux nw;
 	uint8_t nTextLength;
 	OSCParams oscparms;
 	uint8_t buffer[1600];
-	uint32_t remote_ip;
-	uint16_t incoming_port, outgoing_port, remote_port;
+	uint16_t incoming_port, remote_port;
+	OSCRouter router;
 
 	if (argc < 2) {
 		printf("Usage: %s ip_address|interface_name\n", argv[0]);
@@ -70,9 +146,17 @@ int main(int argc, char **argv) {
 
 	nw.Begin(incoming_port);
 
+	router.Add("/ping", handle_ping, 0);
+	router.Add("/2", handle_info, 0);
+	router.Compile();
+
 	nw.Print();
 
 	for (;;) {
+		if (!nw.WaitForPacket(NETWORK_WAIT_FOREVER)) {
+			continue;
+		}
+
 		int bytes_received = nw.RecvFrom(buffer, sizeof buffer, &remote_ip, &remote_port);
 
 		if (bytes_received > 0) {
@@ -82,65 +166,8 @@ int main(int argc, char **argv) {
 
 			printf("%.2d-%.2d-%.4d %.2d:%.2d:%.2d.%.6ld ", ltm.tm_mday, ltm.tm_mon + 1, ltm.tm_year + 1900, ltm.tm_hour, ltm.tm_min, ltm.tm_sec, tv.tv_usec);
 
-			if (OSC::isMatch((const char*) buffer, "/ping")) {
-				OSCSend MsgSend(remote_ip, outgoing_port, "/pong", 0);
-				printf("ping->pong\n");
-			} else {
-				OSCMessage Msg((char *) buffer, bytes_received);
-				printf("path : %s\n", OSC::GetPath((char*) buffer, bytes_received));
-				int argc = Msg.GetArgc();
-
-				for (int i = 0; i < argc; i++) {
-					int type = (int) Msg.GetType(i);
-
-					printf("\targ %d, ", i);
-
-					switch (type) {
-					case OSC_INT32: {
-						printf("int, %d", Msg.GetInt(i));
-						break;
-					}
-					case OSC_FLOAT: {
-						printf("float, %f", Msg.GetFloat(i));
-						break;
-					}
-					case OSC_STRING: {
-						printf("string, %s", Msg.GetString(i));
-						break;
-					}
-					case OSC_BLOB: {
-						OSCBlob blob = Msg.GetBlob(i);
-
-						int size = (int) blob.GetDataSize();
-						printf("blob, size %d, [", (int) size);
-
-						for (int j = 0; j < size && j < 16; j++) {
-							printf("%02x", blob.GetByte(j));
-							if (j + 1 < size) {
-								printf(" ");
-							}
-						}
-
-						printf("]");
-						break;
-					}
-					}
-
-					const int result = Msg.GetResult();
-
-					if (result) {
-						printf(", result = %d\n", result);
-					} else {
-						puts("");
-					}
-				}
-			}
-
-			if (OSC::isMatch((const char*) buffer, "/2")) {
-				unsigned char nLength;
-				OSCSend MsgSendModel(remote_ip, outgoing_port, "/info/model", "s", Hardware::Get()->GetBoardName(nLength));
-				OSCSend MsgSendInfo(remote_ip, outgoing_port, "/info/os", "s", Hardware::Get()->GetSysName(nLength));
-				OSCSend MsgSendSoc(remote_ip, outgoing_port, "/info/soc", "s", Hardware::Get()->GetSocName(nLength));
+			if (!router.Dispatch(buffer, bytes_received)) {
+				print_message(buffer, bytes_received);
 			}
 		}
 	}
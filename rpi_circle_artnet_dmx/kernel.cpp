@@ -214,6 +214,11 @@ TShutdownMode CKernel::Run(void)
 
 	ArtNetNode node;
 
+	if (output_type == OUTPUT_TYPE_SPI) {
+		// One output port per pixel universe, the pages beyond 16 universes get the next Sub-Net
+		artnetparams.SetUniverses(m_SPI.GetUniverseCount());
+	}
+
 	artnetparams.Set(&node);
 	node.SetUniverseSwitch(0, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse());
 
@@ -224,35 +229,8 @@ TShutdownMode CKernel::Run(void)
 		node.SetOutput(&m_SPI);
 		node.SetDirectUpdate(true);
 
-		const uint16_t led_count = m_SPI.GetLEDCount();
-		const uint8_t universe = artnetparams.GetUniverse();
-
-		if (m_SPI.GetLEDType() == SK6812W) {
-			if (led_count > 128) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(1, ARTNET_OUTPUT_PORT, universe + 1);
-			}
-			if (led_count > 256) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(2, ARTNET_OUTPUT_PORT, universe + 2);
-			}
-			if (led_count > 384) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(3, ARTNET_OUTPUT_PORT, universe + 3);
-			}
-		} else {
-			if (led_count > 170) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(1, ARTNET_OUTPUT_PORT, universe + 1);
-			}
-			if (led_count > 340) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(2, ARTNET_OUTPUT_PORT, universe + 2);
-			}
-			if (led_count > 510) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(3, ARTNET_OUTPUT_PORT, universe + 3);
-			}
+		for (uint8_t i = 1; i < m_SPI.GetUniverseCount(); i++) {
+			node.SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse(i));
 		}
 	}
 
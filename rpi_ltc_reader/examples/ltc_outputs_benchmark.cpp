@@ -0,0 +1,217 @@
+/**
+ * @file ltc_outputs_benchmark.cpp
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "ltc_outputs.h"	// util.h has memcmp, memcpy and strlen
+
+/*
+ * No hardware needed: ltc_outputs.c runs on a simulated clock with mock sinks.
+ * The Art-Net sink takes no time, each display sink takes the latency given on the command line.
+ * The main loop calls ltc_outputs_run until there is nothing left, as firmware/main.cpp does,
+ * and then waits for the next frame.
+ *
+ * Usage: ltc_outputs_benchmark [display latency in us] ...
+ */
+
+#define FRAMES			300
+#define FPS				30
+#define FRAME_MICROS	(1000000 / FPS)
+#define MAX_DISPLAYS	(LTC_OUTPUTS_MAX_SINKS - 1)
+
+struct TSink {
+	uint32_t nLatency;
+	char aShadow[TC_CODE_MAX_LENGTH];	///< What the display shows
+	uint32_t nWrites;
+	uint32_t nTypeWrites;
+	uint32_t nWrongTimecode;			///< The shadow does not match the frame after the write
+	uint32_t nLate;						///< Written before Art-Net in the same frame
+	uint32_t nLastFrame;
+	uint32_t nMaxFramesBetween;
+};
+
+static uint32_t s_nMicros;
+static uint32_t s_nFrame;
+static uint32_t s_nArtNetFrame;
+static char s_aTimecode[TC_CODE_MAX_LENGTH + 1];
+static struct TSink s_Sinks[LTC_OUTPUTS_MAX_SINKS];	///< [0] is Art-Net
+
+static uint32_t micros(void) {
+	return s_nMicros;
+}
+
+static void sink_write(struct TSink *pSink, const struct _ltc_output_frame *pFrame) {
+	for (uint32_t i = 0; i < TC_CODE_MAX_LENGTH; i++) {
+		if (pFrame->changed & (1U << i)) {
+			pSink->aShadow[i] = pFrame->timecode[i];
+		}
+	}
+
+	if (memcmp(pSink->aShadow, s_aTimecode, TC_CODE_MAX_LENGTH) != 0) {
+		pSink->nWrongTimecode++;
+	}
+
+	if (pFrame->type != NULL) {
+		pSink->nTypeWrites++;
+	}
+
+	if (pSink->nWrites != 0 && (s_nFrame - pSink->nLastFrame > pSink->nMaxFramesBetween)) {
+		pSink->nMaxFramesBetween = s_nFrame - pSink->nLastFrame;
+	}
+
+	pSink->nWrites++;
+	pSink->nLastFrame = s_nFrame;
+
+	s_nMicros += pSink->nLatency;
+}
+
+static void sink_artnet(const struct _ltc_output_frame *pFrame) {
+	s_nArtNetFrame = s_nFrame;
+	sink_write(&s_Sinks[0], pFrame);
+}
+
+#define SINK_DISPLAY(n) \
+	static void sink_display_##n(const struct _ltc_output_frame *pFrame) { \
+		if (s_nArtNetFrame != s_nFrame) { \
+			s_Sinks[1 + n].nLate++; \
+		} \
+		sink_write(&s_Sinks[1 + n], pFrame); \
+	}
+
+SINK_DISPLAY(0)
+SINK_DISPLAY(1)
+SINK_DISPLAY(2)
+SINK_DISPLAY(3)
+SINK_DISPLAY(4)
+SINK_DISPLAY(5)
+SINK_DISPLAY(6)
+
+static const ltc_output_handler_t s_aDisplays[MAX_DISPLAYS] = {
+		sink_display_0, sink_display_1, sink_display_2, sink_display_3, sink_display_4, sink_display_5, sink_display_6 };
+
+static void timecode(uint32_t nFrame, struct _midi_send_tc *pTc) {
+	pTc->frame = (uint8_t) (nFrame % FPS);
+	pTc->second = (uint8_t) ((nFrame / FPS) % 60);
+	pTc->minute = (uint8_t) ((nFrame / (FPS * 60)) % 60);
+	pTc->hour = (uint8_t) (nFrame / (FPS * 3600));
+	pTc->rate = MIDI_TC_TYPE_SMPTE;
+
+	s_aTimecode[0] = (char) ('0' + pTc->hour / 10);
+	s_aTimecode[1] = (char) ('0' + pTc->hour % 10);
+	s_aTimecode[2] = ':';
+	s_aTimecode[3] = (char) ('0' + pTc->minute / 10);
+	s_aTimecode[4] = (char) ('0' + pTc->minute % 10);
+	s_aTimecode[5] = ':';
+	s_aTimecode[6] = (char) ('0' + pTc->second / 10);
+	s_aTimecode[7] = (char) ('0' + pTc->second % 10);
+	s_aTimecode[8] = '.';
+	s_aTimecode[9] = (char) ('0' + pTc->frame / 10);
+	s_aTimecode[10] = (char) ('0' + pTc->frame % 10);
+}
+
+int main(int argc, char **argv) {
+	uint32_t aLatency[MAX_DISPLAYS] = { 0, 2000, 5000, 12000 };
+	uint32_t nDisplays = 4;
+
+	if (argc > 1) {
+		nDisplays = 0;
+		for (int i = 1; (i < argc) && (nDisplays < MAX_DISPLAYS); i++) {
+			aLatency[nDisplays++] = (uint32_t) atoi(argv[i]);
+		}
+	}
+
+	memset(s_Sinks, 0, sizeof(s_Sinks));
+
+	ltc_outputs_init(micros);
+	(void) ltc_outputs_add(sink_artnet, true);
+
+	for (uint32_t i = 0; i < nDisplays; i++) {
+		s_Sinks[1 + i].nLatency = aLatency[i];
+		(void) ltc_outputs_add(s_aDisplays[i], false);
+	}
+
+	const uint32_t nBudget = FRAME_MICROS / LTC_OUTPUTS_BUDGET_DIVIDER;
+	uint32_t nFramesOverBudget = 0;
+	uint32_t nFramesLate = 0;
+	uint32_t nDisplayMax = 0;
+
+	for (s_nFrame = 0; s_nFrame < FRAMES; s_nFrame++) {
+		const uint32_t nFrameStart = s_nFrame * FRAME_MICROS;
+		struct _midi_send_tc tc;
+
+		if ((int32_t) (s_nMicros - nFrameStart) > 0) {
+			nFramesLate++;
+		} else {
+			s_nMicros = nFrameStart;
+		}
+
+		timecode(s_nFrame, &tc);
+		ltc_outputs_update(s_aTimecode, &tc, TC_TYPE_SMPTE, FRAME_MICROS);
+
+		while (ltc_outputs_run()) {
+		}
+
+		const uint32_t nDisplay = ltc_outputs_get_frame_us();
+
+		if (nDisplay > nBudget) {
+			nFramesOverBudget++;
+		}
+
+		if (nDisplay > nDisplayMax) {
+			nDisplayMax = nDisplay;
+		}
+	}
+
+	bool bIsOk = true;
+
+	printf("%d frames at %d fps, display budget %u us\n", FRAMES, FPS, nBudget);
+
+	for (uint32_t i = 0; i <= nDisplays; i++) {
+		const struct _ltc_output_statistics *pStatistics = ltc_outputs_get_statistics(i);
+		const struct TSink *pSink = &s_Sinks[i];
+		// Whatever the budget, a display is written at least after LTC_OUTPUTS_MAX_SKIPPED frames
+		const bool bIsSinkOk = (pSink->nWrongTimecode == 0) && (pSink->nLate == 0) && (pSink->nTypeWrites == 1)
+				&& (pSink->nMaxFramesBetween <= 1 + LTC_OUTPUTS_MAX_SKIPPED);
+
+		if (i == 0) {
+			printf("Art-Net         : ");
+		} else {
+			printf("Display %5u us: ", pSink->nLatency);
+		}
+
+		printf("%3u writes, %3u skipped, %3u coalesced, %2u frames between writes, %u wrong, %u before Art-Net, %s\n",
+				pStatistics->writes, pStatistics->skipped, pStatistics->coalesced, pSink->nMaxFramesBetween == 0 ? 1 : pSink->nMaxFramesBetween,
+				pSink->nWrongTimecode, pSink->nLate, bIsSinkOk ? "OK" : "WRONG");
+
+		bIsOk &= bIsSinkOk;
+	}
+
+	printf("Display time    : max %u us, %u frames over the budget, %u frames started late\n", nDisplayMax, nFramesOverBudget, nFramesLate);
+	printf("%s\n", bIsOk ? "OK" : "FAILED");
+
+	return bIsOk ? 0 : 1;
+}
@@ -35,11 +35,14 @@
 #include "display_7segment.h"
 #include "display_matrix.h"
 
+#include "i2c_queue.h"
+
 #include "midi_sender.h"
 #include "midi_reader.h"
 
 #include "ltc_reader.h"
 #include "ltc_reader_params.h"
+#include "ltc_outputs.h"
 
 #include "artnetnode.h"
 #include "artnetreader.h"
@@ -154,6 +157,8 @@ void notmain(void) {
 		display_matrix_init(ltc_reader_params_get_max7219_intensity());
 	}
 
+	ltc_outputs_sinks_init(&output);
+
 	console_set_cursor(0, 15);
 	(void) console_puts("Source : ");
 
@@ -208,6 +213,12 @@ void notmain(void) {
 			break;
 		}
 
+		// One display at the most, so the MIDI quarter frames are not held up
+		(void) ltc_outputs_run();
+
+		// Bus idle times and callbacks of the queued display writes
+		i2c_queue_run();
+
 		if (output.artnet_output || (source == LTC_READER_SOURCE_ARTNET)) {
 			// For all cases when ArtNet is enabled -> handles OpPoll / OpPollReply
 			// When source == LTC_READER_SOURCE_ARTNET -> handle OpTimeCode
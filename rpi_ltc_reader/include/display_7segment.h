@@ -34,6 +34,7 @@ extern "C" {
 
 extern void display_7segment_init(const uint8_t);
 extern void display_7segment(const char *);
+extern void display_7segment_update(const char *, uint32_t);
 
 #ifdef __cplusplus
 }
@@ -34,6 +34,7 @@ extern "C" {
 
 extern const bool display_oled_init(void);
 extern void display_oled_line_1(const char *, int);
+extern void display_oled_line_1_at(const char *, int, int);
 extern void display_oled_line_2(const char *);
 
 #ifdef __cplusplus
@@ -0,0 +1,75 @@
+/**
+ * @file ltc_outputs.h
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef LTC_OUTPUTS_H_
+#define LTC_OUTPUTS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "midi.h"
+
+#include "ltc_reader.h"
+
+#define LTC_OUTPUTS_MAX_SINKS		8	///<
+#define LTC_OUTPUTS_MAX_SKIPPED		4	///< A display is written after this many skipped frames, whatever the budget
+#define LTC_OUTPUTS_BUDGET_DIVIDER	2	///< The displays get at most half of a frame
+
+struct _ltc_output_frame {
+	const char *timecode;					///< "hh:mm:ss.ff", TC_CODE_MAX_LENGTH characters
+	const struct _midi_send_tc *tc;			///<
+	/*@null@*/const char *type;				///< NULL when the type is written already
+	uint32_t changed;						///< Bit n is set when timecode[n] changed since the previous write
+};
+
+typedef void (*ltc_output_handler_t)(const struct _ltc_output_frame *);
+
+struct _ltc_output_statistics {
+	uint32_t writes;						///<
+	uint32_t skipped;						///< Frames the display was over the budget
+	uint32_t coalesced;						///< Frames merged into a later write
+	uint32_t cost_us;						///< Running average of a write
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void ltc_outputs_init(uint32_t (*)(void));
+extern bool ltc_outputs_add(ltc_output_handler_t, bool);
+
+extern void ltc_outputs_update(const char *, const struct _midi_send_tc *, timecode_types, uint32_t);
+extern bool ltc_outputs_run(void);
+
+extern /*@null@*/const struct _ltc_output_statistics *ltc_outputs_get_statistics(uint32_t);
+extern uint32_t ltc_outputs_get_frame_us(void);
+
+extern void ltc_outputs_sinks_init(const struct _ltc_reader_output *);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LTC_OUTPUTS_H_ */
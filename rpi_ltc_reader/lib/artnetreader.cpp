@@ -33,6 +33,7 @@
 #include "bcm2835.h"
 
 #include "ltc_reader.h"
+#include "ltc_outputs.h"
 
 #include "artnetreader.h"
 #include "artnettimecode.h"
@@ -40,8 +41,6 @@
 #include "console.h"
 #include "lcd.h"
 #include "display_oled.h"
-#include "display_7segment.h"
-#include "display_matrix.h"
 
 #include "midi.h"
 
@@ -158,7 +157,6 @@ void ArtNetReader::Stop(void) {
 void ArtNetReader::Handler(const struct TArtNetTimeCode *ArtNetTimeCode) {
 	char sLimitWarning[16];
 	uint32_t nLimitUs = 0;
-	char *p_type;
 
 	if (m_pOutput == NULL) {
 		return;
@@ -195,29 +193,7 @@ void ArtNetReader::Handler(const struct TArtNetTimeCode *ArtNetTimeCode) {
 		break;
 	}
 
-	if (m_pOutput->console_output) {
-		console_set_cursor(2, 24);
-		console_write((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if (m_pOutput->lcd_output) {
-		lcd_text_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if(m_pOutput->oled_output) {
-		display_oled_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if (m_pOutput->segment_output) {
-		display_7segment((const char *) timecode);
-	}
-
-	if (m_pOutput->matrix_output) {
-		display_matrix((const char *) timecode);
-	}
-
 	if ((m_PrevType != ArtNetTimeCode->Type)) {
-		p_type = (char *) ltc_reader_get_type((timecode_types) ArtNetTimeCode->Type);
 		m_PrevType = ArtNetTimeCode->Type;
 
 		if (m_pOutput->midi_output) {
@@ -227,21 +203,10 @@ void ArtNetReader::Handler(const struct TArtNetTimeCode *ArtNetTimeCode) {
 			midi_quarter_frame_us = nLimitUs / (uint32_t) 4;
 			BCM2835_ST->C3 = nNowUs + midi_quarter_frame_us;
 		}
-
-		if (m_pOutput->console_output) {
-			console_set_cursor(2, 25);
-			(void) console_puts(p_type);
-		}
-
-		if (m_pOutput->lcd_output) {
-			lcd_text_line_2(p_type, TC_TYPE_MAX_LENGTH);
-		}
-
-		if (m_pOutput->oled_output) {
-			display_oled_line_2(p_type);
-		}
 	}
 
+	ltc_outputs_update((const char *) timecode, &midi_timecode, (timecode_types) ArtNetTimeCode->Type, nLimitUs);
+
 	const uint32_t nDeltaUs = BCM2835_ST->CLO - nNowUs;
 
 	if (nLimitUs == 0) {
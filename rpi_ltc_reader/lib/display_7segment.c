@@ -49,17 +49,33 @@ void display_7segment_init(const uint8_t intensity) {
 	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT2, (uint8_t) 0x80);
 }
 
+/**
+ * Only the digits flagged in \p changed are written.
+ *
+ * @param timecode
+ * @param changed Bit n is set when timecode[n] changed
+ */
+void display_7segment_update(const char *timecode, uint32_t changed) {
+	static const uint8_t digits[8][3] = {
+			{ 0, MAX7219_REG_DIGIT7, 0x00 }, { 1, MAX7219_REG_DIGIT6, 0x80 },
+			{ 3, MAX7219_REG_DIGIT5, 0x00 }, { 4, MAX7219_REG_DIGIT4, 0x80 },
+			{ 6, MAX7219_REG_DIGIT3, 0x00 }, { 7, MAX7219_REG_DIGIT2, 0x80 },
+			{ 9, MAX7219_REG_DIGIT1, 0x00 }, { 10, MAX7219_REG_DIGIT0, 0x00 } };
+	unsigned i;
+
+	for (i = 0; i < sizeof(digits) / sizeof(digits[0]); i++) {
+		const uint8_t position = digits[i][0];
+
+		if (changed & (1 << position)) {
+			max7219_spi_write_reg(&device_info, digits[i][1], (uint8_t) (timecode[position] - '0') | digits[i][2]);
+		}
+	}
+}
+
 /**
  *
  * @param timecode
  */
 void display_7segment(const char *timecode) {
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT7, (uint8_t) (timecode[0] - '0'));
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT6, (uint8_t) (timecode[1] - '0') | 0x80);
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT5, (uint8_t) (timecode[3] - '0'));
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT4, (uint8_t) (timecode[4] - '0') | 0x80);
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT3, (uint8_t) (timecode[6] - '0'));
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT2, (uint8_t) (timecode[7] - '0') | 0x80);
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT1, (uint8_t) (timecode[9] - '0'));
-	max7219_spi_write_reg(&device_info, MAX7219_REG_DIGIT0, (uint8_t) (timecode[10] - '0'));
+	display_7segment_update(timecode, (uint32_t) ~0);
 }
@@ -86,6 +86,17 @@ void display_oled_line_1(const char *s, int n) {
 	oled_write(&oled_info, s, n);
 }
 
+/**
+ *
+ * @param s The characters to write, not the start of the line
+ * @param col
+ * @param n
+ */
+void display_oled_line_1_at(const char *s, int col, int n) {
+	oled_set_cursor(&oled_info, 0, (uint8_t) col);
+	oled_write(&oled_info, s, n);
+}
+
 /**
  *
  * @param s
@@ -0,0 +1,239 @@
+/**
+ * @file ltc_outputs.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "midi.h"
+
+#include "ltc_reader.h"
+#include "ltc_outputs.h"
+
+/*
+ * The timecode goes out to the real-time outputs (Art-Net) straight away, from ltc_outputs_update.
+ * The displays are written one at a time from ltc_outputs_run, which the main loop calls
+ * between the MIDI quarter frames. A display only gets the characters which changed since
+ * it was written last. When its average write time does not fit in what is left of the frame
+ * budget it is skipped, and its changes are merged into the next frame.
+ */
+
+struct _ltc_output_sink {
+	ltc_output_handler_t handler;
+	bool is_realtime;
+	bool is_pending;
+	bool is_skipped;						///< In the current frame
+	uint32_t changed;
+	/*@null@*/const char *type;
+	uint32_t skipped_frames;				///< Consecutive
+	struct _ltc_output_statistics statistics;
+};
+
+static struct _ltc_output_sink sinks[LTC_OUTPUTS_MAX_SINKS];
+static uint32_t sinks_count = 0;
+
+static uint32_t (*micros)(void) = NULL;
+
+static char timecode_frame[TC_CODE_MAX_LENGTH];	///< Copy, the FIQ can change the source while the displays are written
+static struct _midi_send_tc tc_current;
+static timecode_types type_previous = TC_TYPE_INVALID;
+
+static uint32_t budget_us = 0;
+static uint32_t frame_us = 0;				///< Time spent on outputs in the current frame
+
+static void sink_write(struct _ltc_output_sink *sink) {
+	struct _ltc_output_frame frame;
+
+	frame.timecode = timecode_frame;
+	frame.tc = &tc_current;
+	frame.type = sink->type;
+	frame.changed = sink->changed;
+
+	const uint32_t start_us = micros();
+
+	sink->handler(&frame);
+
+	const uint32_t elapsed_us = micros() - start_us;
+
+	sink->statistics.cost_us = (sink->statistics.writes == 0) ? elapsed_us : (3 * sink->statistics.cost_us + elapsed_us) / 4;
+	sink->statistics.writes++;
+
+	sink->is_pending = false;
+	sink->changed = 0;
+	sink->type = NULL;
+	sink->skipped_frames = 0;
+
+	frame_us += elapsed_us;
+}
+
+/**
+ *
+ * @param micros_function Returns the time in us
+ */
+void ltc_outputs_init(uint32_t (*micros_function)(void)) {
+	uint32_t i;
+
+	micros = micros_function;
+	sinks_count = 0;
+
+	for (i = 0; i < TC_CODE_MAX_LENGTH; i++) {
+		timecode_frame[i] = 0;
+	}
+
+	type_previous = TC_TYPE_INVALID;
+	budget_us = 0;
+	frame_us = 0;
+}
+
+/**
+ * The displays are written in the order they are added, add the fastest first.
+ *
+ * @param handler
+ * @param is_realtime Written from \ref ltc_outputs_update, never skipped
+ * @return false when there are \ref LTC_OUTPUTS_MAX_SINKS already
+ */
+bool ltc_outputs_add(ltc_output_handler_t handler, bool is_realtime) {
+	struct _ltc_output_sink *sink;
+
+	if (sinks_count == LTC_OUTPUTS_MAX_SINKS) {
+		return false;
+	}
+
+	sink = &sinks[sinks_count++];
+
+	sink->handler = handler;
+	sink->is_realtime = is_realtime;
+	sink->is_pending = false;
+	sink->is_skipped = false;
+	sink->changed = 0;
+	sink->type = NULL;
+	sink->skipped_frames = 0;
+	sink->statistics.writes = 0;
+	sink->statistics.skipped = 0;
+	sink->statistics.coalesced = 0;
+	sink->statistics.cost_us = 0;
+
+	return true;
+}
+
+/**
+ * A new frame. The real-time outputs are written before returning.
+ *
+ * @param timecode "hh:mm:ss.ff"
+ * @param tc
+ * @param type
+ * @param limit_us Frame time, 0 when the type is unknown
+ */
+void ltc_outputs_update(const char *timecode, const struct _midi_send_tc *tc, timecode_types type, uint32_t limit_us) {
+	uint32_t changed = 0;
+	const char *p_type = NULL;
+	uint32_t i;
+
+	for (i = 0; i < TC_CODE_MAX_LENGTH; i++) {
+		if (timecode[i] != timecode_frame[i]) {
+			timecode_frame[i] = timecode[i];
+			changed |= (1 << i);
+		}
+	}
+
+	if (type != type_previous) {
+		type_previous = type;
+		p_type = ltc_reader_get_type(type);
+	}
+
+	tc_current = *tc;
+
+	budget_us = (limit_us != 0 ? limit_us : (uint32_t) (1000000 / 30)) / LTC_OUTPUTS_BUDGET_DIVIDER;
+	frame_us = 0;
+
+	for (i = 0; i < sinks_count; i++) {
+		struct _ltc_output_sink *sink = &sinks[i];
+
+		if (sink->is_pending) {
+			sink->statistics.coalesced++;
+		}
+
+		sink->changed |= changed;
+		if (p_type != NULL) {
+			sink->type = p_type;
+		}
+		sink->is_pending = (sink->changed != 0) || (sink->type != NULL);
+		sink->is_skipped = false;
+
+		if (sink->is_realtime) {
+			sink_write(sink);
+		}
+	}
+}
+
+/**
+ * Writes at most one display.
+ *
+ * @return true when a display was written, false when there is nothing left for this frame
+ */
+bool ltc_outputs_run(void) {
+	uint32_t i;
+
+	for (i = 0; i < sinks_count; i++) {
+		struct _ltc_output_sink *sink = &sinks[i];
+
+		if (!sink->is_pending || sink->is_skipped) {
+			continue;
+		}
+
+		if ((frame_us + sink->statistics.cost_us > budget_us) && (sink->skipped_frames < LTC_OUTPUTS_MAX_SKIPPED)) {
+			sink->is_skipped = true;
+			sink->skipped_frames++;
+			sink->statistics.skipped++;
+			continue;
+		}
+
+		sink_write(sink);
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ *
+ * @param index In the order of \ref ltc_outputs_add
+ * @return
+ */
+const struct _ltc_output_statistics *ltc_outputs_get_statistics(uint32_t index) {
+	if (index >= sinks_count) {
+		return NULL;
+	}
+
+	return &sinks[index].statistics;
+}
+
+/**
+ *
+ * @return Time spent on outputs in the current frame
+ */
+uint32_t ltc_outputs_get_frame_us(void) {
+	return frame_us;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file ltc_outputs_sinks.c
+ *
+ */
+/* Copyright (C) 2018 by Arjan van Vught mailto:info@raspberrypi-dmx.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bcm2835.h"
+#include "bcm2835_st.h"
+
+#include "midi.h"
+
+#include "ltc_reader.h"
+#include "ltc_outputs.h"
+
+#include "console.h"
+#include "lcd.h"
+#include "display_oled.h"
+#include "display_7segment.h"
+#include "display_matrix.h"
+
+extern void artnet_output(const struct _midi_send_tc *);
+
+static uint32_t micros(void) {
+	return BCM2835_ST->CLO;
+}
+
+static void sink_artnet(const struct _ltc_output_frame *frame) {
+	artnet_output(frame->tc);
+}
+
+static void sink_console(const struct _ltc_output_frame *frame) {
+	if (frame->changed != 0) {
+		const int first = __builtin_ctz(frame->changed);
+		const int last = 31 - __builtin_clz(frame->changed);
+
+		console_set_cursor(2 + first, 24);
+		console_write(&frame->timecode[first], 1 + last - first);
+	}
+
+	if (frame->type != NULL) {
+		console_set_cursor(2, 25);
+		(void) console_puts(frame->type);
+	}
+}
+
+static void sink_7segment(const struct _ltc_output_frame *frame) {
+	display_7segment_update(frame->timecode, frame->changed);
+}
+
+static void sink_matrix(const struct _ltc_output_frame *frame) {
+	if (frame->changed != 0) {
+		display_matrix(frame->timecode);
+	}
+}
+
+static void sink_oled(const struct _ltc_output_frame *frame) {
+	if (frame->changed != 0) {
+		const int first = __builtin_ctz(frame->changed);
+		const int last = 31 - __builtin_clz(frame->changed);
+
+		display_oled_line_1_at(&frame->timecode[first], first, 1 + last - first);
+	}
+
+	if (frame->type != NULL) {
+		display_oled_line_2(frame->type);
+	}
+}
+
+static void sink_lcd(const struct _ltc_output_frame *frame) {
+	if (frame->changed != 0) {
+		lcd_text_line_1(frame->timecode, TC_CODE_MAX_LENGTH);
+	}
+
+	if (frame->type != NULL) {
+		lcd_text_line_2(frame->type, TC_TYPE_MAX_LENGTH);
+	}
+}
+
+/**
+ * Art-Net first, then the displays from fast to slow: frame buffer, SPI, I2C.
+ * The MIDI output is not a sink, the readers send the full message and the quarter frames themselves.
+ *
+ * @param output
+ */
+void ltc_outputs_sinks_init(const struct _ltc_reader_output *output) {
+	ltc_outputs_init(micros);
+
+	if (output->artnet_output) {
+		(void) ltc_outputs_add(sink_artnet, true);
+	}
+
+	if (output->console_output) {
+		(void) ltc_outputs_add(sink_console, false);
+	}
+
+	if (output->segment_output) {
+		(void) ltc_outputs_add(sink_7segment, false);
+	}
+
+	if (output->matrix_output) {
+		(void) ltc_outputs_add(sink_matrix, false);
+	}
+
+	if (output->oled_output) {
+		(void) ltc_outputs_add(sink_oled, false);
+	}
+
+	if (output->lcd_output) {
+		(void) ltc_outputs_add(sink_lcd, false);
+	}
+}
@@ -49,12 +49,12 @@
 
 #include "ltc_reader.h"
 #include "ltc_reader_params.h"
+#include "ltc_outputs.h"
 
 #include "console.h"
 #include "lcd.h"
-#include "display_oled.h"
-#include "display_7segment.h"
-#include "display_matrix.h"
+
+#include "i2c_queue.h"
 
 #include "util.h"
 
@@ -101,8 +101,6 @@ static volatile uint32_t midi_quarter_frame_us = (uint32_t) 0;
 static volatile bool midi_quarter_frame_message = false;
 static volatile uint8_t midi_quarter_frame_piece ALIGNED = 0;
 
-extern void artnet_output(const struct _midi_send_tc *);
-
 /**
  *
  */
@@ -135,6 +133,9 @@ void __attribute__((interrupt("IRQ"))) c_irq_handler(void) {
 		midi_quarter_frame_message = true;
 	}
 
+	// The LCD and OLED writes are queued, see ltc_reader_init
+	i2c_queue_irq_handler();
+
 	dmb();
 }
 
@@ -238,7 +239,6 @@ void ltc_reader(void) {
 	uint32_t limit_us = (uint32_t) 0;
 	uint32_t now_us = (uint32_t) 0;
 	char limit_warning[16] ALIGNED;
-	char *p_type;
 
 	dmb();
 	if (timecode_available) {
@@ -268,33 +268,7 @@ void ltc_reader(void) {
 
 		midi_timecode.rate = type;
 
-		if (output->console_output) {
-			console_set_cursor(2, 24);
-			console_write((char *) timecode, TC_CODE_MAX_LENGTH);
-		}
-
-		if (output->lcd_output) {
-			lcd_text_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-		}
-
-		if(output->oled_output) {
-			display_oled_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-		}
-
-		if (output->segment_output) {
-			display_7segment((const char *) timecode);
-		}
-
-		if (output->artnet_output) {
-			artnet_output((struct _midi_send_tc *)&midi_timecode);
-		}
-
-		if (output->matrix_output) {
-			display_matrix((const char *) timecode);
-		}
-
 		if (prev_type != type) {
-			p_type = (char *) ltc_reader_get_type((timecode_types) type);
 			prev_type = type;
 
 			if (output->midi_output) {
@@ -304,22 +278,10 @@ void ltc_reader(void) {
 				midi_quarter_frame_us = limit_us / (uint32_t) 4;
 				BCM2835_ST->C3 = now_us + midi_quarter_frame_us;
 			}
-
-			if (output->console_output) {
-				console_set_cursor(2, 25);
-				console_puts(p_type);
-			}
-
-			if (output->lcd_output) {
-				lcd_text_line_2(p_type, TC_TYPE_MAX_LENGTH);
-			}
-
-			if (output->oled_output) {
-				display_oled_line_2(p_type);
-			}
-
 		}
 
+		ltc_outputs_update((const char *) timecode, (const struct _midi_send_tc *) &midi_timecode, (timecode_types) type, limit_us);
+
 		const uint32_t delta_us = BCM2835_ST->CLO - now_us;
 
 		if (limit_us == 0) {
@@ -406,6 +368,9 @@ void ltc_reader_init(const struct _ltc_reader_output *out) {
 	dmb();
 	__enable_irq();
 
+	// The display writes return when queued, the main loop calls i2c_queue_run
+	i2c_queue_set_irq(true);
+
 	for (i = 0; i < sizeof(timecode) / sizeof(timecode[0]) ; i++) {
 		timecode[i] = ' ';
 	}
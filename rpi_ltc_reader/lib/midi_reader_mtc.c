@@ -30,21 +30,15 @@
 #include "midi_description.h"
 
 #include "ltc_reader.h"
+#include "ltc_outputs.h"
 
-#include "console.h"
 #include "lcd.h"
-#include "display_oled.h"
-#include "display_7segment.h"
-#include "display_matrix.h"
-
-extern void artnet_output(const struct _midi_send_tc *);
 
 static const struct _ltc_reader_output *output;
 
 static volatile char timecode[TC_CODE_MAX_LENGTH] ALIGNED;
 static struct _midi_send_tc midi_timecode = { 0, 0, 0, 0, MIDI_TC_TYPE_EBU };
 
-static uint8_t prev_type ALIGNED = 0xFF;					///< Invalid type. Force initial update.
 static uint8_t qf[8] ALIGNED = { 0, 0, 0, 0, 0, 0, 0, 0 };	///<
 static uint8_t prev_part ALIGNED = 0;						///<
 
@@ -66,50 +60,7 @@ static void itoa_base10(uint8_t arg, char *buf) {
  * @param type
  */
 static void update(const uint8_t type) {
-	char *p_type;
-
-	if (output->artnet_output) {
-		artnet_output((struct _midi_send_tc *)&midi_timecode);
-	}
-
-	if (output->console_output) {
-		console_set_cursor(2, 24);
-		console_write((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if (output->lcd_output) {
-		lcd_text_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if(output->oled_output) {
-		display_oled_line_1((char *) timecode, TC_CODE_MAX_LENGTH);
-	}
-
-	if (output->segment_output) {
-		display_7segment((const char *) timecode);
-	}
-
-	if (output->matrix_output) {
-		display_matrix((const char *) timecode);
-	}
-
-	if (type != prev_type) {
-		p_type = (char *) ltc_reader_get_type((timecode_types) type);
-		prev_type = type;
-
-		if (output->console_output) {
-			console_set_cursor(2, 25);
-			(void) console_puts(p_type);
-		}
-
-		if (output->lcd_output) {
-			lcd_text_line_2(p_type, TC_TYPE_MAX_LENGTH);
-		}
-
-		if (output->oled_output) {
-			display_oled_line_2(p_type);
-		}
-	}
+	ltc_outputs_update((const char *) timecode, &midi_timecode, (timecode_types) type, 0);
 }
 
 /**
@@ -59,6 +59,8 @@ void notmain(void) {
 	LedBlinkBaremetal lb;
 	Identify identify;
 	LightSet *pLightSet;
+	SPISend *pSPISend = 0;
+	TLC59711Dmx *pTLC59711Dmx = 0;
 	uint8_t nHwTextLength;
 	char aDescription[32];
 
@@ -78,7 +80,7 @@ void notmain(void) {
 
 	if (pwmledparms.Load()) {
 		if ((isLedTypeSet = pwmledparms.IsSetLedType()) == true) {
-			TLC59711Dmx *pTLC59711Dmx = new TLC59711Dmx;
+			pTLC59711Dmx = new TLC59711Dmx;
 			pwmledparms.Dump();
 			pwmledparms.Set(pTLC59711Dmx);
 			pTLC59711Dmx->Start();
@@ -90,7 +92,7 @@ void notmain(void) {
 	if (!isLedTypeSet) {
 		WS28XXStripeParams deviceparams;
 		deviceparams.Load();
-		SPISend *pSPISend = new SPISend;
+		pSPISend = new SPISend;
 		deviceparams.Dump();
 		deviceparams.Set(pSPISend);
 		pSPISend->Start();
@@ -113,6 +115,11 @@ void notmain(void) {
 	for(;;) {
 		hw.WatchdogFeed();
 		(void) dmxrdm.Run();
+		if (pSPISend != 0) {
+			pSPISend->Run();
+		} else if (pTLC59711Dmx != 0) {
+			pTLC59711Dmx->Run();
+		}
 		lb.Run();
 	}
 }
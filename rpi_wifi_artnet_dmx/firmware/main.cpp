@@ -49,6 +49,10 @@
 // DMX output
 #include "dmxparams.h"
 #include "dmxsend.h"
+// Multi-port DMX output
+#include "dmxsendmulti.h"
+#include "dmxuartminiuart.h"
+#include "dmxuartsc16is740.h"
 // Monitor Output
 #include "dmxmonitor.h"
 // WS28xx output
@@ -105,7 +109,7 @@ void notmain(void) {
 	console_set_fg_color(CONSOLE_WHITE);
 	console_puts(" / ");
 	console_set_fg_color(tOutputType == OUTPUT_TYPE_SPI ? CONSOLE_GREEN : CONSOLE_WHITE);
-	console_puts("Pixel controller {4 Universes}");
+	console_puts("Pixel controller");
 	console_set_fg_color(CONSOLE_WHITE);
 
 	hw.SetLed(HARDWARE_LED_ON);
@@ -121,6 +125,10 @@ void notmain(void) {
 
 	ArtNetNode node;
 	DMXSend dmx;
+	DMXSendMulti dmxmulti;
+	DMXUartMiniUart miniuart;
+	DMXUartSC16IS740 sc16is740cs0(SPI_CS0);
+	DMXUartSC16IS740 sc16is740cs1(SPI_CS1);
 	SPISend spi;
 	DMXMonitor monitor;
 	TimeCode timecode;
@@ -130,6 +138,13 @@ void notmain(void) {
 	console_status(CONSOLE_YELLOW, "Setting Node parameters ...");
 	DISPLAY_CONNECTED(oled_connected, display.TextStatus("Setting Node parameters ..."));
 
+	if (tOutputType == OUTPUT_TYPE_SPI) {
+		deviceparms.Set(&spi);
+
+		// One output port per pixel universe, the pages beyond 16 universes get the next Sub-Net
+		artnetparams.SetUniverses(spi.GetUniverseCount());
+	}
+
 	artnetparams.Set(&node);
 
 	if (artnetparams.IsUseTimeCode() || tOutputType == OUTPUT_TYPE_MONITOR) {
@@ -144,7 +159,27 @@ void notmain(void) {
 
 	node.SetUniverseSwitch(0, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse());
 
-	if (tOutputType == OUTPUT_TYPE_DMX) {
+	// More than one universe is sent on the mini UART and the SC16IS740 bridges, without RDM
+	const bool bDmxMulti = (tOutputType == OUTPUT_TYPE_DMX) && (artnetparams.GetUniverses() > 1);
+
+	if (bDmxMulti) {
+		dmx.SetPortDirection(DMXRDM_PORT_DIRECTION_OUTP, false);
+
+		(void) dmxmulti.AddPort(&miniuart);
+		(void) dmxmulti.AddPort(&sc16is740cs0);
+		(void) dmxmulti.AddPort(&sc16is740cs1);
+
+		dmxmulti.SetDmxBreakTime(dmxparams.GetBreakTime());
+		dmxmulti.SetDmxMabTime(dmxparams.GetMabTime());
+		dmxmulti.SetDmxPeriodTime(dmxparams.GetRefreshRate() == 0 ? 0 : 1000000 / dmxparams.GetRefreshRate());
+
+		node.SetOutput(&dmxmulti);
+		node.SetDirectUpdate(false);
+
+		for (uint8_t i = 1; (i < dmxmulti.GetPorts()) && (i < artnetparams.GetUniverses()); i++) {
+			node.SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse(i));
+		}
+	} else if (tOutputType == OUTPUT_TYPE_DMX) {
 		dmxparams.Set(&dmx);
 
 		node.SetOutput(&dmx);
@@ -158,40 +193,11 @@ void notmain(void) {
 			node.SetLongName("Raspberry Pi Art-Net 3 Node RDM Controller");
 		}
 	} else if (tOutputType == OUTPUT_TYPE_SPI) {
-		deviceparms.Set(&spi);
-
 		node.SetOutput(&spi);
 		node.SetDirectUpdate(true);
 
-		const uint16_t nLedCount = spi.GetLEDCount();
-		const uint8_t nUniverse = artnetparams.GetUniverse();
-
-		if (spi.GetLEDType() == SK6812W) {
-			if (nLedCount > 128) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(1, ARTNET_OUTPUT_PORT, nUniverse + 1);
-			}
-			if (nLedCount > 256) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(2, ARTNET_OUTPUT_PORT, nUniverse + 2);
-			}
-			if (nLedCount > 384) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(3, ARTNET_OUTPUT_PORT, nUniverse + 3);
-			}
-		} else {
-			if (nLedCount > 170) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(1, ARTNET_OUTPUT_PORT, nUniverse + 1);
-			}
-			if (nLedCount > 340) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(2, ARTNET_OUTPUT_PORT, nUniverse + 2);
-			}
-			if (nLedCount > 510) {
-				node.SetDirectUpdate(true);
-				node.SetUniverseSwitch(3, ARTNET_OUTPUT_PORT, nUniverse + 3);
-			}
+		for (uint8_t i = 1; i < spi.GetUniverseCount(); i++) {
+			node.SetUniverseSwitch(i, ARTNET_OUTPUT_PORT, artnetparams.GetUniverse(i));
 		}
 	} else if (tOutputType == OUTPUT_TYPE_MONITOR) {
 		node.SetOutput(&monitor);
@@ -205,7 +211,9 @@ void notmain(void) {
 		console_puts("\n\n");
 	}
 
-	if (tOutputType == OUTPUT_TYPE_DMX) {
+	if (bDmxMulti) {
+		dmxmulti.Print();
+	} else if (tOutputType == OUTPUT_TYPE_DMX) {
 		printf("DMX Send parameters\n");
 		printf(" Break time   : %d\n", (int) dmx.GetDmxBreakTime());
 		printf(" MAB time     : %d\n", (int) dmx.GetDmxMabTime());
@@ -216,6 +224,7 @@ void notmain(void) {
 		printf("Led stripe parameters\n");
 		printf(" Type         : %s [%d]\n", WS28XXStripeParams::GetLedTypeString(tType), tType);
 		printf(" Count        : %d\n", (int) spi.GetLEDCount());
+		printf(" Universes    : %d\n", (int) spi.GetUniverseCount());
 	}
 
 	if (oled_connected) {
@@ -223,7 +232,7 @@ void notmain(void) {
 
 		switch (tOutputType) {
 		case OUTPUT_TYPE_DMX:
-			if (artnetparams.IsRdm()) {
+			if (artnetparams.IsRdm() && !bDmxMulti) {
 				display.PutString("RDM");
 			} else {
 				display.PutString("DMX");
@@ -269,6 +278,8 @@ void notmain(void) {
 
 		if (tOutputType == OUTPUT_TYPE_MONITOR) {
 			timesync.ShowSystemTime();
+		} else if (tOutputType == OUTPUT_TYPE_SPI) {
+			spi.Run();
 		}
 
 		lb.Run();
@@ -17,10 +17,16 @@ public:
 	~ArtNetRdmResponder(void);
 
 	void Full(void);
-	const uint8_t GetUidCount(void);
+	const uint16_t GetUidCount(void);
 	void Copy(uint8_t *);
+	uint16_t Copy(uint8_t *, uint16_t nOffset, uint16_t nCount);
 	const uint8_t *Handler(const uint8_t *);
 
+	void DiscoveryStart(bool bIncremental);
+	void DiscoveryStop(void);
+	bool DiscoveryRun(void);
+	bool DiscoveryIsLineFree(void);
+
 	void DumpTod(void);
 
 private:
@@ -56,7 +56,7 @@ void ArtNetRdmResponder::Full(void) {
 	m_Discovery.Full();
 }
 
-const uint8_t ArtNetRdmResponder::GetUidCount(void) {
+const uint16_t ArtNetRdmResponder::GetUidCount(void) {
 	return m_Discovery.GetUidCount();
 }
 
@@ -64,6 +64,26 @@ void ArtNetRdmResponder::Copy(unsigned char *tod) {
 	m_Discovery.Copy(tod);
 }
 
+uint16_t ArtNetRdmResponder::Copy(unsigned char *tod, uint16_t nOffset, uint16_t nCount) {
+	return m_Discovery.Copy(tod, nOffset, nCount);
+}
+
+void ArtNetRdmResponder::DiscoveryStart(bool bIncremental) {
+	m_Discovery.Start(bIncremental);
+}
+
+void ArtNetRdmResponder::DiscoveryStop(void) {
+	m_Discovery.Stop();
+}
+
+bool ArtNetRdmResponder::DiscoveryRun(void) {
+	return m_Discovery.Run();
+}
+
+bool ArtNetRdmResponder::DiscoveryIsLineFree(void) {
+	return m_Discovery.IsLineFree();
+}
+
 void ArtNetRdmResponder::DumpTod(void) {
 	m_Discovery.Dump();
 }
@@ -120,23 +120,26 @@ void notmain(void) {
 	console_status(CONSOLE_YELLOW, "Starting UDP ...");
 	DISPLAY_CONNECTED(IsOledConnected, display.TextStatus("Starting UDP ..."));
 
-	nw.Begin(E131_DEFAULT_PORT);
-
-	console_status(CONSOLE_YELLOW, "Join group ...");
-	DISPLAY_CONNECTED(IsOledConnected, display.TextStatus("Join group ..."));
-
 	E131Bridge bridge;
 
-	struct in_addr group_ip;
-	(void)inet_aton("239.255.0.0", &group_ip);
 	const uint16_t universe = e131params.GetUniverse();
-	group_ip.s_addr = group_ip.s_addr | ((uint32_t)(((uint32_t)universe & (uint32_t)0xFF) << 24)) | ((uint32_t)(((uint32_t)universe & (uint32_t)0xFF00) << 8));
-	nw.JoinGroup(group_ip.s_addr);
 
 	bridge.setCid(uuid);
-	bridge.setUniverse(universe);
+
+	// DMXSend and the monitor have a single port, more universes would interleave on it
+	if (e131params.GetUniverses() > 1) {
+		printf("Universes is limited to 1\n");
+	}
+
+	bridge.setUniverse(0, universe);
+
 	bridge.setMergeMode(e131params.GetMergeMode());
 
+	console_status(CONSOLE_YELLOW, "Join group ...");
+	DISPLAY_CONNECTED(IsOledConnected, display.TextStatus("Join group ..."));
+
+	bridge.Begin();
+
 	if (tOutputType == OUTPUT_TYPE_MONITOR) {
 		bridge.SetOutput(&monitor);
 		monitor.Cls();
@@ -146,7 +149,7 @@ void notmain(void) {
 		bridge.SetOutput(&dmx);
 	}
 
-	bridge.Print(group_ip.s_addr);
+	bridge.Print();
 
 	if (tOutputType == OUTPUT_TYPE_DMX) {
 		printf("DMX Send parameters\n");
@@ -178,7 +181,7 @@ void notmain(void) {
 		(void) display.Printf(3, "CID: ");
 		(void) display.PutString(uuid_str);
 		(void) display.Printf(5, "U: %d M: %s", bridge.getUniverse(), bridge.getMergeMode() == E131_MERGE_HTP ? "HTP" : "LTP");
-		(void) display.Printf(6, "M: " IPSTR "", IP2STR(group_ip.s_addr));
+		(void) display.Printf(6, "M: " IPSTR "", IP2STR(E131Bridge::UniverseToMulticastIp(universe)));
 		(void) display.Printf(7, "U: " IPSTR "", IP2STR(ip_config.ip.addr));
 	}
 
@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "ws28xxstripe.h"
+#include "oscrouter.h"
 
 #define FRAME_BUFFER_SIZE	1024
 
@@ -42,6 +43,16 @@ public:
 
 	void Run(void);
 
+private:
+	void HandleBlackout(const uint8_t *pMessage, unsigned nSize);
+	void HandleChannel(const uint8_t *pMessage, unsigned nSize, int nChannel);
+	void SendInfo(void);
+
+	static void staticPing(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+	static void staticBlackout(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+	static void staticChannel(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+	static void staticInfo(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex);
+
 private:
 	WS28XXStripe	*m_pLEDStripe;
 	char m_Os[32];
@@ -55,6 +66,8 @@ private:
 	bool m_Blackout;
 
 	uint8_t	m_RGBWColour[4];
+	uint32_t m_nRemoteIp;
+	OSCRouter m_Router;
 };
 
 #endif /* OSCWS28XX_H_ */
@@ -34,7 +34,8 @@
 
 #include "osc.h"
 #include "oscsend.h"
-#include "oscmessage.h"
+#include "oscmessageview.h"
+#include "oscrouter.h"
 #include "oscws28xx.h"
 
 #include "ip_address.h"
@@ -47,7 +48,8 @@
 
 OSCWS28xx::OSCWS28xx(unsigned OutgoingPort, unsigned nLEDCount, TWS28XXType nLEDType, const char *sLEDType) :
 	m_pLEDStripe(0),
-	m_Blackout(false)
+	m_Blackout(false),
+	m_nRemoteIp(0)
 {
 	uint8_t nHwTextLength;
 
@@ -64,6 +66,12 @@ OSCWS28xx::OSCWS28xx(unsigned OutgoingPort, unsigned nLEDCount, TWS28XXType nLED
 	for (unsigned i = 0; i < sizeof m_RGBWColour; i++) {
 		m_RGBWColour[i] = 0;
 	}
+
+	m_Router.Add("/ping", OSCWS28xx::staticPing, this);
+	m_Router.Add("/dmx1/blackout", OSCWS28xx::staticBlackout, this);
+	m_Router.Add("/dmx1/*", OSCWS28xx::staticChannel, this);
+	m_Router.Add("/2", OSCWS28xx::staticInfo, this);
+	m_Router.Compile();
 }
 
 OSCWS28xx::~OSCWS28xx(void) {
@@ -98,79 +106,114 @@ void OSCWS28xx::Stop(void) {
 	console_restore_cursor();
 }
 
-void OSCWS28xx::Run(void) {
-	uint16_t from_port;
-	uint32_t from_ip;
+void OSCWS28xx::staticPing(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
 
-	const int len = Network::Get()->RecvFrom((const uint8_t *) m_packet, (const uint16_t) FRAME_BUFFER_SIZE, &from_ip, &from_port);
+	OSCSend MsgSend(((OSCWS28xx *) p)->m_nRemoteIp, ((OSCWS28xx *) p)->m_OutgoingPort, "/pong", 0);
+}
 
-	if (len == 0) {
+void OSCWS28xx::staticBlackout(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
+
+	((OSCWS28xx *) p)->HandleBlackout(pMessage, nSize);
+}
+
+void OSCWS28xx::staticChannel(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
+
+	((OSCWS28xx *) p)->HandleChannel(pMessage, nSize, nIndex);
+}
+
+void OSCWS28xx::staticInfo(void *p, const uint8_t *pMessage, unsigned nSize, int nIndex) {
+	assert(p != 0);
+
+	((OSCWS28xx *) p)->SendInfo();
+}
+
+void OSCWS28xx::HandleBlackout(const uint8_t *pMessage, unsigned nSize) {
+	OSCMessageView Msg(pMessage, nSize);
+
+	if ((Msg.GetResult() != OSC_OK) || (Msg.GetType(0) != OSC_FLOAT)) {
 		return;
 	}
 
-	if (OSC::isMatch((const char*) m_packet, "/ping")) {
-		OSCSend MsgSend(from_ip, m_OutgoingPort, "/pong", 0);
-	} else if (OSC::isMatch((const char*) m_packet, "/dmx1/blackout")) {
-		OSCMessage Msg(m_packet, (unsigned) len);
-		m_Blackout = (unsigned) Msg.GetFloat(0) == 1;
-		console_save_cursor();
-		console_set_cursor(80, 0);
-		if (m_Blackout) {
-			m_pLEDStripe->Blackout();
-			console_set_fg_color(CONSOLE_YELLOW);
-			console_puts("blackout  ");
-		} else {
-			m_pLEDStripe->Update();
-			console_set_fg_color(CONSOLE_CYAN);
-			console_puts("outputting");
-		}
-		console_restore_cursor();
-	} else if (OSC::isMatch((const char*) m_packet, "/dmx1/*")) {
-		OSCMessage Msg(m_packet, (unsigned) len);
+	m_Blackout = (unsigned) Msg.GetFloat(0) == 1;
 
-		const char *p = (const char *) m_packet + 6;
-		const unsigned dmx_channel = (unsigned) (*p - '0');
-		const unsigned dmx_value = (unsigned) Msg.GetFloat(0);
+	console_save_cursor();
+	console_set_cursor(80, 0);
+	if (m_Blackout) {
+		m_pLEDStripe->Blackout();
+		console_set_fg_color(CONSOLE_YELLOW);
+		console_puts("blackout  ");
+	} else {
+		m_pLEDStripe->Update();
+		console_set_fg_color(CONSOLE_CYAN);
+		console_puts("outputting");
+	}
+	console_restore_cursor();
+}
 
-		const unsigned index = dmx_channel - 1;	// DMX channel starts with 1
+void OSCWS28xx::HandleChannel(const uint8_t *pMessage, unsigned nSize, int nChannel) {
+	OSCMessageView Msg(pMessage, nSize);
 
-		if (index < 4) {
-			m_RGBWColour[index] = dmx_value;
-		}
+	if ((Msg.GetResult() != OSC_OK) || (Msg.GetType(0) != OSC_FLOAT)) {
+		return;
+	}
 
-		if (m_nLEDType == SK6812W) {
-			for (unsigned j = 0; j < m_nLEDCount; j++) {
-				m_pLEDStripe->SetLED(j, m_RGBWColour[0], m_RGBWColour[1], m_RGBWColour[2], m_RGBWColour[3]);
-			}
-		} else {
-			for (unsigned j = 0; j < m_nLEDCount; j++) {
-				m_pLEDStripe->SetLED(j, m_RGBWColour[0], m_RGBWColour[1], m_RGBWColour[2]);
-			}
-		}
+	const unsigned dmx_value = (unsigned) Msg.GetFloat(0);
+	const unsigned index = (unsigned) nChannel - 1;	// DMX channel starts with 1
 
+	if (index < 4) {
+		m_RGBWColour[index] = dmx_value;
+	}
 
-		if (!m_Blackout) {
-			m_pLEDStripe->Update();
+	if (m_nLEDType == SK6812W) {
+		for (unsigned j = 0; j < m_nLEDCount; j++) {
+			m_pLEDStripe->SetLED(j, m_RGBWColour[0], m_RGBWColour[1], m_RGBWColour[2], m_RGBWColour[3]);
 		}
-
-		console_save_cursor();
-		console_set_cursor(80, 1);
-		console_puthex_fg_bg(m_RGBWColour[0], CONSOLE_RED, CONSOLE_BLACK);
-		console_puthex_fg_bg(m_RGBWColour[1], CONSOLE_GREEN, CONSOLE_BLACK);
-		console_puthex_fg_bg(m_RGBWColour[2], CONSOLE_BLUE, CONSOLE_BLACK);
-		if (m_nLEDType == SK6812W) {
-			console_puthex_fg_bg(m_RGBWColour[3], CONSOLE_WHITE, CONSOLE_BLACK);
+	} else {
+		for (unsigned j = 0; j < m_nLEDCount; j++) {
+			m_pLEDStripe->SetLED(j, m_RGBWColour[0], m_RGBWColour[1], m_RGBWColour[2]);
 		}
-		console_restore_cursor();
-	} else if (OSC::isMatch((const char*) m_packet, "/2")) {
-		OSCSend MsgSendInfo(from_ip, m_OutgoingPort, "/info/os", "s", m_Os);
-		OSCSend MsgSendModel(from_ip, m_OutgoingPort, "/info/model", "s", m_pModel);
-		OSCSend MsgSendSoc(from_ip, m_OutgoingPort, "/info/soc", "s", m_pSoC);
-		OSCSend MsgSendLedType(from_ip, m_OutgoingPort, "/info/ledtype", "s", m_LEDType);
-		OSCSend MsgSendLedCount(from_ip, m_OutgoingPort, "/info/ledcount", "i", m_nLEDCount);
 	}
 
-	printf("\n%d: " IPSTR ":%d ", (int)len, IP2STR(from_ip), (int) from_port);
+	if (!m_Blackout) {
+		m_pLEDStripe->Update();
+	}
+
+	console_save_cursor();
+	console_set_cursor(80, 1);
+	console_puthex_fg_bg(m_RGBWColour[0], CONSOLE_RED, CONSOLE_BLACK);
+	console_puthex_fg_bg(m_RGBWColour[1], CONSOLE_GREEN, CONSOLE_BLACK);
+	console_puthex_fg_bg(m_RGBWColour[2], CONSOLE_BLUE, CONSOLE_BLACK);
+	if (m_nLEDType == SK6812W) {
+		console_puthex_fg_bg(m_RGBWColour[3], CONSOLE_WHITE, CONSOLE_BLACK);
+	}
+	console_restore_cursor();
+}
+
+void OSCWS28xx::SendInfo(void) {
+	OSCSend MsgSendInfo(m_nRemoteIp, m_OutgoingPort, "/info/os", "s", m_Os);
+	OSCSend MsgSendModel(m_nRemoteIp, m_OutgoingPort, "/info/model", "s", m_pModel);
+	OSCSend MsgSendSoc(m_nRemoteIp, m_OutgoingPort, "/info/soc", "s", m_pSoC);
+	OSCSend MsgSendLedType(m_nRemoteIp, m_OutgoingPort, "/info/ledtype", "s", m_LEDType);
+	OSCSend MsgSendLedCount(m_nRemoteIp, m_OutgoingPort, "/info/ledcount", "i", m_nLEDCount);
+}
+
+void OSCWS28xx::Run(void) {
+	uint16_t from_port;
+
+	(void) m_pLEDStripe->Run();
+
+	const int len = Network::Get()->RecvFrom((const uint8_t *) m_packet, (const uint16_t) FRAME_BUFFER_SIZE, &m_nRemoteIp, &from_port);
+
+	if (len == 0) {
+		return;
+	}
+
+	(void) m_Router.Dispatch(m_packet, (unsigned) len);
+
+	printf("\n%d: " IPSTR ":%d ", (int)len, IP2STR(m_nRemoteIp), (int) from_port);
 
 	for (int i = 0; i < MIN(32, len); i++) {
 		printf("%c", isprint(m_packet[i]) ? m_packet[i] : '.');